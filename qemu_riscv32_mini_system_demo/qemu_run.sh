@@ -24,6 +24,8 @@ gdb_enable=$7
 qemu_test=$8
 test_file=$9
 qemu_help=${10}
+bench_mode=${QEMU_BENCH:-no}
+icount_shift=${QEMU_ICOUNT_SHIFT:-0}
 
 vnc="-vnc :20  -serial mon:stdio"
 qemu_option=""
@@ -51,6 +53,13 @@ Run a OHOS image in qemu according to the options.
     -t,  --test               test mode, exclusive with -g
     -h,  --help               print help info
 
+    Environment:
+
+    QEMU_BENCH=yes            deterministic benchmark mode: -icount with a
+                              virtual clock, cycle/tick counts repeat exactly
+                              (build with bench_deterministic=true as well)
+    QEMU_ICOUNT_SHIFT=N       guest runs at 2^N ns per instruction, default 0
+
     By default, the kernel exec file is: ${elf_file}.
 END
 )
@@ -68,6 +77,15 @@ if [ "$gdb_enable" = "yes" ]; then
     qemu_option+="-s -S"
 fi
 
+# 确定性基准：按指令数推进虚拟时钟，guest 空闲时不睡眠，RTC 也取虚拟时钟，
+# mcycle / mtime 与宿主负载无关；网络等外部输入会重新引入不确定性
+if [ "$bench_mode" = "yes" ]; then
+    qemu_option+=" -icount shift=${icount_shift},align=off,sleep=off -rtc clock=vm"
+    if [ "$net_enable" = "yes" ]; then
+        echo "Warning: network input makes benchmark mode non-deterministic"
+    fi
+fi
+
 function unsupported_parameters_check(){
     if [ "$rebuild_image" = "yes" ]; then
         echo "Error: The -f|--force option is not supported !"
@@ -0,0 +1,42 @@
+#ifndef APP_ALLOC_BACKEND_H
+#define APP_ALLOC_BACKEND_H
+
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 回放用的统一分配器接口
+ * init 按轨迹峰值给出的 arenaSize 从系统堆申请私有区域，deinit 归还；
+ * 直接使用系统堆的后端 (malloc) 忽略 arenaSize。
+ * usage 只在不计时的占用统计轮中调用，可以遍历内部结构。
+ */
+typedef struct {
+    UINT32 usedBytes;           // 已分配字节，含分配器自身的头部与对齐开销
+    UINT32 freeBytes;
+    UINT32 maxFreeBlock;        // 一次能分配出的最大块
+} AllocUsage;
+
+typedef struct {
+    const CHAR *name;
+    UINT32 (*init)(UINT32 arenaSize);
+    VOID (*deinit)(VOID);
+    VOID *(*alloc)(UINT32 size);
+    VOID (*free)(VOID *ptr);
+    VOID *(*realloc)(VOID *ptr, UINT32 size);
+    VOID (*usage)(AllocUsage *usage);
+} AllocBackend;
+
+extern const AllocBackend g_losPoolBackend;
+extern const AllocBackend g_mallocBackend;
+extern const AllocBackend g_tlsfBackend;
+#if defined(LOSCFG_KERNEL_MEMBOX)
+extern const AllocBackend g_memboxBackend;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif
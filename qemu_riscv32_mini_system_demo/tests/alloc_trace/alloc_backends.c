@@ -0,0 +1,362 @@
+/*
+ * 回放后端：独立 LOS 内存池 / newlib malloc / TLSF 池 / 按尺寸分级的 membox 池
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "los_config.h"
+#include "los_memory.h"
+#if defined(LOSCFG_KERNEL_MEMBOX)
+#include "los_membox.h"
+#endif
+
+#include "tlsf.h"
+#include "alloc_backend.h"
+
+/* ================= los_pool ================= */
+// 与系统堆同一套 LOS_Mem 实现，但在私有区域上运行，占用与碎片不受其他任务干扰
+
+static VOID *g_losArena = NULL;
+
+static UINT32 LosPoolInit(UINT32 arenaSize)
+{
+    g_losArena = malloc(arenaSize);
+    if (g_losArena == NULL) {
+        return LOS_NOK;
+    }
+    if (LOS_MemInit(g_losArena, arenaSize) != LOS_OK) {
+        free(g_losArena);
+        g_losArena = NULL;
+        return LOS_NOK;
+    }
+    return LOS_OK;
+}
+
+static VOID LosPoolDeinit(VOID)
+{
+    (void)LOS_MemDeInit(g_losArena);
+    free(g_losArena);
+    g_losArena = NULL;
+}
+
+static VOID *LosPoolAlloc(UINT32 size)
+{
+    return LOS_MemAlloc(g_losArena, size);
+}
+
+static VOID LosPoolFree(VOID *ptr)
+{
+    (void)LOS_MemFree(g_losArena, ptr);
+}
+
+static VOID *LosPoolRealloc(VOID *ptr, UINT32 size)
+{
+    return LOS_MemRealloc(g_losArena, ptr, size);
+}
+
+static VOID PoolUsage(VOID *pool, AllocUsage *usage)
+{
+    LOS_MEM_POOL_STATUS status = { 0 };
+
+    (void)LOS_MemInfoGet(pool, &status);
+    usage->usedBytes = status.totalUsedSize;
+    usage->freeBytes = status.totalFreeSize;
+    usage->maxFreeBlock = status.maxFreeNodeSize;
+}
+
+static VOID LosPoolUsage(AllocUsage *usage)
+{
+    PoolUsage(g_losArena, usage);
+}
+
+const AllocBackend g_losPoolBackend = {
+    .name = "los_pool",
+    .init = LosPoolInit,
+    .deinit = LosPoolDeinit,
+    .alloc = LosPoolAlloc,
+    .free = LosPoolFree,
+    .realloc = LosPoolRealloc,
+    .usage = LosPoolUsage,
+};
+
+/* ================= malloc ================= */
+// newlib malloc 落在系统堆上，占用按 init 时的基线求差，碎片反映的是整个系统堆
+
+static UINT32 g_sysBaseline;
+
+static UINT32 MallocInit(UINT32 arenaSize)
+{
+    LOS_MEM_POOL_STATUS status = { 0 };
+
+    (void)arenaSize;
+    (void)LOS_MemInfoGet(OS_SYS_MEM_ADDR, &status);
+    g_sysBaseline = status.totalUsedSize;
+    return LOS_OK;
+}
+
+static VOID MallocDeinit(VOID)
+{
+}
+
+static VOID *MallocAlloc(UINT32 size)
+{
+    return malloc(size);
+}
+
+static VOID MallocFree(VOID *ptr)
+{
+    free(ptr);
+}
+
+static VOID *MallocRealloc(VOID *ptr, UINT32 size)
+{
+    return realloc(ptr, size);
+}
+
+static VOID MallocUsage(AllocUsage *usage)
+{
+    PoolUsage(OS_SYS_MEM_ADDR, usage);
+    usage->usedBytes = (usage->usedBytes > g_sysBaseline) ? (usage->usedBytes - g_sysBaseline) : 0;
+}
+
+const AllocBackend g_mallocBackend = {
+    .name = "malloc",
+    .init = MallocInit,
+    .deinit = MallocDeinit,
+    .alloc = MallocAlloc,
+    .free = MallocFree,
+    .realloc = MallocRealloc,
+    .usage = MallocUsage,
+};
+
+/* ================= tlsf ================= */
+// tlsf/tlsf.h 的两级分离适配池，与 los_pool 使用同样大小的私有区域
+
+static VOID *g_tlsfArena = NULL;
+
+static UINT32 TlsfInit(UINT32 arenaSize)
+{
+    g_tlsfArena = malloc(arenaSize);
+    if (g_tlsfArena == NULL) {
+        return LOS_NOK;
+    }
+    if (TlsfMemInit(g_tlsfArena, arenaSize) != LOS_OK) {
+        free(g_tlsfArena);
+        g_tlsfArena = NULL;
+        return LOS_NOK;
+    }
+    return LOS_OK;
+}
+
+static VOID TlsfDeinit(VOID)
+{
+    (void)TlsfMemDeInit(g_tlsfArena);
+    free(g_tlsfArena);
+    g_tlsfArena = NULL;
+}
+
+static VOID *TlsfAlloc(UINT32 size)
+{
+    return TlsfMemAlloc(g_tlsfArena, size);
+}
+
+static VOID TlsfFree(VOID *ptr)
+{
+    (void)TlsfMemFree(g_tlsfArena, ptr);
+}
+
+static VOID *TlsfRealloc(VOID *ptr, UINT32 size)
+{
+    return TlsfMemRealloc(g_tlsfArena, ptr, size);
+}
+
+static VOID TlsfUsage(AllocUsage *usage)
+{
+    LOS_MEM_POOL_STATUS status = { 0 };
+
+    (void)TlsfMemInfoGet(g_tlsfArena, &status);
+    usage->usedBytes = status.totalUsedSize;
+    usage->freeBytes = status.totalFreeSize;
+    usage->maxFreeBlock = status.maxFreeNodeSize;
+}
+
+const AllocBackend g_tlsfBackend = {
+    .name = "tlsf",
+    .init = TlsfInit,
+    .deinit = TlsfDeinit,
+    .alloc = TlsfAlloc,
+    .free = TlsfFree,
+    .realloc = TlsfRealloc,
+    .usage = TlsfUsage,
+};
+
+/* ================= membox ================= */
+// 16..512 字节六档定长池各占 arena 的 1/12，其余一半给 LOS 池兜底大块与池满的分配
+
+#if defined(LOSCFG_KERNEL_MEMBOX)
+#define MEMBOX_CLASSES           6
+#define MEMBOX_MIN_SHIFT         4
+
+typedef struct {
+    UINT8 *pool;
+    UINT32 poolSize;
+    UINT32 blkSize;
+    UINT32 capacity;
+    UINT32 inUse;
+} MemboxClass;
+
+static MemboxClass g_classes[MEMBOX_CLASSES];
+static UINT8 *g_memboxArena = NULL;
+static VOID *g_fallback = NULL;
+
+static MemboxClass *ClassOfSize(UINT32 size)
+{
+    for (UINT32 i = 0; i < MEMBOX_CLASSES; i++) {
+        if (size <= g_classes[i].blkSize) {
+            return &g_classes[i];
+        }
+    }
+    return NULL;
+}
+
+static MemboxClass *ClassOfPtr(const VOID *ptr)
+{
+    for (UINT32 i = 0; i < MEMBOX_CLASSES; i++) {
+        const UINT8 *base = g_classes[i].pool;
+        if ((const UINT8 *)ptr >= base && (const UINT8 *)ptr < base + g_classes[i].poolSize) {
+            return &g_classes[i];
+        }
+    }
+    return NULL;
+}
+
+// membox 不提供容量查询，初始化时取空一次得到块数
+static UINT32 MemboxCapacity(MemboxClass *cls)
+{
+    VOID *head = NULL;
+    UINT32 n = 0;
+    VOID *blk;
+
+    while ((blk = LOS_MemboxAlloc(cls->pool)) != NULL) {
+        *(VOID **)blk = head;
+        head = blk;
+        n++;
+    }
+    while (head != NULL) {
+        blk = head;
+        head = *(VOID **)blk;
+        (void)LOS_MemboxFree(cls->pool, blk);
+    }
+    return n;
+}
+
+static UINT32 MemboxInit(UINT32 arenaSize)
+{
+    UINT32 slice = (arenaSize / (MEMBOX_CLASSES * 2)) & ~7U;
+    UINT32 fallbackSize = arenaSize - slice * MEMBOX_CLASSES;
+
+    g_memboxArena = malloc(arenaSize);
+    if (g_memboxArena == NULL) {
+        return LOS_NOK;
+    }
+    for (UINT32 i = 0; i < MEMBOX_CLASSES; i++) {
+        MemboxClass *cls = &g_classes[i];
+        cls->pool = g_memboxArena + slice * i;
+        cls->poolSize = slice;
+        cls->blkSize = 1U << (MEMBOX_MIN_SHIFT + i);
+        cls->inUse = 0;
+        if (LOS_MemboxInit(cls->pool, slice, cls->blkSize) != LOS_OK) {
+            free(g_memboxArena);
+            g_memboxArena = NULL;
+            return LOS_NOK;
+        }
+        cls->capacity = MemboxCapacity(cls);
+    }
+    g_fallback = g_memboxArena + slice * MEMBOX_CLASSES;
+    if (LOS_MemInit(g_fallback, fallbackSize) != LOS_OK) {
+        free(g_memboxArena);
+        g_memboxArena = NULL;
+        return LOS_NOK;
+    }
+    return LOS_OK;
+}
+
+static VOID MemboxDeinit(VOID)
+{
+    (void)LOS_MemDeInit(g_fallback);
+    free(g_memboxArena);
+    g_memboxArena = NULL;
+    g_fallback = NULL;
+}
+
+static VOID *MemboxAlloc(UINT32 size)
+{
+    MemboxClass *cls = ClassOfSize(size);
+    VOID *p;
+
+    if (cls != NULL) {
+        p = LOS_MemboxAlloc(cls->pool);
+        if (p != NULL) {
+            cls->inUse++;
+            return p;
+        }
+    }
+    return LOS_MemAlloc(g_fallback, size);
+}
+
+static VOID MemboxFree(VOID *ptr)
+{
+    MemboxClass *cls = ClassOfPtr(ptr);
+
+    if (cls != NULL) {
+        (void)LOS_MemboxFree(cls->pool, ptr);
+        cls->inUse--;
+        return;
+    }
+    (void)LOS_MemFree(g_fallback, ptr);
+}
+
+static VOID *MemboxRealloc(VOID *ptr, UINT32 size)
+{
+    MemboxClass *cls = ClassOfPtr(ptr);
+    VOID *p;
+
+    if (cls == NULL) {
+        return LOS_MemRealloc(g_fallback, ptr, size);
+    }
+    if (size <= cls->blkSize) {
+        return ptr;
+    }
+    p = MemboxAlloc(size);
+    if (p != NULL) {
+        (void)memcpy(p, ptr, cls->blkSize);
+        MemboxFree(ptr);
+    }
+    return p;
+}
+
+// 定长池的空闲块只能满足本档以内的请求，最大可分配块取兜底池与有空闲的最大档中较大者
+static VOID MemboxUsage(AllocUsage *usage)
+{
+    PoolUsage(g_fallback, usage);
+    for (UINT32 i = 0; i < MEMBOX_CLASSES; i++) {
+        const MemboxClass *cls = &g_classes[i];
+        usage->usedBytes += cls->inUse * cls->blkSize;
+        usage->freeBytes += (cls->capacity - cls->inUse) * cls->blkSize;
+        if (cls->inUse < cls->capacity && cls->blkSize > usage->maxFreeBlock) {
+            usage->maxFreeBlock = cls->blkSize;
+        }
+    }
+}
+
+const AllocBackend g_memboxBackend = {
+    .name = "membox",
+    .init = MemboxInit,
+    .deinit = MemboxDeinit,
+    .alloc = MemboxAlloc,
+    .free = MemboxFree,
+    .realloc = MemboxRealloc,
+    .usage = MemboxUsage,
+};
+#endif
@@ -0,0 +1,402 @@
+/*
+ * 分配器基准：轨迹回放
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+
+#include "los_task.h"
+#include "los_config.h"
+#include "los_tick.h"
+
+#include "alloc_replay.h"
+#include "bench_result.h"
+#include "bench_rng.h"
+#include "event_wake.h"
+
+#define REPLAY_TASK_STACK_SIZE   0x3000
+#define REPLAY_TASK_PRI          10
+#define TRACE_PATH_LEN           64
+#define CASE_NAME_LEN            40
+#define FS_READY_TIMEOUT         LOS_MS2Tick(5000)
+
+/* ================= 全局变量 ================= */
+static const AllocBackend *g_backends[] = {
+    &g_losPoolBackend,
+    &g_mallocBackend,
+    &g_tlsfBackend,
+#if defined(LOSCFG_KERNEL_MEMBOX)
+    &g_memboxBackend,
+#endif
+};
+
+#define BACKEND_COUNT (sizeof(g_backends) / sizeof(g_backends[0]))
+
+/* ================= 回放 ================= */
+
+// 峰值留两倍余量给分配器头部、对齐与碎片
+static UINT32 ArenaSize(const AllocTrace *trace)
+{
+    UINT32 size = trace->hdr.peakBytes * 2 + trace->hdr.maxLive * 16;
+    return (size < ALLOC_REPLAY_ARENA_MIN) ? ALLOC_REPLAY_ARENA_MIN : size;
+}
+
+static UINT32 FragPct(const AllocUsage *u)
+{
+    if (u->freeBytes == 0) {
+        return 0;
+    }
+    return 100 - (UINT32)((UINT64)u->maxFreeBlock * 100 / u->freeBytes);
+}
+
+/*
+ * 执行一个事件，返回 FALSE 表示分配失败
+ */
+static BOOL Step(const AllocBackend *be, VOID **ptrs, const AllocTraceEvent *ev)
+{
+    VOID *p;
+
+    switch (ev->op) {
+        case ALLOC_EV_ALLOC:
+            if (ptrs[ev->id] != NULL) {
+                be->free(ptrs[ev->id]);
+            }
+            ptrs[ev->id] = be->alloc(ev->size);
+            return ptrs[ev->id] != NULL;
+        case ALLOC_EV_FREE:
+            if (ptrs[ev->id] != NULL) {
+                be->free(ptrs[ev->id]);
+                ptrs[ev->id] = NULL;
+            }
+            return TRUE;
+        case ALLOC_EV_REALLOC:
+            if (ptrs[ev->id] == NULL) {
+                return TRUE;
+            }
+            p = be->realloc(ptrs[ev->id], ev->size);
+            if (p == NULL) {
+                return FALSE;
+            }
+            ptrs[ev->id] = p;
+            return TRUE;
+        default:
+            return TRUE;
+    }
+}
+
+static VOID FreeRemaining(const AllocBackend *be, VOID **ptrs, UINT32 n)
+{
+    for (UINT32 i = 0; i < n; i++) {
+        if (ptrs[i] != NULL) {
+            be->free(ptrs[i]);
+            ptrs[i] = NULL;
+        }
+    }
+}
+
+static UINT32 TimedRound(const AllocTrace *trace, const AllocBackend *be, VOID **ptrs,
+                         UINT64 *total, UINT32 *worst)
+{
+    UINT32 failures = 0;
+    UINT64 begin;
+
+    LOS_TaskLock();
+    begin = LOS_SysCycleGet();
+    for (UINT32 i = 0; i < trace->hdr.count; i++) {
+        UINT64 t0 = LOS_SysCycleGet();
+        failures += Step(be, ptrs, &trace->events[i]) ? 0 : 1;
+        UINT32 dt = (UINT32)(LOS_SysCycleGet() - t0);
+        *worst = (dt > *worst) ? dt : *worst;
+    }
+    *total = LOS_SysCycleGet() - begin;
+    LOS_TaskUnlock();
+    FreeRemaining(be, ptrs, trace->hdr.maxLive);
+    return failures;
+}
+
+static VOID FootprintRound(const AllocTrace *trace, const AllocBackend *be, VOID **ptrs, AllocReplayResult *r)
+{
+    AllocUsage usage;
+
+    for (UINT32 i = 0; i < trace->hdr.count; i++) {
+        const AllocTraceEvent *ev = &trace->events[i];
+        (void)Step(be, ptrs, ev);
+        if (ev->op != ALLOC_EV_FREE) {
+            be->usage(&usage);
+            r->peakBytes = (usage.usedBytes > r->peakBytes) ? usage.usedBytes : r->peakBytes;
+        }
+    }
+    be->usage(&usage);
+    r->fragPct = FragPct(&usage);
+    FreeRemaining(be, ptrs, trace->hdr.maxLive);
+}
+
+UINT32 AllocReplayRun(const AllocTrace *trace, const AllocBackend *backend, AllocReplayResult *result)
+{
+    UINT32 arena = ArenaSize(trace);
+    UINT64 best = 0;
+    VOID **ptrs = calloc(trace->hdr.maxLive + 1, sizeof(VOID *));
+
+    memset(result, 0, sizeof(*result));
+    if (ptrs == NULL) {
+        return LOS_NOK;
+    }
+    result->ops = trace->hdr.count;
+
+    for (UINT32 round = 0; round < ALLOC_REPLAY_ROUNDS; round++) {
+        UINT64 total = 0;
+        if (backend->init(arena) != LOS_OK) {
+            free(ptrs);
+            return LOS_NOK;
+        }
+        UINT32 failures = TimedRound(trace, backend, ptrs, &total, &result->worstCycles);
+        backend->deinit();
+        result->failures = (failures > result->failures) ? failures : result->failures;
+        best = (round == 0 || total < best) ? total : best;
+    }
+
+    if (backend->init(arena) == LOS_OK) {
+        FootprintRound(trace, backend, ptrs, result);
+        backend->deinit();
+    }
+    free(ptrs);
+
+    if (best != 0) {
+        result->opsPerSec = (UINT32)((UINT64)result->ops * OS_SYS_CLOCK / best);
+    }
+    result->avgCycles = (result->ops == 0) ? 0 : (UINT32)(best / result->ops);
+    return LOS_OK;
+}
+
+/* ================= 输出 ================= */
+
+static VOID Report(const AllocTrace *trace, const AllocBackend *be, const AllocReplayResult *r)
+{
+    CHAR name[CASE_NAME_LEN];
+
+    printf("%-8s | %-8s | %6u ops | %9u ops/s | avg %5u cyc | worst %7u cyc | peak %7u B | frag %3u%% | fail %u\n",
+           trace->hdr.name, be->name, r->ops, r->opsPerSec, r->avgCycles, r->worstCycles, r->peakBytes,
+           r->fragPct, r->failures);
+
+    (void)snprintf(name, sizeof(name), "%s.%s", trace->hdr.name, be->name);
+    BenchResult br = { "alloc", name, "ops_per_s", "ops/s", r->opsPerSec, r->ops };
+    BenchResultEmit(&br, NULL);
+    br.metric = "avg_cycles";
+    br.unit = "cycles";
+    br.value = r->avgCycles;
+    BenchResultEmit(&br, NULL);
+    br.metric = "worst_cycles";
+    br.value = r->worstCycles;
+    BenchResultEmit(&br, NULL);
+    br.metric = "peak_bytes";
+    br.unit = "bytes";
+    br.value = r->peakBytes;
+    BenchResultEmit(&br, NULL);
+    br.metric = "frag_pct";
+    br.unit = "pct";
+    br.value = r->fragPct;
+    BenchResultEmit(&br, NULL);
+    br.metric = "failures";
+    br.unit = "errors";
+    br.value = r->failures;
+    BenchResultEmit(&br, NULL);
+}
+
+// 百分比相对基准后端，基准为 0 时记 0
+static UINT32 Ratio(UINT32 value, UINT32 base)
+{
+    return (base == 0) ? 0 : (UINT32)((UINT64)value * 100 / base);
+}
+
+static VOID Compare(const AllocTrace *trace, const AllocReplayResult *results, const BOOL *valid)
+{
+    const AllocReplayResult *base = &results[0];
+
+    if (!valid[0]) {
+        return;
+    }
+    for (UINT32 i = 1; i < BACKEND_COUNT; i++) {
+        if (!valid[i]) {
+            continue;
+        }
+        printf("%-8s | %-8s | vs %s: worst %3u%% | avg %3u%% | peak %3u%% | frag %+d pt\n",
+               trace->hdr.name, g_backends[i]->name, g_backends[0]->name,
+               Ratio(results[i].worstCycles, base->worstCycles), Ratio(results[i].avgCycles, base->avgCycles),
+               Ratio(results[i].peakBytes, base->peakBytes), (INT32)results[i].fragPct - (INT32)base->fragPct);
+    }
+}
+
+static VOID ReplayTrace(const AllocTrace *trace)
+{
+    AllocReplayResult results[BACKEND_COUNT];
+    BOOL valid[BACKEND_COUNT];
+
+    printf("[replay] %s: %u events, %u objects, recorded peak %u bytes, arena %u bytes\n",
+           trace->hdr.name, trace->hdr.count, trace->hdr.maxLive, trace->hdr.peakBytes, ArenaSize(trace));
+    for (UINT32 i = 0; i < BACKEND_COUNT; i++) {
+        valid[i] = (AllocReplayRun(trace, g_backends[i], &results[i]) == LOS_OK);
+        if (!valid[i]) {
+            printf("%-8s | %-8s | init failed\n", trace->hdr.name, g_backends[i]->name);
+            continue;
+        }
+        Report(trace, g_backends[i], &results[i]);
+    }
+    Compare(trace, results, valid);
+}
+
+static VOID ReplayFile(const CHAR *path)
+{
+    AllocTrace trace;
+
+    if (AllocTraceLoad(path, &trace) != LOS_OK) {
+        return;
+    }
+    printf("[replay] loaded %s\n", path);
+    ReplayTrace(&trace);
+    AllocTraceRelease(&trace);
+}
+
+/* ================= 合成轨迹 ================= */
+
+static UINT32 SynthSize(BenchRng *rng)
+{
+    UINT32 r = BenchRngNext(rng) % 100;
+
+    if (r < 70) {
+        return 8 + BenchRngNext(rng) % 248;
+    }
+    if (r < 95) {
+        return 256 + BenchRngNext(rng) % 1792;
+    }
+    return 2048 + BenchRngNext(rng) % 6144;
+}
+
+UINT32 AllocReplaySynthesize(AllocTrace *trace)
+{
+    BenchRng rng;
+    UINT16 live[ALLOC_SYNTH_LIVE];
+    UINT16 freeIds[ALLOC_SYNTH_LIVE];
+    UINT32 sizes[ALLOC_SYNTH_LIVE];
+    UINT32 nLive = 0;
+    UINT32 nFree = ALLOC_SYNTH_LIVE;
+    UINT32 liveBytes = 0;
+
+    memset(trace, 0, sizeof(*trace));
+    trace->events = malloc(ALLOC_SYNTH_EVENTS * sizeof(AllocTraceEvent));
+    if (trace->events == NULL) {
+        return LOS_NOK;
+    }
+    for (UINT32 i = 0; i < ALLOC_SYNTH_LIVE; i++) {
+        freeIds[i] = (UINT16)(ALLOC_SYNTH_LIVE - 1 - i);
+    }
+    BenchRngInit(&rng, BENCH_RNG_STREAM_ALLOC_REPLAY);
+
+    for (UINT32 n = 0; n < ALLOC_SYNTH_EVENTS; n++) {
+        AllocTraceEvent *ev = &trace->events[n];
+        UINT32 r = BenchRngNext(&rng) % 100;
+        ev->reserved = 0;
+        if (nLive == 0 || (nFree != 0 && r < 55)) {
+            UINT16 id = freeIds[--nFree];
+            sizes[id] = SynthSize(&rng);
+            liveBytes += sizes[id];
+            live[nLive++] = id;
+            ev->op = ALLOC_EV_ALLOC;
+            ev->id = id;
+            ev->size = sizes[id];
+        } else if (r < 60) {
+            UINT16 id = live[BenchRngNext(&rng) % nLive];
+            liveBytes -= sizes[id];
+            sizes[id] = SynthSize(&rng);
+            liveBytes += sizes[id];
+            ev->op = ALLOC_EV_REALLOC;
+            ev->id = id;
+            ev->size = sizes[id];
+        } else {
+            UINT32 k = BenchRngNext(&rng) % nLive;
+            UINT16 id = live[k];
+            live[k] = live[--nLive];
+            freeIds[nFree++] = id;
+            liveBytes -= sizes[id];
+            ev->op = ALLOC_EV_FREE;
+            ev->id = id;
+            ev->size = 0;
+        }
+        trace->hdr.peakBytes = (liveBytes > trace->hdr.peakBytes) ? liveBytes : trace->hdr.peakBytes;
+    }
+
+    trace->hdr.magic = ALLOC_TRACE_MAGIC;
+    trace->hdr.version = ALLOC_TRACE_VERSION;
+    trace->hdr.maxLive = ALLOC_SYNTH_LIVE;
+    trace->hdr.count = ALLOC_SYNTH_EVENTS;
+    (void)strncpy(trace->hdr.name, "synth", ALLOC_TRACE_NAME_LEN - 1);
+    return LOS_OK;
+}
+
+UINT32 AllocReplayAll(VOID)
+{
+    CHAR paths[ALLOC_REPLAY_MAX_TRACES][TRACE_PATH_LEN];
+    UINT32 n = 0;
+    struct dirent *ent;
+    AllocTrace synth;
+    DIR *dir;
+
+    if (AllocReplaySynthesize(&synth) == LOS_OK) {
+        ReplayTrace(&synth);
+        AllocTraceRelease(&synth);
+    }
+
+    dir = opendir(ALLOC_TRACE_DIR);
+    if (dir == NULL) {
+        return 0;
+    }
+    // 先收集文件名再回放，回放期间不持有目录句柄
+    while ((ent = readdir(dir)) != NULL && n < ALLOC_REPLAY_MAX_TRACES) {
+        size_t len = strlen(ent->d_name);
+        if (strncmp(ent->d_name, ALLOC_TRACE_PREFIX, strlen(ALLOC_TRACE_PREFIX)) == 0 &&
+            len > 4 && strcmp(ent->d_name + len - 4, ".bin") == 0) {
+            (void)snprintf(paths[n++], TRACE_PATH_LEN, "%s/%s", ALLOC_TRACE_DIR, ent->d_name);
+        }
+    }
+    (void)closedir(dir);
+
+    for (UINT32 i = 0; i < n; i++) {
+        ReplayFile(paths[i]);
+    }
+    return n;
+}
+
+static VOID *AllocReplayTask(UINTPTR arg)
+{
+    (void)arg;
+    (void)EvtSysFsProbeStart("/data");
+    (void)EvtSysWait(EVT_SYS_FS_READY, FS_READY_TIMEOUT);
+    printf("\n==== Allocator Replay Benchmark (build %s) ====\n", BenchBuildId());
+    if (AllocReplayAll() == 0) {
+        printf("[replay] no recorded traces in %s\n", ALLOC_TRACE_DIR);
+        printf("[replay] build with alloc_trace_record = true and run the tcm / openhitls / ui tests once,\n"
+               "         or use \"alloctrace start <name>\" / \"alloctrace stop\" in the shell, then reboot\n");
+    }
+    printf("==== Allocator Replay Done ====\n");
+    return NULL;
+}
+
+void AllocReplayApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    // 回放镜像里也能用 shell 临时记录新轨迹
+    (void)AllocTraceShellInit();
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)AllocReplayTask;
+    task.uwStackSize  = REPLAY_TASK_STACK_SIZE;
+    task.pcName       = "AllocReplayTask";
+    task.usTaskPrio   = REPLAY_TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("AllocReplayTask create failed: 0x%X\n", ret);
+    }
+}
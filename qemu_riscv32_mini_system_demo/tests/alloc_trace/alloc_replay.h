@@ -0,0 +1,63 @@
+#ifndef APP_ALLOC_REPLAY_H
+#define APP_ALLOC_REPLAY_H
+
+#include "alloc_trace.h"
+#include "alloc_backend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 分配器基准：把 ALLOC_TRACE_DIR 下记录的真实分配轨迹 (tcm / hitls / ui，见 alloc_trace.h)
+ * 逐一回放到各个后端，比较吞吐、单次操作最坏延迟、峰值占用与结束时的碎片。
+ *   - 计时轮 ALLOC_REPLAY_ROUNDS 次，锁调度回放，取总耗时最短的一轮换算 ops/s 与平均周期，
+ *     最坏周期取所有轮的最大值；
+ *   - 另跑一轮不计时的统计轮，每次分配后取一次占用得到峰值；轨迹走完、释放残留对象之前
+ *     按 100 - 最大空闲块 / 总空闲 计算碎片百分比。
+ * 除记录的轨迹外总会先回放一条合成的碎片化负载 "synth"，没有记录轨迹时也能比较各后端；
+ * 每条轨迹之后列出各后端相对 los_pool (系统堆所用实现) 的最坏延迟、平均延迟、碎片与峰值。
+ * 结果按 bench_result.h 输出，suite 为 "alloc"，case 为 "<trace>.<backend>"。
+ * 周期为 LOS_SysCycleGet 的计数，频率 OS_SYS_CLOCK。
+ */
+
+#define ALLOC_REPLAY_ROUNDS      3
+#define ALLOC_REPLAY_ARENA_MIN   (64 * 1024)
+#define ALLOC_REPLAY_MAX_TRACES  8
+#define ALLOC_SYNTH_EVENTS       6000
+#define ALLOC_SYNTH_LIVE         128
+
+typedef struct {
+    UINT32 ops;
+    UINT32 failures;            // 分配或 realloc 返回 NULL 的次数
+    UINT32 opsPerSec;
+    UINT32 avgCycles;
+    UINT32 worstCycles;
+    UINT32 peakBytes;
+    UINT32 fragPct;
+} AllocReplayResult;
+
+/**
+ * @brief 把一条轨迹回放到一个后端
+ * @return LOS_NOK 后端初始化失败
+ */
+UINT32 AllocReplayRun(const AllocTrace *trace, const AllocBackend *backend, AllocReplayResult *result);
+
+/**
+ * @brief 生成合成轨迹：小块为主、夹杂中大块与 realloc，存活对象数在上限附近随机进出，
+ * 随机数取 BENCH_RNG_STREAM_ALLOC_REPLAY 流，确定模式下每次相同。用完调用 AllocTraceRelease
+ */
+UINT32 AllocReplaySynthesize(AllocTrace *trace);
+
+/**
+ * @brief 回放合成轨迹与 ALLOC_TRACE_DIR 下所有轨迹到所有后端并输出结果
+ * @return 回放的记录轨迹数 (不含合成轨迹)
+ */
+UINT32 AllocReplayAll(VOID);
+
+void AllocReplayApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,383 @@
+/*
+ * 分配轨迹记录
+ * 钩子在分配者任务中、内存池解锁之后调用，这里关中断更新记录状态，不调用任何会再分配内存的接口。
+ * 指针到对象号的映射用线性探测哈希表，删除时向后移位，不留墓碑。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "los_task.h"
+#include "los_config.h"
+#include "los_memory.h"
+#include "los_interrupt.h"
+#include "los_hook.h"
+#include "shcmd.h"
+
+#include "alloc_trace.h"
+
+#define LIVE_HASH_SIZE           (ALLOC_TRACE_MAX_LIVE * 2)
+#define LIVE_HASH_MASK           (LIVE_HASH_SIZE - 1)
+#define TRACE_PATH_LEN           64
+#define RECORDER_STACK_SIZE      0x1000
+#define RECORDER_PRI             20
+
+/* ================= 全局变量 ================= */
+static AllocTraceEvent g_events[ALLOC_TRACE_MAX_EVENTS];
+static AllocTraceStats g_stats;
+static AllocTraceHeader g_hdr;
+static volatile BOOL g_recording = FALSE;
+static UINT32 g_taskFilter;
+
+static UINTPTR g_hashPtr[LIVE_HASH_SIZE];
+static UINT16 g_hashId[LIVE_HASH_SIZE];
+static UINT32 g_idSize[ALLOC_TRACE_MAX_LIVE];
+static UINT16 g_freeIds[ALLOC_TRACE_MAX_LIVE];
+static UINT32 g_freeIdCount;
+static UINT32 g_liveBytes;
+
+static CHAR g_recordName[ALLOC_TRACE_NAME_LEN];
+static UINT32 g_recordTicks;
+
+/* ================= 指针映射 ================= */
+
+static UINT32 Hash(UINTPTR p)
+{
+    return (((UINT32)p >> 3) * 2654435761U) & LIVE_HASH_MASK;
+}
+
+static INT32 Find(UINTPTR p)
+{
+    UINT32 i = Hash(p);
+
+    while (g_hashPtr[i] != 0) {
+        if (g_hashPtr[i] == p) {
+            return (INT32)i;
+        }
+        i = (i + 1) & LIVE_HASH_MASK;
+    }
+    return -1;
+}
+
+static VOID Insert(UINTPTR p, UINT16 id)
+{
+    UINT32 i = Hash(p);
+
+    while (g_hashPtr[i] != 0) {
+        i = (i + 1) & LIVE_HASH_MASK;
+    }
+    g_hashPtr[i] = p;
+    g_hashId[i] = id;
+}
+
+static VOID Remove(UINT32 slot)
+{
+    UINT32 i = slot;
+    UINT32 j = slot;
+
+    for (;;) {
+        j = (j + 1) & LIVE_HASH_MASK;
+        if (g_hashPtr[j] == 0) {
+            break;
+        }
+        // 起始位置不在 (i, j] 环形区间内的项可以前移填补空位
+        UINT32 k = Hash(g_hashPtr[j]);
+        BOOL inRange = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+        if (!inRange) {
+            g_hashPtr[i] = g_hashPtr[j];
+            g_hashId[i] = g_hashId[j];
+            i = j;
+        }
+    }
+    g_hashPtr[i] = 0;
+}
+
+static BOOL IdAlloc(UINT16 *id)
+{
+    if (g_freeIdCount != 0) {
+        *id = g_freeIds[--g_freeIdCount];
+        return TRUE;
+    }
+    if (g_hdr.maxLive < ALLOC_TRACE_MAX_LIVE) {
+        *id = g_hdr.maxLive++;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/* ================= 钩子 ================= */
+
+static VOID Emit(UINT8 op, UINT16 id, UINT32 size)
+{
+    if (g_hdr.count >= ALLOC_TRACE_MAX_EVENTS) {
+        g_stats.dropped++;
+        return;
+    }
+    g_events[g_hdr.count].op = op;
+    g_events[g_hdr.count].reserved = 0;
+    g_events[g_hdr.count].id = id;
+    g_events[g_hdr.count].size = size;
+    g_hdr.count++;
+}
+
+// 释放映射中的一项并记一条 FREE；调用者持有中断锁
+static VOID Release(UINT32 slot)
+{
+    UINT16 id = g_hashId[slot];
+
+    Remove(slot);
+    g_liveBytes -= g_idSize[id];
+    g_freeIds[g_freeIdCount++] = id;
+    Emit(ALLOC_EV_FREE, id, 0);
+}
+
+static VOID OnAlloc(VOID *pool, VOID *ptr, UINT32 size)
+{
+    UINT16 id;
+    UINT32 intSave;
+    INT32 slot;
+
+    if (!g_recording || pool != OS_SYS_MEM_ADDR || ptr == NULL) {
+        return;
+    }
+    if (g_taskFilter != ALLOC_TRACE_ALL_TASKS && LOS_CurTaskIDGet() != g_taskFilter) {
+        return;
+    }
+    intSave = LOS_IntLock();
+    // 地址仍在映射中说明旧对象已被 realloc 搬走 (内核内部释放，不经过钩子)，先按释放结算
+    slot = Find((UINTPTR)ptr);
+    if (slot >= 0) {
+        Release((UINT32)slot);
+        g_stats.staleMaps++;
+    }
+    // 事件缓冲区满时不再登记新对象，避免之后的释放全部变成 foreign
+    if (g_hdr.count >= ALLOC_TRACE_MAX_EVENTS) {
+        g_stats.dropped++;
+    } else if (!IdAlloc(&id)) {
+        g_stats.liveOverflow++;
+    } else {
+        Insert((UINTPTR)ptr, id);
+        g_idSize[id] = size;
+        g_liveBytes += size;
+        g_hdr.peakBytes = (g_liveBytes > g_hdr.peakBytes) ? g_liveBytes : g_hdr.peakBytes;
+        Emit(ALLOC_EV_ALLOC, id, size);
+    }
+    LOS_IntRestore(intSave);
+}
+
+static VOID OnAllocAlign(VOID *pool, VOID *ptr, UINT32 size, UINT32 boundary)
+{
+    (void)boundary;
+    OnAlloc(pool, ptr, size);
+}
+
+static VOID OnFree(VOID *pool, VOID *ptr)
+{
+    UINT32 intSave;
+    INT32 slot;
+
+    if (!g_recording || pool != OS_SYS_MEM_ADDR || ptr == NULL) {
+        return;
+    }
+    intSave = LOS_IntLock();
+    slot = Find((UINTPTR)ptr);
+    if (slot < 0) {
+        g_stats.foreignFrees++;
+    } else {
+        Release((UINT32)slot);
+    }
+    LOS_IntRestore(intSave);
+}
+
+static VOID OnRealloc(VOID *pool, VOID *ptr, UINT32 size)
+{
+    UINT32 intSave;
+    INT32 slot;
+
+    // ptr 为 NULL / size 为 0 时内核转调 LOS_MemAlloc / LOS_MemFree，由对应钩子记录
+    if (!g_recording || pool != OS_SYS_MEM_ADDR || ptr == NULL || size == 0) {
+        return;
+    }
+    intSave = LOS_IntLock();
+    slot = Find((UINTPTR)ptr);
+    if (slot >= 0) {
+        UINT16 id = g_hashId[slot];
+        g_liveBytes = g_liveBytes - g_idSize[id] + size;
+        g_idSize[id] = size;
+        g_hdr.peakBytes = (g_liveBytes > g_hdr.peakBytes) ? g_liveBytes : g_hdr.peakBytes;
+        Emit(ALLOC_EV_REALLOC, id, size);
+    }
+    LOS_IntRestore(intSave);
+}
+
+/* ================= 接口 ================= */
+
+UINT32 AllocTraceStart(const CHAR *name, UINT32 taskId)
+{
+#if defined(LOSCFG_DEBUG_HOOK)
+    if (g_recording || name == NULL) {
+        return LOS_NOK;
+    }
+    memset(&g_hdr, 0, sizeof(g_hdr));
+    memset(&g_stats, 0, sizeof(g_stats));
+    memset(g_hashPtr, 0, sizeof(g_hashPtr));
+    g_hdr.magic = ALLOC_TRACE_MAGIC;
+    g_hdr.version = ALLOC_TRACE_VERSION;
+    (void)strncpy(g_hdr.name, name, ALLOC_TRACE_NAME_LEN - 1);
+    g_freeIdCount = 0;
+    g_liveBytes = 0;
+    g_taskFilter = taskId;
+
+    if (LOS_HookReg(LOS_HOOK_TYPE_MEM_ALLOC, OnAlloc) != LOS_OK ||
+        LOS_HookReg(LOS_HOOK_TYPE_MEM_ALLOCALIGN, OnAllocAlign) != LOS_OK ||
+        LOS_HookReg(LOS_HOOK_TYPE_MEM_FREE, OnFree) != LOS_OK ||
+        LOS_HookReg(LOS_HOOK_TYPE_MEM_REALLOC, OnRealloc) != LOS_OK) {
+        printf("[atrace] memory hook register failed\n");
+        (void)AllocTraceStop();
+        return LOS_NOK;
+    }
+    g_recording = TRUE;
+    printf("[atrace] recording \"%s\"\n", g_hdr.name);
+    return LOS_OK;
+#else
+    (void)name;
+    (void)taskId;
+    (void)OnAllocAlign;
+    (void)OnFree;
+    (void)OnRealloc;
+    printf("[atrace] LOSCFG_DEBUG_HOOK is not enabled\n");
+    return LOS_NOK;
+#endif
+}
+
+UINT32 AllocTraceStop(VOID)
+{
+#if defined(LOSCFG_DEBUG_HOOK)
+    g_recording = FALSE;
+    (void)LOS_HookUnReg(LOS_HOOK_TYPE_MEM_ALLOC, OnAlloc);
+    (void)LOS_HookUnReg(LOS_HOOK_TYPE_MEM_ALLOCALIGN, OnAllocAlign);
+    (void)LOS_HookUnReg(LOS_HOOK_TYPE_MEM_FREE, OnFree);
+    (void)LOS_HookUnReg(LOS_HOOK_TYPE_MEM_REALLOC, OnRealloc);
+    g_stats.events = g_hdr.count;
+    printf("[atrace] \"%s\": %u events, %u objects, peak %u bytes, dropped %u, foreign frees %u, "
+           "live overflow %u, stale maps %u\n", g_hdr.name, g_hdr.count, g_hdr.maxLive, g_hdr.peakBytes,
+           g_stats.dropped, g_stats.foreignFrees, g_stats.liveOverflow, g_stats.staleMaps);
+#endif
+    return LOS_OK;
+}
+
+VOID AllocTraceStatsGet(AllocTraceStats *stats)
+{
+    *stats = g_stats;
+    stats->events = g_hdr.count;
+}
+
+UINT32 AllocTraceSave(VOID)
+{
+    CHAR path[TRACE_PATH_LEN];
+    FILE *fp;
+    BOOL ok;
+
+    if (g_recording || g_hdr.magic != ALLOC_TRACE_MAGIC) {
+        return LOS_NOK;
+    }
+    if (access(ALLOC_TRACE_DIR, F_OK) != 0) {
+        (void)mkdir(ALLOC_TRACE_DIR, 0755);
+    }
+    (void)snprintf(path, sizeof(path), ALLOC_TRACE_DIR "/" ALLOC_TRACE_PREFIX "%s.bin", g_hdr.name);
+    fp = fopen(path, "wb");
+    if (fp == NULL) {
+        printf("[atrace] cannot create %s\n", path);
+        return LOS_NOK;
+    }
+    ok = fwrite(&g_hdr, sizeof(g_hdr), 1, fp) == 1 &&
+         fwrite(g_events, sizeof(AllocTraceEvent), g_hdr.count, fp) == g_hdr.count;
+    fclose(fp);
+    printf("[atrace] %s %s\n", ok ? "saved" : "write failed:", path);
+    return ok ? LOS_OK : LOS_NOK;
+}
+
+UINT32 AllocTraceLoad(const CHAR *path, AllocTrace *trace)
+{
+    FILE *fp = fopen(path, "rb");
+    UINT32 ret = LOS_NOK;
+
+    memset(trace, 0, sizeof(*trace));
+    if (fp == NULL) {
+        return LOS_NOK;
+    }
+    if (fread(&trace->hdr, sizeof(trace->hdr), 1, fp) == 1 && trace->hdr.magic == ALLOC_TRACE_MAGIC &&
+        trace->hdr.version == ALLOC_TRACE_VERSION && trace->hdr.count <= ALLOC_TRACE_MAX_EVENTS &&
+        trace->hdr.maxLive <= ALLOC_TRACE_MAX_LIVE) {
+        trace->hdr.name[ALLOC_TRACE_NAME_LEN - 1] = '\0';
+        trace->events = malloc(trace->hdr.count * sizeof(AllocTraceEvent) + 1);
+        if (trace->events != NULL &&
+            fread(trace->events, sizeof(AllocTraceEvent), trace->hdr.count, fp) == trace->hdr.count) {
+            ret = LOS_OK;
+        }
+    }
+    fclose(fp);
+    if (ret != LOS_OK) {
+        AllocTraceRelease(trace);
+        printf("[atrace] %s is not a valid trace\n", path);
+    }
+    return ret;
+}
+
+VOID AllocTraceRelease(AllocTrace *trace)
+{
+    free(trace->events);
+    trace->events = NULL;
+}
+
+/* ================= 定时记录 ================= */
+
+static VOID *RecorderEntry(UINTPTR arg)
+{
+    (void)arg;
+    if (AllocTraceStart(g_recordName, ALLOC_TRACE_ALL_TASKS) != LOS_OK) {
+        return NULL;
+    }
+    (void)LOS_TaskDelay(g_recordTicks);
+    (void)AllocTraceStop();
+    (void)AllocTraceSave();
+    return NULL;
+}
+
+UINT32 AllocTraceRecordFor(const CHAR *name, UINT32 ticks)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 taskId;
+
+    (void)strncpy(g_recordName, name, ALLOC_TRACE_NAME_LEN - 1);
+    g_recordTicks = ticks;
+    param.pfnTaskEntry = (TSK_ENTRY_FUNC)RecorderEntry;
+    param.uwStackSize  = RECORDER_STACK_SIZE;
+    param.pcName       = "AllocTraceRec";
+    param.usTaskPrio   = RECORDER_PRI;
+    return LOS_TaskCreate(&taskId, &param);
+}
+
+/* ================= shell 命令 ================= */
+
+static UINT32 AllocTraceCmd(UINT32 argc, const CHAR **argv)
+{
+    if (argc >= 2 && strcmp(argv[0], "start") == 0) {
+        UINT32 task = (argc >= 3) ? (UINT32)strtoul(argv[2], NULL, 0) : ALLOC_TRACE_ALL_TASKS;
+        return AllocTraceStart(argv[1], task);
+    }
+    if (argc >= 1 && strcmp(argv[0], "stop") == 0) {
+        (void)AllocTraceStop();
+        return AllocTraceSave();
+    }
+    printf("usage: alloctrace start <name> [taskId] | stop\n");
+    return LOS_NOK;
+}
+
+UINT32 AllocTraceShellInit(VOID)
+{
+    return osCmdReg(CMD_TYPE_EX, "alloctrace", XARGS, (CmdCallBackFunc)AllocTraceCmd);
+}
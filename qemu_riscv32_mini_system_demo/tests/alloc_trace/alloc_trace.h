@@ -0,0 +1,106 @@
+#ifndef APP_ALLOC_TRACE_H
+#define APP_ALLOC_TRACE_H
+
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 分配轨迹记录
+ * 通过 LOS_HOOK_TYPE_MEM_ALLOC / FREE / REALLOC / ALLOCALIGN 钩子记录系统内存池上的分配序列
+ * (newlib malloc 也落在系统内存池)，需要内核开启 LOSCFG_DEBUG_HOOK (kernel_configs/pc_prof.config)。
+ * heap_tlsf 打开时 malloc 改走 TLSF 堆，不再经过这些钩子，记录轨迹须用未打开 heap_tlsf 的镜像。
+ * 指针在记录时映射为对象号：对象存活期间号码唯一，释放后复用，回放时直接作为指针表下标，
+ * 轨迹与地址无关，可以对任意分配器重放。
+ * 记录开始前已存在的对象被释放时计入 foreignFrees，不写入轨迹；
+ * realloc 钩子拿不到新地址，按原地扩缩记录，搬移后的对象释放时同样计入 foreignFrees；
+ * 旧地址之后被重新分配时，先为旧对象补记一条 FREE 再登记新对象 (计入 staleMaps)，映射里不留过期项。
+ *
+ * 文件格式 (小端)：AllocTraceHeader 后接 count 个 AllocTraceEvent，
+ * 保存在 ALLOC_TRACE_DIR/atrace_<name>.bin，/data 在 pflash 上，重启后仍在。
+ */
+
+#define ALLOC_TRACE_MAX_EVENTS   8192
+#define ALLOC_TRACE_MAX_LIVE     1024
+#define ALLOC_TRACE_NAME_LEN     16
+#define ALLOC_TRACE_ALL_TASKS    0xFFFFFFFFU
+#define ALLOC_TRACE_DIR          "/data/bench"
+#define ALLOC_TRACE_PREFIX       "atrace_"
+#define ALLOC_TRACE_MAGIC        0x43525441U    // "ATRC"
+#define ALLOC_TRACE_VERSION      1
+
+typedef enum {
+    ALLOC_EV_ALLOC = 0,
+    ALLOC_EV_FREE,
+    ALLOC_EV_REALLOC,
+} AllocEventOp;
+
+typedef struct {
+    UINT8 op;                   // AllocEventOp
+    UINT8 reserved;
+    UINT16 id;                  // 对象号
+    UINT32 size;                // FREE 时为 0
+} AllocTraceEvent;
+
+typedef struct {
+    UINT32 magic;
+    UINT16 version;
+    UINT16 maxLive;             // 用到的最大对象号 + 1
+    UINT32 count;
+    UINT32 peakBytes;           // 记录期间同时存活的请求字节数峰值
+    CHAR name[ALLOC_TRACE_NAME_LEN];
+} AllocTraceHeader;
+
+typedef struct {
+    AllocTraceHeader hdr;
+    AllocTraceEvent *events;
+} AllocTrace;
+
+typedef struct {
+    UINT32 events;
+    UINT32 dropped;             // 事件缓冲区满后丢弃的事件
+    UINT32 foreignFrees;
+    UINT32 liveOverflow;        // 同时存活对象超过 ALLOC_TRACE_MAX_LIVE 而未记录的分配
+    UINT32 staleMaps;           // 分配到仍在映射中的地址 (旧对象已被 realloc 搬走) 的次数
+} AllocTraceStats;
+
+/**
+ * @brief 开始记录
+ * @param name 轨迹名，保存为 atrace_<name>.bin
+ * @param taskId 只记录该任务发起的分配 (释放不论任务都按指针匹配)；ALLOC_TRACE_ALL_TASKS 记录全部
+ * @return LOS_NOK 已在记录或钩子注册失败
+ */
+UINT32 AllocTraceStart(const CHAR *name, UINT32 taskId);
+
+UINT32 AllocTraceStop(VOID);
+
+/**
+ * @brief 把最近一次记录写入文件，须在 Stop 之后调用
+ */
+UINT32 AllocTraceSave(VOID);
+
+VOID AllocTraceStatsGet(AllocTraceStats *stats);
+
+/**
+ * @brief 创建后台任务记录全部任务的分配 ticks 个 tick，结束后自动保存，用于 UI 这类不返回的场景
+ */
+UINT32 AllocTraceRecordFor(const CHAR *name, UINT32 ticks);
+
+/**
+ * @brief 读入轨迹文件，事件缓冲区用 malloc 分配，用完调用 AllocTraceRelease
+ */
+UINT32 AllocTraceLoad(const CHAR *path, AllocTrace *trace);
+
+VOID AllocTraceRelease(AllocTrace *trace);
+
+/**
+ * @brief 注册 shell 命令 alloctrace start <name> [task] | stop
+ */
+UINT32 AllocTraceShellInit(VOID);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -14,7 +14,13 @@
  */
 
 #if defined(UI_TEST) || defined(ABILITY_TEST) || defined(HELLO_TEST) || defined(MATH_TEST) || defined(FILE_TEST) \
-                     || defined(TCM_TEST) || defined(MALLOC_TEST) || defined(OPENHITLS_SM2_TEST) || defined(VTCM_TEST)
+                     || defined(TCM_TEST) || defined(MALLOC_TEST) || defined(OPENHITLS_SM2_TEST) || defined(VTCM_TEST) \
+                     || defined(CRYPTO_BENCH) || defined(SM2_MONT_TEST) || defined(FAIR_SHARE_TEST) \
+                     || defined(TASK_QUANTUM_BENCH) || defined(LATENCY_TEST) || defined(IPC_BENCH) \
+                     || defined(STACK_PROF) || defined(EVENT_WAKE_TEST) || defined(TIMER_WHEEL_BENCH) \
+                     || defined(TICKLESS_TEST) || defined(DLOG_BENCH) || defined(TELEMETRY_TEST) \
+                     || defined(PC_PROF_TEST) || defined(PERF_TEST) || defined(BENCH_REGISTRY) \
+                     || defined(ALLOC_REPLAY) || defined(HEAP_MON)
 #include "ohos_init.h"
 #include "ui_adapter.h"
 
@@ -46,10 +52,69 @@
 #if defined(VTCM_TEST)
     #include "vtcm_scheduler_test.h"
 #endif
+#if defined(CRYPTO_BENCH)
+    #include "crypto_bench.h"
+#endif
+#if defined(SM2_MONT_TEST)
+    #include "sm2_mont_test.h"
+#endif
+#if defined(FAIR_SHARE_TEST)
+    #include "fair_share_test.h"
+#endif
+#if defined(TASK_QUANTUM_BENCH)
+    #include "task_quantum_bench.h"
+#endif
+#if defined(LATENCY_TEST)
+    #include "latency_test.h"
+#endif
+#if defined(IPC_BENCH)
+    #include "ipc_bench.h"
+#endif
+#if defined(STACK_PROF)
+    #include "stack_prof.h"
+#endif
+#if defined(EVENT_WAKE_TEST)
+    #include "event_wake_test.h"
+#endif
+#if defined(TIMER_WHEEL_BENCH)
+    #include "timer_wheel_bench.h"
+#endif
+#if defined(TICKLESS_TEST)
+    #include "tickless_test.h"
+#endif
+#if defined(DLOG_BENCH)
+    #include "dlog_bench.h"
+#endif
+#if defined(TELEMETRY_TEST)
+    #include "telemetry_test.h"
+#endif
+#if defined(PC_PROF_TEST)
+    #include "pc_prof_test.h"
+#endif
+#if defined(PERF_TEST)
+    #include "perf_test.h"
+#endif
+#if defined(BENCH_REGISTRY)
+    #include "bench_registry.h"
+#endif
+#if defined(ALLOC_REPLAY)
+    #include "alloc_replay.h"
+#endif
+#if defined(HEAP_MON)
+    #include "heap_mon.h"
+#endif
+#if defined(ALLOC_TRACE_RECORD)
+    #include "los_tick.h"
+    #include "alloc_trace.h"
+#endif
 
 void RunApp(void)
 {
 #ifdef UI_TEST
+#if defined(ALLOC_TRACE_RECORD)
+    // UI 不会返回，由后台任务记录开头 10 秒的动画分配作为 ui 轨迹
+    (void)AllocTraceRecordFor("ui", LOS_MS2Tick(10000));
+#endif
     AnimatorDemoStart();
 #elif defined(ABILITY_TEST)
     StartJSApp();
@@ -120,4 +185,148 @@ void AppVtcmTestEntry(void)
 }
 APP_FEATURE_INIT(AppVtcmTestEntry);
 
+void AppCryptoBenchEntry(void)
+{
+#if defined(CRYPTO_BENCH)
+    CryptoBenchApp();
+#endif
+}
+APP_FEATURE_INIT(AppCryptoBenchEntry);
+
+void AppSm2MontTestEntry(void)
+{
+#if defined(SM2_MONT_TEST)
+    Sm2MontTestApp();
+#endif
+}
+APP_FEATURE_INIT(AppSm2MontTestEntry);
+
+void AppFairShareTestEntry(void)
+{
+#if defined(FAIR_SHARE_TEST)
+    FairShareTestApp();
+#endif
+}
+APP_FEATURE_INIT(AppFairShareTestEntry);
+
+void AppTaskQuantumBenchEntry(void)
+{
+#if defined(TASK_QUANTUM_BENCH)
+    TaskQuantumBenchApp();
+#endif
+}
+APP_FEATURE_INIT(AppTaskQuantumBenchEntry);
+
+void AppLatencyTestEntry(void)
+{
+#if defined(LATENCY_TEST)
+    LatencyTestApp();
+#endif
+}
+APP_FEATURE_INIT(AppLatencyTestEntry);
+
+void AppIpcBenchEntry(void)
+{
+#if defined(IPC_BENCH)
+    IpcBenchApp();
+#endif
+}
+APP_FEATURE_INIT(AppIpcBenchEntry);
+
+void AppStackProfEntry(void)
+{
+#if defined(STACK_PROF)
+    StackProfApp();
+#endif
+}
+APP_FEATURE_INIT(AppStackProfEntry);
+
+void AppEventWakeTestEntry(void)
+{
+#if defined(EVENT_WAKE_TEST)
+    EventWakeTestApp();
+#endif
+}
+APP_FEATURE_INIT(AppEventWakeTestEntry);
+
+void AppTimerWheelBenchEntry(void)
+{
+#if defined(TIMER_WHEEL_BENCH)
+    TimerWheelBenchApp();
+#endif
+}
+APP_FEATURE_INIT(AppTimerWheelBenchEntry);
+
+void AppTicklessTestEntry(void)
+{
+#if defined(TICKLESS_TEST)
+    TicklessTestApp();
+#endif
+}
+APP_FEATURE_INIT(AppTicklessTestEntry);
+
+void AppDlogBenchEntry(void)
+{
+#if defined(DLOG_BENCH)
+    DlogBenchApp();
+#endif
+}
+APP_FEATURE_INIT(AppDlogBenchEntry);
+
+void AppTelemetryTestEntry(void)
+{
+#if defined(TELEMETRY_TEST)
+    TelemetryTestApp();
+#endif
+}
+APP_FEATURE_INIT(AppTelemetryTestEntry);
+
+void AppPcProfTestEntry(void)
+{
+#if defined(PC_PROF_TEST)
+    PcProfTestApp();
+#endif
+}
+APP_FEATURE_INIT(AppPcProfTestEntry);
+
+void AppPerfTestEntry(void)
+{
+#if defined(PERF_TEST)
+    PerfTestApp();
+#endif
+}
+APP_FEATURE_INIT(AppPerfTestEntry);
+
+void AppBenchRegistryEntry(void)
+{
+#if defined(BENCH_REGISTRY)
+    BenchRegistryApp();
+#endif
+}
+APP_FEATURE_INIT(AppBenchRegistryEntry);
+
+void AppAllocReplayEntry(void)
+{
+#if defined(ALLOC_REPLAY)
+    AllocReplayApp();
+#endif
+}
+APP_FEATURE_INIT(AppAllocReplayEntry);
+
+void AppAllocTraceEntry(void)
+{
+#if defined(ALLOC_TRACE_RECORD)
+    (void)AllocTraceShellInit();
+#endif
+}
+APP_FEATURE_INIT(AppAllocTraceEntry);
+
+void AppHeapMonEntry(void)
+{
+#if defined(HEAP_MON)
+    HeapMonApp();
+#endif
+}
+APP_FEATURE_INIT(AppHeapMonEntry);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,370 @@
+/*
+ * 运行时基准注册表
+ * 用例表只在启动时追加，之后只读；运行在调用者任务 (shell 触发时为单独的 runner 任务) 中串行进行，
+ * 每次迭代用 LOS_SysCycleGet 计墙钟周期、minstret 计指令数，汇总后按 bench_result 的记录格式输出。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+#include "shcmd.h"
+
+#include "perf_counter.h"
+#include "bench_result.h"
+#include "bench_rng.h"
+#include "bench_registry.h"
+
+#define BENCH_PATTERN_MAX        64
+#define BENCH_PATH_MAX           64
+
+typedef struct {
+    CHAR pattern[BENCH_PATTERN_MAX];
+    UINT32 iterations;
+} BenchRequest;
+
+/* ================= 全局变量 ================= */
+static const BenchCase *g_cases[BENCH_MAX_CASES];
+static UINT32 g_caseCount = 0;
+static BenchSink g_sink = BENCH_SINK_UART;
+static CHAR g_path[BENCH_PATH_MAX] = BENCH_FILE_DEFAULT;
+static volatile BOOL g_busy = FALSE;
+static BOOL g_inited = FALSE;
+static BenchRequest g_request;
+
+static UINT64 g_samples[BENCH_MAX_ITERS];
+static UINT64 g_metricSum[BENCH_MAX_METRICS];
+static const CHAR *g_metricKey[BENCH_MAX_METRICS];
+static const CHAR *g_metricUnit[BENCH_MAX_METRICS];
+static UINT32 g_metricCount;
+
+/* ================= 注册 ================= */
+
+UINT32 BenchRegister(const BenchCase *bench)
+{
+    UINT32 ret = LOS_OK;
+    UINT32 intSave;
+
+    if (bench == NULL || bench->name == NULL || bench->suite == NULL || bench->run == NULL) {
+        return LOS_NOK;
+    }
+    intSave = LOS_IntLock();
+    for (UINT32 i = 0; i < g_caseCount; i++) {
+        if (strcmp(g_cases[i]->name, bench->name) == 0) {
+            ret = LOS_NOK;
+        }
+    }
+    if (ret == LOS_OK && g_caseCount < BENCH_MAX_CASES) {
+        g_cases[g_caseCount++] = bench;
+    } else {
+        ret = LOS_NOK;
+    }
+    LOS_IntRestore(intSave);
+    return ret;
+}
+
+VOID BenchMetricSetUnit(BenchMetrics *metrics, const CHAR *key, const CHAR *unit, UINT64 value)
+{
+    for (UINT32 i = 0; i < metrics->count; i++) {
+        if (strcmp(metrics->key[i], key) == 0) {
+            metrics->unit[i] = unit;
+            metrics->value[i] = value;
+            return;
+        }
+    }
+    if (metrics->count < BENCH_MAX_METRICS) {
+        metrics->key[metrics->count] = key;
+        metrics->unit[metrics->count] = unit;
+        metrics->value[metrics->count] = value;
+        metrics->count++;
+    }
+}
+
+VOID BenchMetricSet(BenchMetrics *metrics, const CHAR *key, UINT64 value)
+{
+    BenchMetricSetUnit(metrics, key, "count", value);
+}
+
+/* ================= 运行 ================= */
+
+static VOID AccumulateMetrics(const BenchMetrics *m)
+{
+    for (UINT32 i = 0; i < m->count; i++) {
+        UINT32 k = 0;
+        while (k < g_metricCount && strcmp(g_metricKey[k], m->key[i]) != 0) {
+            k++;
+        }
+        if (k == g_metricCount) {
+            if (g_metricCount == BENCH_MAX_METRICS) {
+                continue;
+            }
+            g_metricKey[g_metricCount] = m->key[i];
+            g_metricUnit[g_metricCount] = m->unit[i];
+            g_metricSum[g_metricCount] = 0;
+            g_metricCount++;
+        }
+        g_metricSum[k] += m->value[i];
+    }
+}
+
+static UINT64 Median(UINT32 n)
+{
+    // 迭代次数很少，插入排序即可
+    for (UINT32 i = 1; i < n; i++) {
+        UINT64 v = g_samples[i];
+        UINT32 j = i;
+        while (j > 0 && g_samples[j - 1] > v) {
+            g_samples[j] = g_samples[j - 1];
+            j--;
+        }
+        g_samples[j] = v;
+    }
+    return (n == 0) ? 0 : g_samples[n / 2];
+}
+
+static VOID EmitRecord(const BenchCase *bench, const CHAR *metric, const CHAR *unit, UINT64 value, UINT32 n,
+                       FILE *fp)
+{
+    BenchResult r = { bench->suite, bench->name, metric, unit, value, n };
+    BenchResultEmit(&r, fp);
+}
+
+static VOID RunCase(const BenchCase *bench, UINT32 iterations, FILE *fp)
+{
+    BenchMetrics metrics;
+    UINT64 total = 0;
+    UINT64 instret = 0;
+    UINT64 minCycles = ~0ULL;
+    UINT64 maxCycles = 0;
+    UINT32 ok = 0;
+    UINT32 errors = 0;
+    const CHAR *status;
+
+    if (iterations == 0) {
+        iterations = (bench->iterations != 0) ? bench->iterations : BENCH_DEFAULT_ITERS;
+    }
+    if (iterations > BENCH_MAX_ITERS) {
+        iterations = BENCH_MAX_ITERS;
+    }
+    g_metricCount = 0;
+
+    if (bench->setup != NULL && bench->setup() != LOS_OK) {
+        status = "skip";
+        iterations = 0;
+    } else {
+        for (UINT32 i = 0; i < iterations; i++) {
+            memset(&metrics, 0, sizeof(metrics));
+            UINT64 i0 = PerfInstretRead();
+            UINT64 c0 = LOS_SysCycleGet();
+            UINT32 ret = bench->run(i, &metrics);
+            UINT64 cost = LOS_SysCycleGet() - c0;
+            UINT64 ins = PerfInstretRead() - i0;
+            if (ret != LOS_OK) {
+                errors++;
+                continue;
+            }
+            g_samples[ok++] = cost;
+            total += cost;
+            instret += ins;
+            minCycles = (cost < minCycles) ? cost : minCycles;
+            maxCycles = (cost > maxCycles) ? cost : maxCycles;
+            AccumulateMetrics(&metrics);
+        }
+        if (bench->teardown != NULL) {
+            bench->teardown();
+        }
+        status = (ok == 0) ? "error" : "ok";
+    }
+
+    printf("[bench] %s: %s, %u ok, %u errors\n", bench->name, status, ok, errors);
+    if (ok == 0) {
+        // skip / error 只记失败次数，比较端据此把用例标为缺失而不是拿 0 当成结果
+        EmitRecord(bench, "errors", "errors", errors, iterations, fp);
+        return;
+    }
+    EmitRecord(bench, "cycles_median", "cycles", Median(ok), ok, fp);
+    EmitRecord(bench, "cycles_min", "cycles", minCycles, ok, fp);
+    EmitRecord(bench, "cycles_max", "cycles", maxCycles, ok, fp);
+    EmitRecord(bench, "time_avg", "us", total / ok * 1000000ULL / OS_SYS_CLOCK, ok, fp);
+    EmitRecord(bench, "instret_avg", "instr", instret / ok, ok, fp);
+    EmitRecord(bench, "errors", "errors", errors, iterations, fp);
+    for (UINT32 k = 0; k < g_metricCount; k++) {
+        EmitRecord(bench, g_metricKey[k], g_metricUnit[k], g_metricSum[k] / ok, ok, fp);
+    }
+}
+
+static BOOL Matches(const BenchCase *bench, const CHAR *pattern)
+{
+    return strcmp(pattern, "all") == 0 || strcmp(pattern, bench->name) == 0 ||
+           strcmp(pattern, bench->suite) == 0;
+}
+
+UINT32 BenchRun(const CHAR *pattern, UINT32 iterations)
+{
+    UINT32 matched = 0;
+    FILE *fp = NULL;
+
+    if (g_sink == BENCH_SINK_FILE) {
+        if (access(BENCH_DIR, F_OK) != 0) {
+            (void)mkdir(BENCH_DIR, 0755);
+        }
+        fp = fopen(g_path, "a");
+        if (fp == NULL) {
+            printf("[bench] cannot open %s, results go to serial only\n", g_path);
+        }
+    }
+    for (UINT32 i = 0; i < g_caseCount; i++) {
+        if (Matches(g_cases[i], pattern)) {
+            RunCase(g_cases[i], iterations, fp);
+            matched++;
+        }
+    }
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    if (matched == 0) {
+        printf("[bench] no case matches \"%s\"\n", pattern);
+    }
+    return matched;
+}
+
+VOID BenchList(VOID)
+{
+    printf("%-24s | %-8s | %-5s | %s\n", "Name", "Suite", "Iters", "Description");
+    printf("-------------------------|----------|-------|------------\n");
+    for (UINT32 i = 0; i < g_caseCount; i++) {
+        const BenchCase *b = g_cases[i];
+        printf("%-24s | %-8s | %-5u | %s\n", b->name, b->suite,
+               (b->iterations != 0) ? b->iterations : BENCH_DEFAULT_ITERS, (b->desc != NULL) ? b->desc : "");
+    }
+    printf("%u cases\n", g_caseCount);
+}
+
+UINT32 BenchSinkSet(BenchSink sink, const CHAR *path)
+{
+    if (path != NULL) {
+        if (strlen(path) >= BENCH_PATH_MAX) {
+            return LOS_NOK;
+        }
+        (void)strcpy(g_path, path);
+    }
+    g_sink = sink;
+    return LOS_OK;
+}
+
+/* ================= shell 命令 ================= */
+
+static VOID *BenchRunnerEntry(UINTPTR arg)
+{
+    (void)arg;
+    (void)BenchRun(g_request.pattern, g_request.iterations);
+    printf("[bench] done\n");
+    g_busy = FALSE;
+    return NULL;
+}
+
+static UINT32 BenchStartRunner(const CHAR *pattern, UINT32 iterations)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 taskId;
+    UINT32 ret;
+
+    if (g_busy) {
+        printf("[bench] a run is in progress\n");
+        return LOS_NOK;
+    }
+    if (strlen(pattern) >= BENCH_PATTERN_MAX) {
+        return LOS_NOK;
+    }
+    g_busy = TRUE;
+    (void)strcpy(g_request.pattern, pattern);
+    g_request.iterations = iterations;
+
+    param.pfnTaskEntry = (TSK_ENTRY_FUNC)BenchRunnerEntry;
+    param.uwStackSize  = BENCH_RUNNER_STACK;
+    param.pcName       = "BenchRunner";
+    param.usTaskPrio   = BENCH_RUNNER_PRI;
+    ret = LOS_TaskCreate(&taskId, &param);
+    if (ret != LOS_OK) {
+        printf("[bench] runner create failed: 0x%X\n", ret);
+        g_busy = FALSE;
+    }
+    return ret;
+}
+
+static UINT32 BenchCmd(UINT32 argc, const CHAR **argv)
+{
+    if (argc < 1 || strcmp(argv[0], "list") == 0) {
+        BenchList();
+        return LOS_OK;
+    }
+    if (strcmp(argv[0], "run") == 0 && argc >= 2) {
+        UINT32 iterations = (argc >= 3) ? (UINT32)strtoul(argv[2], NULL, 0) : 0;
+        return BenchStartRunner(argv[1], iterations);
+    }
+    if (strcmp(argv[0], "out") == 0 && argc >= 2) {
+        if (strcmp(argv[1], "uart") == 0) {
+            return BenchSinkSet(BENCH_SINK_UART, NULL);
+        }
+        if (strcmp(argv[1], "file") == 0) {
+            return BenchSinkSet(BENCH_SINK_FILE, (argc >= 3) ? argv[2] : NULL);
+        }
+    }
+    printf("usage: bench list | run <name|suite|all> [iterations] | out uart|file [path]\n");
+    return LOS_NOK;
+}
+
+UINT32 BenchInit(VOID)
+{
+    if (g_inited) {
+        return LOS_OK;
+    }
+    (void)osCmdReg(CMD_TYPE_EX, "bench", XARGS, (CmdCallBackFunc)BenchCmd);
+    g_inited = TRUE;
+    return LOS_OK;
+}
+
+/* ================= 启动入口 ================= */
+
+static VOID *BenchRegistryTask(UINTPTR arg)
+{
+    (void)arg;
+    (void)BenchInit();
+    printf("[bench] %u cases registered, \"bench list\" to show, build %s%s\n", g_caseCount, BenchBuildId(),
+           BenchRngDeterministic() ? ", deterministic" : "");
+#if defined(BENCH_AUTORUN)
+    {
+        CHAR list[] = BENCH_AUTORUN;
+        CHAR *save = NULL;
+        for (CHAR *p = strtok_r(list, ",", &save); p != NULL; p = strtok_r(NULL, ",", &save)) {
+            (void)BenchRun(p, 0);
+        }
+        printf("=== bench autorun finished ===\n");
+    }
+#endif
+    return NULL;
+}
+
+void BenchRegistryApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)BenchRegistryTask;
+    task.uwStackSize  = BENCH_RUNNER_STACK;
+    task.pcName       = "BenchRegistry";
+    task.usTaskPrio   = BENCH_RUNNER_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("BenchRegistry task create failed: 0x%X\n", ret);
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef APP_BENCH_REGISTRY_H
+#define APP_BENCH_REGISTRY_H
+
+#include "ohos_init.h"
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 运行时基准注册表
+ * 各套件用 BENCH_REGISTER 登记用例，注册函数随 APP_FEATURE_INIT 在启动时执行，
+ * 链接进镜像的用例都会出现在 "bench list" 中，不再需要每换一个测量就改 GN 参数重编。
+ * shell:
+ *   bench list
+ *   bench run <name|suite|all> [iterations]
+ *   bench out uart|file [path]
+ * 每个用例运行结束按 bench_result.h 的记录格式逐指标输出 (周期中位数 / 最小 / 最大值、平均耗时、
+ * 平均 instret、失败次数与用例自定义指标)，默认写串口，切到 file 后同时追加写入 BENCH_FILE_DEFAULT。
+ */
+
+#define BENCH_MAX_CASES          48
+#define BENCH_MAX_METRICS        6
+#define BENCH_MAX_ITERS          64
+#define BENCH_DEFAULT_ITERS      5
+#define BENCH_RUNNER_PRI         10
+#define BENCH_RUNNER_STACK       0x6000
+#define BENCH_DIR                "/data/bench"
+#define BENCH_FILE_DEFAULT       BENCH_DIR "/bench.jsonl"
+
+typedef enum {
+    BENCH_SINK_UART = 0,
+    BENCH_SINK_FILE,
+} BenchSink;
+
+/*
+ * 用例自定义指标，按成功的迭代取平均后输出为 metric = key 的记录
+ */
+typedef struct {
+    UINT32 count;
+    const CHAR *key[BENCH_MAX_METRICS];
+    const CHAR *unit[BENCH_MAX_METRICS];
+    UINT64 value[BENCH_MAX_METRICS];
+} BenchMetrics;
+
+typedef struct {
+    const CHAR *name;           // "<suite>.<case>"，全局唯一
+    const CHAR *suite;          // tcm / malloc / file / sched / crypto / ui
+    const CHAR *desc;
+    UINT32 iterations;          // 默认迭代次数，0 取 BENCH_DEFAULT_ITERS
+    UINT32 (*setup)(VOID);      // 可为 NULL；失败时整个用例记为 skip
+    UINT32 (*run)(UINT32 iter, BenchMetrics *metrics);   // 计时区间，返回 LOS_OK 表示本次成功
+    VOID (*teardown)(VOID);     // 可为 NULL
+} BenchCase;
+
+/**
+ * @brief 登记用例，通常经由 BENCH_REGISTER 在启动时调用
+ * @return LOS_NOK 注册表已满或重名
+ */
+UINT32 BenchRegister(const BenchCase *bench);
+
+#define BENCH_REGISTER(bench) \
+    static void BenchRegister_##bench(void) \
+    { \
+        (void)BenchRegister(&(bench)); \
+    } \
+    APP_FEATURE_INIT(BenchRegister_##bench)
+
+/**
+ * @brief 在 run 中记录一个指标，同名指标覆盖；单位取 "count"，只作信息展示
+ */
+VOID BenchMetricSet(BenchMetrics *metrics, const CHAR *key, UINT64 value);
+
+/**
+ * @brief 同 BenchMetricSet，单位决定回归比较的方向，见 bench_result.h
+ */
+VOID BenchMetricSetUnit(BenchMetrics *metrics, const CHAR *key, const CHAR *unit, UINT64 value);
+
+/**
+ * @brief 注册 shell 命令 bench，重复调用无副作用
+ */
+UINT32 BenchInit(VOID);
+
+/**
+ * @brief 在调用者任务中同步运行匹配的用例
+ * @param pattern 用例名、套件名或 "all"
+ * @param iterations 0 时使用各用例的默认次数
+ * @return 匹配的用例数
+ */
+UINT32 BenchRun(const CHAR *pattern, UINT32 iterations);
+
+VOID BenchList(VOID);
+
+UINT32 BenchSinkSet(BenchSink sink, const CHAR *path);
+
+/**
+ * @brief 创建常驻任务：注册 shell 命令，若编译时定义了 BENCH_AUTORUN
+ * (逗号分隔的用例 / 套件名) 则依次运行，便于测试模式下一次启动跑完整个矩阵
+ */
+void BenchRegistryApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,122 @@
+/*
+ * 定长块池：单链空闲表，池满或超尺寸时退回 malloc
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "los_interrupt.h"
+#include "shcmd.h"
+
+#include "block_pool.h"
+
+/* ================= 全局变量 ================= */
+static BlockPool *g_pools = NULL;
+static BOOL g_cmdRegistered = FALSE;
+
+/* ================= 池建立 ================= */
+
+static UINT32 BlockPoolCmd(UINT32 argc, const CHAR **argv)
+{
+    (void)argc;
+    (void)argv;
+    BlockPoolDump();
+    return LOS_OK;
+}
+
+// 调用者持有中断锁
+static VOID PoolSetUp(BlockPool *pool)
+{
+    UINT8 *blk = pool->base;
+
+    pool->freeList = NULL;
+    for (UINT32 i = 0; i < pool->blkCount; i++) {
+        *(VOID **)blk = pool->freeList;
+        pool->freeList = blk;
+        blk += pool->blkSize;
+    }
+    pool->next = g_pools;
+    g_pools = pool;
+    pool->ready = TRUE;
+}
+
+BOOL BlockPoolOwns(const BlockPool *pool, const VOID *ptr)
+{
+    const UINT8 *p = (const UINT8 *)ptr;
+
+    return p >= pool->base && p < pool->base + pool->blkSize * pool->blkCount;
+}
+
+/* ================= 分配与释放 ================= */
+
+VOID *BlockPoolAlloc(BlockPool *pool, UINT32 size)
+{
+    UINT32 intSave;
+    VOID *blk = NULL;
+    BOOL first = FALSE;
+
+    intSave = LOS_IntLock();
+    if (!pool->ready) {
+        PoolSetUp(pool);
+        first = !g_cmdRegistered;
+        g_cmdRegistered = TRUE;
+    }
+    if (size <= pool->blkSize && pool->freeList != NULL) {
+        blk = pool->freeList;
+        pool->freeList = *(VOID **)blk;
+        pool->stats.allocs++;
+        pool->stats.inUse++;
+        if (pool->stats.inUse > pool->stats.peak) {
+            pool->stats.peak = pool->stats.inUse;
+        }
+    } else {
+        pool->stats.fallbacks++;
+    }
+    LOS_IntRestore(intSave);
+
+    if (first) {
+        (void)osCmdReg(CMD_TYPE_EX, "blkpool", XARGS, (CmdCallBackFunc)BlockPoolCmd);
+    }
+    return (blk != NULL) ? blk : malloc(size);
+}
+
+VOID BlockPoolFree(BlockPool *pool, VOID *ptr)
+{
+    UINT32 intSave;
+
+    if (ptr == NULL) {
+        return;
+    }
+    if (!BlockPoolOwns(pool, ptr)) {
+        free(ptr);
+        return;
+    }
+    intSave = LOS_IntLock();
+    *(VOID **)ptr = pool->freeList;
+    pool->freeList = ptr;
+    pool->stats.frees++;
+    pool->stats.inUse--;
+    LOS_IntRestore(intSave);
+}
+
+VOID BlockPoolStatsGet(const BlockPool *pool, BlockPoolStats *stats)
+{
+    UINT32 intSave = LOS_IntLock();
+
+    *stats = pool->stats;
+    LOS_IntRestore(intSave);
+}
+
+/* ================= 输出 ================= */
+
+VOID BlockPoolDump(VOID)
+{
+    BlockPoolStats stats;
+
+    printf("%-20s %6s %6s %6s %6s %10s %10s\n", "pool", "blk", "count", "inuse", "peak", "allocs", "fallbacks");
+    for (BlockPool *pool = g_pools; pool != NULL; pool = pool->next) {
+        BlockPoolStatsGet(pool, &stats);
+        printf("%-20s %6u %6u %6u %6u %10u %10u\n", pool->name, pool->blkSize, pool->blkCount,
+               stats.inUse, stats.peak, stats.allocs, stats.fallbacks);
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef APP_BLOCK_POOL_H
+#define APP_BLOCK_POOL_H
+
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 定长块池
+ * 生命周期固定、大小固定的对象 (TCM 命令上下文、UI 控件) 从静态区划出的定长块中分配，
+ * 分配与释放都是从单链空闲表取放一块，不经过系统内存池，也不会在系统内存池里留下碎片。
+ * 池用 BLOCK_POOL_DEFINE 按类型静态定义，第一次分配时串起空闲表并登记到池列表，
+ * 首个池登记时注册 shell 命令 blkpool 打印所有池的统计。
+ * 请求大于块大小或池已取空时退回 malloc 并计入 fallbacks，释放按地址判断归属，
+ * 调用者不必区分块来自池还是系统堆。
+ * 块按 BLOCK_POOL_ALIGN 对齐；LOS_Membox 的块只保证 4 字节对齐，放不下含 double / UINT64 的对象，
+ * 因此没有直接使用 membox。每个操作关中断执行。
+ */
+
+#define BLOCK_POOL_ALIGN         8
+#define BLOCK_POOL_BLK_SIZE(size) \
+    ((((size) < sizeof(VOID *) ? sizeof(VOID *) : (size)) + BLOCK_POOL_ALIGN - 1) & \
+     ~(BLOCK_POOL_ALIGN - 1))
+
+typedef struct {
+    UINT32 allocs;              // 从池中分配的次数
+    UINT32 frees;
+    UINT32 inUse;
+    UINT32 peak;                // inUse 的最大值
+    UINT32 fallbacks;           // 退回 malloc 的次数
+} BlockPoolStats;
+
+typedef struct BlockPool {
+    const CHAR *name;
+    UINT32 blkSize;             // 已按 BLOCK_POOL_ALIGN 取整
+    UINT32 blkCount;
+    UINT8 *base;
+    VOID *freeList;
+    BOOL ready;
+    BlockPoolStats stats;
+    struct BlockPool *next;
+} BlockPool;
+
+/**
+ * @brief 定义一个存放 count 个 type 的池 var，池名取类型名
+ * 存储为 static UINT64 数组以满足 BLOCK_POOL_ALIGN，var 本身为外部链接，可在头文件中 extern 声明
+ */
+#define BLOCK_POOL_DEFINE(var, type, count) \
+    static UINT64 var##Storage[BLOCK_POOL_BLK_SIZE(sizeof(type)) / sizeof(UINT64) * (count)]; \
+    BlockPool var = { #type, BLOCK_POOL_BLK_SIZE(sizeof(type)), (count), (UINT8 *)var##Storage, \
+                      NULL, FALSE, { 0, 0, 0, 0, 0 }, NULL }
+
+/**
+ * @brief 分配一块
+ * @param size 请求大小，大于块大小时退回 malloc
+ * @return 池与系统堆都分配失败时返回 NULL
+ */
+VOID *BlockPoolAlloc(BlockPool *pool, UINT32 size);
+
+/**
+ * @brief 释放 BlockPoolAlloc 得到的块，不属于本池的指针交给 free
+ */
+VOID BlockPoolFree(BlockPool *pool, VOID *ptr);
+
+BOOL BlockPoolOwns(const BlockPool *pool, const VOID *ptr);
+
+VOID BlockPoolStatsGet(const BlockPool *pool, BlockPoolStats *stats);
+
+/**
+ * @brief 打印所有已登记池的块大小、容量、占用、峰值与回退次数
+ */
+VOID BlockPoolDump(VOID);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
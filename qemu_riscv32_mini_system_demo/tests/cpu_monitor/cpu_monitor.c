@@ -0,0 +1,377 @@
+/*
+ * 任务 CPU 占用统计
+ * 切换钩子按周期累计每个任务的运行时间，1 秒定时器把累计值差分成每秒增量存入环形历史，
+ * 1/10/60 秒窗口占用率由历史求和得到。CPUP 只提供 1/10 秒和全程三档且精度到 tick，
+ * 这里在 shell 输出中保留 CPUP 1 秒值作对照。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+#if (LOSCFG_KERNEL_CPUP == 1)
+#include "los_cpup.h"
+#endif
+#include "cmsis_os2.h"
+#include "shcmd.h"
+
+#include "sched_hook.h"
+#include "cpu_monitor.h"
+
+/* ================= 全局变量 ================= */
+// 以下三项只在切换钩子 (关中断) 中写，读取方需关中断取一致快照
+static UINT64 g_runCycles[CPU_MON_MAX_TASKS];
+static UINT32 g_switchIns[CPU_MON_MAX_TASKS];
+static UINT64 g_curStart;           // 当前任务切入时刻
+static UINT32 g_curTask;
+static CpuMonIdleResidency g_idleRes;
+static UINT64 g_idleEdgeCycles[CPU_MON_IDLE_BUCKETS - 1];
+
+// 每秒采样历史，在定时器回调中写，shell / 监控任务读；读写都锁调度。单秒增量远小于 2^32 个周期
+static UINT32 g_slotRun[CPU_MON_HISTORY_SEC][CPU_MON_MAX_TASKS];
+static UINT32 g_slotWall[CPU_MON_HISTORY_SEC];
+static UINT32 g_slotNext = 0;
+static UINT32 g_slotCount = 0;
+static CpuMonSnapshot g_sampleLast;
+
+static CpuMonSnapshot g_dumpLast;
+static BOOL g_dumpValid = FALSE;
+
+static osTimerId_t g_sampleTimer = NULL;
+static BOOL g_inited = FALSE;
+
+static const UINT32 g_winSec[CPU_MON_WIN_NUM] = { 1, 10, CPU_MON_HISTORY_SEC };
+
+/* ================= 累计 ================= */
+
+static VOID CpuMonOnSwitch(const LosTaskCB *from, const LosTaskCB *to, UINT64 cycles)
+{
+    if (from->taskID < CPU_MON_MAX_TASKS) {
+        g_runCycles[from->taskID] += cycles - g_curStart;
+    }
+    if (from->taskID == g_idleTaskID) {
+        UINT64 span = cycles - g_curStart;
+        UINT32 b = 0;
+        while (b < CPU_MON_IDLE_BUCKETS - 1 && span >= g_idleEdgeCycles[b]) {
+            b++;
+        }
+        g_idleRes.entries++;
+        g_idleRes.count[b]++;
+        g_idleRes.cycles[b] += span;
+        if (span > g_idleRes.longest) {
+            g_idleRes.longest = span;
+        }
+    }
+    if (to->taskID < CPU_MON_MAX_TASKS) {
+        g_switchIns[to->taskID]++;
+    }
+    g_curStart = cycles;
+    g_curTask = to->taskID;
+}
+
+VOID CpuMonSnapshotTake(CpuMonSnapshot *snap)
+{
+    UINT32 intSave = LOS_IntLock();
+    UINT64 now = LOS_SysCycleGet();
+
+    snap->cycles = now;
+    for (UINT32 id = 0; id < CPU_MON_MAX_TASKS; id++) {
+        snap->runCycles[id] = g_runCycles[id];
+    }
+    // 正在运行的任务还没有被切出，补上本段
+    if (g_curTask < CPU_MON_MAX_TASKS) {
+        snap->runCycles[g_curTask] += now - g_curStart;
+    }
+    LOS_IntRestore(intSave);
+}
+
+static UINT32 Permille(UINT64 part, UINT64 whole)
+{
+    if (whole == 0) {
+        return 0;
+    }
+    if (part > whole) {
+        part = whole;
+    }
+    return (UINT32)(part * CPU_MON_PRECISION / whole);
+}
+
+UINT32 CpuMonIntervalUsage(const CpuMonSnapshot *prev, const CpuMonSnapshot *cur, UINT32 taskId,
+                           UINT64 *runCycles)
+{
+    UINT64 delta = 0;
+
+    if (taskId < CPU_MON_MAX_TASKS && cur->runCycles[taskId] >= prev->runCycles[taskId]) {
+        delta = cur->runCycles[taskId] - prev->runCycles[taskId];
+    }
+    if (runCycles != NULL) {
+        *runCycles = delta;
+    }
+    return Permille(delta, cur->cycles - prev->cycles);
+}
+
+/* ================= 滑动窗口 ================= */
+
+static VOID CpuMonSample(VOID *arg)
+{
+    static CpuMonSnapshot now;
+    UINT32 slot;
+
+    (void)arg;
+    CpuMonSnapshotTake(&now);
+    LOS_TaskLock();
+    slot = g_slotNext;
+    for (UINT32 id = 0; id < CPU_MON_MAX_TASKS; id++) {
+        g_slotRun[slot][id] = (UINT32)(now.runCycles[id] - g_sampleLast.runCycles[id]);
+    }
+    g_slotWall[slot] = (UINT32)(now.cycles - g_sampleLast.cycles);
+    g_sampleLast = now;
+
+    g_slotNext = (slot + 1) % CPU_MON_HISTORY_SEC;
+    if (g_slotCount < CPU_MON_HISTORY_SEC) {
+        g_slotCount++;
+    }
+    LOS_TaskUnlock();
+}
+
+/**
+ * @brief 对最近 seconds 个采样求和，taskId 为 CPU_MON_MAX_TASKS 时累加除 idle 外的全部任务
+ */
+static UINT32 WindowSum(UINT32 taskId, UINT32 seconds)
+{
+    UINT64 run = 0;
+    UINT64 wall = 0;
+    UINT32 n;
+    UINT32 slot;
+
+    LOS_TaskLock();
+    n = (seconds < g_slotCount) ? seconds : g_slotCount;
+    slot = g_slotNext;
+    for (UINT32 i = 0; i < n; i++) {
+        slot = (slot + CPU_MON_HISTORY_SEC - 1) % CPU_MON_HISTORY_SEC;
+        wall += g_slotWall[slot];
+        if (taskId < CPU_MON_MAX_TASKS) {
+            run += g_slotRun[slot][taskId];
+            continue;
+        }
+        for (UINT32 id = 0; id < CPU_MON_MAX_TASKS; id++) {
+            if (id != g_idleTaskID) {
+                run += g_slotRun[slot][id];
+            }
+        }
+    }
+    LOS_TaskUnlock();
+    return Permille(run, wall);
+}
+
+UINT32 CpuMonWindowUsage(UINT32 taskId, CpuMonWindow win)
+{
+    if (taskId >= CPU_MON_MAX_TASKS || win >= CPU_MON_WIN_NUM) {
+        return 0;
+    }
+    return WindowSum(taskId, g_winSec[win]);
+}
+
+UINT32 CpuMonSysUsage(CpuMonWindow win)
+{
+    if (win >= CPU_MON_WIN_NUM) {
+        return 0;
+    }
+    return WindowSum(CPU_MON_MAX_TASKS, g_winSec[win]);
+}
+
+UINT32 CpuMonTaskUsageGet(UINT32 taskId, CpuMonTaskUsage *usage)
+{
+    UINT32 intSave;
+
+    if (taskId >= CPU_MON_MAX_TASKS || usage == NULL) {
+        return LOS_NOK;
+    }
+    intSave = LOS_IntLock();
+    usage->runCycles = g_runCycles[taskId];
+    if (taskId == g_curTask) {
+        usage->runCycles += LOS_SysCycleGet() - g_curStart;
+    }
+    usage->switchIns = g_switchIns[taskId];
+    LOS_IntRestore(intSave);
+
+    usage->taskId = taskId;
+    for (UINT32 w = 0; w < CPU_MON_WIN_NUM; w++) {
+        usage->usage[w] = WindowSum(taskId, g_winSec[w]);
+    }
+    return LOS_OK;
+}
+
+VOID CpuMonReset(VOID)
+{
+    UINT32 intSave = LOS_IntLock();
+
+    memset(g_runCycles, 0, sizeof(g_runCycles));
+    memset(g_switchIns, 0, sizeof(g_switchIns));
+    memset(&g_idleRes, 0, sizeof(g_idleRes));
+    g_curStart = LOS_SysCycleGet();
+    g_curTask = LOS_CurTaskIDGet();
+    g_slotNext = 0;
+    g_slotCount = 0;
+    g_dumpValid = FALSE;
+    LOS_IntRestore(intSave);
+    LOS_TaskLock();
+    CpuMonSnapshotTake(&g_sampleLast);
+    LOS_TaskUnlock();
+}
+
+/* ================= 输出 ================= */
+
+static UINT32 CyclesToUs(UINT64 cycles)
+{
+    return (UINT32)(cycles * 1000000ULL / OS_SYS_CLOCK);
+}
+
+VOID CpuMonDump(VOID)
+{
+    static CpuMonSnapshot now;
+    TSK_INFO_S info;
+    CpuMonTaskUsage usage;
+    UINT64 delta;
+    UINT32 interval;
+    UINT32 sinceUs;
+
+    CpuMonSnapshotTake(&now);
+    sinceUs = g_dumpValid ? CyclesToUs(now.cycles - g_dumpLast.cycles) : 0;
+
+    printf("%-4s %-16s %4s %8s %12s %7s %7s %7s %10s %7s", "ID", "Name", "Prio", "SwIn",
+           "RunMs", "1s%", "10s%", "60s%", "DeltaUs", "Int%");
+#if (LOSCFG_KERNEL_CPUP == 1)
+    printf(" %7s", "CPUP1s%");
+#endif
+    printf("\n");
+
+    for (UINT32 id = 0; id < CPU_MON_MAX_TASKS; id++) {
+        if (LOS_TaskInfoGet(id, &info) != LOS_OK) {
+            continue;
+        }
+        (void)CpuMonTaskUsageGet(id, &usage);
+        delta = 0;
+        interval = g_dumpValid ? CpuMonIntervalUsage(&g_dumpLast, &now, id, &delta) : 0;
+        printf("%-4u %-16.16s %4u %8u %12u %3u.%u%% %3u.%u%% %3u.%u%% %10u %3u.%u%%",
+               id, info.acName, info.usTaskPrio, usage.switchIns,
+               CyclesToUs(usage.runCycles) / 1000,
+               usage.usage[CPU_MON_WIN_1S] / 10, usage.usage[CPU_MON_WIN_1S] % 10,
+               usage.usage[CPU_MON_WIN_10S] / 10, usage.usage[CPU_MON_WIN_10S] % 10,
+               usage.usage[CPU_MON_WIN_60S] / 10, usage.usage[CPU_MON_WIN_60S] % 10,
+               CyclesToUs(delta), interval / 10, interval % 10);
+#if (LOSCFG_KERNEL_CPUP == 1)
+        UINT32 cpup = LOS_HistoryTaskCpuUsage(id, CPUP_LAST_ONE_SECONDS);
+        printf(" %3u.%u%%", cpup / 10, cpup % 10);
+#endif
+        printf("\n");
+    }
+
+    printf("system busy: 1s %u.%u%%, 10s %u.%u%%, 60s %u.%u%% (%u samples)",
+           CpuMonSysUsage(CPU_MON_WIN_1S) / 10, CpuMonSysUsage(CPU_MON_WIN_1S) % 10,
+           CpuMonSysUsage(CPU_MON_WIN_10S) / 10, CpuMonSysUsage(CPU_MON_WIN_10S) % 10,
+           CpuMonSysUsage(CPU_MON_WIN_60S) / 10, CpuMonSysUsage(CPU_MON_WIN_60S) % 10,
+           g_slotCount);
+    if (g_dumpValid) {
+        printf(", interval %u us", sinceUs);
+    }
+    printf("\n");
+
+    g_dumpLast = now;
+    g_dumpValid = TRUE;
+}
+
+VOID CpuMonIdleResidencyGet(CpuMonIdleResidency *res)
+{
+    UINT32 intSave = LOS_IntLock();
+    *res = g_idleRes;
+    LOS_IntRestore(intSave);
+}
+
+VOID CpuMonIdleResidencyDump(const CpuMonIdleResidency *prev)
+{
+    static const UINT32 edges[] = CPU_MON_IDLE_EDGES;
+    CpuMonIdleResidency cur;
+    UINT64 total = 0;
+    UINT32 entries;
+
+    CpuMonIdleResidencyGet(&cur);
+    if (prev != NULL) {
+        cur.entries -= prev->entries;
+        for (UINT32 b = 0; b < CPU_MON_IDLE_BUCKETS; b++) {
+            cur.count[b] -= prev->count[b];
+            cur.cycles[b] -= prev->cycles[b];
+        }
+    }
+    entries = cur.entries;
+    for (UINT32 b = 0; b < CPU_MON_IDLE_BUCKETS; b++) {
+        total += cur.cycles[b];
+    }
+
+    printf("%-12s %8s %12s %7s\n", "IdleTicks", "Count", "TimeUs", "Time%");
+    for (UINT32 b = 0; b < CPU_MON_IDLE_BUCKETS; b++) {
+        CHAR label[16];
+        if (b == CPU_MON_IDLE_BUCKETS - 1) {
+            (void)snprintf(label, sizeof(label), ">=%u", edges[b - 1]);
+        } else {
+            (void)snprintf(label, sizeof(label), "%u-%u", (b == 0) ? 0 : edges[b - 1], edges[b]);
+        }
+        UINT32 pm = Permille(cur.cycles[b], total);
+        printf("%-12s %8u %12u %3u.%u%%\n", label, cur.count[b], CyclesToUs(cur.cycles[b]), pm / 10, pm % 10);
+    }
+    printf("idle entries %u, avg %u us, longest %u us\n", entries,
+           (entries == 0) ? 0 : CyclesToUs(total / entries), CyclesToUs(cur.longest));
+}
+
+/* ================= shell 命令 ================= */
+
+static UINT32 CpuMonCmd(UINT32 argc, const CHAR **argv)
+{
+    if (argc == 0) {
+        CpuMonDump();
+        return LOS_OK;
+    }
+    if (strcmp(argv[0], "reset") == 0) {
+        CpuMonReset();
+        return LOS_OK;
+    }
+    if (strcmp(argv[0], "idle") == 0) {
+        CpuMonIdleResidencyDump(NULL);
+        return LOS_OK;
+    }
+    printf("usage: cpumon [reset|idle]\n");
+    return LOS_NOK;
+}
+
+UINT32 CpuMonInit(VOID)
+{
+    UINT32 ret;
+
+    if (g_inited) {
+        return LOS_OK;
+    }
+    static const UINT32 edges[] = CPU_MON_IDLE_EDGES;
+    for (UINT32 b = 0; b < CPU_MON_IDLE_BUCKETS - 1; b++) {
+        g_idleEdgeCycles[b] = (UINT64)edges[b] * OS_SYS_CLOCK / LOSCFG_BASE_CORE_TICK_PER_SECOND;
+    }
+    CpuMonReset();
+    ret = SchedHookAdd(CpuMonOnSwitch);
+    if (ret != LOS_OK) {
+        printf("[cpumon] hook register failed\n");
+        return ret;
+    }
+
+    g_sampleTimer = osTimerNew((osTimerFunc_t)CpuMonSample, osTimerPeriodic, NULL, NULL);
+    if (g_sampleTimer == NULL ||
+        osTimerStart(g_sampleTimer, LOSCFG_BASE_CORE_TICK_PER_SECOND) != osOK) {
+        printf("[cpumon] sample timer start failed\n");
+        SchedHookRemove(CpuMonOnSwitch);
+        return LOS_NOK;
+    }
+    (void)osCmdReg(CMD_TYPE_EX, "cpumon", XARGS, (CmdCallBackFunc)CpuMonCmd);
+    g_inited = TRUE;
+    return LOS_OK;
+}
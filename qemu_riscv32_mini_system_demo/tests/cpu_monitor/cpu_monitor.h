@@ -0,0 +1,104 @@
+#ifndef APP_CPU_MONITOR_H
+#define APP_CPU_MONITOR_H
+
+#include "los_task.h"
+#include "los_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 按任务 ID 直接索引，与内核任务表一致 (含 idle)
+#define CPU_MON_MAX_TASKS        (LOSCFG_BASE_CORE_TSK_LIMIT + 1)
+// 保留最近 60 个 1 秒采样，滑动窗口最长 60 秒
+#define CPU_MON_HISTORY_SEC      60
+// 占用率单位：千分比，与 CPUP (LOS_CPUP_PRECISION) 一致
+#define CPU_MON_PRECISION        1000
+
+typedef enum {
+    CPU_MON_WIN_1S = 0,
+    CPU_MON_WIN_10S,
+    CPU_MON_WIN_60S,
+    CPU_MON_WIN_NUM,
+} CpuMonWindow;
+
+typedef struct {
+    UINT32 taskId;
+    UINT32 switchIns;               // 累计切入次数
+    UINT64 runCycles;               // 累计运行周期 (LOS_SysCycleGet)，含当前正在运行的一段
+    UINT32 usage[CPU_MON_WIN_NUM];  // 各窗口占用率，千分比；采样不足一个窗口时按已有采样计算
+} CpuMonTaskUsage;
+
+// idle 连续运行时长分桶的上界 (tick)，最后一桶不设上界
+#define CPU_MON_IDLE_BUCKETS     7
+#define CPU_MON_IDLE_EDGES       { 1, 2, 5, 10, 50, 100 }
+
+/*
+ * idle 驻留分布：每次 idle 被切出时按其本次连续运行的时长计入一个桶
+ * 开启 LOSCFG_KERNEL_PM 时 idle 的大部分时间处于低功耗，段越长越能进入深睡眠
+ */
+typedef struct {
+    UINT32 entries;                          // idle 被切出的次数
+    UINT32 count[CPU_MON_IDLE_BUCKETS];
+    UINT64 cycles[CPU_MON_IDLE_BUCKETS];
+    UINT64 longest;                          // 最长一段 (周期)，Dump 差值时仍为累计值
+} CpuMonIdleResidency;
+
+/*
+ * 某一时刻所有任务的累计运行周期
+ * 调用方保存两次快照，用 CpuMonIntervalUsage 计算任意区间的增量与占用率
+ */
+typedef struct {
+    UINT64 cycles;
+    UINT64 runCycles[CPU_MON_MAX_TASKS];
+} CpuMonSnapshot;
+
+/**
+ * @brief 订阅任务切换、启动 1 秒采样定时器并注册 shell 命令 cpumon，重复调用无副作用
+ * 运行时间在切换钩子中按周期累计，不依赖 tick 采样，因此忙循环任务和短任务同样准确
+ */
+UINT32 CpuMonInit(VOID);
+
+/**
+ * @brief 清零累计值与滑动窗口历史；任务 ID 被回收复用前应调用，否则新任务继承旧计数
+ * CpuMonInit 首次调用时已清零，其他模块可能共用同一份统计，测试区间优先用快照差分
+ */
+VOID CpuMonReset(VOID);
+
+UINT32 CpuMonTaskUsageGet(UINT32 taskId, CpuMonTaskUsage *usage);
+
+/**
+ * @brief 单个任务在指定窗口内的占用率 (千分比)
+ */
+UINT32 CpuMonWindowUsage(UINT32 taskId, CpuMonWindow win);
+
+/**
+ * @brief 除 idle 以外所有任务在指定窗口内的占用率之和 (千分比)
+ */
+UINT32 CpuMonSysUsage(CpuMonWindow win);
+
+VOID CpuMonSnapshotTake(CpuMonSnapshot *snap);
+
+/**
+ * @brief 两次快照之间任务的运行周期增量，runCycles 可为 NULL
+ * @return 该区间内的占用率 (千分比)
+ */
+UINT32 CpuMonIntervalUsage(const CpuMonSnapshot *prev, const CpuMonSnapshot *cur, UINT32 taskId,
+                           UINT64 *runCycles);
+
+VOID CpuMonIdleResidencyGet(CpuMonIdleResidency *res);
+
+/**
+ * @brief 打印 idle 驻留分布；prev 非空时只打印与 prev 的差值
+ */
+VOID CpuMonIdleResidencyDump(const CpuMonIdleResidency *prev);
+
+/**
+ * @brief 打印所有任务的运行时间、1/10/60 秒占用率及与上次打印之间的增量
+ */
+VOID CpuMonDump(VOID);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
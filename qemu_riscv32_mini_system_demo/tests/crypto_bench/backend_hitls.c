@@ -0,0 +1,234 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bsl_sal.h"
+#include "bsl_err.h"
+#include "crypt_algid.h"
+#include "crypt_errno.h"
+#include "crypt_eal_md.h"
+#include "crypt_eal_cipher.h"
+#include "crypt_util_rand.h"
+
+#define HITLS_CRYPTO_SM2
+#define HITLS_CRYPTO_SM2_CRYPT
+
+#include "crypt_sm2.h"
+#include "crypt_bn.h"
+#include "crypt_ecc.h"
+#include "crypto_backend.h"
+#include "bench_rng.h"
+
+#define HITLS_BN_BITS            (CRYPTO_BN_BYTES * 8)
+#define HITLS_POINT_ENC_LEN      (CRYPTO_SM2_POINT_LEN + 1)
+
+static CRYPT_SM2_Ctx *g_sm2Ctx = NULL;
+static CRYPT_EAL_MdCTX *g_sm3Ctx = NULL;
+static CRYPT_EAL_CipherCtx *g_sm4Ctx = NULL;
+
+// 原语接口常驻的大数 / 曲线对象，避免每次调用都申请
+static BN_Optimizer *g_bnOpt = NULL;
+static BN_BigNum *g_bnA = NULL;
+static BN_BigNum *g_bnB = NULL;
+static BN_BigNum *g_bnM = NULL;
+static BN_BigNum *g_bnR = NULL;
+static ECC_Para *g_eccPara = NULL;
+static ECC_Point *g_ptIn = NULL;
+static ECC_Point *g_ptOut = NULL;
+
+static BenchRng g_rng;
+
+static int32_t HitlsBenchRand(uint8_t *randNum, uint32_t randLen)
+{
+    BenchRngBytes(&g_rng, randNum, randLen);
+    return 0;
+}
+
+static void HitlsDeinit(void)
+{
+    CRYPT_SM2_FreeCtx(g_sm2Ctx);
+    CRYPT_EAL_MdFreeCtx(g_sm3Ctx);
+    CRYPT_EAL_CipherFreeCtx(g_sm4Ctx);
+    g_sm2Ctx = NULL;
+    g_sm3Ctx = NULL;
+    g_sm4Ctx = NULL;
+
+    ECC_FreePoint(g_ptIn);
+    ECC_FreePoint(g_ptOut);
+    ECC_FreePara(g_eccPara);
+    BN_Destroy(g_bnA);
+    BN_Destroy(g_bnB);
+    BN_Destroy(g_bnM);
+    BN_Destroy(g_bnR);
+    BN_OptimizerDestroy(g_bnOpt);
+    g_ptIn = NULL;
+    g_ptOut = NULL;
+    g_eccPara = NULL;
+    g_bnA = NULL;
+    g_bnB = NULL;
+    g_bnM = NULL;
+    g_bnR = NULL;
+    g_bnOpt = NULL;
+}
+
+static int HitlsInit(void)
+{
+    // 签名随机数 k 随流固定，确定模式下 SM2 耗时可逐次复现
+    BenchRngInit(&g_rng, BENCH_RNG_STREAM_CRYPTO_BENCH);
+    CRYPT_RandRegist(HitlsBenchRand);
+
+    g_sm2Ctx = CRYPT_SM2_NewCtx();
+    g_sm3Ctx = CRYPT_EAL_MdNewCtx(CRYPT_MD_SM3);
+    g_sm4Ctx = CRYPT_EAL_CipherNewCtx(CRYPT_CIPHER_SM4_CBC);
+    if (g_sm2Ctx == NULL || g_sm3Ctx == NULL || g_sm4Ctx == NULL) {
+        printf("[hitls] ctx create fail!\n");
+        HitlsDeinit();
+        return -1;
+    }
+    if (CRYPT_SM2_Gen(g_sm2Ctx) != CRYPT_SUCCESS) {
+        printf("[hitls] CRYPT_SM2_Gen fail!\n");
+        HitlsDeinit();
+        return -1;
+    }
+
+    g_bnOpt = BN_OptimizerCreate();
+    g_bnA = BN_Create(HITLS_BN_BITS);
+    g_bnB = BN_Create(HITLS_BN_BITS);
+    g_bnM = BN_Create(HITLS_BN_BITS);
+    g_bnR = BN_Create(HITLS_BN_BITS);
+    g_eccPara = ECC_NewPara(CRYPT_ECC_SM2);
+    if (g_bnOpt == NULL || g_bnA == NULL || g_bnB == NULL || g_bnM == NULL || g_bnR == NULL ||
+        g_eccPara == NULL) {
+        printf("[hitls] bn/ecc create fail!\n");
+        HitlsDeinit();
+        return -1;
+    }
+    g_ptIn = ECC_NewPoint(g_eccPara);
+    g_ptOut = ECC_NewPoint(g_eccPara);
+    if (g_ptIn == NULL || g_ptOut == NULL) {
+        printf("[hitls] ecc point create fail!\n");
+        HitlsDeinit();
+        return -1;
+    }
+    return 0;
+}
+
+static int HitlsSm2Keygen(void)
+{
+    return CRYPT_SM2_Gen(g_sm2Ctx) == CRYPT_SUCCESS ? 0 : -1;
+}
+
+static int HitlsSm2Sign(const uint8_t *msg, uint32_t msgLen, uint8_t *sig, uint32_t *sigLen)
+{
+    return CRYPT_SM2_Sign(g_sm2Ctx, CRYPT_MD_SM3, msg, msgLen, sig, sigLen) == CRYPT_SUCCESS ? 0 : -1;
+}
+
+static int HitlsSm2Verify(const uint8_t *msg, uint32_t msgLen, const uint8_t *sig, uint32_t sigLen)
+{
+    return CRYPT_SM2_Verify(g_sm2Ctx, CRYPT_MD_SM3, msg, msgLen, sig, sigLen) == CRYPT_SUCCESS ? 0 : -1;
+}
+
+static int HitlsSm2Encrypt(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t *outLen)
+{
+    return CRYPT_SM2_Encrypt(g_sm2Ctx, in, inLen, out, outLen) == CRYPT_SUCCESS ? 0 : -1;
+}
+
+static int HitlsSm2Decrypt(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t *outLen)
+{
+    return CRYPT_SM2_Decrypt(g_sm2Ctx, in, inLen, out, outLen) == CRYPT_SUCCESS ? 0 : -1;
+}
+
+static int HitlsSm3(const uint8_t *data, uint32_t len, uint8_t digest[CRYPTO_SM3_DIGEST_LEN])
+{
+    uint32_t outLen = CRYPTO_SM3_DIGEST_LEN;
+
+    if (CRYPT_EAL_MdInit(g_sm3Ctx) != CRYPT_SUCCESS ||
+        CRYPT_EAL_MdUpdate(g_sm3Ctx, data, len) != CRYPT_SUCCESS ||
+        CRYPT_EAL_MdFinal(g_sm3Ctx, digest, &outLen) != CRYPT_SUCCESS) {
+        return -1;
+    }
+    return 0;
+}
+
+static int HitlsSm4Encrypt(const uint8_t key[CRYPTO_SM4_KEY_LEN], const uint8_t iv[CRYPTO_SM4_BLOCK_LEN],
+                           const uint8_t *in, uint32_t len, uint8_t *out)
+{
+    uint32_t outLen = len;
+
+    if (CRYPT_EAL_CipherInit(g_sm4Ctx, key, CRYPTO_SM4_KEY_LEN, iv, CRYPTO_SM4_BLOCK_LEN, true) != CRYPT_SUCCESS) {
+        return -1;
+    }
+    if (CRYPT_EAL_CipherSetPadding(g_sm4Ctx, CRYPT_PADDING_NONE) != CRYPT_SUCCESS) {
+        return -1;
+    }
+    return CRYPT_EAL_CipherUpdate(g_sm4Ctx, in, len, out, &outLen) == CRYPT_SUCCESS ? 0 : -1;
+}
+
+/**
+ * @brief 大数转定长大端；BN_Bn2Bin 输出会去掉前导零，这里右对齐补零
+ */
+static int HitlsBnToFixed(const BN_BigNum *bn, uint8_t *out, uint32_t outLen)
+{
+    uint8_t tmp[CRYPTO_SM2_POINT_LEN];
+    uint32_t len = sizeof(tmp);
+
+    if (BN_Bn2Bin(bn, tmp, &len) != CRYPT_SUCCESS || len > outLen) {
+        return -1;
+    }
+    memset(out, 0, outLen - len);
+    memcpy(out + outLen - len, tmp, len);
+    return 0;
+}
+
+static int HitlsBnModMul(uint8_t r[CRYPTO_BN_BYTES], const uint8_t a[CRYPTO_BN_BYTES],
+                         const uint8_t b[CRYPTO_BN_BYTES], const uint8_t m[CRYPTO_BN_BYTES])
+{
+    if (BN_Bin2Bn(g_bnA, a, CRYPTO_BN_BYTES) != CRYPT_SUCCESS ||
+        BN_Bin2Bn(g_bnB, b, CRYPTO_BN_BYTES) != CRYPT_SUCCESS ||
+        BN_Bin2Bn(g_bnM, m, CRYPTO_BN_BYTES) != CRYPT_SUCCESS) {
+        return -1;
+    }
+    if (BN_ModMul(g_bnR, g_bnA, g_bnB, g_bnM, g_bnOpt) != CRYPT_SUCCESS) {
+        return -1;
+    }
+    return HitlsBnToFixed(g_bnR, r, CRYPTO_BN_BYTES);
+}
+
+static int HitlsSm2PointMul(uint8_t r[CRYPTO_SM2_POINT_LEN], const uint8_t k[CRYPTO_BN_BYTES],
+                            const uint8_t p[CRYPTO_SM2_POINT_LEN])
+{
+    uint8_t enc[HITLS_POINT_ENC_LEN];
+    uint32_t encLen = sizeof(enc);
+
+    // 未压缩编码 04 || x || y
+    enc[0] = 0x04;
+    memcpy(enc + 1, p, CRYPTO_SM2_POINT_LEN);
+    if (ECC_DecodePoint(g_eccPara, g_ptIn, enc, sizeof(enc)) != CRYPT_SUCCESS ||
+        BN_Bin2Bn(g_bnA, k, CRYPTO_BN_BYTES) != CRYPT_SUCCESS) {
+        return -1;
+    }
+    if (ECC_PointMul(g_eccPara, g_ptOut, g_bnA, g_ptIn) != CRYPT_SUCCESS) {
+        return -1;
+    }
+    if (ECC_EncodePoint(g_eccPara, g_ptOut, enc, &encLen, CRYPT_POINT_UNCOMPRESSED) != CRYPT_SUCCESS ||
+        encLen != HITLS_POINT_ENC_LEN) {
+        return -1;
+    }
+    memcpy(r, enc + 1, CRYPTO_SM2_POINT_LEN);
+    return 0;
+}
+
+const CryptoBackend g_hitlsBackend = {
+    .name       = "hitls",
+    .init       = HitlsInit,
+    .deinit     = HitlsDeinit,
+    .sm2Keygen  = HitlsSm2Keygen,
+    .sm2Sign    = HitlsSm2Sign,
+    .sm2Verify  = HitlsSm2Verify,
+    .sm2Encrypt = HitlsSm2Encrypt,
+    .sm2Decrypt = HitlsSm2Decrypt,
+    .sm3        = HitlsSm3,
+    .sm4Encrypt = HitlsSm4Encrypt,
+    .bnModMul   = HitlsBnModMul,
+    .sm2PointMul = HitlsSm2PointMul,
+};
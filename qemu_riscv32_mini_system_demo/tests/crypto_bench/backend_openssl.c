@@ -0,0 +1,263 @@
+#include <stdio.h>
+#include <string.h>
+
+// OpenSSL 头文件
+#include "evp.h"
+#include "ec.h"
+#include "bn.h"
+#include "err.h"
+
+#include "crypto_backend.h"
+
+// SM2 默认用户 ID (GB/T 32918)
+static const uint8_t g_sm2DefaultId[] = "1234567812345678";
+
+static EVP_PKEY *g_pkey = NULL;
+static EVP_CIPHER_CTX *g_sm4Ctx = NULL;
+
+// 原语接口常驻对象
+static BN_CTX *g_bnCtx = NULL;
+static BIGNUM *g_bnA = NULL;
+static BIGNUM *g_bnB = NULL;
+static BIGNUM *g_bnM = NULL;
+static BIGNUM *g_bnR = NULL;
+static EC_GROUP *g_sm2Group = NULL;
+static EC_POINT *g_ptIn = NULL;
+static EC_POINT *g_ptOut = NULL;
+
+static void OpensslDeinit(void)
+{
+    EVP_PKEY_free(g_pkey);
+    EVP_CIPHER_CTX_free(g_sm4Ctx);
+    g_pkey = NULL;
+    g_sm4Ctx = NULL;
+
+    EC_POINT_free(g_ptIn);
+    EC_POINT_free(g_ptOut);
+    EC_GROUP_free(g_sm2Group);
+    BN_free(g_bnA);
+    BN_free(g_bnB);
+    BN_free(g_bnM);
+    BN_free(g_bnR);
+    BN_CTX_free(g_bnCtx);
+    g_ptIn = NULL;
+    g_ptOut = NULL;
+    g_sm2Group = NULL;
+    g_bnA = NULL;
+    g_bnB = NULL;
+    g_bnM = NULL;
+    g_bnR = NULL;
+    g_bnCtx = NULL;
+}
+
+static int OpensslSm2Keygen(void)
+{
+    EVP_PKEY *pkey = NULL;
+    int ok = 0;
+
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL);
+    if (ctx != NULL && EVP_PKEY_keygen_init(ctx) > 0 &&
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, NID_sm2) > 0 &&
+        EVP_PKEY_keygen(ctx, &pkey) > 0) {
+#if OPENSSL_VERSION_NUMBER < 0x30000000L
+        // 1.1.1 中 SM2 密钥需显式切换到 SM2 方法，否则按 ECDSA 处理
+        ok = EVP_PKEY_set_alias_type(pkey, EVP_PKEY_SM2) > 0;
+#else
+        ok = 1;
+#endif
+    }
+    EVP_PKEY_CTX_free(ctx);
+
+    if (!ok) {
+        EVP_PKEY_free(pkey);
+        return -1;
+    }
+    EVP_PKEY_free(g_pkey);
+    g_pkey = pkey;
+    return 0;
+}
+
+static int OpensslInit(void)
+{
+    g_sm4Ctx = EVP_CIPHER_CTX_new();
+    if (g_sm4Ctx == NULL || OpensslSm2Keygen() != 0) {
+        printf("[openssl] init fail: 0x%lx\n", ERR_get_error());
+        OpensslDeinit();
+        return -1;
+    }
+
+    g_bnCtx = BN_CTX_new();
+    g_bnA = BN_new();
+    g_bnB = BN_new();
+    g_bnM = BN_new();
+    g_bnR = BN_new();
+    g_sm2Group = EC_GROUP_new_by_curve_name(NID_sm2);
+    if (g_bnCtx == NULL || g_bnA == NULL || g_bnB == NULL || g_bnM == NULL || g_bnR == NULL ||
+        g_sm2Group == NULL) {
+        printf("[openssl] bn/ec init fail: 0x%lx\n", ERR_get_error());
+        OpensslDeinit();
+        return -1;
+    }
+    g_ptIn = EC_POINT_new(g_sm2Group);
+    g_ptOut = EC_POINT_new(g_sm2Group);
+    if (g_ptIn == NULL || g_ptOut == NULL) {
+        OpensslDeinit();
+        return -1;
+    }
+    return 0;
+}
+
+static EVP_MD_CTX *OpensslNewSm2MdCtx(void)
+{
+    EVP_MD_CTX *mctx = EVP_MD_CTX_new();
+    EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new(g_pkey, NULL);
+
+    if (mctx == NULL || pctx == NULL ||
+        EVP_PKEY_CTX_set1_id(pctx, g_sm2DefaultId, sizeof(g_sm2DefaultId) - 1) <= 0) {
+        EVP_MD_CTX_free(mctx);
+        EVP_PKEY_CTX_free(pctx);
+        return NULL;
+    }
+    // mctx 不持有 pctx，由 OpensslFreeSm2MdCtx 一并释放
+    EVP_MD_CTX_set_pkey_ctx(mctx, pctx);
+    return mctx;
+}
+
+static void OpensslFreeSm2MdCtx(EVP_MD_CTX *mctx)
+{
+    if (mctx == NULL) {
+        return;
+    }
+    EVP_PKEY_CTX_free(EVP_MD_CTX_pkey_ctx(mctx));
+    EVP_MD_CTX_free(mctx);
+}
+
+static int OpensslSm2Sign(const uint8_t *msg, uint32_t msgLen, uint8_t *sig, uint32_t *sigLen)
+{
+    size_t len = *sigLen;
+    int ok = 0;
+
+    EVP_MD_CTX *mctx = OpensslNewSm2MdCtx();
+    if (mctx != NULL &&
+        EVP_DigestSignInit(mctx, NULL, EVP_sm3(), NULL, g_pkey) > 0 &&
+        EVP_DigestSign(mctx, sig, &len, msg, msgLen) > 0) {
+        *sigLen = (uint32_t)len;
+        ok = 1;
+    }
+    OpensslFreeSm2MdCtx(mctx);
+    return ok ? 0 : -1;
+}
+
+static int OpensslSm2Verify(const uint8_t *msg, uint32_t msgLen, const uint8_t *sig, uint32_t sigLen)
+{
+    int ok = 0;
+
+    EVP_MD_CTX *mctx = OpensslNewSm2MdCtx();
+    if (mctx != NULL &&
+        EVP_DigestVerifyInit(mctx, NULL, EVP_sm3(), NULL, g_pkey) > 0 &&
+        EVP_DigestVerify(mctx, sig, sigLen, msg, msgLen) > 0) {
+        ok = 1;
+    }
+    OpensslFreeSm2MdCtx(mctx);
+    return ok ? 0 : -1;
+}
+
+static int OpensslSm2Crypt(int encrypt, const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t *outLen)
+{
+    size_t len = *outLen;
+    int ok = 0;
+
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new(g_pkey, NULL);
+    if (ctx != NULL) {
+        if (encrypt) {
+            ok = EVP_PKEY_encrypt_init(ctx) > 0 && EVP_PKEY_encrypt(ctx, out, &len, in, inLen) > 0;
+        } else {
+            ok = EVP_PKEY_decrypt_init(ctx) > 0 && EVP_PKEY_decrypt(ctx, out, &len, in, inLen) > 0;
+        }
+    }
+    EVP_PKEY_CTX_free(ctx);
+    if (ok) {
+        *outLen = (uint32_t)len;
+    }
+    return ok ? 0 : -1;
+}
+
+static int OpensslSm2Encrypt(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t *outLen)
+{
+    return OpensslSm2Crypt(1, in, inLen, out, outLen);
+}
+
+static int OpensslSm2Decrypt(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t *outLen)
+{
+    return OpensslSm2Crypt(0, in, inLen, out, outLen);
+}
+
+static int OpensslSm3(const uint8_t *data, uint32_t len, uint8_t digest[CRYPTO_SM3_DIGEST_LEN])
+{
+    unsigned int mdLen = CRYPTO_SM3_DIGEST_LEN;
+    return EVP_Digest(data, len, digest, &mdLen, EVP_sm3(), NULL) > 0 ? 0 : -1;
+}
+
+static int OpensslSm4Encrypt(const uint8_t key[CRYPTO_SM4_KEY_LEN], const uint8_t iv[CRYPTO_SM4_BLOCK_LEN],
+                             const uint8_t *in, uint32_t len, uint8_t *out)
+{
+    int outLen = 0;
+
+    if (EVP_EncryptInit_ex(g_sm4Ctx, EVP_sm4_cbc(), NULL, key, iv) <= 0) {
+        return -1;
+    }
+    EVP_CIPHER_CTX_set_padding(g_sm4Ctx, 0);
+    return EVP_EncryptUpdate(g_sm4Ctx, out, &outLen, in, (int)len) > 0 ? 0 : -1;
+}
+
+static int OpensslBnModMul(uint8_t r[CRYPTO_BN_BYTES], const uint8_t a[CRYPTO_BN_BYTES],
+                           const uint8_t b[CRYPTO_BN_BYTES], const uint8_t m[CRYPTO_BN_BYTES])
+{
+    if (BN_bin2bn(a, CRYPTO_BN_BYTES, g_bnA) == NULL ||
+        BN_bin2bn(b, CRYPTO_BN_BYTES, g_bnB) == NULL ||
+        BN_bin2bn(m, CRYPTO_BN_BYTES, g_bnM) == NULL) {
+        return -1;
+    }
+    if (BN_mod_mul(g_bnR, g_bnA, g_bnB, g_bnM, g_bnCtx) <= 0) {
+        return -1;
+    }
+    return BN_bn2binpad(g_bnR, r, CRYPTO_BN_BYTES) == CRYPTO_BN_BYTES ? 0 : -1;
+}
+
+static int OpensslSm2PointMul(uint8_t r[CRYPTO_SM2_POINT_LEN], const uint8_t k[CRYPTO_BN_BYTES],
+                              const uint8_t p[CRYPTO_SM2_POINT_LEN])
+{
+    uint8_t enc[CRYPTO_SM2_POINT_LEN + 1];
+
+    // 未压缩编码 04 || x || y
+    enc[0] = POINT_CONVERSION_UNCOMPRESSED;
+    memcpy(enc + 1, p, CRYPTO_SM2_POINT_LEN);
+    if (EC_POINT_oct2point(g_sm2Group, g_ptIn, enc, sizeof(enc), g_bnCtx) <= 0 ||
+        BN_bin2bn(k, CRYPTO_BN_BYTES, g_bnA) == NULL) {
+        return -1;
+    }
+    if (EC_POINT_mul(g_sm2Group, g_ptOut, NULL, g_ptIn, g_bnA, g_bnCtx) <= 0) {
+        return -1;
+    }
+    if (EC_POINT_point2oct(g_sm2Group, g_ptOut, POINT_CONVERSION_UNCOMPRESSED, enc, sizeof(enc),
+                           g_bnCtx) != sizeof(enc)) {
+        return -1;
+    }
+    memcpy(r, enc + 1, CRYPTO_SM2_POINT_LEN);
+    return 0;
+}
+
+const CryptoBackend g_opensslBackend = {
+    .name       = "openssl",
+    .init       = OpensslInit,
+    .deinit     = OpensslDeinit,
+    .sm2Keygen  = OpensslSm2Keygen,
+    .sm2Sign    = OpensslSm2Sign,
+    .sm2Verify  = OpensslSm2Verify,
+    .sm2Encrypt = OpensslSm2Encrypt,
+    .sm2Decrypt = OpensslSm2Decrypt,
+    .sm3        = OpensslSm3,
+    .sm4Encrypt = OpensslSm4Encrypt,
+    .bnModMul   = OpensslBnModMul,
+    .sm2PointMul = OpensslSm2PointMul,
+};
@@ -0,0 +1,126 @@
+/*
+ * SM2 专用 Montgomery 后端 (tests/sm2_mont)
+ * 只提供底层原语：模数为 SM2 素数 p 时模乘走 Montgomery 内核，
+ * 其他模数退回逐位的通用模乘 (慢，但结果正确，保证在 bnModMul 槽位里可以互换)；
+ * 内核由编译开关 SM2_MONT_ASM 决定是 rv32 汇编还是 C 参考实现。
+ */
+
+#include <string.h>
+
+#include "sm2_mont.h"
+#include "crypto_backend.h"
+#include "crypto_vectors.h"
+
+#define BN_WORDS                 (CRYPTO_BN_BYTES / 4)
+
+/* ================= 通用模乘 ================= */
+
+static void BnLoad(uint32_t w[BN_WORDS], const uint8_t be[CRYPTO_BN_BYTES])
+{
+    for (uint32_t i = 0; i < BN_WORDS; i++) {
+        const uint8_t *p = be + CRYPTO_BN_BYTES - 4 * (i + 1);
+        w[i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    }
+}
+
+static void BnStore(uint8_t be[CRYPTO_BN_BYTES], const uint32_t w[BN_WORDS])
+{
+    for (uint32_t i = 0; i < BN_WORDS; i++) {
+        uint8_t *p = be + CRYPTO_BN_BYTES - 4 * (i + 1);
+        p[0] = (uint8_t)(w[i] >> 24);
+        p[1] = (uint8_t)(w[i] >> 16);
+        p[2] = (uint8_t)(w[i] >> 8);
+        p[3] = (uint8_t)w[i];
+    }
+}
+
+// r = (r + r + bit) 或 (r + x) mod m，调用前 r < m、x < m
+static void BnAddMod(uint32_t r[BN_WORDS], const uint32_t x[BN_WORDS], uint32_t bit, const uint32_t m[BN_WORDS])
+{
+    uint64_t acc = bit;
+    uint32_t carry;
+    int ge = 1;
+
+    for (uint32_t i = 0; i < BN_WORDS; i++) {
+        acc += (uint64_t)r[i] + x[i];
+        r[i] = (uint32_t)acc;
+        acc >>= 32;
+    }
+    carry = (uint32_t)acc;
+    if (carry == 0) {
+        for (int i = BN_WORDS - 1; i >= 0; i--) {
+            if (r[i] != m[i]) {
+                ge = (r[i] > m[i]);
+                break;
+            }
+        }
+    }
+    if (carry != 0 || ge) {
+        int64_t borrow = 0;
+        for (uint32_t i = 0; i < BN_WORDS; i++) {
+            borrow += (int64_t)r[i] - m[i];
+            r[i] = (uint32_t)borrow;
+            borrow >>= 32;
+        }
+    }
+}
+
+/**
+ * @brief 任意非零模数的 r = a * b mod m，先把 b 约减到 m 以下，再按 a 的位从高到低倍加
+ */
+static int GenericModMul(uint8_t r[CRYPTO_BN_BYTES], const uint8_t a[CRYPTO_BN_BYTES],
+                         const uint8_t b[CRYPTO_BN_BYTES], const uint8_t m[CRYPTO_BN_BYTES])
+{
+    uint32_t wa[BN_WORDS], wb[BN_WORDS], wm[BN_WORDS];
+    uint32_t bRed[BN_WORDS] = { 0 };
+    uint32_t acc[BN_WORDS] = { 0 };
+    uint32_t nonZero = 0;
+
+    BnLoad(wa, a);
+    BnLoad(wb, b);
+    BnLoad(wm, m);
+    for (uint32_t i = 0; i < BN_WORDS; i++) {
+        nonZero |= wm[i];
+    }
+    if (nonZero == 0) {
+        return -1;
+    }
+    for (int bit = CRYPTO_BN_BYTES * 8 - 1; bit >= 0; bit--) {
+        BnAddMod(bRed, bRed, (wb[bit / 32] >> (bit % 32)) & 1, wm);
+    }
+    for (int bit = CRYPTO_BN_BYTES * 8 - 1; bit >= 0; bit--) {
+        BnAddMod(acc, acc, 0, wm);
+        if ((wa[bit / 32] >> (bit % 32)) & 1) {
+            BnAddMod(acc, bRed, 0, wm);
+        }
+    }
+    BnStore(r, acc);
+    return 0;
+}
+
+/* ================= 后端接口 ================= */
+
+static int Sm2MontBnModMul(uint8_t r[CRYPTO_BN_BYTES], const uint8_t a[CRYPTO_BN_BYTES],
+                           const uint8_t b[CRYPTO_BN_BYTES], const uint8_t m[CRYPTO_BN_BYTES])
+{
+    if (memcmp(m, g_cryptoSm2P, CRYPTO_BN_BYTES) != 0) {
+        return GenericModMul(r, a, b, m);
+    }
+    return Sm2ModMul(Sm2MontDefault(), r, a, b);
+}
+
+static int Sm2MontPointMul(uint8_t r[CRYPTO_SM2_POINT_LEN], const uint8_t k[CRYPTO_BN_BYTES],
+                           const uint8_t p[CRYPTO_SM2_POINT_LEN])
+{
+    return Sm2PointMul(Sm2MontDefault(), r, k, p);
+}
+
+const CryptoBackend g_sm2MontBackend = {
+#if defined(SM2_MONT_ASM)
+    .name        = "rv32mont",
+#else
+    .name        = "cmont",
+#endif
+    .bnModMul    = Sm2MontBnModMul,
+    .sm2PointMul = Sm2MontPointMul,
+};
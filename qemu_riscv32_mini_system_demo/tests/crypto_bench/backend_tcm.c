@@ -0,0 +1,428 @@
+/*
+ * TCM 命令接口后端
+ * 所有操作都通过 _plat__RunCommand 发送完整的 TCM 2.0 命令 (大端)，
+ * 计时包含命令编组/解组，与上层应用经命令接口使用 TCM 的开销一致。
+ * 命令接口不暴露任意操作数的大数 / 点乘原语，bnModMul 与 sm2PointMul 不提供。
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "crypto_backend.h"
+
+#define TCM_ST_NO_SESSIONS       0x8001
+#define TCM_ST_SESSIONS          0x8002
+#define TCM_ST_HASHCHECK         0x8024
+
+#define TCM_CC_CreatePrimary     0x00000131
+#define TCM_CC_Startup           0x00000144
+#define TCM_CC_Sign              0x0000015D
+#define TCM_CC_FlushContext      0x00000165
+#define TCM_CC_VerifySignature   0x00000177
+#define TCM_CC_Hash              0x0000017D
+#define TCM_CC_EncryptDecrypt2   0x00000193
+#define TCM_CC_ECC_Encrypt       0x00000199
+#define TCM_CC_ECC_Decrypt       0x0000019A
+
+#define TCM_RH_OWNER             0x40000001
+#define TCM_RH_NULL              0x40000007
+#define TCM_RS_PW                0x40000009
+
+#define TCM_ALG_SM4              0x0013
+#define TCM_ALG_SM3_256          0x0012
+#define TCM_ALG_NULL             0x0010
+#define TCM_ALG_SM2              0x001B
+#define TCM_ALG_KDF2             0x0021
+#define TCM_ALG_ECC              0x0023
+#define TCM_ALG_SYMCIPHER        0x0025
+#define TCM_ALG_CBC              0x0042
+#define TCM_ECC_SM2_P256         0x0020
+
+#define TCM_SU_CLEAR             0x0000
+#define TCM_RC_SUCCESS           0x00000000
+#define TCM_RC_INITIALIZE        0x00000100
+
+// fixedTCM|fixedParent|sensitiveDataOrigin|userWithAuth|decrypt|sign
+#define TCM_KEY_ATTR_SIGN_DECRYPT 0x00060072
+
+#define TCM_HEADER_SIZE          10
+#define TCM_CMD_BUF_SIZE         2048
+#define TCM_RSP_BUF_SIZE         2048
+#define TCM_MAX_BUFFER           CRYPTO_TCM_MAX_BUFFER     // Hash / EncryptDecrypt2 的数据上限
+
+extern void _plat__RunCommand(uint32_t size, unsigned char *command, uint32_t *response_size, unsigned char **response);
+extern void _plat__Signal_PowerOn(void);
+extern void _plat__Signal_Reset(void);
+extern void _plat__SetNvAvail(void);
+extern void _plat__NVEnable(void *platParameter, uint32_t size);
+extern int TCM_Manufacture(int firstTime);
+extern bool _plat__NVNeedsManufacture(void);
+extern void TCM_TearDown(void);
+
+static uint8_t g_cmd[TCM_CMD_BUF_SIZE];
+static uint8_t g_rsp[TCM_RSP_BUF_SIZE];
+static uint8_t *g_rspPtr;
+static uint32_t g_rspSize;
+
+static uint32_t g_sm2Handle;
+static uint32_t g_sm4Handle;
+
+/* ================= 编组辅助 ================= */
+
+static inline void write_be16(uint8_t *buf, uint16_t v) {
+    buf[0] = (uint8_t)((v >> 8) & 0xFF); buf[1] = (uint8_t)(v & 0xFF);
+}
+static inline void write_be32(uint8_t *buf, uint32_t v) {
+    buf[0] = (uint8_t)((v >> 24) & 0xFF); buf[1] = (uint8_t)((v >> 16) & 0xFF);
+    buf[2] = (uint8_t)((v >> 8) & 0xFF);  buf[3] = (uint8_t)(v & 0xFF);
+}
+static inline uint16_t read_be16(const uint8_t *buf) {
+    return (uint16_t)buf[1] | ((uint16_t)buf[0] << 8);
+}
+static inline uint32_t read_be32(const uint8_t *buf) {
+    return (uint32_t)buf[3] | ((uint32_t)buf[2] << 8) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[0] << 24);
+}
+
+// 写入命令头，commandSize 在 TcmExec 中回填
+static void TcmBeginCmd(uint16_t tag, uint32_t cc, uint32_t *off)
+{
+    write_be16(g_cmd, tag);
+    write_be32(g_cmd + 6, cc);
+    *off = TCM_HEADER_SIZE;
+}
+
+// 空口令会话 (TCM_RS_PW)
+static void TcmPutPasswordSession(uint32_t *off)
+{
+    write_be32(g_cmd + *off, 9); *off += 4;
+    write_be32(g_cmd + *off, TCM_RS_PW); *off += 4;
+    write_be16(g_cmd + *off, 0); *off += 2;
+    g_cmd[(*off)++] = 0x00;
+    write_be16(g_cmd + *off, 0); *off += 2;
+}
+
+// 放不下时返回 -1，g_cmd 不被改动
+static int TcmPutTpm2b(const uint8_t *data, uint32_t len, uint32_t *off)
+{
+    if (len > 0xFFFF || *off + 2 + len > TCM_CMD_BUF_SIZE) {
+        return -1;
+    }
+    write_be16(g_cmd + *off, (uint16_t)len); *off += 2;
+    if (len > 0) {
+        memcpy(g_cmd + *off, data, len);
+        *off += len;
+    }
+    return 0;
+}
+
+// 原样追加已编组的数据 (签名、密文)，放不下时返回 -1
+static int TcmPutRaw(const uint8_t *data, uint32_t len, uint32_t *off)
+{
+    if (*off + len > TCM_CMD_BUF_SIZE) {
+        return -1;
+    }
+    memcpy(g_cmd + *off, data, len);
+    *off += len;
+    return 0;
+}
+
+static uint32_t TcmExec(uint32_t len)
+{
+    write_be32(g_cmd + 2, len);
+    g_rspSize = sizeof(g_rsp);
+    g_rspPtr = g_rsp;
+    _plat__RunCommand(len, g_cmd, &g_rspSize, &g_rspPtr);
+    if (g_rspPtr == NULL || g_rspSize < TCM_HEADER_SIZE) {
+        return 0xFFFFFFFF;
+    }
+    return read_be32(g_rspPtr + 6);
+}
+
+/* ================= 对象管理 ================= */
+
+static void TcmFlush(uint32_t handle)
+{
+    uint32_t off;
+
+    if (handle == 0) {
+        return;
+    }
+    TcmBeginCmd(TCM_ST_NO_SESSIONS, TCM_CC_FlushContext, &off);
+    write_be32(g_cmd + off, handle); off += 4;
+    (void)TcmExec(off);
+}
+
+static int TcmCreatePrimary(uint16_t type, uint32_t *handle)
+{
+    uint32_t off;
+
+    TcmBeginCmd(TCM_ST_SESSIONS, TCM_CC_CreatePrimary, &off);
+    write_be32(g_cmd + off, TCM_RH_OWNER); off += 4;
+    TcmPutPasswordSession(&off);
+
+    // inSensitive: 空 userAuth / data
+    write_be16(g_cmd + off, 4); off += 2;
+    write_be16(g_cmd + off, 0); off += 2;
+    write_be16(g_cmd + off, 0); off += 2;
+
+    uint32_t pubSizeOff = off; off += 2;
+    uint32_t pubStart = off;
+    write_be16(g_cmd + off, type); off += 2;
+    write_be16(g_cmd + off, TCM_ALG_SM3_256); off += 2;
+    write_be32(g_cmd + off, TCM_KEY_ATTR_SIGN_DECRYPT); off += 4;
+    write_be16(g_cmd + off, 0); off += 2;                    // authPolicy
+    if (type == TCM_ALG_ECC) {
+        write_be16(g_cmd + off, TCM_ALG_NULL); off += 2;     // symmetric
+        write_be16(g_cmd + off, TCM_ALG_NULL); off += 2;     // scheme
+        write_be16(g_cmd + off, TCM_ECC_SM2_P256); off += 2; // curveID
+        write_be16(g_cmd + off, TCM_ALG_NULL); off += 2;     // kdf
+        write_be16(g_cmd + off, 0); off += 2;                // unique.x
+        write_be16(g_cmd + off, 0); off += 2;                // unique.y
+    } else {
+        write_be16(g_cmd + off, TCM_ALG_SM4); off += 2;
+        write_be16(g_cmd + off, 128); off += 2;
+        write_be16(g_cmd + off, TCM_ALG_CBC); off += 2;
+        write_be16(g_cmd + off, 0); off += 2;                // unique
+    }
+    write_be16(g_cmd + pubSizeOff, (uint16_t)(off - pubStart));
+
+    write_be16(g_cmd + off, 0); off += 2;                    // outsideInfo
+    write_be32(g_cmd + off, 0); off += 4;                    // creationPCR
+
+    uint32_t rc = TcmExec(off);
+    if (rc != TCM_RC_SUCCESS) {
+        printf("[tcm] CreatePrimary(0x%04X) fail: 0x%08X\n", type, rc);
+        return -1;
+    }
+    *handle = read_be32(g_rspPtr + TCM_HEADER_SIZE);
+    return 0;
+}
+
+/* ================= 后端实现 ================= */
+
+static void TcmBackendDeinit(void)
+{
+    TcmFlush(g_sm2Handle);
+    TcmFlush(g_sm4Handle);
+    g_sm2Handle = 0;
+    g_sm4Handle = 0;
+}
+
+static int TcmBackendInit(void)
+{
+    uint32_t off;
+
+    _plat__Signal_PowerOn();
+    _plat__SetNvAvail();
+    _plat__Signal_Reset();
+    _plat__NVEnable(NULL, 0);
+    if (_plat__NVNeedsManufacture()) {
+        if (TCM_Manufacture(1) != 0) {
+            printf("[tcm] Manufacture Failed!\n");
+            return -1;
+        }
+        TCM_TearDown();
+        _plat__Signal_PowerOn();
+        _plat__NVEnable(NULL, 0);
+        _plat__Signal_Reset();
+    }
+
+    TcmBeginCmd(TCM_ST_NO_SESSIONS, TCM_CC_Startup, &off);
+    write_be16(g_cmd + off, TCM_SU_CLEAR); off += 2;
+    uint32_t rc = TcmExec(off);
+    if (rc != TCM_RC_SUCCESS && rc != TCM_RC_INITIALIZE) {
+        printf("[tcm] Startup fail: 0x%08X\n", rc);
+        return -1;
+    }
+
+    if (TcmCreatePrimary(TCM_ALG_ECC, &g_sm2Handle) != 0 ||
+        TcmCreatePrimary(TCM_ALG_SYMCIPHER, &g_sm4Handle) != 0) {
+        TcmBackendDeinit();
+        return -1;
+    }
+    return 0;
+}
+
+static int TcmSm2Keygen(void)
+{
+    TcmFlush(g_sm2Handle);
+    g_sm2Handle = 0;
+    return TcmCreatePrimary(TCM_ALG_ECC, &g_sm2Handle);
+}
+
+/*
+ * TCM2_Sign 的输入已经是摘要，这里直接把 32 字节消息当作摘要；
+ * 输出为编组后的 TCMT_SIGNATURE，验签时原样回填
+ */
+static int TcmSm2Sign(const uint8_t *msg, uint32_t msgLen, uint8_t *sig, uint32_t *sigLen)
+{
+    uint32_t off;
+
+    if (msgLen != CRYPTO_SM3_DIGEST_LEN) {
+        return -1;
+    }
+    TcmBeginCmd(TCM_ST_SESSIONS, TCM_CC_Sign, &off);
+    write_be32(g_cmd + off, g_sm2Handle); off += 4;
+    TcmPutPasswordSession(&off);
+    if (TcmPutTpm2b(msg, msgLen, &off) != 0) {
+        return -1;
+    }
+    write_be16(g_cmd + off, TCM_ALG_SM2); off += 2;
+    write_be16(g_cmd + off, TCM_ALG_SM3_256); off += 2;
+    write_be16(g_cmd + off, TCM_ST_HASHCHECK); off += 2;
+    write_be32(g_cmd + off, TCM_RH_NULL); off += 4;
+    write_be16(g_cmd + off, 0); off += 2;
+
+    if (TcmExec(off) != TCM_RC_SUCCESS) {
+        return -1;
+    }
+    // Header(10) + ParamSize(4) + TCMT_SIGNATURE
+    uint32_t paramSize = read_be32(g_rspPtr + TCM_HEADER_SIZE);
+    if (paramSize > *sigLen || TCM_HEADER_SIZE + 4 + paramSize > g_rspSize) {
+        return -1;
+    }
+    memcpy(sig, g_rspPtr + TCM_HEADER_SIZE + 4, paramSize);
+    *sigLen = paramSize;
+    return 0;
+}
+
+static int TcmSm2Verify(const uint8_t *msg, uint32_t msgLen, const uint8_t *sig, uint32_t sigLen)
+{
+    uint32_t off;
+
+    if (msgLen != CRYPTO_SM3_DIGEST_LEN) {
+        return -1;
+    }
+    TcmBeginCmd(TCM_ST_NO_SESSIONS, TCM_CC_VerifySignature, &off);
+    write_be32(g_cmd + off, g_sm2Handle); off += 4;
+    if (TcmPutTpm2b(msg, msgLen, &off) != 0 || TcmPutRaw(sig, sigLen, &off) != 0) {
+        return -1;
+    }
+    return TcmExec(off) == TCM_RC_SUCCESS ? 0 : -1;
+}
+
+// 输出为编组后的 C1 || C2 || C3，解密时原样回填
+static int TcmSm2Encrypt(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t *outLen)
+{
+    uint32_t off;
+
+    TcmBeginCmd(TCM_ST_NO_SESSIONS, TCM_CC_ECC_Encrypt, &off);
+    write_be32(g_cmd + off, g_sm2Handle); off += 4;
+    if (inLen > TCM_MAX_BUFFER || TcmPutTpm2b(in, inLen, &off) != 0) {
+        return -1;
+    }
+    write_be16(g_cmd + off, TCM_ALG_KDF2); off += 2;
+    write_be16(g_cmd + off, TCM_ALG_SM3_256); off += 2;
+
+    if (TcmExec(off) != TCM_RC_SUCCESS) {
+        return -1;
+    }
+    uint32_t len = g_rspSize - TCM_HEADER_SIZE;
+    if (len > *outLen) {
+        return -1;
+    }
+    memcpy(out, g_rspPtr + TCM_HEADER_SIZE, len);
+    *outLen = len;
+    return 0;
+}
+
+static int TcmSm2Decrypt(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t *outLen)
+{
+    uint32_t off;
+
+    TcmBeginCmd(TCM_ST_SESSIONS, TCM_CC_ECC_Decrypt, &off);
+    write_be32(g_cmd + off, g_sm2Handle); off += 4;
+    TcmPutPasswordSession(&off);
+    if (inLen > TCM_MAX_BUFFER || TcmPutRaw(in, inLen, &off) != 0) {
+        return -1;
+    }
+    write_be16(g_cmd + off, TCM_ALG_KDF2); off += 2;
+    write_be16(g_cmd + off, TCM_ALG_SM3_256); off += 2;
+
+    if (TcmExec(off) != TCM_RC_SUCCESS) {
+        return -1;
+    }
+    // Header(10) + ParamSize(4) + TCM2B_MAX_BUFFER
+    uint16_t len = read_be16(g_rspPtr + TCM_HEADER_SIZE + 4);
+    if (len > *outLen) {
+        return -1;
+    }
+    memcpy(out, g_rspPtr + TCM_HEADER_SIZE + 6, len);
+    *outLen = len;
+    return 0;
+}
+
+static int TcmSm3(const uint8_t *data, uint32_t len, uint8_t digest[CRYPTO_SM3_DIGEST_LEN])
+{
+    uint32_t off;
+
+    // TCM2_Hash 一次最多 TCM_MAX_BUFFER 字节，更长的数据需要 HashSequence，这里不做
+    if (len > TCM_MAX_BUFFER) {
+        return -1;
+    }
+    TcmBeginCmd(TCM_ST_NO_SESSIONS, TCM_CC_Hash, &off);
+    if (TcmPutTpm2b(data, len, &off) != 0) {
+        return -1;
+    }
+    write_be16(g_cmd + off, TCM_ALG_SM3_256); off += 2;
+    write_be32(g_cmd + off, TCM_RH_OWNER); off += 4;
+
+    if (TcmExec(off) != TCM_RC_SUCCESS) {
+        return -1;
+    }
+    // Header(10) + Size(2) + Digest
+    memcpy(digest, g_rspPtr + TCM_HEADER_SIZE + 2, CRYPTO_SM3_DIGEST_LEN);
+    return 0;
+}
+
+// SM4 密钥由 TCM 派生并常驻，key 参数被忽略 (sm4InternalKey)，分派表不会选用此实现
+static int TcmSm4Encrypt(const uint8_t key[CRYPTO_SM4_KEY_LEN], const uint8_t iv[CRYPTO_SM4_BLOCK_LEN],
+                         const uint8_t *in, uint32_t len, uint8_t *out)
+{
+    uint32_t off;
+    (void)key;
+
+    if (len > TCM_MAX_BUFFER) {
+        return -1;
+    }
+    TcmBeginCmd(TCM_ST_SESSIONS, TCM_CC_EncryptDecrypt2, &off);
+    write_be32(g_cmd + off, g_sm4Handle); off += 4;
+    TcmPutPasswordSession(&off);
+    if (TcmPutTpm2b(in, len, &off) != 0) {
+        return -1;
+    }
+    g_cmd[off++] = 0x00;                                     // decrypt = NO
+    write_be16(g_cmd + off, TCM_ALG_CBC); off += 2;
+    if (TcmPutTpm2b(iv, CRYPTO_SM4_BLOCK_LEN, &off) != 0) {
+        return -1;
+    }
+
+    if (TcmExec(off) != TCM_RC_SUCCESS) {
+        return -1;
+    }
+    // Header(10) + ParamSize(4) + outData
+    uint16_t outLen = read_be16(g_rspPtr + TCM_HEADER_SIZE + 4);
+    if (outLen != len) {
+        return -1;
+    }
+    memcpy(out, g_rspPtr + TCM_HEADER_SIZE + 6, outLen);
+    return 0;
+}
+
+const CryptoBackend g_tcmBackend = {
+    .name       = "tcm",
+    .init       = TcmBackendInit,
+    .deinit     = TcmBackendDeinit,
+    .sm2Keygen  = TcmSm2Keygen,
+    .sm2Sign    = TcmSm2Sign,
+    .sm2Verify  = TcmSm2Verify,
+    .sm2Encrypt = TcmSm2Encrypt,
+    .sm2Decrypt = TcmSm2Decrypt,
+    .sm3        = TcmSm3,
+    .sm4Encrypt = TcmSm4Encrypt,
+    .sm4InternalKey = 1,
+    .sm2SignDigest  = 1,
+    .symMaxLen  = TCM_MAX_BUFFER,
+};
@@ -0,0 +1,72 @@
+#ifndef APP_CRYPTO_BACKEND_H
+#define APP_CRYPTO_BACKEND_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRYPTO_SM3_DIGEST_LEN    32
+#define CRYPTO_SM4_KEY_LEN       16
+#define CRYPTO_SM4_BLOCK_LEN     16
+#define CRYPTO_SM2_SIG_MAX       160
+#define CRYPTO_SM2_CIPHER_MAX    256
+#define CRYPTO_BN_BYTES          32
+#define CRYPTO_SM2_POINT_LEN     64
+
+/*
+ * 统一的密码后端接口
+ * 所有函数返回 0 表示成功；某个后端不支持的操作置为 NULL，测试时记为 skip
+ * SM2 操作使用后端内部常驻的密钥 (sm2Keygen 生成或 init 时生成)
+ */
+typedef struct {
+    const char *name;
+    int (*init)(void);
+    void (*deinit)(void);
+
+    int (*sm2Keygen)(void);
+    int (*sm2Sign)(const uint8_t *msg, uint32_t msgLen, uint8_t *sig, uint32_t *sigLen);
+    int (*sm2Verify)(const uint8_t *msg, uint32_t msgLen, const uint8_t *sig, uint32_t sigLen);
+    int (*sm2Encrypt)(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t *outLen);
+    int (*sm2Decrypt)(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t *outLen);
+
+    int (*sm3)(const uint8_t *data, uint32_t len, uint8_t digest[CRYPTO_SM3_DIGEST_LEN]);
+    // SM4-CBC 无填充，len 必须为分组长度的整数倍
+    int (*sm4Encrypt)(const uint8_t key[CRYPTO_SM4_KEY_LEN], const uint8_t iv[CRYPTO_SM4_BLOCK_LEN],
+                      const uint8_t *in, uint32_t len, uint8_t *out);
+    // 非 0 表示 sm4Encrypt 忽略 key 参数，用后端内部常驻的密钥；结果不能与带密钥的实现互换
+    int sm4InternalKey;
+    // 非 0 表示 sm2Sign / sm2Verify 把 msg 直接当作摘要，不做 ZA 与 SM3；结果不能与先摘要的实现比较
+    int sm2SignDigest;
+    // 非 0 表示 sm3 / sm4Encrypt 单次输入的字节上限，超出时返回 -1；分派表只选用不限长的实现
+    uint32_t symMaxLen;
+
+    /* 底层原语，供 crypto_dispatch 按原语挑选实现 */
+    // r = a * b mod m，操作数均为 CRYPTO_BN_BYTES 字节大端
+    int (*bnModMul)(uint8_t r[CRYPTO_BN_BYTES], const uint8_t a[CRYPTO_BN_BYTES],
+                    const uint8_t b[CRYPTO_BN_BYTES], const uint8_t m[CRYPTO_BN_BYTES]);
+    // SM2 曲线标量乘 R = k * P，点为 x || y 各 32 字节大端
+    int (*sm2PointMul)(uint8_t r[CRYPTO_SM2_POINT_LEN], const uint8_t k[CRYPTO_BN_BYTES],
+                       const uint8_t p[CRYPTO_SM2_POINT_LEN]);
+} CryptoBackend;
+
+#if defined(CRYPTO_BENCH_HITLS)
+extern const CryptoBackend g_hitlsBackend;
+#endif
+#if defined(CRYPTO_BENCH_OPENSSL)
+extern const CryptoBackend g_opensslBackend;
+#endif
+#if defined(CRYPTO_BENCH_TCM)
+// TCM2B_MAX_BUFFER，TCM 后端的 symMaxLen
+#define CRYPTO_TCM_MAX_BUFFER    1024
+extern const CryptoBackend g_tcmBackend;
+#endif
+#if defined(CRYPTO_BENCH_SM2MONT)
+extern const CryptoBackend g_sm2MontBackend;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,379 @@
+/*
+ * 跨库密码性能基准：OpenHiTLS / OpenSSL / TCM 命令接口
+ * 每个操作先预热，再按固定次数计时 (LOS_SysCycleGet 周期计数)，
+ * 结果以 JSON Lines 输出到串口并写入 /data/bench/crypto_bench.jsonl，
+ * 串口上另按 bench_result 的记录格式输出，case 为 "<后端>.<操作>"
+ * SM4 只测 CBC 加密方向；sm4InternalKey 的后端 (TCM) 不用调用方密钥，sm2SignDigest 的后端 (TCM)
+ * 签名 / 验签不做 ZA 与 SM3，这些结果标记为 "comparable":false，不参与最优后端比较
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+
+#include "crypto_backend.h"
+#include "crypto_vectors.h"
+#include "crypto_dispatch.h"
+#include "crypto_bench.h"
+#include "bench_result.h"
+
+#define TASK_STACK_SIZE          0x6000
+#define TASK_PRI                 25
+
+// 迭代配置
+#define CRYPTO_BENCH_WARMUP      2
+#define CRYPTO_BENCH_SM2_ITERS   10
+#define CRYPTO_BENCH_SYM_ITERS   100
+#define CRYPTO_BENCH_BN_ITERS    200
+#define CRYPTO_BENCH_SYM_BYTES   1024
+
+#define CRYPTO_BENCH_DIR         "/data/bench"
+#define CRYPTO_BENCH_FILE        CRYPTO_BENCH_DIR "/crypto_bench.jsonl"
+
+/* ================= 数据结构 ================= */
+typedef enum {
+    OP_SM2_KEYGEN = 0,
+    OP_SM2_SIGN,
+    OP_SM2_VERIFY,
+    OP_SM2_ENCRYPT,
+    OP_SM2_DECRYPT,
+    OP_BN_MODMUL,
+    OP_SM2_POINT_MUL,
+    OP_SM3,
+    OP_SM4_CBC_ENC,
+    OP_COUNT
+} CryptoOp;
+
+typedef struct {
+    uint32_t iterations;
+    uint32_t errors;
+    uint64_t minCycles;
+    uint64_t maxCycles;
+    uint64_t totalCycles;
+    BOOL skipped;
+} OpResult;
+
+static const char *g_opNames[OP_COUNT] = {
+    "sm2_keygen", "sm2_sign", "sm2_verify", "sm2_encrypt", "sm2_decrypt",
+    "bn_modmul", "sm2_point_mul", "sm3", "sm4_cbc_enc",
+};
+
+static const uint32_t g_opBytes[OP_COUNT] = {
+    0, CRYPTO_SM3_DIGEST_LEN, CRYPTO_SM3_DIGEST_LEN, CRYPTO_SM3_DIGEST_LEN, CRYPTO_SM3_DIGEST_LEN,
+    CRYPTO_BN_BYTES, CRYPTO_BN_BYTES, CRYPTO_BENCH_SYM_BYTES, CRYPTO_BENCH_SYM_BYTES,
+};
+
+static const uint32_t g_opIters[OP_COUNT] = {
+    CRYPTO_BENCH_SM2_ITERS, CRYPTO_BENCH_SM2_ITERS, CRYPTO_BENCH_SM2_ITERS, CRYPTO_BENCH_SM2_ITERS,
+    CRYPTO_BENCH_SM2_ITERS, CRYPTO_BENCH_BN_ITERS, CRYPTO_BENCH_SM2_ITERS, CRYPTO_BENCH_SYM_ITERS,
+    CRYPTO_BENCH_SYM_ITERS,
+};
+
+static const CryptoBackend *g_backends[] = {
+#if defined(CRYPTO_BENCH_HITLS)
+    &g_hitlsBackend,
+#endif
+#if defined(CRYPTO_BENCH_OPENSSL)
+    &g_opensslBackend,
+#endif
+#if defined(CRYPTO_BENCH_TCM)
+    &g_tcmBackend,
+#endif
+#if defined(CRYPTO_BENCH_SM2MONT)
+    &g_sm2MontBackend,
+#endif
+    NULL,
+};
+
+#define BACKEND_COUNT (sizeof(g_backends) / sizeof(g_backends[0]) - 1)
+
+/* ================= 全局变量 ================= */
+static OpResult g_results[BACKEND_COUNT + 1][OP_COUNT];
+
+// 各操作共用的输入 / 中间结果，避免在任务栈上放大缓冲区
+static uint8_t g_msg[CRYPTO_SM3_DIGEST_LEN];
+static uint8_t g_sig[CRYPTO_SM2_SIG_MAX];
+static uint32_t g_sigLen;
+static uint8_t g_cipher[CRYPTO_SM2_CIPHER_MAX];
+static uint32_t g_cipherLen;
+static uint8_t g_plain[CRYPTO_SM2_CIPHER_MAX];
+static uint8_t g_symIn[CRYPTO_BENCH_SYM_BYTES];
+static uint8_t g_symOut[CRYPTO_BENCH_SYM_BYTES];
+static uint8_t g_bnOut[CRYPTO_SM2_POINT_LEN];
+
+/* ================= 辅助函数 ================= */
+
+static BOOL OpSupported(const CryptoBackend *be, CryptoOp op)
+{
+    switch (op) {
+        case OP_SM2_KEYGEN:  return be->sm2Keygen != NULL;
+        case OP_SM2_SIGN:    return be->sm2Sign != NULL;
+        case OP_SM2_VERIFY:  return be->sm2Sign != NULL && be->sm2Verify != NULL;
+        case OP_SM2_ENCRYPT: return be->sm2Encrypt != NULL;
+        case OP_SM2_DECRYPT: return be->sm2Encrypt != NULL && be->sm2Decrypt != NULL;
+        case OP_BN_MODMUL:   return be->bnModMul != NULL;
+        case OP_SM2_POINT_MUL: return be->sm2PointMul != NULL;
+        case OP_SM3:         return be->sm3 != NULL;
+        case OP_SM4_CBC_ENC: return be->sm4Encrypt != NULL;
+        default:             return FALSE;
+    }
+}
+
+/**
+ * @brief 结果是否与其他后端同口径 (同样的输入与密钥)
+ */
+static BOOL OpComparable(const CryptoBackend *be, CryptoOp op)
+{
+    if (op == OP_SM4_CBC_ENC) {
+        return !be->sm4InternalKey;
+    }
+    if (op == OP_SM2_SIGN || op == OP_SM2_VERIFY) {
+        return !be->sm2SignDigest;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief 为依赖前置结果的操作准备输入 (验签需要签名，解密需要密文)
+ */
+static int PrepareOp(const CryptoBackend *be, CryptoOp op)
+{
+    if (op == OP_SM2_VERIFY) {
+        g_sigLen = sizeof(g_sig);
+        return be->sm2Sign(g_msg, sizeof(g_msg), g_sig, &g_sigLen);
+    }
+    if (op == OP_SM2_DECRYPT) {
+        g_cipherLen = sizeof(g_cipher);
+        return be->sm2Encrypt(g_msg, sizeof(g_msg), g_cipher, &g_cipherLen);
+    }
+    return 0;
+}
+
+static int RunOpOnce(const CryptoBackend *be, CryptoOp op)
+{
+    uint32_t len;
+    uint8_t digest[CRYPTO_SM3_DIGEST_LEN];
+
+    switch (op) {
+        case OP_SM2_KEYGEN:
+            return be->sm2Keygen();
+        case OP_SM2_SIGN:
+            len = sizeof(g_sig);
+            return be->sm2Sign(g_msg, sizeof(g_msg), g_sig, &len);
+        case OP_SM2_VERIFY:
+            return be->sm2Verify(g_msg, sizeof(g_msg), g_sig, g_sigLen);
+        case OP_SM2_ENCRYPT:
+            len = sizeof(g_plain);
+            return be->sm2Encrypt(g_msg, sizeof(g_msg), g_plain, &len);
+        case OP_SM2_DECRYPT:
+            len = sizeof(g_plain);
+            if (be->sm2Decrypt(g_cipher, g_cipherLen, g_plain, &len) != 0) {
+                return -1;
+            }
+            return (len == sizeof(g_msg) && memcmp(g_plain, g_msg, len) == 0) ? 0 : -1;
+        case OP_BN_MODMUL:
+            // g_msg 首字节为 0x01，小于模数
+            return be->bnModMul(g_bnOut, g_msg, g_msg, g_cryptoSm2P);
+        case OP_SM2_POINT_MUL:
+            return be->sm2PointMul(g_bnOut, g_msg, g_cryptoSm2G);
+        case OP_SM3:
+            return be->sm3(g_symIn, sizeof(g_symIn), digest);
+        case OP_SM4_CBC_ENC:
+            return be->sm4Encrypt(g_cryptoSm4Key, g_cryptoSm4Iv, g_symIn, sizeof(g_symIn), g_symOut);
+        default:
+            return -1;
+    }
+}
+
+static void RunOp(const CryptoBackend *be, CryptoOp op, OpResult *res)
+{
+    uint32_t iters = g_opIters[op];
+
+    memset(res, 0, sizeof(OpResult));
+    if (!OpSupported(be, op)) {
+        res->skipped = TRUE;
+        return;
+    }
+    if (PrepareOp(be, op) != 0) {
+        res->errors = iters;
+        return;
+    }
+
+    for (uint32_t i = 0; i < CRYPTO_BENCH_WARMUP; i++) {
+        (void)RunOpOnce(be, op);
+    }
+
+    res->minCycles = UINT64_MAX;
+    for (uint32_t i = 0; i < iters; i++) {
+        uint64_t start = LOS_SysCycleGet();
+        int ret = RunOpOnce(be, op);
+        uint64_t cost = LOS_SysCycleGet() - start;
+
+        if (ret != 0) {
+            res->errors++;
+            continue;
+        }
+        res->iterations++;
+        res->totalCycles += cost;
+        res->minCycles = (cost < res->minCycles) ? cost : res->minCycles;
+        res->maxCycles = (cost > res->maxCycles) ? cost : res->maxCycles;
+    }
+    if (res->iterations == 0) {
+        res->minCycles = 0;
+    }
+}
+
+static void EmitResult(FILE *fp, const CryptoBackend *be, CryptoOp op, const OpResult *res)
+{
+    char line[320];
+    uint64_t avg = res->iterations ? res->totalCycles / res->iterations : 0;
+    const char *status = res->skipped ? "skip" : (res->iterations == 0 ? "error" : "ok");
+
+    (void)snprintf(line, sizeof(line),
+        "{\"suite\":\"crypto\",\"backend\":\"%s\",\"op\":\"%s\",\"status\":\"%s\","
+        "\"bytes\":%u,\"warmup\":%u,\"iterations\":%u,\"errors\":%u,"
+        "\"min_cycles\":%llu,\"avg_cycles\":%llu,\"max_cycles\":%llu,\"avg_us\":%llu,"
+        "\"comparable\":%s}\n",
+        be->name, g_opNames[op], status, g_opBytes[op], CRYPTO_BENCH_WARMUP,
+        res->iterations, res->errors, res->minCycles, avg, res->maxCycles,
+        avg * 1000000ULL / OS_SYS_CLOCK, OpComparable(be, op) ? "true" : "false");
+
+    printf("%s", line);
+    if (fp != NULL) {
+        fputs(line, fp);
+    }
+    if (res->skipped) {
+        return;
+    }
+
+    (void)snprintf(line, sizeof(line), "%s.%s", be->name, g_opNames[op]);
+    BenchResult r = { "crypto", line, "errors", "errors", res->errors, res->iterations + res->errors };
+    BenchResultEmit(&r, NULL);
+    if (res->iterations == 0) {
+        return;
+    }
+    r.iterations = res->iterations;
+    r.metric = "cycles_avg";
+    r.unit = "cycles";
+    r.value = avg;
+    BenchResultEmit(&r, NULL);
+    r.metric = "cycles_min";
+    r.value = res->minCycles;
+    BenchResultEmit(&r, NULL);
+    r.metric = "time_avg";
+    r.unit = "us";
+    r.value = avg * 1000000ULL / OS_SYS_CLOCK;
+    BenchResultEmit(&r, NULL);
+}
+
+static void PrintBestBackends(void)
+{
+    printf("\n%-14s | %-8s | %12s\n", "Op", "Best", "AvgCycles");
+    printf("---------------|----------|-------------\n");
+    for (int op = 0; op < OP_COUNT; op++) {
+        const char *best = "-";
+        uint64_t bestAvg = UINT64_MAX;
+        for (uint32_t b = 0; b < BACKEND_COUNT; b++) {
+            const OpResult *res = &g_results[b][op];
+            if (res->skipped || res->iterations == 0 || res->errors != 0 ||
+                !OpComparable(g_backends[b], (CryptoOp)op)) {
+                continue;
+            }
+            uint64_t avg = res->totalCycles / res->iterations;
+            if (avg < bestAvg) {
+                bestAvg = avg;
+                best = g_backends[b]->name;
+            }
+        }
+        printf("%-14s | %-8s | %12llu\n", g_opNames[op], best, bestAvg == UINT64_MAX ? 0 : bestAvg);
+    }
+    printf("note: sm4_cbc_enc measures encryption only, decryption is not benchmarked\n");
+    for (uint32_t b = 0; b < BACKEND_COUNT; b++) {
+        if (g_backends[b]->sm4Encrypt != NULL && g_backends[b]->sm4InternalKey) {
+            printf("note: %s sm4_cbc_enc uses its internal key, excluded from Best\n", g_backends[b]->name);
+        }
+        if (g_backends[b]->sm2Sign != NULL && g_backends[b]->sm2SignDigest) {
+            printf("note: %s sm2_sign / sm2_verify skip ZA and SM3, excluded from Best\n", g_backends[b]->name);
+        }
+    }
+}
+
+/* ================= 任务入口 ================= */
+
+static void CryptoBenchTask(void)
+{
+    FILE *fp;
+
+    printf("\n=== Crypto Backend Benchmark (%u backends) ===\n", (unsigned)BACKEND_COUNT);
+
+    for (uint32_t i = 0; i < sizeof(g_msg); i++) {
+        g_msg[i] = (uint8_t)(i * 7 + 1);
+    }
+    for (uint32_t i = 0; i < sizeof(g_symIn); i++) {
+        g_symIn[i] = (uint8_t)i;
+    }
+
+    if (access(CRYPTO_BENCH_DIR, F_OK) != 0) {
+        (void)mkdir(CRYPTO_BENCH_DIR, 0755);
+    }
+    fp = fopen(CRYPTO_BENCH_FILE, "w");
+    if (fp == NULL) {
+        printf("warning: cannot open %s, results go to serial only\n", CRYPTO_BENCH_FILE);
+    }
+
+    for (uint32_t b = 0; b < BACKEND_COUNT; b++) {
+        const CryptoBackend *be = g_backends[b];
+        if (be->init != NULL && be->init() != 0) {
+            printf("[%s] init failed, skipped\n", be->name);
+            for (int op = 0; op < OP_COUNT; op++) {
+                g_results[b][op].skipped = TRUE;
+                EmitResult(fp, be, (CryptoOp)op, &g_results[b][op]);
+            }
+            continue;
+        }
+        for (int op = 0; op < OP_COUNT; op++) {
+            RunOp(be, (CryptoOp)op, &g_results[b][op]);
+            EmitResult(fp, be, (CryptoOp)op, &g_results[b][op]);
+        }
+        if (be->deinit != NULL) {
+            be->deinit();
+        }
+    }
+
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    PrintBestBackends();
+
+    // 基准各后端已 deinit，分派表重新初始化后端并常驻
+    if (CryptoDispatchInit(0) == 0) {
+        CryptoDispatchDump();
+    } else {
+        printf("[dispatch] no usable backend\n");
+    }
+    printf("=== Crypto Backend Benchmark Finished ===\n");
+}
+
+void CryptoBenchApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)CryptoBenchTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "CryptoBenchTask";
+    task.usTaskPrio   = TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("CryptoBenchTask create failed: 0x%X\n", ret);
+    }
+}
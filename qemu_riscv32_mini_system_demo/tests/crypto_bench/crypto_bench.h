@@ -0,0 +1,13 @@
+#ifndef APP_CRYPTO_BENCH_H
+#define APP_CRYPTO_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void CryptoBenchApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
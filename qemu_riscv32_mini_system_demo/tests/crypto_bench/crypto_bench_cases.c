@@ -0,0 +1,152 @@
+/*
+ * crypto / tcm 套件的注册表用例
+ * crypto.* 走 crypto_dispatch 选中的实现，衡量的是"当前镜像里最快的那条路径"；
+ * tcm.* 直接调用 TCM 后端，命令经 _plat__RunCommand 在本地执行，对应 tcm_test 中的签名 / 验签 / 摘要路径；
+ * TCM2_Hash 单条命令最多 CRYPTO_TCM_MAX_BUFFER 字节，tcm.sm3_1k 只取输入的前 1KB。
+ * 后端初始化在首个用例的 setup 中做一次，此后常驻。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "los_task.h"
+
+#include "crypto_backend.h"
+#include "crypto_dispatch.h"
+#include "crypto_vectors.h"
+#include "bench_registry.h"
+
+#define CASE_SYM_BYTES           4096
+
+/* ================= 全局变量 ================= */
+static BOOL g_ready = FALSE;
+static uint8_t g_msg[CRYPTO_SM3_DIGEST_LEN];
+static uint8_t g_symIn[CASE_SYM_BYTES];
+static uint8_t g_symOut[CASE_SYM_BYTES];
+static uint8_t g_point[CRYPTO_SM2_POINT_LEN];
+
+static UINT32 CryptoSetup(VOID)
+{
+    if (g_ready) {
+        return LOS_OK;
+    }
+    for (uint32_t i = 0; i < sizeof(g_msg); i++) {
+        g_msg[i] = (uint8_t)(i + 1);
+    }
+    for (uint32_t i = 0; i < sizeof(g_symIn); i++) {
+        g_symIn[i] = (uint8_t)i;
+    }
+    if (CryptoDispatchInit(0) != 0) {
+        return LOS_NOK;
+    }
+    g_ready = TRUE;
+    return LOS_OK;
+}
+
+/* ================= crypto 套件 ================= */
+
+static UINT32 Sm3Run(UINT32 iter, BenchMetrics *metrics)
+{
+    uint8_t digest[CRYPTO_SM3_DIGEST_LEN];
+    const CryptoDispatchTable *t = CryptoDispatchGet();
+
+    (void)iter;
+    BenchMetricSet(metrics, "bytes", sizeof(g_symIn));
+    return (t->sm3(g_symIn, sizeof(g_symIn), digest) == 0) ? LOS_OK : LOS_NOK;
+}
+
+static UINT32 Sm4Run(UINT32 iter, BenchMetrics *metrics)
+{
+    const CryptoDispatchTable *t = CryptoDispatchGet();
+
+    (void)iter;
+    BenchMetricSet(metrics, "bytes", sizeof(g_symIn));
+    return (t->sm4Encrypt(g_cryptoSm4Key, g_cryptoSm4Iv, g_symIn, sizeof(g_symIn), g_symOut) == 0) ? LOS_OK : LOS_NOK;
+}
+
+static UINT32 PointMulRun(UINT32 iter, BenchMetrics *metrics)
+{
+    const CryptoDispatchTable *t = CryptoDispatchGet();
+
+    (void)iter;
+    (void)metrics;
+    return (t->sm2PointMul(g_point, g_msg, g_cryptoSm2G) == 0) ? LOS_OK : LOS_NOK;
+}
+
+static const BenchCase g_cryptoSm3 = {
+    .name = "crypto.sm3_4k", .suite = "crypto", .desc = "SM3 over 4KB, dispatched",
+    .iterations = 20, .setup = CryptoSetup, .run = Sm3Run,
+};
+BENCH_REGISTER(g_cryptoSm3);
+
+static const BenchCase g_cryptoSm4 = {
+    .name = "crypto.sm4_cbc_4k", .suite = "crypto", .desc = "SM4-CBC encrypt 4KB, dispatched",
+    .iterations = 20, .setup = CryptoSetup, .run = Sm4Run,
+};
+BENCH_REGISTER(g_cryptoSm4);
+
+static const BenchCase g_cryptoPointMul = {
+    .name = "crypto.sm2_point_mul", .suite = "crypto", .desc = "SM2 k*G, dispatched",
+    .iterations = 5, .setup = CryptoSetup, .run = PointMulRun,
+};
+BENCH_REGISTER(g_cryptoPointMul);
+
+/* ================= tcm 套件 ================= */
+
+#if defined(CRYPTO_BENCH_TCM)
+static uint8_t g_sig[CRYPTO_SM2_SIG_MAX];
+static uint32_t g_sigLen;
+
+static UINT32 TcmVerifySetup(VOID)
+{
+    if (CryptoSetup() != LOS_OK) {
+        return LOS_NOK;
+    }
+    g_sigLen = sizeof(g_sig);
+    return (g_tcmBackend.sm2Sign(g_msg, sizeof(g_msg), g_sig, &g_sigLen) == 0) ? LOS_OK : LOS_NOK;
+}
+
+static UINT32 TcmSm3Run(UINT32 iter, BenchMetrics *metrics)
+{
+    uint8_t digest[CRYPTO_SM3_DIGEST_LEN];
+
+    (void)iter;
+    BenchMetricSet(metrics, "bytes", CRYPTO_TCM_MAX_BUFFER);
+    return (g_tcmBackend.sm3(g_symIn, CRYPTO_TCM_MAX_BUFFER, digest) == 0) ? LOS_OK : LOS_NOK;
+}
+
+static UINT32 TcmSignRun(UINT32 iter, BenchMetrics *metrics)
+{
+    uint8_t sig[CRYPTO_SM2_SIG_MAX];
+    uint32_t len = sizeof(sig);
+
+    (void)iter;
+    (void)metrics;
+    return (g_tcmBackend.sm2Sign(g_msg, sizeof(g_msg), sig, &len) == 0) ? LOS_OK : LOS_NOK;
+}
+
+static UINT32 TcmVerifyRun(UINT32 iter, BenchMetrics *metrics)
+{
+    (void)iter;
+    (void)metrics;
+    return (g_tcmBackend.sm2Verify(g_msg, sizeof(g_msg), g_sig, g_sigLen) == 0) ? LOS_OK : LOS_NOK;
+}
+
+static const BenchCase g_tcmSm3 = {
+    .name = "tcm.sm3_1k", .suite = "tcm", .desc = "TCM SM3 over 1KB",
+    .iterations = 10, .setup = CryptoSetup, .run = TcmSm3Run,
+};
+BENCH_REGISTER(g_tcmSm3);
+
+static const BenchCase g_tcmSign = {
+    .name = "tcm.sm2_sign", .suite = "tcm", .desc = "TCM SM2 sign 32B",
+    .iterations = 5, .setup = CryptoSetup, .run = TcmSignRun,
+};
+BENCH_REGISTER(g_tcmSign);
+
+static const BenchCase g_tcmVerify = {
+    .name = "tcm.sm2_verify", .suite = "tcm", .desc = "TCM SM2 verify 32B",
+    .iterations = 5, .setup = TcmVerifySetup, .run = TcmVerifyRun,
+};
+BENCH_REGISTER(g_tcmVerify);
+#endif
@@ -0,0 +1,376 @@
+/*
+ * 按原语的密码后端分派表
+ * 启动时对每个原语 (模乘 / SM2 点乘 / SM3 / SM4) 在所有可用后端上做一次短微基准，
+ * 通过已知答案向量校验的实现中取最快的填入分派表，并连同核标识缓存到 /data，下次启动直接加载。
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+
+#include "crypto_dispatch.h"
+#include "crypto_vectors.h"
+
+// 每个原语的测速次数，点乘较慢单独配置
+#define DISPATCH_TUNE_ITERS      16
+#define DISPATCH_TUNE_PT_ITERS   3
+#define DISPATCH_TUNE_SYM_BYTES  256
+#define DISPATCH_LINE_MAX        96
+#define DISPATCH_CORE_ID_MAX     64
+
+/* ================= 数据结构 ================= */
+static const CryptoBackend *g_candidates[] = {
+#if defined(CRYPTO_BENCH_HITLS)
+    &g_hitlsBackend,
+#endif
+#if defined(CRYPTO_BENCH_OPENSSL)
+    &g_opensslBackend,
+#endif
+#if defined(CRYPTO_BENCH_TCM)
+    &g_tcmBackend,
+#endif
+#if defined(CRYPTO_BENCH_SM2MONT)
+    &g_sm2MontBackend,
+#endif
+    NULL,
+};
+
+#define CANDIDATE_COUNT (sizeof(g_candidates) / sizeof(g_candidates[0]) - 1)
+
+static const char *g_primNames[CRYPTO_PRIM_COUNT] = {
+    "bn_modmul", "sm2_point_mul", "sm3", "sm4_cbc",
+};
+
+/* ================= 全局变量 ================= */
+static BOOL g_ready[CANDIDATE_COUNT + 1];
+static const CryptoBackend *g_owner[CRYPTO_PRIM_COUNT];
+static uint64_t g_ownerCycles[CRYPTO_PRIM_COUNT];
+static BOOL g_fromCache = FALSE;
+
+static int StubModMul(uint8_t r[CRYPTO_BN_BYTES], const uint8_t a[CRYPTO_BN_BYTES],
+                      const uint8_t b[CRYPTO_BN_BYTES], const uint8_t m[CRYPTO_BN_BYTES])
+{
+    (void)r; (void)a; (void)b; (void)m;
+    return -1;
+}
+
+static int StubPointMul(uint8_t r[CRYPTO_SM2_POINT_LEN], const uint8_t k[CRYPTO_BN_BYTES],
+                        const uint8_t p[CRYPTO_SM2_POINT_LEN])
+{
+    (void)r; (void)k; (void)p;
+    return -1;
+}
+
+static int StubSm3(const uint8_t *data, uint32_t len, uint8_t digest[CRYPTO_SM3_DIGEST_LEN])
+{
+    (void)data; (void)len; (void)digest;
+    return -1;
+}
+
+static int StubSm4(const uint8_t key[CRYPTO_SM4_KEY_LEN], const uint8_t iv[CRYPTO_SM4_BLOCK_LEN],
+                   const uint8_t *in, uint32_t len, uint8_t *out)
+{
+    (void)key; (void)iv; (void)in; (void)len; (void)out;
+    return -1;
+}
+
+static CryptoDispatchTable g_table = {
+    .bnModMul    = StubModMul,
+    .sm2PointMul = StubPointMul,
+    .sm3         = StubSm3,
+    .sm4Encrypt  = StubSm4,
+};
+
+static uint8_t g_opA[CRYPTO_BN_BYTES];
+static uint8_t g_opB[CRYPTO_BN_BYTES];
+static uint8_t g_symIn[DISPATCH_TUNE_SYM_BYTES];
+static uint8_t g_tryOut[DISPATCH_TUNE_SYM_BYTES];
+
+/* ================= 辅助函数 ================= */
+
+static BOOL PrimSupported(const CryptoBackend *be, CryptoPrimitive prim)
+{
+    switch (prim) {
+        case CRYPTO_PRIM_BN_MODMUL:     return be->bnModMul != NULL;
+        case CRYPTO_PRIM_SM2_POINT_MUL: return be->sm2PointMul != NULL;
+        // 有输入长度上限的实现 (如 TCM) 不能替代通用的 SM3 / SM4
+        case CRYPTO_PRIM_SM3:           return be->sm3 != NULL && be->symMaxLen == 0;
+        // 忽略 key 的实现 (如 TCM) 不能替代带密钥的 SM4-CBC
+        case CRYPTO_PRIM_SM4_CBC:       return be->sm4Encrypt != NULL && !be->sm4InternalKey && be->symMaxLen == 0;
+        default:                        return FALSE;
+    }
+}
+
+/**
+ * @brief 用已知答案向量校验实现，返回 TRUE 表示输出与标准值一致
+ */
+static BOOL KatCheck(const CryptoBackend *be, CryptoPrimitive prim, uint8_t *out)
+{
+    switch (prim) {
+        case CRYPTO_PRIM_BN_MODMUL:
+            return be->bnModMul(out, g_cryptoSm2G, g_cryptoSm2G + CRYPTO_BN_BYTES, g_cryptoSm2P) == 0 &&
+                   memcmp(out, g_katModMulR, CRYPTO_BN_BYTES) == 0;
+        case CRYPTO_PRIM_SM2_POINT_MUL:
+            return be->sm2PointMul(out, g_katPointK, g_cryptoSm2G) == 0 &&
+                   memcmp(out, g_katPointR, CRYPTO_SM2_POINT_LEN) == 0;
+        case CRYPTO_PRIM_SM3:
+            return be->sm3(g_katSm3Msg, sizeof(g_katSm3Msg), out) == 0 &&
+                   memcmp(out, g_katSm3Digest, CRYPTO_SM3_DIGEST_LEN) == 0;
+        case CRYPTO_PRIM_SM4_CBC:
+            return be->sm4Encrypt(g_cryptoSm4Key, g_cryptoSm4Iv, g_cryptoSm4Key, CRYPTO_KAT_SM4_LEN, out) == 0 &&
+                   memcmp(out, g_katSm4Cipher, CRYPTO_KAT_SM4_LEN) == 0;
+        default:
+            return FALSE;
+    }
+}
+
+/**
+ * @brief 执行一次原语，输出写入 out，返回输出长度；失败返回 0
+ */
+static uint32_t RunPrimOnce(const CryptoBackend *be, CryptoPrimitive prim, uint8_t *out)
+{
+    switch (prim) {
+        case CRYPTO_PRIM_BN_MODMUL:
+            return be->bnModMul(out, g_opA, g_opB, g_cryptoSm2P) == 0 ? CRYPTO_BN_BYTES : 0;
+        case CRYPTO_PRIM_SM2_POINT_MUL:
+            return be->sm2PointMul(out, g_opA, g_cryptoSm2G) == 0 ? CRYPTO_SM2_POINT_LEN : 0;
+        case CRYPTO_PRIM_SM3:
+            return be->sm3(g_symIn, sizeof(g_symIn), out) == 0 ? CRYPTO_SM3_DIGEST_LEN : 0;
+        case CRYPTO_PRIM_SM4_CBC:
+            return be->sm4Encrypt(g_cryptoSm4Key, g_cryptoSm4Iv, g_symIn, sizeof(g_symIn), out) == 0 ?
+                   sizeof(g_symIn) : 0;
+        default:
+            return 0;
+    }
+}
+
+static void InstallOwner(CryptoPrimitive prim, const CryptoBackend *be)
+{
+    g_owner[prim] = be;
+    switch (prim) {
+        case CRYPTO_PRIM_BN_MODMUL:     g_table.bnModMul = be->bnModMul; break;
+        case CRYPTO_PRIM_SM2_POINT_MUL: g_table.sm2PointMul = be->sm2PointMul; break;
+        case CRYPTO_PRIM_SM3:           g_table.sm3 = be->sm3; break;
+        case CRYPTO_PRIM_SM4_CBC:       g_table.sm4Encrypt = be->sm4Encrypt; break;
+        default:                        break;
+    }
+}
+
+/**
+ * @brief 当前核的标识：misa / mvendorid / marchid / mimpid 与系统时钟
+ * 换核或改主频后缓存失效，重新测速
+ */
+static void GetCoreId(char *buf, uint32_t size)
+{
+    uint32_t misa, vendor, arch, impl;
+
+    __asm__ volatile("csrr %0, misa" : "=r"(misa));
+    __asm__ volatile("csrr %0, mvendorid" : "=r"(vendor));
+    __asm__ volatile("csrr %0, marchid" : "=r"(arch));
+    __asm__ volatile("csrr %0, mimpid" : "=r"(impl));
+    (void)snprintf(buf, size, "%08x:%08x:%08x:%08x:%u", misa, vendor, arch, impl, (unsigned)OS_SYS_CLOCK);
+}
+
+static const CryptoBackend *FindReadyBackend(const char *name)
+{
+    for (uint32_t i = 0; i < CANDIDATE_COUNT; i++) {
+        if (g_ready[i] && strcmp(g_candidates[i]->name, name) == 0) {
+            return g_candidates[i];
+        }
+    }
+    return NULL;
+}
+
+/* ================= 缓存读写 ================= */
+
+static int LoadCache(void)
+{
+    char line[DISPATCH_LINE_MAX];
+    char coreId[DISPATCH_CORE_ID_MAX];
+    const CryptoBackend *chosen[CRYPTO_PRIM_COUNT] = { 0 };
+    BOOL coreMatch = FALSE;
+    FILE *fp = fopen(CRYPTO_DISPATCH_CACHE, "r");
+
+    if (fp == NULL) {
+        return -1;
+    }
+    GetCoreId(coreId, sizeof(coreId));
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char *eq = strchr(line, '=');
+        if (line[0] == '#' || eq == NULL) {
+            continue;
+        }
+        *eq = '\0';
+        char *value = eq + 1;
+        value[strcspn(value, "\r\n")] = '\0';
+
+        if (strcmp(line, "core") == 0) {
+            coreMatch = (strcmp(value, coreId) == 0);
+            continue;
+        }
+        for (int p = 0; p < CRYPTO_PRIM_COUNT; p++) {
+            if (strcmp(line, g_primNames[p]) == 0) {
+                chosen[p] = FindReadyBackend(value);
+            }
+        }
+    }
+    fclose(fp);
+
+    if (!coreMatch) {
+        printf("[dispatch] cache core mismatch, retune\n");
+        return -1;
+    }
+    for (int p = 0; p < CRYPTO_PRIM_COUNT; p++) {
+        // 缓存中的后端本次未编译进来 / 初始化失败 / 不支持该原语，整体重测
+        if (chosen[p] == NULL || !PrimSupported(chosen[p], (CryptoPrimitive)p)) {
+            printf("[dispatch] cache entry %s unusable, retune\n", g_primNames[p]);
+            return -1;
+        }
+    }
+    for (int p = 0; p < CRYPTO_PRIM_COUNT; p++) {
+        InstallOwner((CryptoPrimitive)p, chosen[p]);
+        g_ownerCycles[p] = 0;
+    }
+    return 0;
+}
+
+static void SaveCache(void)
+{
+    char coreId[DISPATCH_CORE_ID_MAX];
+    FILE *fp = fopen(CRYPTO_DISPATCH_CACHE, "w");
+
+    if (fp == NULL) {
+        printf("[dispatch] warning: cannot write %s\n", CRYPTO_DISPATCH_CACHE);
+        return;
+    }
+    GetCoreId(coreId, sizeof(coreId));
+    fprintf(fp, "# crypto dispatch cache, delete to retune\n");
+    fprintf(fp, "core=%s\n", coreId);
+    for (int p = 0; p < CRYPTO_PRIM_COUNT; p++) {
+        if (g_owner[p] != NULL) {
+            fprintf(fp, "%s=%s\n", g_primNames[p], g_owner[p]->name);
+        }
+    }
+    fclose(fp);
+}
+
+/* ================= 启动测速 ================= */
+
+/**
+ * @brief 对单个原语测速
+ * 每个实现先过已知答案向量，不符的直接淘汰，不以"第一个能跑通的后端"作参考；
+ * 取每个实现的最小周期数比较，减少中断与调度带来的抖动
+ */
+static void TunePrimitive(CryptoPrimitive prim)
+{
+    uint32_t iters = (prim == CRYPTO_PRIM_SM2_POINT_MUL) ? DISPATCH_TUNE_PT_ITERS : DISPATCH_TUNE_ITERS;
+    const CryptoBackend *best = NULL;
+    uint64_t bestCycles = UINT64_MAX;
+
+    for (uint32_t i = 0; i < CANDIDATE_COUNT; i++) {
+        const CryptoBackend *be = g_candidates[i];
+        uint64_t minCycles = UINT64_MAX;
+
+        if (!g_ready[i] || !PrimSupported(be, prim)) {
+            continue;
+        }
+        if (!KatCheck(be, prim, g_tryOut)) {
+            printf("[dispatch] %s/%s known-answer test failed, rejected\n", be->name, g_primNames[prim]);
+            continue;
+        }
+        // 预热一次
+        if (RunPrimOnce(be, prim, g_tryOut) == 0) {
+            printf("[dispatch] %s/%s failed, skipped\n", be->name, g_primNames[prim]);
+            continue;
+        }
+
+        for (uint32_t n = 0; n < iters; n++) {
+            uint64_t start = LOS_SysCycleGet();
+            uint32_t ret = RunPrimOnce(be, prim, g_tryOut);
+            uint64_t cost = LOS_SysCycleGet() - start;
+            if (ret != 0 && cost < minCycles) {
+                minCycles = cost;
+            }
+        }
+        if (minCycles < bestCycles) {
+            bestCycles = minCycles;
+            best = be;
+        }
+    }
+
+    if (best != NULL) {
+        InstallOwner(prim, best);
+        g_ownerCycles[prim] = bestCycles;
+    }
+}
+
+/* ================= 对外接口 ================= */
+
+int CryptoDispatchInit(int forceTune)
+{
+    uint32_t readyCount = 0;
+
+    for (uint32_t i = 0; i < sizeof(g_opA); i++) {
+        g_opA[i] = (uint8_t)(0xA5 ^ (i * 29));
+        g_opB[i] = (uint8_t)(0x3C + i * 17);
+    }
+    // 操作数最高字节清零，保证小于模数
+    g_opA[0] = 0;
+    g_opB[0] = 0;
+    for (uint32_t i = 0; i < sizeof(g_symIn); i++) {
+        g_symIn[i] = (uint8_t)i;
+    }
+
+    for (uint32_t i = 0; i < CANDIDATE_COUNT; i++) {
+        const CryptoBackend *be = g_candidates[i];
+        g_ready[i] = (be->init == NULL || be->init() == 0);
+        readyCount += g_ready[i] ? 1 : 0;
+        if (!g_ready[i]) {
+            printf("[dispatch] backend %s init failed\n", be->name);
+        }
+    }
+    if (readyCount == 0) {
+        return -1;
+    }
+
+    g_fromCache = FALSE;
+    if (!forceTune && LoadCache() == 0) {
+        g_fromCache = TRUE;
+        return 0;
+    }
+
+    for (int p = 0; p < CRYPTO_PRIM_COUNT; p++) {
+        TunePrimitive((CryptoPrimitive)p);
+    }
+    SaveCache();
+    return 0;
+}
+
+const CryptoDispatchTable *CryptoDispatchGet(void)
+{
+    return &g_table;
+}
+
+const char *CryptoDispatchOwner(CryptoPrimitive prim)
+{
+    if (prim >= CRYPTO_PRIM_COUNT || g_owner[prim] == NULL) {
+        return "-";
+    }
+    return g_owner[prim]->name;
+}
+
+void CryptoDispatchDump(void)
+{
+    printf("\n[dispatch] table (%s)\n", g_fromCache ? "cached" : "tuned");
+    printf("%-14s | %-8s | %12s\n", "Primitive", "Backend", "MinCycles");
+    printf("---------------|----------|-------------\n");
+    for (int p = 0; p < CRYPTO_PRIM_COUNT; p++) {
+        printf("%-14s | %-8s | %12llu\n", g_primNames[p], CryptoDispatchOwner((CryptoPrimitive)p),
+               g_ownerCycles[p]);
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef APP_CRYPTO_DISPATCH_H
+#define APP_CRYPTO_DISPATCH_H
+
+#include <stdint.h>
+#include "crypto_backend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRYPTO_DISPATCH_CACHE    "/data/crypto_dispatch.cfg"
+
+typedef enum {
+    CRYPTO_PRIM_BN_MODMUL = 0,
+    CRYPTO_PRIM_SM2_POINT_MUL,
+    CRYPTO_PRIM_SM3,
+    CRYPTO_PRIM_SM4_CBC,
+    CRYPTO_PRIM_COUNT
+} CryptoPrimitive;
+
+/*
+ * 按原语分派的函数表
+ * 每个原语独立选择实现，可以来自不同后端；未初始化或无可用实现时返回 -1
+ * bnModMul 以 SM2 素数为模测速，各实现对任意非零模数都须给出正确结果
+ */
+typedef struct {
+    int (*bnModMul)(uint8_t r[CRYPTO_BN_BYTES], const uint8_t a[CRYPTO_BN_BYTES],
+                    const uint8_t b[CRYPTO_BN_BYTES], const uint8_t m[CRYPTO_BN_BYTES]);
+    int (*sm2PointMul)(uint8_t r[CRYPTO_SM2_POINT_LEN], const uint8_t k[CRYPTO_BN_BYTES],
+                       const uint8_t p[CRYPTO_SM2_POINT_LEN]);
+    int (*sm3)(const uint8_t *data, uint32_t len, uint8_t digest[CRYPTO_SM3_DIGEST_LEN]);
+    int (*sm4Encrypt)(const uint8_t key[CRYPTO_SM4_KEY_LEN], const uint8_t iv[CRYPTO_SM4_BLOCK_LEN],
+                      const uint8_t *in, uint32_t len, uint8_t *out);
+} CryptoDispatchTable;
+
+/**
+ * @brief 初始化分派表
+ * @param forceTune 非 0 时忽略 /data 上的缓存，重新做启动微基准
+ * @return 0 成功；-1 没有任何可用后端
+ *
+ * 先初始化所有编译进来的后端 (此后常驻，不再 deinit)，
+ * 缓存的核标识与当前一致且所选后端都可用时直接采用缓存，否则逐原语测速并回写缓存。
+ */
+int CryptoDispatchInit(int forceTune);
+
+const CryptoDispatchTable *CryptoDispatchGet(void);
+
+/**
+ * @brief 某个原语当前选中的后端名，未选中返回 "-"
+ */
+const char *CryptoDispatchOwner(CryptoPrimitive prim);
+
+void CryptoDispatchDump(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,53 @@
+/*
+ * 共用的曲线参数、测速密钥与已知答案向量
+ */
+
+#include "crypto_vectors.h"
+
+const uint8_t g_cryptoSm2P[CRYPTO_BN_BYTES] = {
+    0xFF, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+const uint8_t g_cryptoSm2G[CRYPTO_SM2_POINT_LEN] = {
+    0x32, 0xC4, 0xAE, 0x2C, 0x1F, 0x19, 0x81, 0x19, 0x5F, 0x99, 0x04, 0x46, 0x6A, 0x39, 0xC9, 0x94,
+    0x8F, 0xE3, 0x0B, 0xBF, 0xF2, 0x66, 0x0B, 0xE1, 0x71, 0x5A, 0x45, 0x89, 0x33, 0x4C, 0x74, 0xC7,
+    0xBC, 0x37, 0x36, 0xA2, 0xF4, 0xF6, 0x77, 0x9C, 0x59, 0xBD, 0xCE, 0xE3, 0x6B, 0x69, 0x21, 0x53,
+    0xD0, 0xA9, 0x87, 0x7C, 0xC6, 0x2A, 0x47, 0x40, 0x02, 0xDF, 0x32, 0xE5, 0x21, 0x39, 0xF0, 0xA0,
+};
+
+const uint8_t g_cryptoSm4Key[CRYPTO_SM4_KEY_LEN] = {
+    0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0xFE, 0xDC, 0xBA, 0x98, 0x76, 0x54, 0x32, 0x10
+};
+
+const uint8_t g_cryptoSm4Iv[CRYPTO_SM4_BLOCK_LEN] = { 0 };
+
+/* ================= 已知答案向量 ================= */
+
+const uint8_t g_katModMulR[CRYPTO_BN_BYTES] = {
+    0xED, 0xD7, 0xE7, 0x45, 0xBD, 0xC4, 0x63, 0x0C, 0xCF, 0xA1, 0xDA, 0x10, 0x57, 0x03, 0x3A, 0x52,
+    0x53, 0x46, 0xDB, 0xF2, 0x02, 0xF0, 0x82, 0xF3, 0xC4, 0x31, 0x34, 0x99, 0x91, 0xAC, 0xE7, 0x6A,
+};
+
+const uint8_t g_katPointK[CRYPTO_BN_BYTES] = {
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10,
+    0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20,
+};
+
+const uint8_t g_katPointR[CRYPTO_SM2_POINT_LEN] = {
+    0x46, 0xD1, 0x08, 0x6F, 0x6E, 0x5C, 0x93, 0x84, 0x47, 0xF0, 0x52, 0x80, 0xDB, 0x70, 0x7C, 0x27,
+    0x9A, 0x7B, 0x45, 0x9C, 0x38, 0xF1, 0x9E, 0x4D, 0x9A, 0x30, 0xAD, 0x2D, 0xAD, 0xF9, 0xF2, 0x8A,
+    0xF4, 0x5F, 0xC1, 0xDC, 0x5B, 0x37, 0x77, 0x36, 0xB5, 0x7E, 0x97, 0xE7, 0xE0, 0x56, 0x3C, 0xCC,
+    0xA2, 0x4C, 0x97, 0xF4, 0x40, 0xE1, 0xD1, 0x37, 0xE5, 0x94, 0x1D, 0x84, 0xD2, 0xEB, 0x43, 0xC9,
+};
+
+const uint8_t g_katSm3Msg[CRYPTO_KAT_SM3_MSG_LEN] = { 'a', 'b', 'c' };
+
+const uint8_t g_katSm3Digest[CRYPTO_SM3_DIGEST_LEN] = {
+    0x66, 0xC7, 0xF0, 0xF4, 0x62, 0xEE, 0xED, 0xD9, 0xD1, 0xF2, 0xD4, 0x6B, 0xDC, 0x10, 0xE4, 0xE2,
+    0x41, 0x67, 0xC4, 0x87, 0x5C, 0xF2, 0xF7, 0xA2, 0x29, 0x7D, 0xA0, 0x2B, 0x8F, 0x4B, 0xA8, 0xE0,
+};
+
+const uint8_t g_katSm4Cipher[CRYPTO_KAT_SM4_LEN] = {
+    0x68, 0x1E, 0xDF, 0x34, 0xD2, 0x06, 0x96, 0x5E, 0x86, 0xB3, 0xE9, 0x4F, 0x53, 0x6E, 0x42, 0x46,
+};
@@ -0,0 +1,41 @@
+#ifndef APP_CRYPTO_VECTORS_H
+#define APP_CRYPTO_VECTORS_H
+
+#include <stdint.h>
+#include "crypto_backend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * crypto_bench / crypto_dispatch / 后端共用的曲线参数、测速密钥与已知答案向量 (KAT)
+ * KAT 用于启动测速时校验每个实现，不依赖"第一个能跑通的后端"作参考
+ */
+
+#define CRYPTO_KAT_SM3_MSG_LEN   3
+#define CRYPTO_KAT_SM4_LEN       CRYPTO_SM4_BLOCK_LEN
+
+// SM2 素数 p 与基点 G (x || y)
+extern const uint8_t g_cryptoSm2P[CRYPTO_BN_BYTES];
+extern const uint8_t g_cryptoSm2G[CRYPTO_SM2_POINT_LEN];
+
+// 测速用 SM4 密钥与全零 IV
+extern const uint8_t g_cryptoSm4Key[CRYPTO_SM4_KEY_LEN];
+extern const uint8_t g_cryptoSm4Iv[CRYPTO_SM4_BLOCK_LEN];
+
+// Gx * Gy mod p
+extern const uint8_t g_katModMulR[CRYPTO_BN_BYTES];
+// k = 0x01 0x02 ... 0x20，R = k * G
+extern const uint8_t g_katPointK[CRYPTO_BN_BYTES];
+extern const uint8_t g_katPointR[CRYPTO_SM2_POINT_LEN];
+// GB/T 32905 示例 1："abc"
+extern const uint8_t g_katSm3Msg[CRYPTO_KAT_SM3_MSG_LEN];
+extern const uint8_t g_katSm3Digest[CRYPTO_SM3_DIGEST_LEN];
+// GB/T 32907 示例 1：密钥与明文同为 g_cryptoSm4Key，CBC 全零 IV 下单分组密文与 ECB 相同
+extern const uint8_t g_katSm4Cipher[CRYPTO_KAT_SM4_LEN];
+
+#ifdef __cplusplus
+}
+#endif
+#endif
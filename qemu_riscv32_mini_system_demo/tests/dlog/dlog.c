@@ -0,0 +1,603 @@
+/*
+ * 延迟二进制日志
+ * 写入方按格式串解析出每个参数的类型，用 va_arg 取出后原样存成 64 位字；
+ * 排空方再次解析同一格式串，对每个转换说明单独调用 snprintf，参数按原类型还原。
+ * 私有环是单生产者 / 单消费者：生产者只写 head，消费者只写 tail，记录内容与下标之间用内存屏障排序。
+ * 开启 LOSCFG_DEBUG_HOOK 时任务删除钩子解除该任务的绑定，私有环连同未排空的记录留给下一个任务接着用。
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_interrupt.h"
+#include "los_mux.h"
+#if defined(LOSCFG_DEBUG_HOOK)
+#include "los_hook.h"
+#endif
+#include "shcmd.h"
+
+#include "dlog.h"
+
+#define DRAIN_STACK_SIZE         0x1000
+#define RING_MASK                (DLOG_RING_ENTRIES - 1)
+#define RING_SHARED              DLOG_MAX_RINGS
+#define SPEC_MAX                 32
+
+typedef enum {
+    DLOG_ARG_NONE = 0,
+    DLOG_ARG_INT,
+    DLOG_ARG_LONG,
+    DLOG_ARG_LLONG,
+    DLOG_ARG_SIZE,
+    DLOG_ARG_PTR,
+    DLOG_ARG_DOUBLE,
+    DLOG_ARG_LDOUBLE,
+} DlogArgType;
+
+// 一个转换说明；conv 为 0 表示无法识别，按原文输出
+typedef struct {
+    BOOL starWidth;
+    BOOL starPrec;
+    DlogArgType type;
+    CHAR conv;
+} DlogSpec;
+
+typedef struct {
+    const CHAR *fmt;
+    UINT32 nargs;
+    UINT64 cycles;
+    UINT64 args[DLOG_MAX_ARGS];
+} DlogEntry;
+
+typedef struct {
+    volatile UINT32 head;        // 只由生产者推进
+    volatile UINT32 tail;        // 只由消费者推进
+    UINT32 written;
+    UINT32 dropped;
+    DlogEntry entries[DLOG_RING_ENTRIES];
+} DlogRing;
+
+/* ================= 全局变量 ================= */
+// 最后一个是共享环
+static DlogRing g_rings[DLOG_MAX_RINGS + 1];
+// 任务 ID -> 环下标 + 1，0 表示尚未绑定
+static UINT8 g_ringOf[LOSCFG_BASE_CORE_TSK_LIMIT + 1];
+// 私有环是否已绑定任务；绑定与解绑都在关中断下进行
+static BOOL g_ringBound[DLOG_MAX_RINGS];
+static UINT32 g_ringsUsed = 0;
+#if defined(LOSCFG_DEBUG_HOOK)
+static BOOL g_hookRegistered = FALSE;
+#endif
+
+// 以下只在持有 g_drainMux 时访问
+static UINT32 g_drained = 0;
+static UINT32 g_maxDepth = 0;
+static FILE *g_fp = NULL;
+static DlogSink g_sink = DLOG_SINK_UART;
+
+static DlogStats g_base;
+static UINT32 g_drainMux;
+static UINT32 g_drainTaskId;
+static BOOL g_inited = FALSE;
+
+/* ================= 格式串解析 ================= */
+
+static inline BOOL IsDigit(CHAR c)
+{
+    return (c >= '0') && (c <= '9');
+}
+
+/**
+ * @brief 解析从 '%' 开始的一个转换说明，返回其后的位置
+ */
+static const CHAR *ParseSpec(const CHAR *p, DlogSpec *s)
+{
+    CHAR len = 0;
+
+    memset(s, 0, sizeof(*s));
+    p++;
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') {
+        p++;
+    }
+    if (*p == '*') {
+        s->starWidth = TRUE;
+        p++;
+    }
+    while (IsDigit(*p)) {
+        p++;
+    }
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            s->starPrec = TRUE;
+            p++;
+        }
+        while (IsDigit(*p)) {
+            p++;
+        }
+    }
+    if (*p == 'h' || *p == 'l') {
+        len = *p++;
+        if (*p == len) {
+            len = (len == 'l') ? 'q' : 'h';   // 'q' 代表 ll，hh 与 h 同按 int 传递
+            p++;
+        }
+    } else if (*p == 'j' || *p == 'z' || *p == 't' || *p == 'L') {
+        len = *p++;
+    }
+    if (*p == '\0') {
+        return p;
+    }
+
+    s->conv = *p++;
+    switch (s->conv) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+            if (len == 'q' || len == 'j') {
+                s->type = DLOG_ARG_LLONG;
+            } else if (len == 'l') {
+                s->type = DLOG_ARG_LONG;
+            } else if (len == 'z' || len == 't') {
+                s->type = DLOG_ARG_SIZE;
+            } else {
+                s->type = DLOG_ARG_INT;
+            }
+            break;
+        case 's': case 'p':
+            s->type = DLOG_ARG_PTR;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            s->type = (len == 'L') ? DLOG_ARG_LDOUBLE : DLOG_ARG_DOUBLE;
+            break;
+        case '%':
+            break;
+        default:
+            s->conv = 0;
+            break;
+    }
+    return p;
+}
+
+/**
+ * @brief 按格式串取出可变参数存入 args，返回保存的个数；超过 DLOG_MAX_ARGS 的参数不再读取
+ */
+static UINT32 Pack(const CHAR *fmt, va_list ap, UINT64 *args)
+{
+    UINT32 n = 0;
+    DlogSpec s;
+    const CHAR *p = fmt;
+
+    while ((p = strchr(p, '%')) != NULL) {
+        p = ParseSpec(p, &s);
+        if (s.conv == 0 || s.conv == '%') {
+            continue;
+        }
+        if (n + (UINT32)s.starWidth + (UINT32)s.starPrec + 1 > DLOG_MAX_ARGS) {
+            break;
+        }
+        if (s.starWidth) {
+            args[n++] = (UINT32)va_arg(ap, int);
+        }
+        if (s.starPrec) {
+            args[n++] = (UINT32)va_arg(ap, int);
+        }
+        switch (s.type) {
+            case DLOG_ARG_INT:
+                args[n++] = (UINT32)va_arg(ap, int);
+                break;
+            case DLOG_ARG_LONG:
+                args[n++] = (UINT64)va_arg(ap, long);
+                break;
+            case DLOG_ARG_LLONG:
+                args[n++] = (UINT64)va_arg(ap, long long);
+                break;
+            case DLOG_ARG_SIZE:
+                args[n++] = (UINT64)va_arg(ap, size_t);
+                break;
+            case DLOG_ARG_PTR:
+                args[n++] = (UINTPTR)va_arg(ap, VOID *);
+                break;
+            case DLOG_ARG_DOUBLE:
+            case DLOG_ARG_LDOUBLE: {
+                double d = (s.type == DLOG_ARG_DOUBLE) ? va_arg(ap, double) : (double)va_arg(ap, long double);
+                (VOID)memcpy(&args[n++], &d, sizeof(d));
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return n;
+}
+
+static UINT32 Clamp(INT32 ret, UINT32 room)
+{
+    if (ret < 0) {
+        return 0;
+    }
+    return ((UINT32)ret >= room) ? room - 1 : (UINT32)ret;
+}
+
+/**
+ * @brief 输出一个转换说明；spec 已把 '*' 替换为数值并去掉 'L'
+ */
+static UINT32 EmitOne(CHAR *out, UINT32 room, const CHAR *spec, const DlogSpec *s, UINT64 v)
+{
+    double d;
+
+    switch (s->type) {
+        case DLOG_ARG_INT:
+            return Clamp(snprintf(out, room, spec, (int)(UINT32)v), room);
+        case DLOG_ARG_LONG:
+            return Clamp(snprintf(out, room, spec, (long)v), room);
+        case DLOG_ARG_LLONG:
+            return Clamp(snprintf(out, room, spec, (long long)v), room);
+        case DLOG_ARG_SIZE:
+            return Clamp(snprintf(out, room, spec, (size_t)v), room);
+        case DLOG_ARG_PTR:
+            if (s->conv == 's') {
+                const CHAR *str = (const CHAR *)(UINTPTR)v;
+                return Clamp(snprintf(out, room, spec, (str != NULL) ? str : "(null)"), room);
+            }
+            return Clamp(snprintf(out, room, spec, (VOID *)(UINTPTR)v), room);
+        case DLOG_ARG_DOUBLE:
+        case DLOG_ARG_LDOUBLE:
+            (VOID)memcpy(&d, &v, sizeof(d));
+            return Clamp(snprintf(out, room, spec, d), room);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief 把一条记录格式化到 out，返回长度
+ */
+static UINT32 Format(const DlogEntry *e, CHAR *out, UINT32 size)
+{
+    UINT32 len = 0;
+    UINT32 n = 0;
+    const CHAR *p = e->fmt;
+    DlogSpec s;
+
+    while (*p != '\0' && len < size - 1) {
+        if (*p != '%') {
+            out[len++] = *p++;
+            continue;
+        }
+        const CHAR *start = p;
+        p = ParseSpec(p, &s);
+        if (s.conv == '%') {
+            out[len++] = '%';
+            continue;
+        }
+        UINT32 need = (UINT32)s.starWidth + (UINT32)s.starPrec + 1;
+        if (s.conv == 0 || n + need > e->nargs) {
+            // 无法识别或参数被截断：原样输出
+            while (start < p && len < size - 1) {
+                out[len++] = *start++;
+            }
+            continue;
+        }
+
+        CHAR spec[SPEC_MAX];
+        UINT32 k = 0;
+        for (const CHAR *q = start; q < p && k < SPEC_MAX - 12; q++) {
+            if (*q == '*') {
+                k += Clamp(snprintf(&spec[k], SPEC_MAX - k, "%d", (int)(UINT32)e->args[n++]), SPEC_MAX - k);
+            } else if (*q != 'L') {
+                spec[k++] = *q;
+            }
+        }
+        spec[k] = '\0';
+        len += EmitOne(&out[len], size - len, spec, &s, e->args[n++]);
+    }
+    out[len] = '\0';
+    return len;
+}
+
+/* ================= 写入 ================= */
+
+#if defined(LOSCFG_DEBUG_HOOK)
+/**
+ * @brief 任务删除钩子：归还私有环，任务号被复用时重新绑定
+ */
+static VOID DlogOnTaskDelete(const LosTaskCB *taskCB)
+{
+    UINT32 taskId = taskCB->taskID;
+    UINT32 intSave;
+    UINT32 idx;
+
+    if (taskId > LOSCFG_BASE_CORE_TSK_LIMIT || g_ringOf[taskId] == 0) {
+        return;
+    }
+    intSave = LOS_IntLock();
+    idx = g_ringOf[taskId] - 1U;
+    if (idx < DLOG_MAX_RINGS) {
+        g_ringBound[idx] = FALSE;
+        g_ringsUsed--;
+    }
+    g_ringOf[taskId] = 0;
+    LOS_IntRestore(intSave);
+}
+#endif
+
+/**
+ * @brief 取一个空闲私有环，没有时返回共享环下标；调用方持有中断锁
+ */
+static UINT32 RingBind(VOID)
+{
+#if defined(LOSCFG_DEBUG_HOOK)
+    if (!g_hookRegistered) {
+        g_hookRegistered = (LOS_HookReg(LOS_HOOK_TYPE_TASK_DELETE, DlogOnTaskDelete) == LOS_OK);
+    }
+#endif
+    for (UINT32 i = 0; i < DLOG_MAX_RINGS; i++) {
+        if (!g_ringBound[i]) {
+            g_ringBound[i] = TRUE;
+            g_ringsUsed++;
+            return i;
+        }
+    }
+    return RING_SHARED;
+}
+
+static DlogRing *RingGet(VOID)
+{
+    UINT32 taskId;
+    UINT32 intSave;
+
+    if (OS_INT_ACTIVE) {
+        return &g_rings[RING_SHARED];
+    }
+    taskId = LOS_CurTaskIDGet();
+    if (taskId > LOSCFG_BASE_CORE_TSK_LIMIT) {
+        return &g_rings[RING_SHARED];
+    }
+    if (g_ringOf[taskId] == 0) {
+        // 只有任务自己会绑定自己的条目，锁只用于分配环下标
+        intSave = LOS_IntLock();
+        g_ringOf[taskId] = (UINT8)(RingBind() + 1);
+        LOS_IntRestore(intSave);
+    }
+    return &g_rings[g_ringOf[taskId] - 1];
+}
+
+VOID DlogWrite(const CHAR *fmt, ...)
+{
+    DlogRing *ring = RingGet();
+    BOOL shared = (ring == &g_rings[RING_SHARED]);
+    UINT32 intSave = 0;
+    UINT32 head;
+    va_list ap;
+
+    if (shared) {
+        intSave = LOS_IntLock();
+    }
+    head = ring->head;
+    if (head - ring->tail >= DLOG_RING_ENTRIES) {
+        ring->dropped++;
+    } else {
+        DlogEntry *e = &ring->entries[head & RING_MASK];
+        e->fmt = fmt;
+        e->cycles = LOS_SysCycleGet();
+        va_start(ap, fmt);
+        e->nargs = Pack(fmt, ap, e->args);
+        va_end(ap);
+        ring->written++;
+        // 记录内容先于 head 对消费者可见
+        __sync_synchronize();
+        ring->head = head + 1;
+    }
+    if (shared) {
+        LOS_IntRestore(intSave);
+    }
+}
+
+/* ================= 排空 ================= */
+
+static VOID Output(const CHAR *line)
+{
+    if (g_sink == DLOG_SINK_FILE && g_fp != NULL) {
+        (VOID)fputs(line, g_fp);
+    } else {
+        printf("%s", line);
+    }
+}
+
+/**
+ * @brief 每次取所有环中时间戳最早的一条输出，直到全部为空；调用方持有 g_drainMux
+ */
+static UINT32 DrainLocked(VOID)
+{
+    CHAR line[DLOG_LINE_MAX];
+    UINT32 count = 0;
+
+    while (1) {
+        DlogRing *oldest = NULL;
+        UINT64 oldestCycles = 0;
+
+        for (UINT32 i = 0; i <= DLOG_MAX_RINGS; i++) {
+            DlogRing *r = &g_rings[i];
+            UINT32 tail = r->tail;
+            UINT32 depth = r->head - tail;
+            if (depth == 0) {
+                continue;
+            }
+            if (depth > g_maxDepth) {
+                g_maxDepth = depth;
+            }
+            __sync_synchronize();
+            UINT64 cycles = r->entries[tail & RING_MASK].cycles;
+            if (oldest == NULL || cycles < oldestCycles) {
+                oldest = r;
+                oldestCycles = cycles;
+            }
+        }
+        if (oldest == NULL) {
+            break;
+        }
+
+        UINT32 tail = oldest->tail;
+        (VOID)Format(&oldest->entries[tail & RING_MASK], line, sizeof(line));
+        // 格式化完成后才把槽位还给生产者
+        __sync_synchronize();
+        oldest->tail = tail + 1;
+        Output(line);
+        count++;
+    }
+    if (count != 0 && g_fp != NULL) {
+        (VOID)fflush(g_fp);
+    }
+    g_drained += count;
+    return count;
+}
+
+UINT32 DlogFlush(VOID)
+{
+    UINT32 count;
+
+    if (!g_inited && DlogInit() != LOS_OK) {
+        return 0;
+    }
+    (VOID)LOS_MuxPend(g_drainMux, LOS_WAIT_FOREVER);
+    count = DrainLocked();
+    (VOID)LOS_MuxPost(g_drainMux);
+    return count;
+}
+
+static VOID *DlogDrainTask(UINTPTR arg)
+{
+    (VOID)arg;
+    while (1) {
+        if (DlogFlush() == 0) {
+            (VOID)LOS_TaskDelay(DLOG_DRAIN_PERIOD_TICKS);
+        }
+    }
+    return NULL;
+}
+
+UINT32 DlogSinkSet(DlogSink sink, const CHAR *path)
+{
+    UINT32 ret = LOS_OK;
+
+    if (!g_inited && DlogInit() != LOS_OK) {
+        return LOS_NOK;
+    }
+    (VOID)LOS_MuxPend(g_drainMux, LOS_WAIT_FOREVER);
+    // 切换前把已有记录输出到旧目标
+    (VOID)DrainLocked();
+    if (g_fp != NULL) {
+        (VOID)fclose(g_fp);
+        g_fp = NULL;
+    }
+    g_sink = DLOG_SINK_UART;
+    if (sink == DLOG_SINK_FILE) {
+        g_fp = fopen((path != NULL) ? path : DLOG_FILE_DEFAULT, "a");
+        if (g_fp != NULL) {
+            g_sink = DLOG_SINK_FILE;
+        } else {
+            printf("[dlog] open %s failed, keep uart\n", (path != NULL) ? path : DLOG_FILE_DEFAULT);
+            ret = LOS_NOK;
+        }
+    }
+    (VOID)LOS_MuxPost(g_drainMux);
+    return ret;
+}
+
+/* ================= 统计 ================= */
+
+static VOID StatsRaw(DlogStats *stats)
+{
+    UINT32 intSave = LOS_IntLock();
+
+    memset(stats, 0, sizeof(*stats));
+    for (UINT32 i = 0; i <= DLOG_MAX_RINGS; i++) {
+        stats->written += g_rings[i].written;
+        stats->dropped += g_rings[i].dropped;
+    }
+    stats->shared = g_rings[RING_SHARED].written;
+    stats->drained = g_drained;
+    stats->rings = g_ringsUsed;
+    stats->maxDepth = g_maxDepth;
+    LOS_IntRestore(intSave);
+}
+
+VOID DlogStatsGet(DlogStats *stats)
+{
+    StatsRaw(stats);
+    stats->written -= g_base.written;
+    stats->dropped -= g_base.dropped;
+    stats->shared -= g_base.shared;
+    stats->drained -= g_base.drained;
+}
+
+VOID DlogStatsReset(VOID)
+{
+    // 计数器由各生产者无锁递增，这里只记下基线，不直接清零
+    StatsRaw(&g_base);
+    g_maxDepth = 0;
+}
+
+/* ================= shell 命令 ================= */
+
+static UINT32 DlogCmd(UINT32 argc, const CHAR **argv)
+{
+    DlogStats stats;
+
+    if (argc == 0 || strcmp(argv[0], "stats") == 0) {
+        DlogStatsGet(&stats);
+        printf("written %u, dropped %u, drained %u, shared %u, rings %u/%u, max depth %u/%u, sink %s\n",
+               stats.written, stats.dropped, stats.drained, stats.shared, stats.rings, DLOG_MAX_RINGS,
+               stats.maxDepth, DLOG_RING_ENTRIES, (g_sink == DLOG_SINK_FILE) ? "file" : "uart");
+        return LOS_OK;
+    }
+    if (strcmp(argv[0], "flush") == 0) {
+        printf("[dlog] %u records flushed\n", DlogFlush());
+        return LOS_OK;
+    }
+    if (strcmp(argv[0], "reset") == 0) {
+        DlogStatsReset();
+        return LOS_OK;
+    }
+    if (strcmp(argv[0], "uart") == 0) {
+        return DlogSinkSet(DLOG_SINK_UART, NULL);
+    }
+    if (strcmp(argv[0], "file") == 0) {
+        return DlogSinkSet(DLOG_SINK_FILE, (argc > 1) ? argv[1] : NULL);
+    }
+    printf("usage: dlog [stats|flush|reset|uart|file [path]]\n");
+    return LOS_NOK;
+}
+
+UINT32 DlogInit(VOID)
+{
+    UINT32 ret;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    if (g_inited) {
+        return LOS_OK;
+    }
+    ret = LOS_MuxCreate(&g_drainMux);
+    if (ret != LOS_OK) {
+        printf("[dlog] mutex create failed: 0x%X\n", ret);
+        return ret;
+    }
+    // 排空任务创建前置位，DlogFlush 不会再回到这里
+    g_inited = TRUE;
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)DlogDrainTask;
+    task.uwStackSize  = DRAIN_STACK_SIZE;
+    task.pcName       = "DlogDrain";
+    task.usTaskPrio   = DLOG_DRAIN_PRIO;
+    ret = LOS_TaskCreate(&g_drainTaskId, &task);
+    if (ret != LOS_OK) {
+        printf("[dlog] drain task create failed: 0x%X\n", ret);
+        (VOID)LOS_MuxDelete(g_drainMux);
+        g_inited = FALSE;
+        return ret;
+    }
+    (VOID)osCmdReg(CMD_TYPE_EX, "dlog", XARGS, (CmdCallBackFunc)DlogCmd);
+    return LOS_OK;
+}
@@ -0,0 +1,80 @@
+#ifndef APP_DLOG_H
+#define APP_DLOG_H
+
+#include "los_task.h"
+#include "los_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 延迟二进制日志
+ * 调用点只记录格式串地址 (即格式串 ID)、时间戳与原始参数，不做格式化也不碰 UART；
+ * 最低优先级的排空任务在 CPU 空闲时按时间戳合并各环，格式化后输出到 UART 或文件。
+ * 每个任务第一次写日志时绑定一个私有环，任务是唯一生产者、排空方是唯一消费者，写入无锁；
+ * 中断中以及私有环用尽后的任务写共享环，共享环的写入在关中断下进行。
+ * 任务删除时私有环经任务删除钩子归还 (需要 LOSCFG_DEBUG_HOOK)，否则一直占用到重启。
+ * 环满时丢弃新记录并计数，调用点永远不会阻塞。
+ * 限制：格式串与 %s 参数必须在排空前一直有效 (字符串字面量)；参数最多 DLOG_MAX_ARGS 个 (含 '*')，
+ *       不支持 %n；%Lf 按 double 保存。
+ */
+
+#define DLOG_MAX_ARGS            4
+#define DLOG_RING_ENTRIES        64            // 2 的幂
+#define DLOG_MAX_RINGS           8             // 私有环个数，另有一个共享环
+#define DLOG_LINE_MAX            160           // 单条格式化后的最大长度，超出截断
+#define DLOG_DRAIN_PRIO          (OS_TASK_PRIORITY_LOWEST - 1)
+#define DLOG_DRAIN_PERIOD_TICKS  10            // 排空任务无记录时的休眠间隔
+#define DLOG_FILE_DEFAULT        "/data/dlog.txt"
+
+typedef enum {
+    DLOG_SINK_UART = 0,
+    DLOG_SINK_FILE,
+} DlogSink;
+
+typedef struct {
+    UINT32 written;              // 成功写入环的记录数
+    UINT32 dropped;              // 环满丢弃的记录数
+    UINT32 drained;              // 已格式化输出的记录数
+    UINT32 shared;               // 写入共享环的记录数 (中断或私有环用尽)
+    UINT32 rings;                // 当前绑定着任务的私有环个数
+    UINT32 maxDepth;             // 排空时观察到的单环最大积压
+} DlogStats;
+
+/**
+ * @brief 创建排空任务并注册 shell 命令 dlog，重复调用无副作用
+ * 未初始化时 DLOG 仍会写入环，直到环满；之后可用 DlogFlush 手动排空
+ */
+UINT32 DlogInit(VOID);
+
+/**
+ * @brief 记录一条日志；参数类型按格式串在调用时取出，格式化推迟到排空时
+ */
+VOID DlogWrite(const CHAR *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+#if defined(DLOG_DISABLE)
+#define DLOG(fmt, ...)           ((VOID)0)
+#else
+#define DLOG(fmt, ...)           DlogWrite(fmt, ##__VA_ARGS__)
+#endif
+
+/**
+ * @brief 在调用者上下文中排空所有环，返回输出的记录数
+ * 与排空任务互斥；测试在忙负载结束后调用，避免最低优先级的排空任务长时间得不到运行
+ */
+UINT32 DlogFlush(VOID);
+
+/**
+ * @brief 切换输出目标；DLOG_SINK_FILE 以追加方式打开 path (NULL 时用 DLOG_FILE_DEFAULT)
+ */
+UINT32 DlogSinkSet(DlogSink sink, const CHAR *path);
+
+VOID DlogStatsGet(DlogStats *stats);
+
+VOID DlogStatsReset(VOID);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
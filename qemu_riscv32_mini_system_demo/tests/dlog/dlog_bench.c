@@ -0,0 +1,306 @@
+/*
+ * 延迟日志与 printf 对比
+ * 1. 单次调用开销：同一条 "#%u Wait: %llu ticks" 分别用 printf 与 DLOG 记录 CALL_SAMPLES 次，
+ *    DLOG 另测排空时每条记录的格式化 + 输出开销 (这部分转移到了最低优先级任务)。
+ * 2. 对调度测量的干扰：复现 vtpm 调度测试的 CPU 密集工作任务，每次被重新调度时记录等待时间，
+ *    分别不记录 / printf / DLOG 运行 RUN_TICKS，比较任务切入次数、观测到的重调度次数
+ *    以及工作任务花在记录日志上的时间占比。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+
+#include "cpu_monitor.h"
+#include "dlog.h"
+#include "dlog_bench.h"
+#include "test_assert.h"
+
+#define TASK_STACK_SIZE          0x1000
+#define CTRL_TASK_PRI            4
+#define WORKER_TASK_PRI          20          // 与 vtpm 调度测试的低优先级任务一致，高于排空任务
+
+#define CALL_SAMPLES             32          // 不超过 DLOG_RING_ENTRIES，保证全部写入
+#define WORKER_NUM               3
+#define RUN_TICKS                (2 * LOSCFG_BASE_CORE_TICK_PER_SECOND)
+#define BURN_LOOPS               20000
+
+#define WORKER_FMT               "[LTask%u] #%u Wait: %llu ticks\n"
+
+typedef enum {
+    MODE_NONE = 0,
+    MODE_PRINTF,
+    MODE_DLOG,
+    MODE_NUM,
+} LogMode;
+
+typedef struct {
+    UINT32 taskId;
+    UINT32 resched;              // 工作任务自己观测到的重调度次数
+    UINT32 logCalls;
+    UINT64 waitTicks;
+    UINT64 logCycles;
+} WorkerStat;
+
+typedef struct {
+    UINT32 switchIns;            // cpu_monitor 统计的工作任务切入次数
+    UINT32 resched;
+    UINT32 logCalls;
+    UINT32 avgWaitX10;           // 平均等待 (0.1 tick)
+    UINT32 logPermille;          // 工作任务运行时间中记录日志所占千分比
+    UINT32 dropped;
+} ModeResult;
+
+static TestStats g_stats = { 0 };
+
+/* ================= 全局变量 ================= */
+static const CHAR *g_modeNames[MODE_NUM] = { "none", "printf", "dlog" };
+static volatile BOOL g_running = FALSE;
+static volatile UINT32 g_alive = 0;
+static volatile LogMode g_mode = MODE_NONE;
+static WorkerStat g_workers[WORKER_NUM];
+
+static CpuMonSnapshot g_snapBegin;
+static CpuMonSnapshot g_snapEnd;
+static UINT32 g_switchBegin[WORKER_NUM];
+
+static VOID BurnCpu(UINT32 loops)
+{
+    volatile UINT32 acc = 0;
+    for (UINT32 i = 0; i < loops; i++) {
+        acc += i;
+    }
+    (VOID)acc;
+}
+
+/* ================= 单次调用开销 ================= */
+
+static UINT32 PrintfCost(VOID)
+{
+    UINT64 total = 0;
+
+    LOS_TaskLock();
+    for (UINT32 i = 0; i < CALL_SAMPLES; i++) {
+        UINT64 start = LOS_SysCycleGet();
+        printf(WORKER_FMT, 1U, i, (UINT64)i);
+        total += LOS_SysCycleGet() - start;
+    }
+    LOS_TaskUnlock();
+    return (UINT32)(total / CALL_SAMPLES);
+}
+
+static UINT32 DlogCost(UINT32 *drainCyc)
+{
+    UINT64 total = 0;
+    UINT64 start;
+    UINT32 n;
+
+    (VOID)DlogFlush();
+    LOS_TaskLock();
+    for (UINT32 i = 0; i < CALL_SAMPLES; i++) {
+        start = LOS_SysCycleGet();
+        DLOG(WORKER_FMT, 1U, i, (UINT64)i);
+        total += LOS_SysCycleGet() - start;
+    }
+    LOS_TaskUnlock();
+
+    start = LOS_SysCycleGet();
+    n = DlogFlush();
+    *drainCyc = (n == 0) ? 0 : (UINT32)((LOS_SysCycleGet() - start) / n);
+    return (UINT32)(total / CALL_SAMPLES);
+}
+
+/* ================= 调度干扰 ================= */
+
+/**
+ * @brief 同 vtpm_scheduler_test 的 LowPriorityTaskEntry：忙循环，tick 在两段计算之间变化即视为被重新调度
+ */
+static VOID *WorkerEntry(UINTPTR arg)
+{
+    WorkerStat *w = &g_workers[arg];
+    UINT64 lastEnd = LOS_TickCountGet();
+
+    while (g_running) {
+        UINT64 tick = LOS_TickCountGet();
+        if (tick != lastEnd) {
+            UINT64 wait = tick - lastEnd;
+            w->resched++;
+            w->waitTicks += wait;
+            if (g_mode != MODE_NONE) {
+                UINT64 start = LOS_SysCycleGet();
+                if (g_mode == MODE_PRINTF) {
+                    printf(WORKER_FMT, (UINT32)arg + 1, w->resched, wait);
+                } else {
+                    DLOG(WORKER_FMT, (UINT32)arg + 1, w->resched, wait);
+                }
+                w->logCycles += LOS_SysCycleGet() - start;
+                w->logCalls++;
+            }
+        }
+        BurnCpu(BURN_LOOPS);
+        lastEnd = LOS_TickCountGet();
+    }
+
+    UINT32 intSave = LOS_IntLock();
+    g_alive--;
+    LOS_IntRestore(intSave);
+    return NULL;
+}
+
+static UINT32 SwitchInsGet(UINT32 taskId)
+{
+    CpuMonTaskUsage usage;
+    return (CpuMonTaskUsageGet(taskId, &usage) == LOS_OK) ? usage.switchIns : 0;
+}
+
+static UINT32 RunMode(LogMode mode, ModeResult *res)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    DlogStats dstats;
+    UINT64 runCycles = 0;
+    UINT64 logCycles = 0;
+    UINT64 waitTicks = 0;
+    UINT32 ret;
+
+    memset(res, 0, sizeof(*res));
+    memset(g_workers, 0, sizeof(g_workers));
+    DlogStatsReset();
+    g_mode = mode;
+    g_running = TRUE;
+    g_alive = 0;
+
+    // 工作任务在控制任务睡眠后才开始运行，先全部创建再统一取基线
+    LOS_TaskLock();
+    for (UINT32 i = 0; i < WORKER_NUM; i++) {
+        param.pfnTaskEntry = (TSK_ENTRY_FUNC)WorkerEntry;
+        param.uwStackSize  = TASK_STACK_SIZE;
+        param.pcName       = "DlogWorker";
+        param.usTaskPrio   = WORKER_TASK_PRI;
+        param.uwArg        = i;
+        ret = LOS_TaskCreate(&g_workers[i].taskId, &param);
+        if (ret != LOS_OK) {
+            printf("create worker %u failed: 0x%X\n", i, ret);
+            g_running = FALSE;
+            LOS_TaskUnlock();
+            while (g_alive != 0) {
+                (VOID)LOS_TaskDelay(1);
+            }
+            return ret;
+        }
+        g_alive++;
+    }
+    CpuMonSnapshotTake(&g_snapBegin);
+    for (UINT32 i = 0; i < WORKER_NUM; i++) {
+        g_switchBegin[i] = SwitchInsGet(g_workers[i].taskId);
+    }
+    LOS_TaskUnlock();
+
+    (VOID)LOS_TaskDelay(RUN_TICKS);
+    CpuMonSnapshotTake(&g_snapEnd);
+    g_running = FALSE;
+    for (UINT32 i = 0; i < WORKER_NUM; i++) {
+        const WorkerStat *w = &g_workers[i];
+        UINT64 cyc = 0;
+        res->switchIns += SwitchInsGet(w->taskId) - g_switchBegin[i];
+        (VOID)CpuMonIntervalUsage(&g_snapBegin, &g_snapEnd, w->taskId, &cyc);
+        runCycles += cyc;
+        res->resched += w->resched;
+        res->logCalls += w->logCalls;
+        logCycles += w->logCycles;
+        waitTicks += w->waitTicks;
+    }
+    while (g_alive != 0) {
+        (VOID)LOS_TaskDelay(1);
+    }
+
+    res->avgWaitX10 = (res->resched == 0) ? 0 : (UINT32)(waitTicks * 10 / res->resched);
+    res->logPermille = (runCycles == 0) ? 0 : (UINT32)(logCycles * 1000 / runCycles);
+    if (mode == MODE_DLOG) {
+        // 测量结束后再输出积压的记录
+        (VOID)DlogFlush();
+        DlogStatsGet(&dstats);
+        res->dropped = dstats.dropped;
+    }
+    return LOS_OK;
+}
+
+/* ================= 测试流程 ================= */
+
+static VOID *DlogBenchTask(UINTPTR arg)
+{
+    ModeResult res[MODE_NUM];
+    UINT32 printfCyc;
+    UINT32 dlogCyc;
+    UINT32 drainCyc = 0;
+    DlogStats dstats;
+
+    (VOID)arg;
+    printf("\n>>> Deferred Log Benchmark <<<\n");
+    if (CpuMonInit() != LOS_OK || DlogInit() != LOS_OK) {
+        printf("cpu monitor / dlog init failed\n");
+        return NULL;
+    }
+
+    printfCyc = PrintfCost();
+    dlogCyc = DlogCost(&drainCyc);
+    printf("\ncall cost: printf %u cyc, dlog %u cyc (drain %u cyc/record), at %u Hz\n",
+           printfCyc, dlogCyc, drainCyc, (UINT32)OS_SYS_CLOCK);
+
+    for (UINT32 m = 0; m < MODE_NUM; m++) {
+        if (RunMode((LogMode)m, &res[m]) != LOS_OK) {
+            printf("mode %s setup failed\n", g_modeNames[m]);
+            return NULL;
+        }
+    }
+    DlogStatsGet(&dstats);
+
+    printf("\n%-6s | %-9s | %-9s | %-8s | %-8s | %-8s | %s\n",
+           "Mode", "Switches", "Resched", "LogCalls", "AvgWait", "LogTime", "Dropped");
+    printf("-------|-----------|-----------|----------|----------|----------|--------\n");
+    for (UINT32 m = 0; m < MODE_NUM; m++) {
+        const ModeResult *r = &res[m];
+        printf("%-6s | %-9u | %-9u | %-8u | %5u.%u  | %4u.%u%%  | %u\n", g_modeNames[m], r->switchIns, r->resched,
+               r->logCalls, r->avgWaitX10 / 10, r->avgWaitX10 % 10, r->logPermille / 10, r->logPermille % 10,
+               r->dropped);
+    }
+
+    // 便于脚本提取的单行结果
+    printf("DLOG call printf_cyc=%u dlog_cyc=%u drain_cyc=%u\n", printfCyc, dlogCyc, drainCyc);
+    for (UINT32 m = 0; m < MODE_NUM; m++) {
+        const ModeResult *r = &res[m];
+        printf("DLOG mode=%s run_ticks=%u switches=%u resched=%u log_calls=%u avg_wait_x10=%u "
+               "log_permille=%u dropped=%u\n", g_modeNames[m], RUN_TICKS, r->switchIns, r->resched,
+               r->logCalls, r->avgWaitX10, r->logPermille, r->dropped);
+    }
+
+    TEST_ASSERT(dlogCyc < printfCyc, "DLOG 单次调用开销低于 printf");
+    TEST_ASSERT(res[MODE_DLOG].logPermille < res[MODE_PRINTF].logPermille, "DLOG 占用工作任务的时间少于 printf");
+    // RunMode 开始时重置了统计，dstats 只含 DLOG 模式
+    TEST_ASSERT(res[MODE_DLOG].logCalls == dstats.written + dstats.dropped, "每次 DLOG 调用要么写入要么计入丢弃");
+    TEST_ASSERT(dstats.drained == dstats.written, "写入的记录全部排空");
+
+    TEST_SUMMARY();
+    return NULL;
+}
+
+void DlogBenchApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)DlogBenchTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "DlogBenchTask";
+    task.usTaskPrio   = CTRL_TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("DlogBenchTask create failed: 0x%X\n", ret);
+    }
+}
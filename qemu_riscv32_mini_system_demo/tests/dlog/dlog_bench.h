@@ -0,0 +1,13 @@
+#ifndef APP_DLOG_BENCH_H
+#define APP_DLOG_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void DlogBenchApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
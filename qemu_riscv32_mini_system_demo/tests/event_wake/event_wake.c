@@ -0,0 +1,178 @@
+/*
+ * 事件驱动唤醒框架
+ * 截止时间与周期都由 CMSIS 软件定时器产生，到期时写事件；等待者只在事件到达时被调度。
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "los_event.h"
+#include "los_task.h"
+#include "los_interrupt.h"
+#include "cmsis_os2.h"
+
+#include "event_wake.h"
+
+/* ================= 全局变量 ================= */
+static EVENT_CB_S g_sysEvent;
+static BOOL g_sysEventInited = FALSE;
+
+static BOOL g_fsProbeStarted = FALSE;
+static const CHAR *g_fsProbePath = NULL;
+
+/* ================= 等待对象 ================= */
+
+static VOID DeadlineExpired(VOID *arg)
+{
+    (VOID)LOS_EventWrite(&((EvtWaiter *)arg)->event, EVT_WAKE_DEADLINE);
+}
+
+static VOID PeriodExpired(VOID *arg)
+{
+    (VOID)LOS_EventWrite(&((EvtWaiter *)arg)->event, EVT_WAKE_PERIOD);
+}
+
+UINT32 EvtWaiterInit(EvtWaiter *w)
+{
+    if (w == NULL) {
+        return LOS_NOK;
+    }
+    memset(w, 0, sizeof(*w));
+    return LOS_EventInit(&w->event);
+}
+
+VOID EvtWaiterDeinit(EvtWaiter *w)
+{
+    if (w->deadline != NULL) {
+        (VOID)osTimerStop(w->deadline);
+        (VOID)osTimerDelete(w->deadline);
+        w->deadline = NULL;
+    }
+    if (w->period != NULL) {
+        (VOID)osTimerStop(w->period);
+        (VOID)osTimerDelete(w->period);
+        w->period = NULL;
+    }
+    (VOID)LOS_EventDestroy(&w->event);
+}
+
+UINT32 EvtWaiterDeadline(EvtWaiter *w, UINT32 ticks)
+{
+    if (w->deadline == NULL) {
+        w->deadline = osTimerNew((osTimerFunc_t)DeadlineExpired, osTimerOnce, w, NULL);
+        if (w->deadline == NULL) {
+            return LOS_NOK;
+        }
+    }
+    // LOS_EventClear 保留 mask 中的位，这里清掉上一次未读的截止事件
+    (VOID)LOS_EventClear(&w->event, ~EVT_WAKE_DEADLINE);
+    return (osTimerStart(w->deadline, ticks) == osOK) ? LOS_OK : LOS_NOK;
+}
+
+UINT32 EvtWaiterPeriod(EvtWaiter *w, UINT32 ticks)
+{
+    if (ticks == 0) {
+        if (w->period != NULL) {
+            (VOID)osTimerStop(w->period);
+        }
+        return LOS_OK;
+    }
+    if (w->period == NULL) {
+        w->period = osTimerNew((osTimerFunc_t)PeriodExpired, osTimerPeriodic, w, NULL);
+        if (w->period == NULL) {
+            return LOS_NOK;
+        }
+    }
+    return (osTimerStart(w->period, ticks) == osOK) ? LOS_OK : LOS_NOK;
+}
+
+UINT32 EvtWaiterSignal(EvtWaiter *w, UINT32 bits)
+{
+    return LOS_EventWrite(&w->event, bits);
+}
+
+UINT32 EvtWaiterWait(EvtWaiter *w, UINT32 mask, UINT32 timeout)
+{
+    UINT32 ret = LOS_EventRead(&w->event, mask, LOS_WAITMODE_OR | LOS_WAITMODE_CLR, timeout);
+    // LOS_EventRead 出错时返回错误码，其最高位置位，不会与事件位混淆
+    if (ret == 0 || (ret & ~mask) != 0) {
+        w->timeouts++;
+        return 0;
+    }
+    w->wakeups++;
+    return ret;
+}
+
+/* ================= 系统就绪事件 ================= */
+
+static VOID SysEventInitOnce(VOID)
+{
+    UINT32 intSave = LOS_IntLock();
+    if (!g_sysEventInited) {
+        (VOID)LOS_EventInit(&g_sysEvent);
+        g_sysEventInited = TRUE;
+    }
+    LOS_IntRestore(intSave);
+}
+
+UINT32 EvtSysSignal(UINT32 bits)
+{
+    SysEventInitOnce();
+    return LOS_EventWrite(&g_sysEvent, bits);
+}
+
+UINT32 EvtSysWait(UINT32 bits, UINT32 timeout)
+{
+    SysEventInitOnce();
+    UINT32 ret = LOS_EventRead(&g_sysEvent, bits, LOS_WAITMODE_AND, timeout);
+    // 就绪事件只用低位，高位置位说明返回的是错误码
+    return ((ret & bits) == bits && (ret & ~(UINT32)EVT_WAKE_USER_MASK) == 0) ? LOS_OK : LOS_NOK;
+}
+
+/**
+ * @brief 探测任务：stat 可能在文件系统锁上阻塞，不能放在软件定时器任务里执行
+ */
+static VOID *FsProbeEntry(UINTPTR arg)
+{
+    struct stat st;
+    UINT32 delay = EVT_SYS_FS_PROBE_MIN;
+
+    (VOID)arg;
+    while (stat(g_fsProbePath, &st) != 0) {
+        (VOID)LOS_TaskDelay(delay);
+        // 失败时按指数退避
+        delay = (delay * 2 > EVT_SYS_FS_PROBE_MAX) ? EVT_SYS_FS_PROBE_MAX : delay * 2;
+    }
+    (VOID)EvtSysSignal(EVT_SYS_FS_READY);
+    return NULL;
+}
+
+UINT32 EvtSysFsProbeStart(const CHAR *path)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 taskId;
+    UINT32 intSave;
+    UINT32 ret;
+
+    SysEventInitOnce();
+    intSave = LOS_IntLock();
+    if (g_fsProbeStarted) {
+        LOS_IntRestore(intSave);
+        return LOS_OK;
+    }
+    g_fsProbeStarted = TRUE;
+    LOS_IntRestore(intSave);
+
+    g_fsProbePath = path;
+    param.pfnTaskEntry = (TSK_ENTRY_FUNC)FsProbeEntry;
+    param.uwStackSize  = EVT_SYS_FS_PROBE_STACK;
+    param.pcName       = "EvtFsProbe";
+    param.usTaskPrio   = EVT_SYS_FS_PROBE_PRI;
+    ret = LOS_TaskCreate(&taskId, &param);
+    if (ret != LOS_OK) {
+        g_fsProbeStarted = FALSE;
+        return ret;
+    }
+    return LOS_OK;
+}
@@ -0,0 +1,90 @@
+#ifndef APP_EVENT_WAKE_H
+#define APP_EVENT_WAKE_H
+
+#include "los_event.h"
+#include "cmsis_os2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 事件驱动的任务唤醒
+ * 任务阻塞在 LOS 事件上，直到数据到达 (EvtWaiterSignal)、截止时间到达 (一次性软件定时器)、
+ * 周期到达 (周期软件定时器) 或系统就绪信号出现，期间不产生任何轮询唤醒。
+ * 定时器回调在软件定时器任务中执行，只做一次 LOS_EventWrite。
+ */
+
+// 低 8 位留给调用者的数据事件，高位由框架占用
+#define EVT_WAKE_USER_MASK       0x00FFU
+#define EVT_WAKE_DEADLINE        0x0100U
+#define EVT_WAKE_PERIOD          0x0200U
+#define EVT_WAKE_STOP            0x0400U
+
+// 系统就绪事件：置位后保持，所有等待者都能看到
+#define EVT_SYS_FS_READY         0x0001U
+
+// 文件系统探测的退避区间 (tick) 与探测任务参数
+#define EVT_SYS_FS_PROBE_MIN     1
+#define EVT_SYS_FS_PROBE_MAX     64
+#define EVT_SYS_FS_PROBE_STACK   0x4000
+#define EVT_SYS_FS_PROBE_PRI     12
+
+typedef struct {
+    EVENT_CB_S event;
+    osTimerId_t deadline;
+    osTimerId_t period;
+    UINT32 wakeups;              // EvtWaiterWait 成功返回的次数
+    UINT32 timeouts;
+} EvtWaiter;
+
+/**
+ * @brief 初始化等待对象，定时器按需创建
+ */
+UINT32 EvtWaiterInit(EvtWaiter *w);
+
+/**
+ * @brief 停止并删除定时器，销毁事件；调用前等待者须已退出
+ */
+VOID EvtWaiterDeinit(EvtWaiter *w);
+
+/**
+ * @brief ticks 后置位 EVT_WAKE_DEADLINE，重复调用会重新计时
+ */
+UINT32 EvtWaiterDeadline(EvtWaiter *w, UINT32 ticks);
+
+/**
+ * @brief 每 ticks 置位一次 EVT_WAKE_PERIOD；ticks 为 0 时停止
+ */
+UINT32 EvtWaiterPeriod(EvtWaiter *w, UINT32 ticks);
+
+/**
+ * @brief 置位事件，可在中断中调用
+ */
+UINT32 EvtWaiterSignal(EvtWaiter *w, UINT32 bits);
+
+/**
+ * @brief 等待 mask 中任一事件，返回到达的事件并清除；超时返回 0
+ */
+UINT32 EvtWaiterWait(EvtWaiter *w, UINT32 mask, UINT32 timeout);
+
+/**
+ * @brief 置位系统就绪事件；板级代码在挂载文件系统后可直接调用
+ */
+UINT32 EvtSysSignal(UINT32 bits);
+
+/**
+ * @brief 等待系统就绪事件全部置位 (不清除)；超时返回 LOS_NOK
+ */
+UINT32 EvtSysWait(UINT32 bits, UINT32 timeout);
+
+/**
+ * @brief 板级代码不发信号时，由一个低优先级任务以指数退避探测 path 是否可访问，
+ *        成功后置位 EVT_SYS_FS_READY 并退出；stat 不在软件定时器任务中执行
+ */
+UINT32 EvtSysFsProbeStart(const CHAR *path);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
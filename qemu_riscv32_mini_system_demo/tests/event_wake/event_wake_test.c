@@ -0,0 +1,457 @@
+/*
+ * 轮询与事件驱动唤醒对比
+ * 同一组任务以两种方式各运行 RUN_SEC 秒：
+ *   monitor   每 2 秒出一次报告；轮询版每 50 tick 醒来检查时间 (同调度测试的 MonitorTaskEntry)
+ *   consumer  等待生产者的数据；轮询版每 tick 检查标志
+ *   deadline  到达截止时间后处理；轮询版每 10 tick 检查一次
+ *   fs        等待文件系统就绪；轮询版固定睡眠 (同 file_test 的 osDelay(3000))
+ * 由 cpu_monitor 统计区间内除 idle 外所有任务的切入次数 (唤醒次数) 与 idle 占用。
+ * 开启 LOSCFG_KERNEL_PM 时 idle 进入低功耗，idle 占用越高、唤醒越少，可睡眠的时间越长。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+
+#include "cpu_monitor.h"
+#include "event_wake.h"
+#include "event_wake_test.h"
+#include "test_assert.h"
+
+#define TASK_STACK_SIZE          0x1000
+#define CTRL_TASK_PRI            4
+#define MONITOR_TASK_PRI         6
+#define PRODUCER_TASK_PRI        8
+#define WORKER_TASK_PRI          10
+
+#define RUN_SEC                  10
+#define REPORT_TICKS             (2 * LOSCFG_BASE_CORE_TICK_PER_SECOND)
+#define MONITOR_POLL_TICKS       50
+#define PRODUCE_TICKS            30
+#define DEADLINE_TICKS           LOSCFG_BASE_CORE_TICK_PER_SECOND
+#define DEADLINE_POLL_TICKS      10
+#define FS_FIXED_WAIT_TICKS      (3 * LOSCFG_BASE_CORE_TICK_PER_SECOND)
+#define FS_PROBE_PATH            "/data"
+
+#define EVT_DATA                 0x01U
+
+typedef enum {
+    MODE_POLL = 0,
+    MODE_EVENT,
+    MODE_NUM,
+} WakeMode;
+
+typedef struct {
+    UINT32 wakeups;          // 区间内除 idle 外所有任务的切入次数
+    UINT32 taskWakeups;      // 其中本测试任务的切入次数
+    UINT32 idlePermille;
+    UINT32 reports;
+    UINT32 produced;
+    UINT32 consumed;
+    UINT32 deadlines;
+    UINT32 fsReadyMs;        // 0xFFFFFFFF 表示未就绪
+} WakeResult;
+
+static TestStats g_stats = { 0 };
+
+#define WAKE_TASK_NUM            5
+
+/* ================= 全局变量 ================= */
+static const CHAR *g_modeNames[MODE_NUM] = { "poll", "event" };
+static volatile BOOL g_running = FALSE;
+static volatile BOOL g_producing = FALSE;
+static volatile BOOL g_producerDone = FALSE;
+static volatile UINT32 g_alive = 0;
+static volatile UINT32 g_pending = 0;
+static WakeResult g_res;
+static UINT64 g_startTick;
+static UINT32 g_taskIds[WAKE_TASK_NUM];
+static UINT32 g_taskNum;
+
+static EvtWaiter g_monitorWaiter;
+static EvtWaiter g_consumerWaiter;
+static EvtWaiter g_deadlineWaiter;
+
+static CpuMonSnapshot g_snapBegin;
+static CpuMonSnapshot g_snapEnd;
+static UINT32 g_switchBegin[CPU_MON_MAX_TASKS];
+
+static VOID TaskExit(VOID)
+{
+    UINT32 intSave = LOS_IntLock();
+    g_alive--;
+    LOS_IntRestore(intSave);
+}
+
+/**
+ * @brief 取走所有已到达的数据
+ */
+static VOID ConsumeAll(VOID)
+{
+    while (g_pending != 0) {
+        UINT32 intSave = LOS_IntLock();
+        g_pending--;
+        LOS_IntRestore(intSave);
+        g_res.consumed++;
+    }
+}
+
+/* ================= 轮询版任务 ================= */
+
+static VOID *MonitorPollEntry(UINTPTR arg)
+{
+    UINT64 last = LOS_TickCountGet();
+
+    (VOID)arg;
+    while (g_running) {
+        (VOID)LOS_TaskDelay(MONITOR_POLL_TICKS);
+        if (LOS_TickCountGet() - last >= REPORT_TICKS) {
+            last = LOS_TickCountGet();
+            g_res.reports++;
+        }
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID *ConsumerPollEntry(UINTPTR arg)
+{
+    (VOID)arg;
+    while (g_running) {
+        if (g_pending == 0) {
+            (VOID)LOS_TaskDelay(1);
+            continue;
+        }
+        UINT32 intSave = LOS_IntLock();
+        g_pending--;
+        LOS_IntRestore(intSave);
+        g_res.consumed++;
+    }
+    // 生产者已先停止，退出前取走剩余数据
+    ConsumeAll();
+    TaskExit();
+    return NULL;
+}
+
+static VOID *DeadlinePollEntry(UINTPTR arg)
+{
+    (VOID)arg;
+    while (g_running) {
+        UINT64 deadline = LOS_TickCountGet() + DEADLINE_TICKS;
+        while (g_running && LOS_TickCountGet() < deadline) {
+            (VOID)LOS_TaskDelay(DEADLINE_POLL_TICKS);
+        }
+        if (g_running) {
+            g_res.deadlines++;
+        }
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID *FsPollEntry(UINTPTR arg)
+{
+    (VOID)arg;
+    // 原实现：固定睡眠后假定文件系统可用
+    (VOID)LOS_TaskDelay(FS_FIXED_WAIT_TICKS);
+    g_res.fsReadyMs = (UINT32)((LOS_TickCountGet() - g_startTick) * 1000 / LOSCFG_BASE_CORE_TICK_PER_SECOND);
+    TaskExit();
+    return NULL;
+}
+
+/* ================= 事件版任务 ================= */
+
+static VOID *MonitorEventEntry(UINTPTR arg)
+{
+    (VOID)arg;
+    (VOID)EvtWaiterPeriod(&g_monitorWaiter, REPORT_TICKS);
+    while (1) {
+        UINT32 bits = EvtWaiterWait(&g_monitorWaiter, EVT_WAKE_PERIOD | EVT_WAKE_STOP, LOS_WAIT_FOREVER);
+        if ((bits & EVT_WAKE_STOP) != 0) {
+            break;
+        }
+        g_res.reports++;
+    }
+    (VOID)EvtWaiterPeriod(&g_monitorWaiter, 0);
+    TaskExit();
+    return NULL;
+}
+
+static VOID *ConsumerEventEntry(UINTPTR arg)
+{
+    (VOID)arg;
+    while (1) {
+        UINT32 bits = EvtWaiterWait(&g_consumerWaiter, EVT_DATA | EVT_WAKE_STOP, LOS_WAIT_FOREVER);
+        // 一次唤醒取走所有已到达的数据；停止时生产者已退出，取完剩余数据再走
+        ConsumeAll();
+        if ((bits & EVT_WAKE_STOP) != 0) {
+            break;
+        }
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID *DeadlineEventEntry(UINTPTR arg)
+{
+    (VOID)arg;
+    while (1) {
+        (VOID)EvtWaiterDeadline(&g_deadlineWaiter, DEADLINE_TICKS);
+        UINT32 bits = EvtWaiterWait(&g_deadlineWaiter, EVT_WAKE_DEADLINE | EVT_WAKE_STOP, LOS_WAIT_FOREVER);
+        if ((bits & EVT_WAKE_STOP) != 0) {
+            break;
+        }
+        g_res.deadlines++;
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID *FsEventEntry(UINTPTR arg)
+{
+    (VOID)arg;
+    (VOID)EvtSysFsProbeStart(FS_PROBE_PATH);
+    if (EvtSysWait(EVT_SYS_FS_READY, RUN_SEC * LOSCFG_BASE_CORE_TICK_PER_SECOND) == LOS_OK) {
+        g_res.fsReadyMs = (UINT32)((LOS_TickCountGet() - g_startTick) * 1000 / LOSCFG_BASE_CORE_TICK_PER_SECOND);
+    }
+    TaskExit();
+    return NULL;
+}
+
+/* ================= 公共任务 ================= */
+
+static VOID *ProducerEntry(UINTPTR arg)
+{
+    WakeMode mode = (WakeMode)arg;
+
+    while (g_producing) {
+        (VOID)LOS_TaskDelay(PRODUCE_TICKS);
+        if (!g_producing) {
+            break;
+        }
+        UINT32 intSave = LOS_IntLock();
+        g_pending++;
+        LOS_IntRestore(intSave);
+        g_res.produced++;
+        if (mode == MODE_EVENT) {
+            (VOID)EvtWaiterSignal(&g_consumerWaiter, EVT_DATA);
+        }
+    }
+    g_producerDone = TRUE;
+    TaskExit();
+    return NULL;
+}
+
+/* ================= 测试流程 ================= */
+
+static UINT32 SpawnTask(const CHAR *name, TSK_ENTRY_FUNC entry, UINT16 prio, UINTPTR arg)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 id;
+    UINT32 ret;
+
+    param.pfnTaskEntry = entry;
+    param.uwStackSize  = TASK_STACK_SIZE;
+    param.pcName       = (CHAR *)name;
+    param.usTaskPrio   = prio;
+    param.uwArg        = arg;
+    ret = LOS_TaskCreate(&id, &param);
+    if (ret != LOS_OK) {
+        printf("create %s failed: 0x%X\n", name, ret);
+        return ret;
+    }
+    g_alive++;
+    if (g_taskNum < WAKE_TASK_NUM) {
+        g_taskIds[g_taskNum++] = id;
+    }
+    return LOS_OK;
+}
+
+static VOID MeasureBegin(VOID)
+{
+    CpuMonTaskUsage usage;
+
+    CpuMonSnapshotTake(&g_snapBegin);
+    for (UINT32 id = 0; id < CPU_MON_MAX_TASKS; id++) {
+        g_switchBegin[id] = (CpuMonTaskUsageGet(id, &usage) == LOS_OK) ? usage.switchIns : 0;
+    }
+}
+
+static VOID MeasureEnd(WakeResult *res)
+{
+    CpuMonTaskUsage usage;
+
+    CpuMonSnapshotTake(&g_snapEnd);
+    for (UINT32 id = 0; id < CPU_MON_MAX_TASKS; id++) {
+        if (id == g_idleTaskID || CpuMonTaskUsageGet(id, &usage) != LOS_OK) {
+            continue;
+        }
+        UINT32 delta = usage.switchIns - g_switchBegin[id];
+        res->wakeups += delta;
+        for (UINT32 i = 0; i < g_taskNum; i++) {
+            if (g_taskIds[i] == id) {
+                res->taskWakeups += delta;
+            }
+        }
+    }
+    res->idlePermille = CpuMonIntervalUsage(&g_snapBegin, &g_snapEnd, g_idleTaskID, NULL);
+}
+
+static UINT32 RunMode(WakeMode mode, WakeResult *out)
+{
+    UINT32 ret = LOS_OK;
+    UINT32 prodRet;
+
+    memset(&g_res, 0, sizeof(g_res));
+    g_res.fsReadyMs = 0xFFFFFFFF;
+    g_pending = 0;
+    g_alive = 0;
+    g_taskNum = 0;
+    g_running = TRUE;
+    g_producing = TRUE;
+    g_producerDone = FALSE;
+
+    if (mode == MODE_EVENT) {
+        (VOID)EvtWaiterInit(&g_monitorWaiter);
+        (VOID)EvtWaiterInit(&g_consumerWaiter);
+        (VOID)EvtWaiterInit(&g_deadlineWaiter);
+    }
+
+    MeasureBegin();
+    g_startTick = LOS_TickCountGet();
+    if (mode == MODE_POLL) {
+        ret = SpawnTask("WakeMonitor", (TSK_ENTRY_FUNC)MonitorPollEntry, MONITOR_TASK_PRI, 0);
+        ret |= SpawnTask("WakeConsumer", (TSK_ENTRY_FUNC)ConsumerPollEntry, WORKER_TASK_PRI, 0);
+        ret |= SpawnTask("WakeDeadline", (TSK_ENTRY_FUNC)DeadlinePollEntry, WORKER_TASK_PRI, 0);
+        ret |= SpawnTask("WakeFs", (TSK_ENTRY_FUNC)FsPollEntry, WORKER_TASK_PRI, 0);
+    } else {
+        ret = SpawnTask("WakeMonitor", (TSK_ENTRY_FUNC)MonitorEventEntry, MONITOR_TASK_PRI, 0);
+        ret |= SpawnTask("WakeConsumer", (TSK_ENTRY_FUNC)ConsumerEventEntry, WORKER_TASK_PRI, 0);
+        ret |= SpawnTask("WakeDeadline", (TSK_ENTRY_FUNC)DeadlineEventEntry, WORKER_TASK_PRI, 0);
+        ret |= SpawnTask("WakeFs", (TSK_ENTRY_FUNC)FsEventEntry, WORKER_TASK_PRI, 0);
+    }
+    prodRet = SpawnTask("WakeProducer", (TSK_ENTRY_FUNC)ProducerEntry, PRODUCER_TASK_PRI, (UINTPTR)mode);
+    ret |= prodRet;
+
+    (VOID)LOS_TaskDelay(RUN_SEC * LOSCFG_BASE_CORE_TICK_PER_SECOND);
+    MeasureEnd(&g_res);
+
+    // 先停生产者并等它退出，消费者收到停止时不会再有新数据，produced 与 consumed 可直接比较
+    g_producing = FALSE;
+    while (prodRet == LOS_OK && !g_producerDone) {
+        (VOID)LOS_TaskDelay(1);
+    }
+    g_running = FALSE;
+    if (mode == MODE_EVENT) {
+        (VOID)EvtWaiterSignal(&g_monitorWaiter, EVT_WAKE_STOP);
+        (VOID)EvtWaiterSignal(&g_consumerWaiter, EVT_WAKE_STOP);
+        (VOID)EvtWaiterSignal(&g_deadlineWaiter, EVT_WAKE_STOP);
+    }
+    while (g_alive != 0) {
+        (VOID)LOS_TaskDelay(1);
+    }
+    if (mode == MODE_EVENT) {
+        EvtWaiterDeinit(&g_monitorWaiter);
+        EvtWaiterDeinit(&g_consumerWaiter);
+        EvtWaiterDeinit(&g_deadlineWaiter);
+    }
+
+    *out = g_res;
+    return ret;
+}
+
+static VOID PrintResult(WakeMode mode, const WakeResult *r)
+{
+    printf("%-6s | %9u.%u | %9u.%u | %5u.%u%% | %7u | %5u/%-5u | %9u | ",
+           g_modeNames[mode],
+           r->wakeups / RUN_SEC, (r->wakeups % RUN_SEC) * 10 / RUN_SEC,
+           r->taskWakeups / RUN_SEC, (r->taskWakeups % RUN_SEC) * 10 / RUN_SEC,
+           r->idlePermille / 10, r->idlePermille % 10,
+           r->reports, r->consumed, r->produced, r->deadlines);
+    if (r->fsReadyMs == 0xFFFFFFFF) {
+        printf("%s\n", "n/a");
+    } else {
+        printf("%u\n", r->fsReadyMs);
+    }
+}
+
+static VOID *EventWakeTestTask(UINTPTR arg)
+{
+    WakeResult res[MODE_NUM];
+
+    (VOID)arg;
+    printf("\n>>> Event-driven Wake-up Test <<<\n");
+#ifdef LOSCFG_KERNEL_PM
+    printf("LOSCFG_KERNEL_PM: on\n");
+#else
+    printf("LOSCFG_KERNEL_PM: off (idle%% still comparable, no low-power residency)\n");
+#endif
+    if (CpuMonInit() != LOS_OK) {
+        printf("cpu monitor init failed\n");
+        return NULL;
+    }
+
+    for (UINT32 m = 0; m < MODE_NUM; m++) {
+        if (RunMode((WakeMode)m, &res[m]) != LOS_OK) {
+            printf("mode %s setup failed\n", g_modeNames[m]);
+            return NULL;
+        }
+    }
+
+    printf("\n%-6s | %-11s | %-11s | %-7s | %-7s | %-11s | %-9s | %s\n",
+           "Mode", "Wakeups/s", "TaskWake/s", "Idle", "Reports", "Consumed", "Deadlines", "FsReadyMs");
+    printf("-------|-------------|-------------|---------|---------|-------------|-----------|----------\n");
+    for (UINT32 m = 0; m < MODE_NUM; m++) {
+        PrintResult((WakeMode)m, &res[m]);
+    }
+    // 便于脚本提取的单行结果
+    for (UINT32 m = 0; m < MODE_NUM; m++) {
+        printf("WAKE mode=%s run_s=%u wakeups=%u task_wakeups=%u idle_permille=%u fs_ready_ms=%d\n",
+               g_modeNames[m], RUN_SEC, res[m].wakeups, res[m].taskWakeups, res[m].idlePermille,
+               (res[m].fsReadyMs == 0xFFFFFFFF) ? -1 : (INT32)res[m].fsReadyMs);
+    }
+
+    const WakeResult *poll = &res[MODE_POLL];
+    const WakeResult *evt = &res[MODE_EVENT];
+    if (poll->taskWakeups != 0) {
+        // 事件版唤醒可能多于轮询版，差值按有符号计算
+        INT32 cut = (INT32)(((INT64)poll->taskWakeups - (INT64)evt->taskWakeups) * 1000 /
+                            (INT64)poll->taskWakeups);
+        printf("task wake-ups reduced by %s%d.%d%%, idle %+d permille\n", (cut < 0) ? "-" : "",
+               ((cut < 0) ? -cut : cut) / 10, ((cut < 0) ? -cut : cut) % 10,
+               (INT32)evt->idlePermille - (INT32)poll->idlePermille);
+    }
+
+    TEST_ASSERT(evt->taskWakeups < poll->taskWakeups, "事件驱动的任务唤醒次数少于轮询");
+    TEST_ASSERT(evt->idlePermille >= poll->idlePermille, "事件驱动的 idle 占用不低于轮询");
+    TEST_ASSERT(evt->consumed == evt->produced, "事件驱动消费者取走全部数据");
+    // 轮询版按 50 tick 粒度检查，区间边界上可能差一次
+    TEST_ASSERT(evt->reports + 1 >= poll->reports && poll->reports + 1 >= evt->reports,
+                "两种方式的监控报告次数一致");
+    TEST_ASSERT(evt->deadlines >= RUN_SEC - 1, "截止事件按时到达");
+
+    TEST_SUMMARY();
+    return NULL;
+}
+
+void EventWakeTestApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)EventWakeTestTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "EventWakeTestTask";
+    task.usTaskPrio   = CTRL_TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("EventWakeTestTask create failed: 0x%X\n", ret);
+    }
+}
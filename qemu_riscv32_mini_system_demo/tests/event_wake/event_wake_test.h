@@ -0,0 +1,13 @@
+#ifndef APP_EVENT_WAKE_TEST_H
+#define APP_EVENT_WAKE_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void EventWakeTestApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
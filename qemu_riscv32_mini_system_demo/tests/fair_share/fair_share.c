@@ -0,0 +1,364 @@
+/*
+ * 同优先级任务组的加权公平调度 (虚拟运行时间)
+ * 运行周期来自 cpu_monitor，结算在 CMSIS 周期定时器 (软件定时器任务) 中完成，
+ * 通过 LOS_TaskPriSet 在 prio / prio + 1 之间切换成员。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "los_task.h"
+#include "los_config.h"
+#include "cmsis_os2.h"
+
+#include "cpu_monitor.h"
+#include "fair_share.h"
+
+#define FAIR_SHARE_NONE          0xFFFFFFFF
+
+typedef struct {
+    BOOL used;
+    UINT32 taskId;
+    UINT32 weight;
+    UINT64 lastRun;         // 上次结算时 cpu_monitor 给出的累计运行周期
+    UINT64 runCycles;
+    UINT64 vruntime;
+} FairShareMember;
+
+typedef struct {
+    BOOL used;
+    BOOL running;
+    UINT16 prio;
+    UINT32 current;         // 当前被提升的成员下标
+    UINT64 minVruntime;     // 可运行成员虚拟运行时间最小值，单调不减
+    FairShareMember members[FAIR_SHARE_MAX_MEMBERS];
+} FairShareGroup;
+
+/* ================= 全局变量 ================= */
+static FairShareGroup g_groups[FAIR_SHARE_MAX_GROUPS];
+static osTimerId_t g_settleTimer = NULL;
+
+/* ================= 结算 ================= */
+
+static UINT64 TaskRunCycles(UINT32 taskId)
+{
+    CpuMonTaskUsage usage;
+
+    if (CpuMonTaskUsageGet(taskId, &usage) != LOS_OK) {
+        return 0;
+    }
+    return usage.runCycles;
+}
+
+static VOID MemberCharge(FairShareMember *m)
+{
+    UINT64 run = TaskRunCycles(m->taskId);
+    UINT64 delta = (run > m->lastRun) ? (run - m->lastRun) : 0;
+
+    m->lastRun = run;
+    m->runCycles += delta;
+    m->vruntime += delta * FAIR_SHARE_WEIGHT_UNIT / m->weight;
+}
+
+static UINT64 MinVruntime(const FairShareGroup *g)
+{
+    UINT64 min = 0;
+    BOOL found = FALSE;
+
+    for (UINT32 i = 0; i < FAIR_SHARE_MAX_MEMBERS; i++) {
+        const FairShareMember *m = &g->members[i];
+        if (m->used && (!found || m->vruntime < min)) {
+            min = m->vruntime;
+            found = TRUE;
+        }
+    }
+    return min;
+}
+
+static BOOL MemberRunnable(const FairShareMember *m)
+{
+    return (OS_TCB_FROM_TID(m->taskId)->taskStatus & (OS_TASK_STATUS_READY | OS_TASK_STATUS_RUNNING)) != 0;
+}
+
+/**
+ * @brief 推进组的 minVruntime，并把落后于它的成员拉到 minVruntime
+ * 阻塞的成员不累计虚拟运行时间，若不钳位，唤醒后会凭积攒的差值长期独占 CPU
+ */
+static VOID GroupClamp(FairShareGroup *g)
+{
+    UINT64 floor = 0;
+    BOOL found = FALSE;
+
+    for (UINT32 i = 0; i < FAIR_SHARE_MAX_MEMBERS; i++) {
+        const FairShareMember *m = &g->members[i];
+        if (m->used && MemberRunnable(m) && (!found || m->vruntime < floor)) {
+            floor = m->vruntime;
+            found = TRUE;
+        }
+    }
+    if (found && floor > g->minVruntime) {
+        g->minVruntime = floor;
+    }
+    for (UINT32 i = 0; i < FAIR_SHARE_MAX_MEMBERS; i++) {
+        FairShareMember *m = &g->members[i];
+        if (m->used && m->vruntime < g->minVruntime) {
+            m->vruntime = g->minVruntime;
+        }
+    }
+}
+
+/**
+ * @brief 结算组内成员并提升可运行成员中虚拟运行时间最小者，需在调度锁内调用
+ * 阻塞成员被钳位到 minVruntime 后会与最慢的可运行成员持平，不能参与挑选，否则按下标先到先得
+ * 会把提升留给阻塞任务，可运行成员全部停在 prio + 1 轮转，权重失效；
+ * 没有可运行成员时保持现状
+ */
+static VOID GroupSettle(FairShareGroup *g)
+{
+    UINT32 pick = FAIR_SHARE_NONE;
+
+    for (UINT32 i = 0; i < FAIR_SHARE_MAX_MEMBERS; i++) {
+        if (g->members[i].used) {
+            MemberCharge(&g->members[i]);
+        }
+    }
+    GroupClamp(g);
+    for (UINT32 i = 0; i < FAIR_SHARE_MAX_MEMBERS; i++) {
+        FairShareMember *m = &g->members[i];
+        if (!m->used || !MemberRunnable(m)) {
+            continue;
+        }
+        if (pick == FAIR_SHARE_NONE || m->vruntime < g->members[pick].vruntime) {
+            pick = i;
+        }
+    }
+    if (pick == FAIR_SHARE_NONE || pick == g->current) {
+        return;
+    }
+    if (g->current != FAIR_SHARE_NONE) {
+        (void)LOS_TaskPriSet(g->members[g->current].taskId, g->prio + 1);
+    }
+    if (pick != FAIR_SHARE_NONE) {
+        (void)LOS_TaskPriSet(g->members[pick].taskId, g->prio);
+    }
+    g->current = pick;
+}
+
+static VOID FairShareTick(VOID *arg)
+{
+    (void)arg;
+    LOS_TaskLock();
+    for (UINT32 i = 0; i < FAIR_SHARE_MAX_GROUPS; i++) {
+        if (g_groups[i].used && g_groups[i].running) {
+            GroupSettle(&g_groups[i]);
+        }
+    }
+    LOS_TaskUnlock();
+}
+
+/* ================= 组管理 ================= */
+
+static FairShareGroup *GroupGet(UINT32 groupId)
+{
+    if (groupId >= FAIR_SHARE_MAX_GROUPS || !g_groups[groupId].used) {
+        return NULL;
+    }
+    return &g_groups[groupId];
+}
+
+static UINT32 FairShareTimerInit(VOID)
+{
+    if (g_settleTimer != NULL) {
+        return LOS_OK;
+    }
+    if (CpuMonInit() != LOS_OK) {
+        return LOS_NOK;
+    }
+    g_settleTimer = osTimerNew((osTimerFunc_t)FairShareTick, osTimerPeriodic, NULL, NULL);
+    if (g_settleTimer == NULL) {
+        return LOS_NOK;
+    }
+    if (osTimerStart(g_settleTimer, FAIR_SHARE_PERIOD_TICKS) != osOK) {
+        (void)osTimerDelete(g_settleTimer);
+        g_settleTimer = NULL;
+        return LOS_NOK;
+    }
+    return LOS_OK;
+}
+
+UINT32 FairShareGroupCreate(UINT16 prio, UINT32 *groupId)
+{
+    UINT32 ret = LOS_NOK;
+
+    // prio + 1 仍需高于 idle
+    if (groupId == NULL || prio + 1 >= OS_TASK_PRIORITY_LOWEST) {
+        return LOS_NOK;
+    }
+    if (FairShareTimerInit() != LOS_OK) {
+        printf("[fairshare] settle timer start failed\n");
+        return LOS_NOK;
+    }
+
+    LOS_TaskLock();
+    for (UINT32 i = 0; i < FAIR_SHARE_MAX_GROUPS; i++) {
+        if (!g_groups[i].used) {
+            memset(&g_groups[i], 0, sizeof(FairShareGroup));
+            g_groups[i].used = TRUE;
+            g_groups[i].prio = prio;
+            g_groups[i].current = FAIR_SHARE_NONE;
+            *groupId = i;
+            ret = LOS_OK;
+            break;
+        }
+    }
+    LOS_TaskUnlock();
+    return ret;
+}
+
+UINT32 FairShareGroupDelete(UINT32 groupId)
+{
+    FairShareGroup *g = GroupGet(groupId);
+
+    if (g == NULL) {
+        return LOS_NOK;
+    }
+    (void)FairShareStop(groupId);
+    g->used = FALSE;
+    return LOS_OK;
+}
+
+UINT32 FairShareJoin(UINT32 groupId, UINT32 taskId, UINT32 weight)
+{
+    FairShareGroup *g = GroupGet(groupId);
+    UINT32 ret = LOS_NOK;
+
+    if (g == NULL) {
+        return LOS_NOK;
+    }
+    LOS_TaskLock();
+    for (UINT32 i = 0; i < FAIR_SHARE_MAX_MEMBERS; i++) {
+        FairShareMember *m = &g->members[i];
+        if (m->used) {
+            continue;
+        }
+        // 先取最小值再置 used，新成员不参与自身的比较；组空时沿用组的 minVruntime
+        m->vruntime = MinVruntime(g);
+        if (m->vruntime < g->minVruntime) {
+            m->vruntime = g->minVruntime;
+        }
+        m->used = TRUE;
+        m->taskId = taskId;
+        m->weight = (weight == 0) ? FAIR_SHARE_WEIGHT_UNIT : weight;
+        m->lastRun = TaskRunCycles(taskId);
+        m->runCycles = 0;
+        (void)LOS_TaskPriSet(taskId, g->running ? g->prio + 1 : g->prio);
+        ret = LOS_OK;
+        break;
+    }
+    LOS_TaskUnlock();
+    return ret;
+}
+
+UINT32 FairShareLeave(UINT32 groupId, UINT32 taskId)
+{
+    FairShareGroup *g = GroupGet(groupId);
+    UINT32 ret = LOS_NOK;
+
+    if (g == NULL) {
+        return LOS_NOK;
+    }
+    LOS_TaskLock();
+    for (UINT32 i = 0; i < FAIR_SHARE_MAX_MEMBERS; i++) {
+        FairShareMember *m = &g->members[i];
+        if (m->used && m->taskId == taskId) {
+            m->used = FALSE;
+            if (g->current == i) {
+                g->current = FAIR_SHARE_NONE;
+            }
+            (void)LOS_TaskPriSet(taskId, g->prio);
+            ret = LOS_OK;
+            break;
+        }
+    }
+    LOS_TaskUnlock();
+    return ret;
+}
+
+UINT32 FairShareStart(UINT32 groupId)
+{
+    FairShareGroup *g = GroupGet(groupId);
+
+    if (g == NULL) {
+        return LOS_NOK;
+    }
+    LOS_TaskLock();
+    for (UINT32 i = 0; i < FAIR_SHARE_MAX_MEMBERS; i++) {
+        FairShareMember *m = &g->members[i];
+        if (m->used) {
+            // 停止期间的运行时间不计入份额
+            m->lastRun = TaskRunCycles(m->taskId);
+            (void)LOS_TaskPriSet(m->taskId, g->prio + 1);
+        }
+    }
+    g->current = FAIR_SHARE_NONE;
+    g->running = TRUE;
+    GroupSettle(g);
+    LOS_TaskUnlock();
+    return LOS_OK;
+}
+
+UINT32 FairShareStop(UINT32 groupId)
+{
+    FairShareGroup *g = GroupGet(groupId);
+
+    if (g == NULL) {
+        return LOS_NOK;
+    }
+    LOS_TaskLock();
+    if (g->running) {
+        for (UINT32 i = 0; i < FAIR_SHARE_MAX_MEMBERS; i++) {
+            FairShareMember *m = &g->members[i];
+            if (m->used) {
+                MemberCharge(m);
+                (void)LOS_TaskPriSet(m->taskId, g->prio);
+            }
+        }
+    }
+    g->running = FALSE;
+    g->current = FAIR_SHARE_NONE;
+    LOS_TaskUnlock();
+    return LOS_OK;
+}
+
+UINT32 FairShareStatsGet(UINT32 groupId, FairShareMemberStats *out, UINT32 max)
+{
+    FairShareGroup *g = GroupGet(groupId);
+    UINT64 totalRun = 0;
+    UINT64 totalWeight = 0;
+    UINT32 n = 0;
+
+    if (g == NULL || out == NULL) {
+        return 0;
+    }
+    LOS_TaskLock();
+    for (UINT32 i = 0; i < FAIR_SHARE_MAX_MEMBERS && n < max; i++) {
+        const FairShareMember *m = &g->members[i];
+        if (!m->used) {
+            continue;
+        }
+        out[n].taskId = m->taskId;
+        out[n].weight = m->weight;
+        out[n].runCycles = m->runCycles;
+        out[n].vruntime = m->vruntime;
+        totalRun += m->runCycles;
+        totalWeight += m->weight;
+        n++;
+    }
+    LOS_TaskUnlock();
+
+    for (UINT32 i = 0; i < n; i++) {
+        out[i].share = (totalRun == 0) ? 0 : (UINT32)(out[i].runCycles * 1000 / totalRun);
+        out[i].target = (UINT32)((UINT64)out[i].weight * 1000 / totalWeight);
+    }
+    return n;
+}
@@ -0,0 +1,69 @@
+#ifndef APP_FAIR_SHARE_H
+#define APP_FAIR_SHARE_H
+
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FAIR_SHARE_MAX_GROUPS    2
+#define FAIR_SHARE_MAX_MEMBERS   8
+// 权重 1024 为 1 份，与 CFS 的 nice 0 权重同一量级
+#define FAIR_SHARE_WEIGHT_UNIT   1024
+// 结算周期 (tick)，决定份额收敛的粒度
+#ifndef FAIR_SHARE_PERIOD_TICKS
+#define FAIR_SHARE_PERIOD_TICKS  2
+#endif
+
+/*
+ * 同优先级任务组的加权公平调度
+ * 内核只有优先级 + 时间片轮转，这里不改内核：组内成员平时停在 prio + 1，
+ * 周期定时器按切换钩子统计的运行周期累计各成员虚拟运行时间 (运行周期 / 权重)，
+ * 把虚拟运行时间最小的成员提升到 prio。被提升的成员阻塞时其余成员照常运行，不浪费 CPU。
+ * 组内维护单调的 minVruntime (可运行成员的最小值)，成员加入或阻塞后唤醒时不低于它。
+ * prio + 1 上不应再有组外任务，否则会与停放的成员抢占 CPU。
+ */
+typedef struct {
+    UINT32 taskId;
+    UINT32 weight;
+    UINT64 runCycles;       // 入组以来的运行周期
+    UINT64 vruntime;        // 按权重折算后的虚拟运行时间
+    UINT32 share;           // 占组内运行时间的千分比
+    UINT32 target;          // 按权重应得的千分比
+} FairShareMemberStats;
+
+/**
+ * @brief 创建任务组，prio 为组内成员被提升时的优先级
+ * 首次调用时初始化 cpu_monitor 并启动结算定时器
+ */
+UINT32 FairShareGroupCreate(UINT16 prio, UINT32 *groupId);
+
+/**
+ * @brief 删除任务组，成员恢复到 prio
+ */
+UINT32 FairShareGroupDelete(UINT32 groupId);
+
+/**
+ * @brief 加入任务组，weight 为 0 时使用 FAIR_SHARE_WEIGHT_UNIT
+ * 新成员的虚拟运行时间取组内最小值，不会因为入组晚而长期独占 CPU
+ */
+UINT32 FairShareJoin(UINT32 groupId, UINT32 taskId, UINT32 weight);
+
+UINT32 FairShareLeave(UINT32 groupId, UINT32 taskId);
+
+/**
+ * @brief 启动 / 停止组的份额控制；停止后成员恢复到 prio，退化为普通时间片轮转
+ */
+UINT32 FairShareStart(UINT32 groupId);
+UINT32 FairShareStop(UINT32 groupId);
+
+/**
+ * @brief 读出成员统计，返回实际条数
+ */
+UINT32 FairShareStatsGet(UINT32 groupId, FairShareMemberStats *out, UINT32 max);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
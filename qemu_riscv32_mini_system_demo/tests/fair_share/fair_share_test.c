@@ -0,0 +1,271 @@
+/*
+ * 加权公平调度测试
+ * 1. 权重 1:2:4 的三个 CPU-hog 租户，份额应接近 1/7、2/7、4/7
+ * 2. 等权重的 hog 与频繁 Yield 的租户，份额应各占一半，不受命令形态影响
+ * 对照组为关闭份额控制的普通时间片轮转，仅打印不做断言。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+
+#include "cpu_monitor.h"
+#include "fair_share.h"
+#include "fair_share_test.h"
+#include "test_assert.h"
+
+#define TASK_STACK_SIZE          0x1000
+#define CTRL_TASK_PRI            5
+#define TENANT_PRI               12
+
+#define TENANT_MAX               3
+#define SCENARIO_SEC             4
+#define SLEEPER_BURST            4        // 睡眠租户每计算几轮睡一个 tick
+// 份额允许偏差 (千分比，绝对值)
+#define FAIR_SHARE_TOLERANCE     30
+
+static TestStats g_stats = { 0 };
+
+typedef enum {
+    TENANT_HOG = 0,     // 长命令：持续计算
+    TENANT_YIELDER,     // 短命令：每条命令后 Yield
+    TENANT_SLEEPER,     // 周期性阻塞：计算若干轮后睡眠
+} TenantType;
+
+typedef struct {
+    UINT32 taskId;
+    CHAR name[16];
+    TenantType type;
+    UINT32 weight;
+} Tenant;
+
+/* ================= 全局变量 ================= */
+static Tenant g_tenants[TENANT_MAX];
+static volatile BOOL g_tenantRunning = FALSE;
+static volatile UINT32 g_tenantAlive = 0;
+
+static VOID BurnCpu(UINT32 intensity)
+{
+    volatile UINT32 res = 0;
+    for (UINT32 i = 0; i < intensity; i++) {
+        res += i * i;
+    }
+    (void)res;
+}
+
+static VOID *TenantTaskEntry(UINTPTR arg)
+{
+    const Tenant *t = &g_tenants[arg];
+    UINT32 rounds = 0;
+
+    while (g_tenantRunning) {
+        if (t->type == TENANT_YIELDER) {
+            BurnCpu(200);
+            LOS_TaskYield();
+        } else if (t->type == TENANT_SLEEPER) {
+            BurnCpu(5000);
+            if (++rounds % SLEEPER_BURST == 0) {
+                LOS_TaskDelay(1);
+            }
+        } else {
+            BurnCpu(5000);
+        }
+    }
+    UINT32 intSave = LOS_IntLock();
+    g_tenantAlive--;
+    LOS_IntRestore(intSave);
+    return NULL;
+}
+
+/**
+ * @brief 解散任务组并等待已创建的租户退出
+ */
+static VOID StopTenants(BOOL fair, UINT32 groupId)
+{
+    if (fair) {
+        (void)FairShareGroupDelete(groupId);
+    }
+    g_tenantRunning = FALSE;
+    while (g_tenantAlive != 0) {
+        LOS_TaskDelay(1);
+    }
+}
+
+/**
+ * @brief 创建租户并运行 SCENARIO_SEC 秒，返回各租户占组内运行时间的千分比
+ * fair 为 FALSE 时不启用份额控制，作为对照
+ */
+static UINT32 RunScenario(const TenantType *types, const UINT32 *weights, UINT32 count, BOOL fair,
+                          UINT32 share[TENANT_MAX])
+{
+    static CpuMonSnapshot before;
+    static CpuMonSnapshot after;
+    TSK_INIT_PARAM_S param;
+    UINT32 groupId = 0;
+    UINT64 run[TENANT_MAX] = { 0 };
+    UINT64 total = 0;
+    UINT32 weightSum = 0;
+    UINT32 ret;
+
+    if (fair && FairShareGroupCreate(TENANT_PRI, &groupId) != LOS_OK) {
+        printf("FairShareGroupCreate failed\n");
+        return LOS_NOK;
+    }
+
+    g_tenantRunning = TRUE;
+    g_tenantAlive = 0;
+    // 控制任务优先级更高，租户在它睡眠后才开始运行，可以放心逐个创建
+    for (UINT32 i = 0; i < count; i++) {
+        Tenant *t = &g_tenants[i];
+        (void)snprintf(t->name, sizeof(t->name), "Tenant%u", i);
+        t->type = types[i];
+        t->weight = weights[i];
+
+        memset(&param, 0, sizeof(param));
+        param.pfnTaskEntry = (TSK_ENTRY_FUNC)TenantTaskEntry;
+        param.uwStackSize  = TASK_STACK_SIZE;
+        param.pcName       = t->name;
+        param.usTaskPrio   = TENANT_PRI;
+        param.uwArg        = i;
+        ret = LOS_TaskCreate(&t->taskId, &param);
+        if (ret != LOS_OK) {
+            printf("create %s failed: 0x%X\n", t->name, ret);
+            StopTenants(fair, groupId);
+            return ret;
+        }
+        g_tenantAlive++;
+        if (fair) {
+            (void)FairShareJoin(groupId, t->taskId, t->weight);
+        }
+    }
+    if (fair) {
+        (void)FairShareStart(groupId);
+    }
+
+    CpuMonSnapshotTake(&before);
+    LOS_TaskDelay(SCENARIO_SEC * LOSCFG_BASE_CORE_TICK_PER_SECOND);
+    CpuMonSnapshotTake(&after);
+    StopTenants(fair, groupId);
+
+    for (UINT32 i = 0; i < count; i++) {
+        (void)CpuMonIntervalUsage(&before, &after, g_tenants[i].taskId, &run[i]);
+        total += run[i];
+        weightSum += weights[i];
+    }
+    printf("%-10s | %-7s | %-6s | %-8s | %-8s\n", "Tenant", "Type", "Weight", "Share", "Target");
+    printf("-----------|---------|--------|----------|---------\n");
+    for (UINT32 i = 0; i < count; i++) {
+        UINT32 target = weights[i] * 1000 / weightSum;
+        share[i] = (total == 0) ? 0 : (UINT32)(run[i] * 1000 / total);
+        printf("%-10s | %-7s | %-6u | %3u.%u%%   | %3u.%u%%\n", g_tenants[i].name,
+               types[i] == TENANT_YIELDER ? "Yield" : (types[i] == TENANT_SLEEPER ? "Sleep" : "Hog"), weights[i],
+               share[i] / 10, share[i] % 10, target / 10, target % 10);
+    }
+    return LOS_OK;
+}
+
+static BOOL ShareWithin(UINT32 share, UINT32 weight, UINT32 weightSum)
+{
+    UINT32 target = weight * 1000 / weightSum;
+    UINT32 diff = (share > target) ? (share - target) : (target - share);
+    return diff <= FAIR_SHARE_TOLERANCE;
+}
+
+static VOID TestWeightedHogs(VOID)
+{
+    static const TenantType types[] = { TENANT_HOG, TENANT_HOG, TENANT_HOG };
+    static const UINT32 weights[] = { FAIR_SHARE_WEIGHT_UNIT, 2 * FAIR_SHARE_WEIGHT_UNIT,
+                                      4 * FAIR_SHARE_WEIGHT_UNIT };
+    UINT32 share[TENANT_MAX];
+    CHAR msg[64];
+
+    printf("\n=== 测试1: 权重 1:2:4 的 CPU-hog 租户 ===\n");
+    if (RunScenario(types, weights, 3, TRUE, share) != LOS_OK) {
+        TEST_ASSERT(FALSE, "weighted scenario setup");
+        return;
+    }
+    for (UINT32 i = 0; i < 3; i++) {
+        (void)snprintf(msg, sizeof(msg), "Tenant%u share within %u.%u%%", i,
+                       FAIR_SHARE_TOLERANCE / 10, FAIR_SHARE_TOLERANCE % 10);
+        TEST_ASSERT(ShareWithin(share[i], weights[i], 7 * FAIR_SHARE_WEIGHT_UNIT), msg);
+    }
+}
+
+static VOID TestCommandMix(VOID)
+{
+    static const TenantType types[] = { TENANT_HOG, TENANT_YIELDER };
+    static const UINT32 weights[] = { FAIR_SHARE_WEIGHT_UNIT, FAIR_SHARE_WEIGHT_UNIT };
+    UINT32 share[TENANT_MAX];
+
+    printf("\n=== 对照: 时间片轮转下 hog 与 yielder ===\n");
+    (void)RunScenario(types, weights, 2, FALSE, share);
+
+    printf("\n=== 测试2: 份额控制下 hog 与 yielder ===\n");
+    if (RunScenario(types, weights, 2, TRUE, share) != LOS_OK) {
+        TEST_ASSERT(FALSE, "command mix scenario setup");
+        return;
+    }
+    TEST_ASSERT(ShareWithin(share[0], weights[0], 2 * FAIR_SHARE_WEIGHT_UNIT), "hog tenant gets half");
+    TEST_ASSERT(ShareWithin(share[1], weights[1], 2 * FAIR_SHARE_WEIGHT_UNIT), "yielding tenant gets half");
+}
+
+/**
+ * @brief 权重最高的租户周期性阻塞，其余两个 hog 之间仍应按 1:2 分配
+ */
+static VOID TestSleepingMember(VOID)
+{
+    static const TenantType types[] = { TENANT_SLEEPER, TENANT_HOG, TENANT_HOG };
+    static const UINT32 weights[] = { 4 * FAIR_SHARE_WEIGHT_UNIT, FAIR_SHARE_WEIGHT_UNIT,
+                                      2 * FAIR_SHARE_WEIGHT_UNIT };
+    UINT32 share[TENANT_MAX];
+    UINT32 hogSum;
+
+    printf("\n=== 测试3: 权重 4 的租户周期性睡眠，hog 权重 1:2 ===\n");
+    if (RunScenario(types, weights, 3, TRUE, share) != LOS_OK) {
+        TEST_ASSERT(FALSE, "sleeping member scenario setup");
+        return;
+    }
+    hogSum = share[1] + share[2];
+    TEST_ASSERT(share[0] > 0, "sleeping tenant still runs");
+    TEST_ASSERT(hogSum != 0 && ShareWithin(share[2] * 1000 / hogSum, weights[2], weights[1] + weights[2]),
+                "hogs keep the 1:2 split while a member sleeps");
+}
+
+static VOID *FairShareTestTask(UINTPTR arg)
+{
+    (void)arg;
+    printf("\n>>> Fair-share Scheduling Test (tolerance %u.%u%%) <<<\n",
+           FAIR_SHARE_TOLERANCE / 10, FAIR_SHARE_TOLERANCE % 10);
+    if (CpuMonInit() != LOS_OK) {
+        printf("CpuMonInit failed\n");
+        return NULL;
+    }
+
+    TestWeightedHogs();
+    TestCommandMix();
+    TestSleepingMember();
+
+    TEST_SUMMARY();
+    return NULL;
+}
+
+void FairShareTestApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)FairShareTestTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "FairShareTestTask";
+    task.usTaskPrio   = CTRL_TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("FairShareTestTask create failed: 0x%X\n", ret);
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef APP_FAIR_SHARE_TEST_H
+#define APP_FAIR_SHARE_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void FairShareTestApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
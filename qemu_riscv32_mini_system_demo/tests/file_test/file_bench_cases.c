@@ -0,0 +1,121 @@
+/*
+ * file 套件的注册表用例
+ *   file.create  20 次 fopen("w") / fputs / fclose
+ *   file.rw_4k   4 x 4KB 写入后读回校验
+ * 文件放在 /data/storage/bench 下，teardown 时删除。
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "los_task.h"
+
+#include "event_wake.h"
+#include "bench_registry.h"
+
+#define BENCH_FILE_DIR           "/data/storage/bench"
+#define CREATE_COUNT             20
+#define RW_CHUNK                 4096
+#define RW_CHUNKS                4
+#define PATH_LEN                 48
+#define FS_READY_TIMEOUT         3000
+
+/* ================= 全局变量 ================= */
+static CHAR g_chunk[RW_CHUNK];
+static CHAR g_readBack[RW_CHUNK];
+
+static VOID FilePath(CHAR *buf, UINT32 index)
+{
+    (void)snprintf(buf, PATH_LEN, BENCH_FILE_DIR "/f%02u.txt", index);
+}
+
+static UINT32 FileSetup(VOID)
+{
+    struct stat st;
+
+    (void)EvtSysFsProbeStart("/data");
+    (void)EvtSysWait(EVT_SYS_FS_READY, FS_READY_TIMEOUT);
+    if (stat(BENCH_FILE_DIR, &st) != 0 && mkdir(BENCH_FILE_DIR, 0755) != 0) {
+        printf("[bench] mkdir %s failed, is /data mounted?\n", BENCH_FILE_DIR);
+        return LOS_NOK;
+    }
+    for (UINT32 i = 0; i < RW_CHUNK; i++) {
+        g_chunk[i] = (CHAR)('a' + i % 26);
+    }
+    return LOS_OK;
+}
+
+static VOID FileTeardown(VOID)
+{
+    CHAR path[PATH_LEN];
+
+    for (UINT32 i = 0; i <= CREATE_COUNT; i++) {
+        FilePath(path, i);
+        (void)unlink(path);
+    }
+}
+
+static UINT32 CreateRun(UINT32 iter, BenchMetrics *metrics)
+{
+    CHAR path[PATH_LEN];
+
+    (void)iter;
+    for (UINT32 i = 0; i < CREATE_COUNT; i++) {
+        FilePath(path, i);
+        FILE *fp = fopen(path, "w");
+        if (fp == NULL) {
+            return LOS_NOK;
+        }
+        (void)fputs("bench\n", fp);
+        (void)fclose(fp);
+    }
+    BenchMetricSet(metrics, "files", CREATE_COUNT);
+    return LOS_OK;
+}
+
+static UINT32 ReadWriteRun(UINT32 iter, BenchMetrics *metrics)
+{
+    CHAR path[PATH_LEN];
+    UINT32 ret = LOS_OK;
+    FILE *fp;
+
+    (void)iter;
+    FilePath(path, CREATE_COUNT);
+    fp = fopen(path, "wb");
+    if (fp == NULL) {
+        return LOS_NOK;
+    }
+    for (UINT32 i = 0; i < RW_CHUNKS; i++) {
+        if (fwrite(g_chunk, 1, RW_CHUNK, fp) != RW_CHUNK) {
+            ret = LOS_NOK;
+        }
+    }
+    (void)fclose(fp);
+
+    fp = fopen(path, "rb");
+    if (fp == NULL) {
+        return LOS_NOK;
+    }
+    for (UINT32 i = 0; i < RW_CHUNKS; i++) {
+        if (fread(g_readBack, 1, RW_CHUNK, fp) != RW_CHUNK || memcmp(g_readBack, g_chunk, RW_CHUNK) != 0) {
+            ret = LOS_NOK;
+        }
+    }
+    (void)fclose(fp);
+    BenchMetricSet(metrics, "bytes", RW_CHUNK * RW_CHUNKS * 2);
+    return ret;
+}
+
+static const BenchCase g_fileCreate = {
+    .name = "file.create", .suite = "file", .desc = "20 x fopen/fputs/fclose",
+    .iterations = 5, .setup = FileSetup, .run = CreateRun, .teardown = FileTeardown,
+};
+BENCH_REGISTER(g_fileCreate);
+
+static const BenchCase g_fileReadWrite = {
+    .name = "file.rw_4k", .suite = "file", .desc = "write 16KB in 4KB chunks, read back and verify",
+    .iterations = 5, .setup = FileSetup, .run = ReadWriteRun, .teardown = FileTeardown,
+};
+BENCH_REGISTER(g_fileReadWrite);
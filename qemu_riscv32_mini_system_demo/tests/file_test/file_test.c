@@ -7,9 +7,13 @@
 #include "cmsis_os2.h"
 #include "los_task.h"
 #include "los_tick.h"
+#include "event_wake.h"
+#include "perf_bench.h"
 
 #define TASK_STACK_SIZE      0x4000
 #define TASK_PRI             8
+// 文件系统就绪的最长等待 (原固定睡眠时长)
+#define FS_READY_TIMEOUT     3000
 
 // 测试配置
 #define TEST_FILE_PATH    "/data/storage/test_file.txt"
@@ -121,7 +125,10 @@ static void comprehensive_file_test(void)
     for (int i = 0; tests[i].name != NULL; i++) {
         printf("\n[测试 %d] %s...\n", i + 1, tests[i].name);
         
+        PerfRegion *region = PerfRegionGet(tests[i].name);
+        PerfRegionBegin(region);
         int result = tests[i].function();
+        PerfRegionEnd(region);
         if (result == 0) {
             printf("%s 通过\n", tests[i].name);
         } else {
@@ -147,6 +154,7 @@ static void comprehensive_file_test(void)
     } else {
         printf("发现 %d 个错误，请检查文件系统\n", total_errors);
     }
+    PERF_REPORT();
 }
 
 // ========== 具体的测试函数实现 ==========
@@ -405,20 +413,24 @@ static int test_performance(void)
     printf("执行性能测试...\n");
     
     const int iterations = 100;
-    uint32_t start_time = osKernelGetTickCount();
+    PerfCounters start, end;
+    PerfRead(&start);
     
     for (int i = 0; i < iterations; i++) {
+        PERF_BEGIN("fopen(w)");
         FILE* fp = fopen(TEST_FILE_PATH, "w");
+        PERF_END("fopen(w)");
         if (!fp) {
             printf("错误: 性能测试中无法创建文件\n");
             return -1;
         }
-        fputs("性能测试数据\n", fp);
-        fclose(fp);
+        PERF_MEASURE("fputs", fputs("性能测试数据\n", fp));
+        PERF_MEASURE("fclose", fclose(fp));
     }
     
-    uint32_t duration = osKernelGetTickCount() - start_time;
-    printf("性能测试: %d 次操作耗时 %u 毫秒\n", iterations, duration);
+    PerfRead(&end);
+    printf("性能测试: %d 次操作 %llu 周期, %llu 条指令 (平均每次 %llu 周期)\n", iterations,
+           end.cycles - start.cycles, end.instret - start.instret, (end.cycles - start.cycles) / iterations);
     
     return 0;
 }
@@ -463,8 +475,11 @@ static void safe_file_test_task(void* arg)
     
     printf("文件测试任务启动...\n");
     
-    // 等待系统稳定
-    osDelay(3000);
+    // 等待文件系统就绪：探测到挂载点可访问即返回，最多等 FS_READY_TIMEOUT
+    (void)EvtSysFsProbeStart("/data");
+    if (EvtSysWait(EVT_SYS_FS_READY, FS_READY_TIMEOUT) != LOS_OK) {
+        printf("文件系统未就绪，继续执行\n");
+    }
     
     // 执行综合测试
     comprehensive_file_test();
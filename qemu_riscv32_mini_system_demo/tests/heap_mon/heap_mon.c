@@ -0,0 +1,374 @@
+/*
+ * 堆碎片监视与堆图转储
+ * 遍历在关中断下分段进行，每段最多 HEAP_WALK_CHUNK 个节点，段间开中断；
+ * 重新关中断后先核对当前节点与前一节点的链接，堆在段间被改动时从头重走。
+ * 堆图缓冲区由互斥锁保护，文件写入在锁外的任务上下文中完成。
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "los_task.h"
+#include "los_config.h"
+#include "los_memory.h"
+#include "los_interrupt.h"
+#include "los_mux.h"
+#include "los_tick.h"
+#include "shcmd.h"
+
+#include "heap_mon.h"
+
+// 告警时在监视任务中直接写堆图文件，栈与文件测试任务相同
+#define HEAP_MON_STACK_SIZE      0x4000
+#define HEAP_MON_PRI             20
+// 在池首这一范围内查找首节点
+#define HEAP_HEAD_SEARCH         4096
+// 每次关中断最多遍历的节点数，以及堆在段间被改动时的重走次数
+#define HEAP_WALK_CHUNK          64
+#define HEAP_WALK_RETRIES        4
+
+typedef enum {
+    WALK_DONE = 0,
+    WALK_LAYOUT,                // 节点布局与预期不符
+    WALK_CHANGED,               // 段间堆被改动
+} WalkResult;
+
+/* ================= 节点布局 ================= */
+// 与 kernel/liteos_m/kernel/src/mm/los_memory.c 的 struct OsMemNodeHead 保持一致
+
+typedef struct HeapNode {
+#if (LOSCFG_BASE_MEM_NODE_INTEGRITY_CHECK == 1)
+    UINT32 magic;
+#endif
+#if (LOSCFG_MEM_LEAKCHECK == 1)
+    UINTPTR linkReg[LOSCFG_MEM_RECORD_LR_CNT];
+#endif
+    struct HeapNode *prev;      // 物理上的前一个节点，首节点指向尾哨兵
+#if (LOSCFG_TASK_MEM_USED == 1)
+    UINT32 taskID;
+#endif
+    UINT32 sizeAndFlag;
+} HeapNode;
+
+#define NODE_USED_FLAG           (1U << 31)
+#define NODE_FLAG_MASK           (7U << 29)         // 已用 / 对齐 / 区域尾
+#define NODE_SIZE(node)          ((node)->sizeAndFlag & ~NODE_FLAG_MASK)
+#define NODE_IS_USED(node)       (((node)->sizeAndFlag & NODE_USED_FLAG) != 0)
+
+/* ================= 全局变量 ================= */
+static HeapMap g_map;
+static UINT32 g_mapMux;
+static UINT32 g_minMaxFree = 0xFFFFFFFFU;
+static UINT32 g_minFree = 0xFFFFFFFFU;
+static UINT32 g_alarms = 0;
+static BOOL g_alarm = FALSE;
+static BOOL g_inited = FALSE;
+
+/* ================= 遍历 ================= */
+
+// 尾哨兵位于池末尾，首节点是池首之后第一个 prev 指向它的节点头
+static HeapNode *FirstNodeFind(UINT8 *pool, UINT32 size)
+{
+    HeapNode *end = (HeapNode *)(pool + size - sizeof(HeapNode));
+    UINT32 limit = (size < HEAP_HEAD_SEARCH) ? size : HEAP_HEAD_SEARCH;
+
+    // 池首第一个字是 info.pool，从其后开始
+    for (UINT32 off = offsetof(HeapNode, prev) + sizeof(UINTPTR); off + sizeof(HeapNode) <= limit;
+         off += sizeof(UINTPTR)) {
+        if (*(HeapNode **)(pool + off) != end) {
+            continue;
+        }
+        HeapNode *node = (HeapNode *)(pool + off - offsetof(HeapNode, prev));
+        UINT32 nodeSize = NODE_SIZE(node);
+        if (nodeSize >= sizeof(HeapNode) && (UINT8 *)node + nodeSize <= (UINT8 *)end) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+static UINT32 HistBin(UINT32 size)
+{
+    UINT32 bin = 0;
+
+    while (bin < HEAP_HIST_BINS - 1 && size >= (1U << (HEAP_HIST_MIN_SHIFT + bin))) {
+        bin++;
+    }
+    return bin;
+}
+
+static VOID MapMark(HeapMap *map, UINT32 shift, UINT32 start, UINT32 len)
+{
+    UINT32 end = start + len;
+
+    while (start < end) {
+        UINT32 cell = start >> shift;
+        UINT32 cellEnd = (cell + 1) << shift;
+        UINT32 chunk = ((end < cellEnd) ? end : cellEnd) - start;
+        UINT32 v = map->cells[cell] + (chunk * 255 + (map->cellSize >> 1)) / map->cellSize;
+
+        map->cells[cell] = (UINT8)((v > 255) ? 255 : v);
+        start += chunk;
+    }
+}
+
+// 分段遍历，段内持有中断锁
+static WalkResult PoolWalk(UINT8 *pool, UINT32 size, HeapReport *report, HeapMap *map, UINT32 shift)
+{
+    HeapNode *end = (HeapNode *)(pool + size - sizeof(HeapNode));
+    HeapNode *node;
+    HeapNode *prev = end;
+    UINT32 intSave = LOS_IntLock();
+
+    node = FirstNodeFind(pool, size);
+    if (node == NULL) {
+        LOS_IntRestore(intSave);
+        return WALK_LAYOUT;
+    }
+    if (map != NULL) {
+        MapMark(map, shift, 0, (UINT32)((UINT8 *)node - pool));
+        MapMark(map, shift, size - sizeof(HeapNode), sizeof(HeapNode));
+    }
+    for (UINT32 n = 1; node != end; n++) {
+        UINT32 nodeSize = NODE_SIZE(node);
+        if (node->prev != prev || nodeSize < sizeof(HeapNode) || (UINT8 *)node + nodeSize > (UINT8 *)end) {
+            LOS_IntRestore(intSave);
+            return WALK_LAYOUT;
+        }
+        if (NODE_IS_USED(node)) {
+            report->usedNodes++;
+            report->usedBytes += nodeSize;
+            if (map != NULL) {
+                MapMark(map, shift, (UINT32)((UINT8 *)node - pool), nodeSize);
+            }
+        } else {
+            UINT32 bin = HistBin(nodeSize);
+            report->freeNodes++;
+            report->freeBytes += nodeSize;
+            report->histCount[bin]++;
+            report->histBytes[bin] += nodeSize;
+            if (nodeSize > report->maxFreeBlock) {
+                report->maxFreeBlock = nodeSize;
+            }
+        }
+        prev = node;
+        node = (HeapNode *)((UINT8 *)node + nodeSize);
+        if (n % HEAP_WALK_CHUNK != 0 || node == end) {
+            continue;
+        }
+        LOS_IntRestore(intSave);
+        intSave = LOS_IntLock();
+        // prev 被释放合并或 node 被并入 prev 时，这两个条件至少一个不再成立
+        if ((UINT8 *)prev + NODE_SIZE(prev) != (UINT8 *)node || node->prev != prev) {
+            LOS_IntRestore(intSave);
+            return WALK_CHANGED;
+        }
+    }
+    LOS_IntRestore(intSave);
+    return WALK_DONE;
+}
+
+UINT32 HeapMonInspect(VOID *pool, HeapReport *report, HeapMap *map)
+{
+    LOS_MEM_POOL_STATUS status = { 0 };
+    UINT32 size = LOS_MemPoolSizeGet(pool);
+    UINT32 shift = HEAP_MAP_MIN_CELL_SHIFT;
+    WalkResult result = WALK_LAYOUT;
+    BOOL walked;
+
+    if (map != NULL) {
+        while (((size + (1U << shift) - 1) >> shift) > HEAP_MAP_MAX_CELLS) {
+            shift++;
+        }
+        map->cellSize = 1U << shift;
+        map->cellCount = (size + map->cellSize - 1) >> shift;
+    }
+    for (UINT32 retry = 0; retry < HEAP_WALK_RETRIES && size > sizeof(HeapNode); retry++) {
+        (void)memset(report, 0, sizeof(*report));
+        if (map != NULL) {
+            (void)memset(map->cells, 0, sizeof(map->cells));
+        }
+        result = PoolWalk((UINT8 *)pool, size, report, map, shift);
+        if (result != WALK_CHANGED) {
+            break;
+        }
+    }
+    walked = (result == WALK_DONE);
+
+    if (!walked) {
+        (void)memset(report, 0, sizeof(*report));
+        (void)LOS_MemInfoGet(pool, &status);
+        report->usedBytes = status.totalUsedSize;
+        report->freeBytes = status.totalFreeSize;
+        report->maxFreeBlock = status.maxFreeNodeSize;
+        report->freeNodes = status.freeNodeNum;
+        report->usedNodes = status.usedNodeNum;
+        if (map != NULL) {
+            map->cellCount = 0;
+        }
+    }
+    report->walked = walked ? 1 : 0;
+    report->poolSize = size;
+    report->fragPct = (report->freeBytes == 0) ? 0 :
+        100 - (UINT32)((UINT64)report->maxFreeBlock * 100 / report->freeBytes);
+    return walked ? LOS_OK : LOS_NOK;
+}
+
+/* ================= 输出 ================= */
+
+VOID HeapMonPrint(const HeapReport *report)
+{
+    printf("heap: size %u used %u (%u nodes) free %u (%u nodes) max free %u frag %u%%\n",
+           report->poolSize, report->usedBytes, report->usedNodes, report->freeBytes, report->freeNodes,
+           report->maxFreeBlock, report->fragPct);
+    if (!report->walked) {
+        printf("heap: node layout not recognised, histogram unavailable\n");
+        return;
+    }
+    printf("%-16s %8s %10s\n", "free block size", "count", "bytes");
+    for (UINT32 i = 0; i < HEAP_HIST_BINS; i++) {
+        UINT32 lo = (i == 0) ? 0 : (1U << (HEAP_HIST_MIN_SHIFT + i - 1));
+        if (i == HEAP_HIST_BINS - 1) {
+            printf(">= %-13u %8u %10u\n", lo, report->histCount[i], report->histBytes[i]);
+        } else {
+            printf("%6u..%-8u %8u %10u\n", lo, (1U << (HEAP_HIST_MIN_SHIFT + i)) - 1,
+                   report->histCount[i], report->histBytes[i]);
+        }
+    }
+}
+
+UINT32 HeapMonMapDump(const CHAR *path)
+{
+    HeapMapHeader hdr = { 0 };
+    FILE *fp;
+    BOOL ok;
+
+    if (!g_inited) {
+        return LOS_NOK;
+    }
+    if (path == NULL) {
+        path = HEAP_MAP_FILE;
+    }
+    (void)LOS_MuxPend(g_mapMux, LOS_WAIT_FOREVER);
+    if (HeapMonInspect(OS_SYS_MEM_ADDR, &hdr.report, &g_map) != LOS_OK) {
+        (void)LOS_MuxPost(g_mapMux);
+        printf("[heapmon] node layout not recognised, no map\n");
+        return LOS_NOK;
+    }
+    hdr.magic = HEAP_MAP_MAGIC;
+    hdr.version = HEAP_MAP_VERSION;
+    hdr.histBins = HEAP_HIST_BINS;
+    hdr.poolBase = (UINT32)(UINTPTR)OS_SYS_MEM_ADDR;
+    hdr.tick = (UINT32)LOS_TickCountGet();
+    hdr.cellSize = g_map.cellSize;
+    hdr.cellCount = g_map.cellCount;
+    hdr.minMaxFreeBlock = (g_minMaxFree == 0xFFFFFFFFU) ? 0 : g_minMaxFree;
+
+    if (access(HEAP_MAP_DIR, F_OK) != 0) {
+        (void)mkdir(HEAP_MAP_DIR, 0755);
+    }
+    fp = fopen(path, "wb");
+    if (fp == NULL) {
+        (void)LOS_MuxPost(g_mapMux);
+        printf("[heapmon] cannot create %s\n", path);
+        return LOS_NOK;
+    }
+    ok = fwrite(&hdr, sizeof(hdr), 1, fp) == 1 &&
+         fwrite(g_map.cells, 1, g_map.cellCount, fp) == g_map.cellCount;
+    fclose(fp);
+    (void)LOS_MuxPost(g_mapMux);
+    printf("[heapmon] %s %s\n", ok ? "map saved" : "write failed:", path);
+    return ok ? LOS_OK : LOS_NOK;
+}
+
+/* ================= 低水位告警 ================= */
+
+static VOID HeapMonCheck(VOID)
+{
+    HeapReport report;
+
+    (void)HeapMonInspect(OS_SYS_MEM_ADDR, &report, NULL);
+    if (report.maxFreeBlock < g_minMaxFree) {
+        g_minMaxFree = report.maxFreeBlock;
+    }
+    if (report.freeBytes < g_minFree) {
+        g_minFree = report.freeBytes;
+    }
+    if (!g_alarm && report.maxFreeBlock < HEAP_LOW_WATER_BLOCK) {
+        g_alarm = TRUE;
+        g_alarms++;
+        printf("[heapmon] WARNING: largest free block %u < %u, allocations above it will fail\n",
+               report.maxFreeBlock, (UINT32)HEAP_LOW_WATER_BLOCK);
+        HeapMonPrint(&report);
+        (void)HeapMonMapDump(HEAP_MAP_ALARM_FILE);
+    } else if (g_alarm && report.maxFreeBlock >= HEAP_LOW_WATER_BLOCK + HEAP_LOW_WATER_BLOCK / 8) {
+        g_alarm = FALSE;
+        printf("[heapmon] recovered: largest free block %u\n", report.maxFreeBlock);
+    }
+}
+
+static VOID HeapMonTask(VOID)
+{
+    for (;;) {
+        (void)LOS_TaskDelay(HEAP_MON_PERIOD_TICKS);
+        HeapMonCheck();
+    }
+}
+
+/* ================= shell 命令 ================= */
+
+static UINT32 HeapMonCmd(UINT32 argc, const CHAR **argv)
+{
+    HeapReport report;
+
+    if (argc == 0 || strcmp(argv[0], "report") == 0) {
+        (void)HeapMonInspect(OS_SYS_MEM_ADDR, &report, NULL);
+        HeapMonPrint(&report);
+        printf("low water: max free %u free %u, threshold %u, alarms %u%s\n",
+               (g_minMaxFree == 0xFFFFFFFFU) ? report.maxFreeBlock : g_minMaxFree,
+               (g_minFree == 0xFFFFFFFFU) ? report.freeBytes : g_minFree,
+               (UINT32)HEAP_LOW_WATER_BLOCK, g_alarms, g_alarm ? " (active)" : "");
+        return LOS_OK;
+    }
+    if (strcmp(argv[0], "map") == 0) {
+        return HeapMonMapDump((argc >= 2) ? argv[1] : NULL);
+    }
+    printf("usage: heapmon [report] | map [path]\n");
+    return LOS_NOK;
+}
+
+UINT32 HeapMonInit(VOID)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 taskId;
+
+    if (g_inited) {
+        return LOS_OK;
+    }
+    if (LOS_MuxCreate(&g_mapMux) != LOS_OK) {
+        return LOS_NOK;
+    }
+    param.pfnTaskEntry = (TSK_ENTRY_FUNC)HeapMonTask;
+    param.uwStackSize  = HEAP_MON_STACK_SIZE;
+    param.pcName       = "HeapMon";
+    param.usTaskPrio   = HEAP_MON_PRI;
+    if (LOS_TaskCreate(&taskId, &param) != LOS_OK) {
+        (void)LOS_MuxDelete(g_mapMux);
+        printf("[heapmon] task create failed\n");
+        return LOS_NOK;
+    }
+    (void)osCmdReg(CMD_TYPE_EX, "heapmon", XARGS, (CmdCallBackFunc)HeapMonCmd);
+    g_inited = TRUE;
+    return LOS_OK;
+}
+
+void HeapMonApp(void)
+{
+    if (HeapMonInit() == LOS_OK) {
+        printf("[heapmon] checking every %u ticks, alarm below %u bytes, use 'heapmon' for the report\n",
+               (UINT32)HEAP_MON_PERIOD_TICKS, (UINT32)HEAP_LOW_WATER_BLOCK);
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef APP_HEAP_MON_H
+#define APP_HEAP_MON_H
+
+#include "los_task.h"
+#include "los_config.h"
+#include "los_memory.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 堆碎片监视
+ * 逐节点遍历 LiteOS-M 内存池，给出空闲块大小直方图、最大空闲块与碎片指数
+ * (100 - 最大空闲块 * 100 / 总空闲，与 alloc_replay 的 frag_pct 一致)，并可把整池占用
+ * 压缩成每格一字节的堆图写到 HEAP_MAP_DIR，由 tools/heapmap_render.py 在主机端渲染。
+ * 监视任务每 HEAP_MON_PERIOD_TICKS 检查一次系统堆，最大空闲块低于 HEAP_LOW_WATER_BLOCK 时告警
+ * 并转储一份堆图，回升到阈值的 9/8 以上后解除，避免在阈值附近反复告警。
+ * 节点布局是内核私有的，遍历前用 "首节点 prev 指向尾哨兵、相邻节点 prev 互指" 自检，
+ * 不符时 (如 LOSCFG_MEM_FREE_BY_TASKID、多区域内存池) 只给出 LOS_MemInfoGet 的汇总，不生成直方图与堆图。
+ * 遍历分段关中断，堆在段间被改动时重走，连续被打断 HEAP_WALK_RETRIES 次后同样只给出汇总。
+ * heap_tlsf 打开时应用的 malloc 落在 TLSF 堆上，在系统堆中只表现为一个大的已用块。
+ */
+
+#define HEAP_HIST_BINS           12                 // [0,32) [32,64) ... [16K,32K) [32K,∞)
+#define HEAP_HIST_MIN_SHIFT      5
+#define HEAP_MAP_MAX_CELLS       4096
+#define HEAP_MAP_MIN_CELL_SHIFT  4
+#define HEAP_MAP_DIR             "/data/heap"
+#define HEAP_MAP_FILE            HEAP_MAP_DIR "/heapmap.bin"
+#define HEAP_MAP_ALARM_FILE      HEAP_MAP_DIR "/heapmap_alarm.bin"
+#define HEAP_MAP_MAGIC           0x50414D48U        // "HMAP"
+#define HEAP_MAP_VERSION         1
+#ifndef HEAP_MON_PERIOD_TICKS
+#define HEAP_MON_PERIOD_TICKS    LOSCFG_BASE_CORE_TICK_PER_SECOND
+#endif
+#ifndef HEAP_LOW_WATER_BLOCK
+#define HEAP_LOW_WATER_BLOCK     (64 * 1024)
+#endif
+
+typedef struct {
+    UINT32 walked;              // 0: 节点布局自检失败，直方图为空
+    UINT32 poolSize;
+    UINT32 usedBytes;
+    UINT32 freeBytes;
+    UINT32 maxFreeBlock;
+    UINT32 freeNodes;
+    UINT32 usedNodes;
+    UINT32 fragPct;
+    UINT32 histCount[HEAP_HIST_BINS];
+    UINT32 histBytes[HEAP_HIST_BINS];
+} HeapReport;
+
+/*
+ * 堆图：把内存池等分为 cellCount 格，每格记录已用比例 (0 全空闲，255 全占用，节点头计入所属节点)
+ */
+typedef struct {
+    UINT32 cellSize;            // 2 的幂，不小于 1 << HEAP_MAP_MIN_CELL_SHIFT
+    UINT32 cellCount;
+    UINT8 cells[HEAP_MAP_MAX_CELLS];
+} HeapMap;
+
+/*
+ * 堆图文件格式 (小端)：HeapMapHeader 后接 cellCount 字节
+ */
+typedef struct {
+    UINT32 magic;
+    UINT16 version;
+    UINT16 histBins;
+    UINT32 poolBase;
+    UINT32 tick;                // 转储时的 tick 低 32 位
+    UINT32 cellSize;
+    UINT32 cellCount;
+    UINT32 minMaxFreeBlock;     // 监视期间最大空闲块的最低值，未启动监视时为 0
+    HeapReport report;
+} HeapMapHeader;
+
+/**
+ * @brief 遍历内存池
+ * @param map 可为 NULL；不为 NULL 时顺带生成堆图
+ * @return LOS_NOK 节点布局自检失败或遍历反复被打断，report 中只有 LOS_MemInfoGet 的汇总
+ */
+UINT32 HeapMonInspect(VOID *pool, HeapReport *report, HeapMap *map);
+
+VOID HeapMonPrint(const HeapReport *report);
+
+/**
+ * @brief 遍历系统堆并把堆图写入 path (NULL 时为 HEAP_MAP_FILE)
+ */
+UINT32 HeapMonMapDump(const CHAR *path);
+
+/**
+ * @brief 启动监视任务并注册 shell 命令 heapmon，重复调用无副作用
+ */
+UINT32 HeapMonInit(VOID);
+
+void HeapMonApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,520 @@
+/*
+ * IPC 原语基准 (参考 Rhealstone 的思路)
+ * 对 queue / event / sem 三种消息型原语分别测量：
+ *   pingpong  两个任务经一对通道往返，取单次往返周期
+ *   oneway    单生产者连续发送，高优先级消费者接收，取每秒消息数
+ *   contend   1..8 个同优先级生产者向同一消费者发送，取每秒消息数
+ * mutex 不传递消息，对应测量：
+ *   pingpong  持锁任务释放到高优先级等待者获得锁的交接周期
+ *   oneway    单任务无竞争 lock/unlock 每秒次数
+ *   contend   1..8 个任务持锁期间让出 CPU，强制锁交接，取每秒 lock/unlock 次数
+ * 每条结果另输出一行 "IPC key=value ..." 供脚本解析，并按 bench_result 的记录格式输出，
+ * case 为 "<原语>.<测试>"，contend 另带生产者数 ".p<N>"。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_sem.h"
+#include "los_mux.h"
+#include "los_event.h"
+#include "los_queue.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+
+#include "ipc_bench.h"
+#include "bench_result.h"
+
+#define TASK_STACK_SIZE          0x1000
+#define CTRL_TASK_PRI            5
+#define HIGH_TASK_PRI            7      // 消费者 / 应答方 / 锁等待者
+#define LOW_TASK_PRI             8      // 生产者 / 发起方 / 持锁方
+
+#define PINGPONG_ITERS           1000
+#define ONEWAY_MSGS              2000
+#define CONTEND_MSGS_PER_PROD    500
+#define MAX_PRODUCERS            8
+#define QUEUE_DEPTH              16
+#define DONE_TIMEOUT_TICKS       (30 * LOSCFG_BASE_CORE_TICK_PER_SECOND)
+#define CASE_NAME_LEN            32
+#define MAX_ROUND_TASKS          (MAX_PRODUCERS + 1)
+#define TASK_ID_NONE             0xFFFFFFFF
+
+typedef struct {
+    UINT32 handle;          // 队列 / 信号量 ID
+    EVENT_CB_S event;
+} IpcChan;
+
+typedef struct {
+    const CHAR *name;
+    UINT32 (*create)(IpcChan *ch);
+    UINT32 (*send)(IpcChan *ch, UINT32 producer);
+    UINT32 (*recv)(IpcChan *ch);        // 返回本次收到的消息数
+    VOID (*destroy)(IpcChan *ch);
+} IpcPrim;
+
+/* ================= 全局变量 ================= */
+static IpcChan g_chan[2];
+static const IpcPrim *g_prim = NULL;
+static UINT32 g_mux;
+static UINT32 g_goSem;
+static UINT32 g_doneSem;
+static volatile UINT32 g_alive = 0;
+static UINT32 g_roundTasks[MAX_ROUND_TASKS];     // 本轮创建且尚未退出的任务
+static volatile UINT32 g_expected = 0;
+static volatile UINT64 g_endCycles = 0;
+static volatile UINT64 g_handoffStart = 0;
+static UINT64 g_handoffSum;
+static UINT64 g_handoffMin;
+static UINT64 g_handoffMax;
+
+static VOID TaskExit(VOID)
+{
+    UINT32 self = LOS_CurTaskIDGet();
+    UINT32 intSave = LOS_IntLock();
+    for (UINT32 i = 0; i < MAX_ROUND_TASKS; i++) {
+        if (g_roundTasks[i] == self) {
+            g_roundTasks[i] = TASK_ID_NONE;
+        }
+    }
+    UINT32 left = --g_alive;
+    LOS_IntRestore(intSave);
+    if (left == 0) {
+        (void)LOS_SemPost(g_doneSem);
+    }
+}
+
+/* ================= 消息型原语 ================= */
+
+static UINT32 QueueCreate(IpcChan *ch)
+{
+    return LOS_QueueCreate("ipcBench", QUEUE_DEPTH, &ch->handle, 0, sizeof(UINT32));
+}
+
+static UINT32 QueueSend(IpcChan *ch, UINT32 producer)
+{
+    return LOS_QueueWriteCopy(ch->handle, &producer, sizeof(producer), LOS_WAIT_FOREVER);
+}
+
+static UINT32 QueueRecv(IpcChan *ch)
+{
+    UINT32 msg;
+    UINT32 size = sizeof(msg);
+    return (LOS_QueueReadCopy(ch->handle, &msg, &size, LOS_WAIT_FOREVER) == LOS_OK) ? 1 : 0;
+}
+
+static VOID QueueDestroy(IpcChan *ch)
+{
+    (void)LOS_QueueDelete(ch->handle);
+}
+
+static UINT32 EventCreate(IpcChan *ch)
+{
+    return LOS_EventInit(&ch->event);
+}
+
+static UINT32 EventSend(IpcChan *ch, UINT32 producer)
+{
+    // 每个生产者占一位；消费者优先级更高，写入即被读走，不会合并
+    return LOS_EventWrite(&ch->event, 1U << producer);
+}
+
+static UINT32 EventRecv(IpcChan *ch)
+{
+    UINT32 mask = (1U << MAX_PRODUCERS) - 1;
+    UINT32 bits = LOS_EventRead(&ch->event, mask, LOS_WAITMODE_OR | LOS_WAITMODE_CLR, LOS_WAIT_FOREVER);
+    UINT32 n = 0;
+
+    // 出错时返回的是错误码，落在掩码之外，不能当作事件位计数
+    if ((bits & ~mask) != 0) {
+        printf("LOS_EventRead failed: 0x%X\n", bits);
+        return 0;
+    }
+    while (bits != 0 && n < MAX_PRODUCERS) {
+        n += bits & 1;
+        bits >>= 1;
+    }
+    return n;
+}
+
+static VOID EventDestroy(IpcChan *ch)
+{
+    (void)LOS_EventDestroy(&ch->event);
+}
+
+static UINT32 SemCreate(IpcChan *ch)
+{
+    return LOS_SemCreate(0, &ch->handle);
+}
+
+static UINT32 SemSend(IpcChan *ch, UINT32 producer)
+{
+    (void)producer;
+    return LOS_SemPost(ch->handle);
+}
+
+static UINT32 SemRecv(IpcChan *ch)
+{
+    return (LOS_SemPend(ch->handle, LOS_WAIT_FOREVER) == LOS_OK) ? 1 : 0;
+}
+
+static VOID SemDestroy(IpcChan *ch)
+{
+    (void)LOS_SemDelete(ch->handle);
+}
+
+static const IpcPrim g_prims[] = {
+    { "queue", QueueCreate, QueueSend, QueueRecv, QueueDestroy },
+    { "event", EventCreate, EventSend, EventRecv, EventDestroy },
+    { "sem", SemCreate, SemSend, SemRecv, SemDestroy },
+};
+
+/* ================= 公共 ================= */
+
+static UINT32 SpawnTask(const CHAR *name, TSK_ENTRY_FUNC entry, UINT16 prio, UINTPTR arg)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 id;
+    UINT32 ret;
+
+    param.pfnTaskEntry = entry;
+    param.uwStackSize  = TASK_STACK_SIZE;
+    param.pcName       = (CHAR *)name;
+    param.usTaskPrio   = prio;
+    param.uwArg        = arg;
+    ret = LOS_TaskCreate(&id, &param);
+    if (ret != LOS_OK) {
+        printf("create %s failed: 0x%X\n", name, ret);
+        return ret;
+    }
+    g_roundTasks[g_alive++] = id;
+    return LOS_OK;
+}
+
+static VOID RoundBegin(VOID)
+{
+    g_alive = 0;
+    for (UINT32 i = 0; i < MAX_ROUND_TASKS; i++) {
+        g_roundTasks[i] = TASK_ID_NONE;
+    }
+}
+
+/**
+ * @brief 删除本轮仍未退出的任务 (阻塞在原语上的收发方)，之后原语可以安全删除
+ */
+static VOID ReapRound(VOID)
+{
+    LOS_TaskLock();
+    for (UINT32 i = 0; i < MAX_ROUND_TASKS; i++) {
+        if (g_roundTasks[i] != TASK_ID_NONE) {
+            (void)LOS_TaskDelete(g_roundTasks[i]);
+            g_roundTasks[i] = TASK_ID_NONE;
+        }
+    }
+    g_alive = 0;
+    LOS_TaskUnlock();
+    // 超时与删除之间若有任务退出并释放了完成信号，清掉，避免下一轮误判完成
+    while (LOS_SemPend(g_doneSem, LOS_NO_WAIT) == LOS_OK) {
+    }
+}
+
+/**
+ * @brief 等待本轮所有任务退出；控制任务优先级最高，创建期间任务不会运行
+ * 超时时删除剩余任务，调用方随后照常删除原语
+ */
+static UINT32 WaitDone(VOID)
+{
+    UINT32 ret = LOS_SemPend(g_doneSem, DONE_TIMEOUT_TICKS);
+    if (ret != LOS_OK) {
+        printf("timeout, %u tasks still running, deleted\n", g_alive);
+        ReapRound();
+    }
+    return ret;
+}
+
+static UINT32 CyclesToUs(UINT64 cycles)
+{
+    return (UINT32)(cycles * 1000000ULL / OS_SYS_CLOCK);
+}
+
+static UINT32 PerSecond(UINT32 count, UINT64 cycles)
+{
+    return (cycles == 0) ? 0 : (UINT32)((UINT64)count * OS_SYS_CLOCK / cycles);
+}
+
+static VOID ReportLatency(const CHAR *prim, UINT32 iters, UINT64 avg, UINT64 min, UINT64 max)
+{
+    printf("%-6s | pingpong | %8u iters | avg %6u us | min %6u us | max %6u us\n",
+           prim, iters, CyclesToUs(avg), CyclesToUs(min), CyclesToUs(max));
+    printf("IPC prim=%s test=pingpong iters=%u avg_cyc=%llu min_cyc=%llu max_cyc=%llu clock=%u\n",
+           prim, iters, avg, min, max, (UINT32)OS_SYS_CLOCK);
+
+    CHAR name[CASE_NAME_LEN];
+    (void)snprintf(name, sizeof(name), "%s.pingpong", prim);
+    BenchResult r = { "ipc", name, "cycles_avg", "cycles", avg, iters };
+    BenchResultEmit(&r, NULL);
+    r.metric = "cycles_min";
+    r.value = min;
+    BenchResultEmit(&r, NULL);
+}
+
+static VOID ReportRate(const CHAR *prim, const CHAR *test, UINT32 producers, UINT32 count, UINT64 cycles)
+{
+    printf("%-6s | %-8s | %u producer(s) | %8u ops | %10u ops/s\n",
+           prim, test, producers, count, PerSecond(count, cycles));
+    printf("IPC prim=%s test=%s producers=%u ops=%u cycles=%llu ops_per_s=%u clock=%u\n",
+           prim, test, producers, count, cycles, PerSecond(count, cycles), (UINT32)OS_SYS_CLOCK);
+
+    CHAR name[CASE_NAME_LEN];
+    (void)snprintf(name, sizeof(name), "%s.%s.p%u", prim, test, producers);
+    BenchResult r = { "ipc", name, "rate", "ops/s", PerSecond(count, cycles), count };
+    BenchResultEmit(&r, NULL);
+}
+
+/* ================= 消息型原语测试 ================= */
+
+static VOID *PongTaskEntry(UINTPTR arg)
+{
+    (void)arg;
+    for (UINT32 i = 0; i < PINGPONG_ITERS; i++) {
+        (void)g_prim->recv(&g_chan[0]);
+        (void)g_prim->send(&g_chan[1], 0);
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID *PingTaskEntry(UINTPTR arg)
+{
+    UINT64 min = (UINT64)-1;
+    UINT64 max = 0;
+    UINT64 begin = LOS_SysCycleGet();
+
+    (void)arg;
+    for (UINT32 i = 0; i < PINGPONG_ITERS; i++) {
+        UINT64 t0 = LOS_SysCycleGet();
+        (void)g_prim->send(&g_chan[0], 0);
+        (void)g_prim->recv(&g_chan[1]);
+        UINT64 rtt = LOS_SysCycleGet() - t0;
+        min = (rtt < min) ? rtt : min;
+        max = (rtt > max) ? rtt : max;
+    }
+    ReportLatency(g_prim->name, PINGPONG_ITERS, (LOS_SysCycleGet() - begin) / PINGPONG_ITERS, min, max);
+    TaskExit();
+    return NULL;
+}
+
+static VOID *ConsumerTaskEntry(UINTPTR arg)
+{
+    UINT32 got = 0;
+
+    (void)arg;
+    while (got < g_expected) {
+        got += g_prim->recv(&g_chan[0]);
+    }
+    g_endCycles = LOS_SysCycleGet();
+    TaskExit();
+    return NULL;
+}
+
+static VOID *ProducerTaskEntry(UINTPTR arg)
+{
+    UINT32 count = g_expected / (UINT32)(arg >> 8);
+
+    for (UINT32 i = 0; i < count; i++) {
+        (void)g_prim->send(&g_chan[0], (UINT32)(arg & 0xFF));
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID BenchPingPong(const IpcPrim *prim)
+{
+    g_prim = prim;
+    if (prim->create(&g_chan[0]) != LOS_OK) {
+        printf("%s create failed\n", prim->name);
+        return;
+    }
+    if (prim->create(&g_chan[1]) != LOS_OK) {
+        printf("%s create failed\n", prim->name);
+        prim->destroy(&g_chan[0]);
+        return;
+    }
+    RoundBegin();
+    // 应答方优先级更高，先运行到 recv 处阻塞
+    (void)SpawnTask("IpcPong", (TSK_ENTRY_FUNC)PongTaskEntry, HIGH_TASK_PRI, 0);
+    (void)SpawnTask("IpcPing", (TSK_ENTRY_FUNC)PingTaskEntry, LOW_TASK_PRI, 0);
+    (void)WaitDone();
+    prim->destroy(&g_chan[0]);
+    prim->destroy(&g_chan[1]);
+}
+
+/**
+ * @brief producers 个生产者共发送 total 条消息，返回消费者收完所用周期
+ */
+static UINT64 RunProducers(const IpcPrim *prim, UINT32 producers, UINT32 total)
+{
+    UINT64 start;
+    UINT32 done;
+
+    g_prim = prim;
+    if (prim->create(&g_chan[0]) != LOS_OK) {
+        printf("%s create failed\n", prim->name);
+        return 0;
+    }
+    RoundBegin();
+    g_expected = total;
+    (void)SpawnTask("IpcConsumer", (TSK_ENTRY_FUNC)ConsumerTaskEntry, HIGH_TASK_PRI, 0);
+    for (UINT32 p = 0; p < producers; p++) {
+        // 参数低 8 位为生产者序号，其余为生产者数
+        (void)SpawnTask("IpcProducer", (TSK_ENTRY_FUNC)ProducerTaskEntry, LOW_TASK_PRI,
+                        (UINTPTR)((producers << 8) | p));
+    }
+    start = LOS_SysCycleGet();
+    // 超时时 WaitDone 已删除剩余任务，原语照常删除
+    done = WaitDone();
+    prim->destroy(&g_chan[0]);
+    return (done == LOS_OK) ? g_endCycles - start : 0;
+}
+
+static VOID BenchMessagePrim(const IpcPrim *prim)
+{
+    BenchPingPong(prim);
+    ReportRate(prim->name, "oneway", 1, ONEWAY_MSGS, RunProducers(prim, 1, ONEWAY_MSGS));
+    for (UINT32 p = 1; p <= MAX_PRODUCERS; p++) {
+        UINT32 total = p * CONTEND_MSGS_PER_PROD;
+        ReportRate(prim->name, "contend", p, total, RunProducers(prim, p, total));
+    }
+}
+
+/* ================= mutex ================= */
+
+static VOID *MuxWaiterEntry(UINTPTR arg)
+{
+    (void)arg;
+    for (UINT32 i = 0; i < PINGPONG_ITERS; i++) {
+        (void)LOS_SemPend(g_goSem, LOS_WAIT_FOREVER);
+        // 持锁方仍持有锁，这里阻塞直到它释放
+        (void)LOS_MuxPend(g_mux, LOS_WAIT_FOREVER);
+        UINT64 lat = LOS_SysCycleGet() - g_handoffStart;
+        (void)LOS_MuxPost(g_mux);
+        g_handoffSum += lat;
+        g_handoffMin = (lat < g_handoffMin) ? lat : g_handoffMin;
+        g_handoffMax = (lat > g_handoffMax) ? lat : g_handoffMax;
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID *MuxHolderEntry(UINTPTR arg)
+{
+    (void)arg;
+    for (UINT32 i = 0; i < PINGPONG_ITERS; i++) {
+        (void)LOS_MuxPend(g_mux, LOS_WAIT_FOREVER);
+        (void)LOS_SemPost(g_goSem);     // 等待者抢占运行并阻塞在锁上
+        g_handoffStart = LOS_SysCycleGet();
+        (void)LOS_MuxPost(g_mux);       // 等待者抢占运行，记录交接延迟
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID *MuxContenderEntry(UINTPTR arg)
+{
+    for (UINT32 i = 0; i < (UINT32)arg; i++) {
+        (void)LOS_MuxPend(g_mux, LOS_WAIT_FOREVER);
+        // 持锁期间让出 CPU，其余同级任务会阻塞在锁上，制造交接
+        (void)LOS_TaskYield();
+        (void)LOS_MuxPost(g_mux);
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID BenchMutex(VOID)
+{
+    UINT64 start;
+    UINT64 cycles;
+
+    if (LOS_MuxCreate(&g_mux) != LOS_OK || LOS_SemCreate(0, &g_goSem) != LOS_OK) {
+        printf("mutex create failed\n");
+        return;
+    }
+
+    g_handoffSum = 0;
+    g_handoffMin = (UINT64)-1;
+    g_handoffMax = 0;
+    RoundBegin();
+    (void)SpawnTask("MuxWaiter", (TSK_ENTRY_FUNC)MuxWaiterEntry, HIGH_TASK_PRI, 0);
+    (void)SpawnTask("MuxHolder", (TSK_ENTRY_FUNC)MuxHolderEntry, LOW_TASK_PRI, 0);
+    if (WaitDone() == LOS_OK) {
+        ReportLatency("mutex", PINGPONG_ITERS, g_handoffSum / PINGPONG_ITERS, g_handoffMin, g_handoffMax);
+    }
+
+    // 无竞争：控制任务自身循环
+    start = LOS_SysCycleGet();
+    for (UINT32 i = 0; i < ONEWAY_MSGS; i++) {
+        (void)LOS_MuxPend(g_mux, LOS_WAIT_FOREVER);
+        (void)LOS_MuxPost(g_mux);
+    }
+    ReportRate("mutex", "oneway", 1, ONEWAY_MSGS, LOS_SysCycleGet() - start);
+
+    for (UINT32 p = 1; p <= MAX_PRODUCERS; p++) {
+        RoundBegin();
+        for (UINT32 i = 0; i < p; i++) {
+            (void)SpawnTask("MuxContender", (TSK_ENTRY_FUNC)MuxContenderEntry, LOW_TASK_PRI,
+                            CONTEND_MSGS_PER_PROD);
+        }
+        start = LOS_SysCycleGet();
+        cycles = (WaitDone() == LOS_OK) ? LOS_SysCycleGet() - start : 0;
+        ReportRate("mutex", "contend", p, p * CONTEND_MSGS_PER_PROD, cycles);
+    }
+
+    (void)LOS_SemDelete(g_goSem);
+    (void)LOS_MuxDelete(g_mux);
+}
+
+/* ================= 入口 ================= */
+
+static VOID *IpcBenchTask(UINTPTR arg)
+{
+    (void)arg;
+    printf("\n>>> IPC Primitive Benchmark <<<\n");
+    printf("clock %u Hz, pingpong %u iters, oneway %u msgs, contend %u msgs/producer x 1..%u\n",
+           (UINT32)OS_SYS_CLOCK, PINGPONG_ITERS, ONEWAY_MSGS, CONTEND_MSGS_PER_PROD, MAX_PRODUCERS);
+    if (LOS_SemCreate(0, &g_doneSem) != LOS_OK) {
+        printf("LOS_SemCreate failed\n");
+        return NULL;
+    }
+
+    for (UINT32 i = 0; i < sizeof(g_prims) / sizeof(g_prims[0]); i++) {
+        printf("\n=== %s ===\n", g_prims[i].name);
+        BenchMessagePrim(&g_prims[i]);
+    }
+    printf("\n=== mutex ===\n");
+    BenchMutex();
+
+    (void)LOS_SemDelete(g_doneSem);
+    printf("\n>>> IPC Primitive Benchmark Finished <<<\n");
+    return NULL;
+}
+
+void IpcBenchApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)IpcBenchTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "IpcBenchTask";
+    task.usTaskPrio   = CTRL_TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("IpcBenchTask create failed: 0x%X\n", ret);
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef APP_IPC_BENCH_H
+#define APP_IPC_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void IpcBenchApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
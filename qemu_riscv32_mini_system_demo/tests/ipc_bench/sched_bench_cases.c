@@ -0,0 +1,174 @@
+/*
+ * sched 套件的注册表用例
+ *   sched.sem_pingpong  与高一级优先级的应答任务经一对信号量往返 1000 次
+ *   sched.yield         与同优先级任务互相 LOS_TaskYield 1000 次
+ * 辅助任务的优先级相对调用者取，shell 触发与 autorun 两种运行方式下语义一致；
+ * 辅助任务在 setup 中创建，teardown 时通知退出。
+ */
+
+#include <stdio.h>
+
+#include "los_task.h"
+#include "los_sem.h"
+
+#include "bench_registry.h"
+
+#define HELPER_STACK_SIZE        0x1000
+#define ROUND_TRIPS              1000
+#define YIELDS                   1000
+#define EXIT_TIMEOUT_TICKS       100
+
+/* ================= 全局变量 ================= */
+static UINT32 g_pingSem;
+static UINT32 g_pongSem;
+static UINT32 g_exitSem;
+static volatile BOOL g_stop;
+static volatile UINT32 g_helperSwitches;
+// 已发出但还没收到应答的 ping 数，超时后非 0，下一次 Run 先收回迟到的应答
+static UINT32 g_pongOwed;
+
+static UINT32 HelperCreate(TSK_ENTRY_FUNC entry, const CHAR *name, UINT16 prio)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 taskId;
+
+    param.pfnTaskEntry = entry;
+    param.uwStackSize  = HELPER_STACK_SIZE;
+    param.pcName       = (CHAR *)name;
+    param.usTaskPrio   = prio;
+    return LOS_TaskCreate(&taskId, &param);
+}
+
+/* ================= 信号量往返 ================= */
+
+static VOID *PongEntry(UINTPTR arg)
+{
+    (void)arg;
+    while (LOS_SemPend(g_pingSem, LOS_WAIT_FOREVER) == LOS_OK && !g_stop) {
+        (void)LOS_SemPost(g_pongSem);
+    }
+    (void)LOS_SemPost(g_exitSem);
+    return NULL;
+}
+
+static UINT32 PingPongSetup(VOID)
+{
+    UINT16 prio = LOS_TaskPriGet(LOS_CurTaskIDGet());
+
+    if (prio == 0) {
+        return LOS_NOK;
+    }
+    g_stop = FALSE;
+    g_pongOwed = 0;
+    if (LOS_SemCreate(0, &g_pingSem) != LOS_OK) {
+        return LOS_NOK;
+    }
+    if (LOS_SemCreate(0, &g_pongSem) != LOS_OK) {
+        (void)LOS_SemDelete(g_pingSem);
+        return LOS_NOK;
+    }
+    if (LOS_SemCreate(0, &g_exitSem) != LOS_OK) {
+        (void)LOS_SemDelete(g_pingSem);
+        (void)LOS_SemDelete(g_pongSem);
+        return LOS_NOK;
+    }
+    if (HelperCreate((TSK_ENTRY_FUNC)PongEntry, "BenchPong", prio - 1) != LOS_OK) {
+        (void)LOS_SemDelete(g_pingSem);
+        (void)LOS_SemDelete(g_pongSem);
+        (void)LOS_SemDelete(g_exitSem);
+        return LOS_NOK;
+    }
+    return LOS_OK;
+}
+
+static UINT32 PingPongRun(UINT32 iter, BenchMetrics *metrics)
+{
+    (void)iter;
+    // 应答任务对每个 ping 恰好回一个 pong，先收齐上次超时欠下的，本轮的 Pend 才与本轮的 Post 一一对应
+    while (g_pongOwed > 0) {
+        if (LOS_SemPend(g_pongSem, EXIT_TIMEOUT_TICKS) != LOS_OK) {
+            return LOS_NOK;
+        }
+        g_pongOwed--;
+    }
+    for (UINT32 i = 0; i < ROUND_TRIPS; i++) {
+        (void)LOS_SemPost(g_pingSem);
+        if (LOS_SemPend(g_pongSem, EXIT_TIMEOUT_TICKS) != LOS_OK) {
+            // 本轮已失败，就地再等一次迟到的应答，收不到再留给下一轮，避免计时轮里出现收回的等待
+            if (LOS_SemPend(g_pongSem, EXIT_TIMEOUT_TICKS) != LOS_OK) {
+                g_pongOwed++;
+            }
+            return LOS_NOK;
+        }
+    }
+    BenchMetricSet(metrics, "round_trips", ROUND_TRIPS);
+    return LOS_OK;
+}
+
+static VOID PingPongTeardown(VOID)
+{
+    g_stop = TRUE;
+    (void)LOS_SemPost(g_pingSem);
+    (void)LOS_SemPend(g_exitSem, EXIT_TIMEOUT_TICKS);
+    (void)LOS_SemDelete(g_pingSem);
+    (void)LOS_SemDelete(g_pongSem);
+    (void)LOS_SemDelete(g_exitSem);
+}
+
+/* ================= 同优先级让出 ================= */
+
+static VOID *YieldEntry(UINTPTR arg)
+{
+    (void)arg;
+    while (!g_stop) {
+        g_helperSwitches++;
+        (void)LOS_TaskYield();
+    }
+    (void)LOS_SemPost(g_exitSem);
+    return NULL;
+}
+
+static UINT32 YieldSetup(VOID)
+{
+    g_stop = FALSE;
+    if (LOS_SemCreate(0, &g_exitSem) != LOS_OK) {
+        return LOS_NOK;
+    }
+    if (HelperCreate((TSK_ENTRY_FUNC)YieldEntry, "BenchYield", LOS_TaskPriGet(LOS_CurTaskIDGet())) != LOS_OK) {
+        (void)LOS_SemDelete(g_exitSem);
+        return LOS_NOK;
+    }
+    return LOS_OK;
+}
+
+static UINT32 YieldRun(UINT32 iter, BenchMetrics *metrics)
+{
+    UINT32 before = g_helperSwitches;
+
+    (void)iter;
+    for (UINT32 i = 0; i < YIELDS; i++) {
+        (void)LOS_TaskYield();
+    }
+    // 辅助任务未运行说明让出没有发生切换
+    BenchMetricSet(metrics, "helper_runs", g_helperSwitches - before);
+    return (g_helperSwitches != before) ? LOS_OK : LOS_NOK;
+}
+
+static VOID YieldTeardown(VOID)
+{
+    g_stop = TRUE;
+    (void)LOS_SemPend(g_exitSem, EXIT_TIMEOUT_TICKS);
+    (void)LOS_SemDelete(g_exitSem);
+}
+
+static const BenchCase g_schedPingPong = {
+    .name = "sched.sem_pingpong", .suite = "sched", .desc = "1000 sem round trips with a higher-priority task",
+    .iterations = 10, .setup = PingPongSetup, .run = PingPongRun, .teardown = PingPongTeardown,
+};
+BENCH_REGISTER(g_schedPingPong);
+
+static const BenchCase g_schedYield = {
+    .name = "sched.yield", .suite = "sched", .desc = "1000 LOS_TaskYield with a same-priority task",
+    .iterations = 10, .setup = YieldSetup, .run = YieldRun, .teardown = YieldTeardown,
+};
+BENCH_REGISTER(g_schedYield);
@@ -0,0 +1,453 @@
+/*
+ * 唤醒 / 抢占延迟测试
+ * 后台 CPU-hog 持续运行时，高优先级目标任务分别由以下方式唤醒：
+ *   timer  软件定时器回调中 LOS_TaskResume
+ *   event  LOS_EventWrite
+ *   sem    LOS_SemPost
+ *   queue  LOS_QueueWriteCopy (消息体携带发送时刻)
+ *   swi    LOS_HwiTrigger 触发软件中断，ISR 中 LOS_SemPost
+ * 记录从唤醒动作发生 (任务变为就绪) 到目标任务真正运行的周期数，输出直方图与 min/avg/p99/max。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_sem.h"
+#include "los_event.h"
+#include "los_queue.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+#include "cmsis_os2.h"
+
+#include "latency_test.h"
+
+#define TASK_STACK_SIZE          0x1000
+#define CTRL_TASK_PRI            10
+#define TARGET_TASK_PRI          3
+#define TRIGGER_TASK_PRI         8
+#define HOG_TASK_PRI             20
+
+#define HOG_TASK_NUM             2
+#define LATENCY_SAMPLES          500
+#define TRIGGER_PERIOD_TICKS     2
+#define WAIT_TIMEOUT_TICKS       (50 * TRIGGER_PERIOD_TICKS)
+#define MAX_MISSES               3
+
+// 软件中断号，默认为 RISC-V 机器模式软件中断；平台不支持触发时该项跳过
+#ifndef LATENCY_SWI_IRQ
+#define LATENCY_SWI_IRQ          3
+#endif
+
+// 直方图桶上界 (us)，最后一桶收纳其余
+static const UINT32 g_bucketUs[] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000 };
+#define BUCKET_NUM               (sizeof(g_bucketUs) / sizeof(g_bucketUs[0]) + 1)
+
+typedef struct {
+    const CHAR *name;
+    UINT32 (*setup)(VOID);
+    VOID (*trigger)(VOID);          // 在触发任务中调用；timer 为 NULL，由定时器回调触发
+    UINT32 (*wait)(UINT32 timeout); // 在目标任务中调用，返回 LOS_OK 表示被唤醒
+    VOID (*teardown)(VOID);
+} LatencySource;
+
+/* ================= 全局变量 ================= */
+static UINT32 g_samples[LATENCY_SAMPLES];
+static volatile UINT32 g_sampleCount = 0;
+static volatile UINT64 g_readyCycles = 0;
+static volatile BOOL g_stop = FALSE;
+static volatile BOOL g_hogRunning = FALSE;
+static volatile UINT32 g_alive = 0;
+static UINT32 g_doneSem;
+static UINT32 g_targetId;
+static const LatencySource *g_source = NULL;
+
+static UINT32 g_sem;
+static EVENT_CB_S g_event;
+static UINT32 g_queue;
+static osTimerId_t g_timer = NULL;
+static BOOL g_swiReady = FALSE;
+
+static VOID TaskExit(VOID)
+{
+    UINT32 intSave = LOS_IntLock();
+    g_alive--;
+    LOS_IntRestore(intSave);
+}
+
+/* ================= 唤醒源 ================= */
+
+static VOID TimerCallback(VOID *arg)
+{
+    (void)arg;
+    g_readyCycles = LOS_SysCycleGet();
+    // 目标任务尚未挂起时本次唤醒作废，下一周期重新计时
+    (void)LOS_TaskResume(g_targetId);
+}
+
+static UINT32 TimerSetup(VOID)
+{
+    g_timer = osTimerNew((osTimerFunc_t)TimerCallback, osTimerPeriodic, NULL, NULL);
+    if (g_timer == NULL || osTimerStart(g_timer, TRIGGER_PERIOD_TICKS) != osOK) {
+        return LOS_NOK;
+    }
+    return LOS_OK;
+}
+
+static UINT32 TimerWait(UINT32 timeout)
+{
+    (void)timeout;
+    return LOS_TaskSuspend(LOS_CurTaskIDGet());
+}
+
+static VOID TimerTeardown(VOID)
+{
+    if (g_timer != NULL) {
+        (void)osTimerStop(g_timer);
+        (void)osTimerDelete(g_timer);
+        g_timer = NULL;
+    }
+    (void)LOS_TaskResume(g_targetId);
+}
+
+static UINT32 EventSetup(VOID)
+{
+    return LOS_EventInit(&g_event);
+}
+
+static VOID EventTrigger(VOID)
+{
+    (void)LOS_EventWrite(&g_event, 0x1);
+}
+
+static UINT32 EventWait(UINT32 timeout)
+{
+    UINT32 ret = LOS_EventRead(&g_event, 0x1, LOS_WAITMODE_AND | LOS_WAITMODE_CLR, timeout);
+    return (ret == 0x1) ? LOS_OK : LOS_NOK;
+}
+
+static VOID EventTeardown(VOID)
+{
+    (void)LOS_EventWrite(&g_event, 0x1);
+    (void)LOS_EventDestroy(&g_event);
+}
+
+static UINT32 SemSetup(VOID)
+{
+    return LOS_SemCreate(0, &g_sem);
+}
+
+static VOID SemTrigger(VOID)
+{
+    (void)LOS_SemPost(g_sem);
+}
+
+static UINT32 SemWait(UINT32 timeout)
+{
+    return LOS_SemPend(g_sem, timeout);
+}
+
+static VOID SemTeardown(VOID)
+{
+    // 仍有任务等待时无法删除，先放出目标任务
+    (void)LOS_SemPost(g_sem);
+    (void)LOS_SemDelete(g_sem);
+}
+
+static UINT32 QueueSetup(VOID)
+{
+    return LOS_QueueCreate("latQueue", 4, &g_queue, 0, sizeof(UINT64));
+}
+
+static VOID QueueTrigger(VOID)
+{
+    UINT64 stamp = g_readyCycles;
+    (void)LOS_QueueWriteCopy(g_queue, &stamp, sizeof(stamp), 0);
+}
+
+static UINT32 QueueWait(UINT32 timeout)
+{
+    UINT64 stamp;
+    UINT32 size = sizeof(stamp);
+    UINT32 ret = LOS_QueueReadCopy(g_queue, &stamp, &size, timeout);
+    if (ret == LOS_OK) {
+        // 以消息中的发送时刻为准，不依赖共享变量
+        g_readyCycles = stamp;
+    }
+    return ret;
+}
+
+static VOID QueueTeardown(VOID)
+{
+    QueueTrigger();
+    (void)LOS_QueueDelete(g_queue);
+}
+
+static VOID SwiHandler(VOID)
+{
+    (void)LOS_SemPost(g_sem);
+}
+
+static UINT32 SwiSetup(VOID)
+{
+    UINT32 ret = LOS_SemCreate(0, &g_sem);
+    if (ret != LOS_OK) {
+        return ret;
+    }
+    if (!g_swiReady) {
+        ret = LOS_HwiCreate(LATENCY_SWI_IRQ, 0, 0, (HWI_PROC_FUNC)SwiHandler, NULL);
+        if (ret != LOS_OK) {
+            (void)LOS_SemDelete(g_sem);
+            return ret;
+        }
+        g_swiReady = TRUE;
+    }
+    return LOS_OK;
+}
+
+static VOID SwiTrigger(VOID)
+{
+    (void)LOS_HwiTrigger(LATENCY_SWI_IRQ);
+}
+
+static VOID SwiTeardown(VOID)
+{
+    // 先摘掉中断处理函数，之后不会再有 ISR 向将被删除的信号量 Post
+    if (g_swiReady) {
+        (void)LOS_HwiDelete(LATENCY_SWI_IRQ, NULL);
+        g_swiReady = FALSE;
+    }
+    SemTeardown();
+}
+
+static const LatencySource g_sources[] = {
+    { "timer", TimerSetup, NULL, TimerWait, TimerTeardown },
+    { "event", EventSetup, EventTrigger, EventWait, EventTeardown },
+    { "sem", SemSetup, SemTrigger, SemWait, SemTeardown },
+    { "queue", QueueSetup, QueueTrigger, QueueWait, QueueTeardown },
+    { "swi", SwiSetup, SwiTrigger, SemWait, SwiTeardown },
+};
+
+/* ================= 任务入口 ================= */
+
+static VOID *HogTaskEntry(UINTPTR arg)
+{
+    volatile UINT32 res = 0;
+
+    (void)arg;
+    while (g_hogRunning) {
+        for (UINT32 i = 0; i < 1000; i++) {
+            res += i * i;
+        }
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID *TargetTaskEntry(UINTPTR arg)
+{
+    UINT32 misses = 0;
+
+    (void)arg;
+    while (g_sampleCount < LATENCY_SAMPLES && !g_stop) {
+        if (g_source->wait(WAIT_TIMEOUT_TICKS) != LOS_OK) {
+            if (++misses >= MAX_MISSES) {
+                break;
+            }
+            continue;
+        }
+        UINT64 now = LOS_SysCycleGet();
+        if (g_stop) {
+            break;
+        }
+        g_samples[g_sampleCount++] = (UINT32)(now - g_readyCycles);
+    }
+    (void)LOS_SemPost(g_doneSem);
+    TaskExit();
+    return NULL;
+}
+
+static VOID *TriggerTaskEntry(UINTPTR arg)
+{
+    (void)arg;
+    while (!g_stop) {
+        (void)LOS_TaskDelay(TRIGGER_PERIOD_TICKS);
+        if (g_stop) {
+            break;
+        }
+        g_readyCycles = LOS_SysCycleGet();
+        g_source->trigger();
+    }
+    TaskExit();
+    return NULL;
+}
+
+/* ================= 统计输出 ================= */
+
+static int CompareU32(const void *a, const void *b)
+{
+    UINT32 x = *(const UINT32 *)a;
+    UINT32 y = *(const UINT32 *)b;
+    return (x > y) - (x < y);
+}
+
+static UINT32 CyclesToUs(UINT64 cycles)
+{
+    return (UINT32)(cycles * 1000000ULL / OS_SYS_CLOCK);
+}
+
+static VOID ReportSource(const CHAR *name, UINT32 n)
+{
+    UINT32 hist[BUCKET_NUM] = { 0 };
+    UINT64 sum = 0;
+
+    if (n == 0) {
+        printf("[%s] no samples (source not supported on this platform?)\n", name);
+        printf("LAT src=%s n=0\n", name);
+        return;
+    }
+    qsort(g_samples, n, sizeof(g_samples[0]), CompareU32);
+    for (UINT32 i = 0; i < n; i++) {
+        UINT32 us = CyclesToUs(g_samples[i]);
+        UINT32 b = 0;
+        while (b < BUCKET_NUM - 1 && us >= g_bucketUs[b]) {
+            b++;
+        }
+        hist[b]++;
+        sum += g_samples[i];
+    }
+
+    UINT32 minC = g_samples[0];
+    UINT32 maxC = g_samples[n - 1];
+    UINT32 p99C = g_samples[(n * 99) / 100 < n ? (n * 99) / 100 : n - 1];
+    UINT32 avgC = (UINT32)(sum / n);
+
+    printf("\n[%s] %u samples: min %u / avg %u / p99 %u / max %u cycles (%u / %u / %u / %u us)\n",
+           name, n, minC, avgC, p99C, maxC,
+           CyclesToUs(minC), CyclesToUs(avgC), CyclesToUs(p99C), CyclesToUs(maxC));
+    for (UINT32 b = 0; b < BUCKET_NUM; b++) {
+        if (b < BUCKET_NUM - 1) {
+            printf("  < %5u us | %5u | ", g_bucketUs[b], hist[b]);
+        } else {
+            printf("  >=%5u us | %5u | ", g_bucketUs[b - 1], hist[b]);
+        }
+        for (UINT32 k = 0; k < (hist[b] * 50 + n - 1) / n; k++) {
+            printf("#");
+        }
+        printf("\n");
+    }
+    // 便于脚本提取的单行结果
+    printf("LAT src=%s n=%u min_cyc=%u avg_cyc=%u p99_cyc=%u max_cyc=%u clock=%u\n",
+           name, n, minC, avgC, p99C, maxC, (UINT32)OS_SYS_CLOCK);
+}
+
+/* ================= 测试流程 ================= */
+
+static UINT32 SpawnTask(const CHAR *name, TSK_ENTRY_FUNC entry, UINT16 prio, UINT32 *taskId)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 id;
+    UINT32 ret;
+
+    param.pfnTaskEntry = entry;
+    param.uwStackSize  = TASK_STACK_SIZE;
+    param.pcName       = (CHAR *)name;
+    param.usTaskPrio   = prio;
+    ret = LOS_TaskCreate(&id, &param);
+    if (ret != LOS_OK) {
+        printf("create %s failed: 0x%X\n", name, ret);
+        return ret;
+    }
+    g_alive++;
+    if (taskId != NULL) {
+        *taskId = id;
+    }
+    return LOS_OK;
+}
+
+static VOID RunSource(const LatencySource *src)
+{
+    UINT32 ret;
+
+    g_source = src;
+    g_sampleCount = 0;
+    g_stop = FALSE;
+
+    ret = src->setup();
+    if (ret != LOS_OK) {
+        printf("[%s] setup failed: 0x%X, skipped\n", src->name, ret);
+        ReportSource(src->name, 0);
+        return;
+    }
+    // 目标任务优先级最高，创建后立即运行到 wait 处阻塞，之后才开始触发
+    ret = SpawnTask("LatTarget", (TSK_ENTRY_FUNC)TargetTaskEntry, TARGET_TASK_PRI, &g_targetId);
+    if (ret == LOS_OK && src->trigger != NULL) {
+        ret = SpawnTask("LatTrigger", (TSK_ENTRY_FUNC)TriggerTaskEntry, TRIGGER_TASK_PRI, NULL);
+    }
+
+    if (ret == LOS_OK) {
+        (void)LOS_SemPend(g_doneSem, LATENCY_SAMPLES * WAIT_TIMEOUT_TICKS);
+    }
+    g_stop = TRUE;
+    src->teardown();
+    // teardown 放出仍在等待的目标任务，与自行超时退出的情况一样等待计数归零
+    while (g_alive > HOG_TASK_NUM) {
+        (void)LOS_TaskDelay(1);
+    }
+    (void)LOS_SemPend(g_doneSem, LOS_NO_WAIT);
+
+    ReportSource(src->name, g_sampleCount);
+}
+
+static VOID *LatencyTestTask(UINTPTR arg)
+{
+    (void)arg;
+    printf("\n>>> Wake-up Latency Test <<<\n");
+    printf("target prio %u, trigger prio %u, %u hogs at prio %u, %u samples per source, period %u ticks\n",
+           TARGET_TASK_PRI, TRIGGER_TASK_PRI, HOG_TASK_NUM, HOG_TASK_PRI, LATENCY_SAMPLES,
+           TRIGGER_PERIOD_TICKS);
+
+    if (LOS_SemCreate(0, &g_doneSem) != LOS_OK) {
+        printf("LOS_SemCreate failed\n");
+        return NULL;
+    }
+    g_alive = 0;
+    g_hogRunning = TRUE;
+    for (UINT32 i = 0; i < HOG_TASK_NUM; i++) {
+        if (SpawnTask("LatHog", (TSK_ENTRY_FUNC)HogTaskEntry, HOG_TASK_PRI, NULL) != LOS_OK) {
+            break;
+        }
+    }
+
+    for (UINT32 i = 0; i < sizeof(g_sources) / sizeof(g_sources[0]); i++) {
+        RunSource(&g_sources[i]);
+    }
+
+    g_hogRunning = FALSE;
+    while (g_alive != 0) {
+        (void)LOS_TaskDelay(1);
+    }
+    (void)LOS_SemDelete(g_doneSem);
+    printf("\n>>> Wake-up Latency Test Finished <<<\n");
+    return NULL;
+}
+
+void LatencyTestApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)LatencyTestTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "LatencyTestTask";
+    task.usTaskPrio   = CTRL_TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("LatencyTestTask create failed: 0x%X\n", ret);
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef APP_LATENCY_TEST_H
+#define APP_LATENCY_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void LatencyTestApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,87 @@
+/*
+ * malloc 套件的注册表用例
+ *   malloc.small  256 次 16..256 字节的 malloc/free 成对操作
+ *   malloc.mixed  保持 32 个存活块，随机替换 512 次，大小 16..4096 字节
+ * 大小序列由固定种子的 LCG 生成，每次迭代相同。
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "los_task.h"
+
+#include "bench_registry.h"
+
+#define SMALL_OPS                256
+#define MIXED_LIVE               32
+#define MIXED_OPS                512
+#define LCG_SEED                 0x12345678U
+
+static void *g_live[MIXED_LIVE];
+
+static UINT32 Lcg(UINT32 *state)
+{
+    *state = *state * 1103515245U + 12345U;
+    return *state >> 8;
+}
+
+static UINT32 SmallRun(UINT32 iter, BenchMetrics *metrics)
+{
+    UINT32 seed = LCG_SEED;
+    UINT32 fails = 0;
+
+    (void)iter;
+    for (UINT32 i = 0; i < SMALL_OPS; i++) {
+        void *p = malloc(16 + Lcg(&seed) % 241);
+        if (p == NULL) {
+            fails++;
+            continue;
+        }
+        free(p);
+    }
+    BenchMetricSet(metrics, "ops", SMALL_OPS);
+    return (fails == 0) ? LOS_OK : LOS_NOK;
+}
+
+static UINT32 MixedRun(UINT32 iter, BenchMetrics *metrics)
+{
+    UINT32 seed = LCG_SEED;
+    UINT32 fails = 0;
+    UINT32 live = 0;
+    UINT32 peak = 0;
+    UINT32 sizes[MIXED_LIVE] = { 0 };
+
+    (void)iter;
+    for (UINT32 i = 0; i < MIXED_OPS; i++) {
+        UINT32 slot = Lcg(&seed) % MIXED_LIVE;
+        UINT32 size = 16 + Lcg(&seed) % 4081;
+        if (g_live[slot] != NULL) {
+            free(g_live[slot]);
+            live -= sizes[slot];
+        }
+        g_live[slot] = malloc(size);
+        sizes[slot] = (g_live[slot] != NULL) ? size : 0;
+        fails += (g_live[slot] == NULL) ? 1 : 0;
+        live += sizes[slot];
+        peak = (live > peak) ? live : peak;
+    }
+    for (UINT32 s = 0; s < MIXED_LIVE; s++) {
+        free(g_live[s]);
+        g_live[s] = NULL;
+    }
+    BenchMetricSet(metrics, "ops", MIXED_OPS);
+    BenchMetricSetUnit(metrics, "peak_live_bytes", "bytes", peak);
+    return (fails == 0) ? LOS_OK : LOS_NOK;
+}
+
+static const BenchCase g_mallocSmall = {
+    .name = "malloc.small", .suite = "malloc", .desc = "256 x malloc/free 16..256B",
+    .iterations = 10, .run = SmallRun,
+};
+BENCH_REGISTER(g_mallocSmall);
+
+static const BenchCase g_mallocMixed = {
+    .name = "malloc.mixed", .suite = "malloc", .desc = "32 live blocks, 512 replacements 16..4096B",
+    .iterations = 10, .run = MixedRun,
+};
+BENCH_REGISTER(g_mallocMixed);
@@ -5,6 +5,10 @@
 #include "ohos_init.h"
 #include "cmsis_os2.h"
 #include "los_task.h"
+#include "perf_bench.h"
+#if defined(HEAP_MON)
+#include "heap_mon.h"
+#endif
 
 #define TEST_BUFFER_SIZE      1024
 #define MAX_TEST_ALLOCATIONS  100
@@ -214,7 +218,9 @@ void test_multiple_allocations(void) {
     // 分配多块不同大小的内存
     for (int i = 0; i < MAX_TEST_ALLOCATIONS / 2; i++) {
         sizes[i] = (i + 1) * 16; // 16, 32, 48, ... 字节
+        PERF_BEGIN("malloc 16..800");
         pointers[i] = malloc(sizes[i]);
+        PERF_END("malloc 16..800");
         
         if (pointers[i] != NULL) {
             g_test_stats.total_allocated += sizes[i];
@@ -241,7 +247,7 @@ void test_multiple_allocations(void) {
             }
             TEST_ASSERT(data_ok, "分配的数据应正确保存");
             
-            free(pointers[i]);
+            PERF_MEASURE("free 16..800", free(pointers[i]));
             g_test_stats.total_allocated -= sizes[i];
             pointers[i] = NULL;
         }
@@ -252,12 +258,18 @@ void test_multiple_allocations(void) {
 
 // ========== 测试入口 ==========
 void MallocTestTask(void) {
+#if defined(HEAP_MON)
+  // 手工计数只反映本测试请求的字节数，碎片看前后两次遍历系统堆的结果
+  HeapReport heapBefore;
+  HeapReport heapAfter;
+  (void)HeapMonInspect(OS_SYS_MEM_ADDR, &heapBefore, NULL);
+#endif
   printf("=== 内存分配器测试开始 ===\n");
-  test_basic_malloc_free();
-  test_calloc_initialization();
-  test_realloc_functionality(); 
-  test_edge_cases();
-  test_multiple_allocations();
+  PERF_MEASURE("basic_malloc_free", test_basic_malloc_free());
+  PERF_MEASURE("calloc", test_calloc_initialization());
+  PERF_MEASURE("realloc", test_realloc_functionality());
+  PERF_MEASURE("edge_cases", test_edge_cases());
+  PERF_MEASURE("multiple_allocations", test_multiple_allocations());
   
   // 测试总结
   printf("\n=== 测试总结 ===\n");
@@ -266,6 +278,14 @@ void MallocTestTask(void) {
   printf("失败: %d\n", g_test_stats.failed_tests);
   printf("当前分配内存: %zu 字节\n", g_test_stats.total_allocated);
   printf("峰值分配内存: %zu 字节\n", g_test_stats.peak_allocated);
+#if defined(HEAP_MON)
+  (void)HeapMonInspect(OS_SYS_MEM_ADDR, &heapAfter, NULL);
+  printf("系统堆空闲块: %u -> %u, 最大空闲块: %u -> %u, 碎片: %u%% -> %u%%\n",
+         heapBefore.freeNodes, heapAfter.freeNodes, heapBefore.maxFreeBlock, heapAfter.maxFreeBlock,
+         heapBefore.fragPct, heapAfter.fragPct);
+  HeapMonPrint(&heapAfter);
+#endif
+  PERF_REPORT();
   printf("=== 内存分配器测试结束 ===\n");
 }
 
@@ -0,0 +1,379 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "los_task.h"
+#include "los_interrupt.h"
+
+#include "bsl_sal.h"
+#include "crypt_errno.h"
+
+#include "hitls_sm2_pool.h"
+
+#define ARENA_ALIGN             8
+#define ARENA_HDR_SIZE          ARENA_ALIGN
+#define ARENA_NONE              0xFFFFFFFF
+#define ARENA_FREED             0x80000000U
+#define POOL_OWNER_NONE         0xFFFFFFFF
+
+/* ================= 数据结构 ================= */
+
+/*
+ * arena 对象头：紧挨在对象之前，按分配顺序串成栈
+ * 栈顶对象释放时回退 used，并继续弹出其下已标记释放的对象，
+ * 先分配后释放的临时大数 (LIFO 为主) 的空间在操作进行中即可复用
+ */
+typedef struct {
+    uint32_t prev;       // 前一个对象头的偏移，ARENA_NONE 表示栈底
+    uint32_t size;       // 含对象头的占用字节数，最高位为已释放标记
+} ArenaHdr;
+
+typedef struct {
+    uint8_t buf[HITLS_SM2_ARENA_SIZE] __attribute__((aligned(ARENA_ALIGN)));
+    uint32_t used;       // bump 指针
+    uint32_t top;        // 栈顶对象头偏移
+    uint32_t live;       // 尚未释放的 arena 对象个数
+} HitlsArena;
+
+typedef struct {
+    CRYPT_SM2_Ctx *ctx;
+    volatile UINT32 owner;       // 当前持有该上下文的任务 ID
+    volatile BOOL arenaActive;   // 是否处于 ArenaBegin/ArenaEnd 之间
+    HitlsArena arena;
+} HitlsSm2Slot;
+
+/* ================= 全局变量 ================= */
+static HitlsSm2Slot g_slots[HITLS_SM2_POOL_SIZE];
+static HitlsSm2PoolStats g_stats;
+static BOOL g_poolReady = FALSE;
+static BOOL g_hooked = FALSE;
+// 注册钩子前的 BSL SAL 内存回调，堆路径转交给它们，Deinit 时恢复；NULL 为库默认的 malloc/free
+static HitlsSm2MallocFunc g_prevMalloc = NULL;
+static HitlsSm2FreeFunc g_prevFree = NULL;
+
+/* ================= 辅助函数 ================= */
+
+static HitlsSm2Slot *FindSlotByCtx(const CRYPT_SM2_Ctx *ctx)
+{
+    for (int i = 0; i < HITLS_SM2_POOL_SIZE; i++) {
+        if (g_slots[i].ctx == ctx) {
+            return &g_slots[i];
+        }
+    }
+    return NULL;
+}
+
+static HitlsSm2Slot *FindSlotByPtr(const void *ptr)
+{
+    const uint8_t *p = (const uint8_t *)ptr;
+    for (int i = 0; i < HITLS_SM2_POOL_SIZE; i++) {
+        const uint8_t *base = g_slots[i].arena.buf;
+        if (p >= base && p < base + HITLS_SM2_ARENA_SIZE) {
+            return &g_slots[i];
+        }
+    }
+    return NULL;
+}
+
+static void ArenaReset(HitlsArena *arena)
+{
+    arena->used = 0;
+    arena->top = ARENA_NONE;
+    arena->live = 0;
+}
+
+static void *HeapMalloc(uint32_t size)
+{
+    return (g_prevMalloc != NULL) ? g_prevMalloc(size) : malloc(size);
+}
+
+static void HeapFree(void *ptr)
+{
+    if (g_prevFree != NULL) {
+        g_prevFree(ptr);
+    } else {
+        free(ptr);
+    }
+}
+
+/**
+ * @brief 在 arena 中分配，空间不足返回 NULL；调用者持有中断锁
+ */
+static void *ArenaAlloc(HitlsArena *arena, uint32_t size)
+{
+    uint32_t need = ARENA_HDR_SIZE + ((size + ARENA_ALIGN - 1) & ~(uint32_t)(ARENA_ALIGN - 1));
+
+    if (need > HITLS_SM2_ARENA_SIZE - arena->used) {
+        return NULL;
+    }
+    ArenaHdr *hdr = (ArenaHdr *)(arena->buf + arena->used);
+    hdr->prev = arena->top;
+    hdr->size = need;
+    arena->top = arena->used;
+    arena->used += need;
+    arena->live++;
+    return (uint8_t *)hdr + ARENA_HDR_SIZE;
+}
+
+/**
+ * @brief 标记释放并从栈顶回收连续的已释放对象；调用者持有中断锁
+ */
+static void ArenaFree(HitlsArena *arena, void *ptr)
+{
+    ArenaHdr *hdr = (ArenaHdr *)((uint8_t *)ptr - ARENA_HDR_SIZE);
+
+    if ((hdr->size & ARENA_FREED) != 0 || arena->live == 0) {
+        return;
+    }
+    hdr->size |= ARENA_FREED;
+    if (--arena->live == 0) {
+        ArenaReset(arena);
+        return;
+    }
+    while (arena->top != ARENA_NONE) {
+        ArenaHdr *top = (ArenaHdr *)(arena->buf + arena->top);
+        if ((top->size & ARENA_FREED) == 0) {
+            break;
+        }
+        arena->used = arena->top;
+        arena->top = top->prev;
+    }
+}
+
+/**
+ * @brief BSL_SAL_Malloc 钩子
+ * 只有持有上下文且处于操作期间的任务走 arena，其余调用转交注册前的回调
+ */
+static void *PoolMalloc(uint32_t size)
+{
+    UINT32 self = LOS_CurTaskIDGet();
+    UINT32 intSave = LOS_IntLock();
+
+    for (int i = 0; i < HITLS_SM2_POOL_SIZE; i++) {
+        HitlsSm2Slot *slot = &g_slots[i];
+        if (!slot->arenaActive || slot->owner != self) {
+            continue;
+        }
+        void *ptr = ArenaAlloc(&slot->arena, size);
+        if (ptr == NULL) {
+            g_stats.arenaOverflows++;
+            break;
+        }
+        g_stats.arenaAllocs++;
+        if (slot->arena.used > g_stats.arenaPeak) {
+            g_stats.arenaPeak = slot->arena.used;
+        }
+        LOS_IntRestore(intSave);
+        return ptr;
+    }
+    g_stats.heapAllocs++;
+    LOS_IntRestore(intSave);
+    return HeapMalloc(size);
+}
+
+static void PoolFree(void *ptr)
+{
+    UINT32 intSave;
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    HitlsSm2Slot *slot = FindSlotByPtr(ptr);
+    intSave = LOS_IntLock();
+    if (slot == NULL) {
+        g_stats.heapFrees++;
+        LOS_IntRestore(intSave);
+        HeapFree(ptr);
+        return;
+    }
+    ArenaFree(&slot->arena, ptr);
+    LOS_IntRestore(intSave);
+}
+
+#if defined(HITLS_SM2_POOL_REALLOC_CB)
+/**
+ * @brief BSL_SAL_Realloc 钩子
+ * arena 栈顶对象原地伸缩，其余 arena 对象搬到新分配的空间；堆对象交给 PoolMalloc / PoolFree
+ */
+static void *PoolRealloc(void *addr, uint32_t newSize, uint32_t oldSize)
+{
+    HitlsSm2Slot *slot;
+    UINT32 intSave;
+    void *ptr;
+
+    if (addr == NULL) {
+        return PoolMalloc(newSize);
+    }
+    slot = FindSlotByPtr(addr);
+    if (slot != NULL) {
+        HitlsArena *arena = &slot->arena;
+        uint32_t off = (uint32_t)((uint8_t *)addr - ARENA_HDR_SIZE - arena->buf);
+        uint32_t need = ARENA_HDR_SIZE + ((newSize + ARENA_ALIGN - 1) & ~(uint32_t)(ARENA_ALIGN - 1));
+
+        intSave = LOS_IntLock();
+        g_stats.reallocs++;
+        if (off == arena->top && need <= HITLS_SM2_ARENA_SIZE - off) {
+            ((ArenaHdr *)(arena->buf + off))->size = need;
+            arena->used = off + need;
+            if (arena->used > g_stats.arenaPeak) {
+                g_stats.arenaPeak = arena->used;
+            }
+            LOS_IntRestore(intSave);
+            return addr;
+        }
+        LOS_IntRestore(intSave);
+    }
+    ptr = PoolMalloc(newSize);
+    if (ptr != NULL) {
+        (void)memcpy(ptr, addr, (oldSize < newSize) ? oldSize : newSize);
+        PoolFree(addr);
+    }
+    return ptr;
+}
+#endif
+
+/* ================= 对外接口 ================= */
+
+int32_t HitlsSm2PoolInit(HitlsSm2MallocFunc prevMalloc, HitlsSm2FreeFunc prevFree)
+{
+    int32_t ret;
+
+    if (g_poolReady) {
+        return CRYPT_SUCCESS;
+    }
+
+    memset(g_slots, 0, sizeof(g_slots));
+    memset(&g_stats, 0, sizeof(g_stats));
+    for (int i = 0; i < HITLS_SM2_POOL_SIZE; i++) {
+        g_slots[i].owner = POOL_OWNER_NONE;
+        ArenaReset(&g_slots[i].arena);
+    }
+    g_prevMalloc = prevMalloc;
+    g_prevFree = prevFree;
+
+    // 先挂钩子再建上下文，保证上下文对象由 PoolFree 释放时走同一个堆
+    g_hooked = TRUE;
+    ret = BSL_SAL_CallBack_Ctrl(BSL_SAL_MEM_MALLOC, (void *)PoolMalloc);
+    if (ret == BSL_SUCCESS) {
+        ret = BSL_SAL_CallBack_Ctrl(BSL_SAL_MEM_FREE, (void *)PoolFree);
+    }
+#if defined(HITLS_SM2_POOL_REALLOC_CB)
+    if (ret == BSL_SUCCESS) {
+        ret = BSL_SAL_CallBack_Ctrl(BSL_SAL_MEM_REALLOC, (void *)PoolRealloc);
+    }
+#endif
+    if (ret != BSL_SUCCESS) {
+        printf("[SM2Pool] register memory hooks failed: 0x%x\n", ret);
+        HitlsSm2PoolDeinit();
+        return ret;
+    }
+
+    for (int i = 0; i < HITLS_SM2_POOL_SIZE; i++) {
+        g_slots[i].ctx = CRYPT_SM2_NewCtx();
+        if (g_slots[i].ctx == NULL) {
+            printf("[SM2Pool] CRYPT_SM2_NewCtx fail, slot %d\n", i);
+            HitlsSm2PoolDeinit();
+            return CRYPT_MEM_ALLOC_FAIL;
+        }
+        // 密钥随上下文常驻，后续操作不再触发密钥对象的分配
+        ret = CRYPT_SM2_Gen(g_slots[i].ctx);
+        if (ret != CRYPT_SUCCESS) {
+            printf("[SM2Pool] CRYPT_SM2_Gen fail, slot %d, ret = %d\n", i, ret);
+            HitlsSm2PoolDeinit();
+            return ret;
+        }
+    }
+
+    g_poolReady = TRUE;
+    printf("[SM2Pool] %d contexts ready, arena %d bytes each\n",
+           HITLS_SM2_POOL_SIZE, HITLS_SM2_ARENA_SIZE);
+    return CRYPT_SUCCESS;
+}
+
+void HitlsSm2PoolDeinit(void)
+{
+    for (int i = 0; i < HITLS_SM2_POOL_SIZE; i++) {
+        if (g_slots[i].ctx != NULL) {
+            CRYPT_SM2_FreeCtx(g_slots[i].ctx);
+            g_slots[i].ctx = NULL;
+        }
+        g_slots[i].owner = POOL_OWNER_NONE;
+        g_slots[i].arenaActive = FALSE;
+    }
+    // 上下文释放完再恢复回调，它们的堆对象仍经 PoolFree 交还注册前的回调
+    if (g_hooked) {
+        (void)BSL_SAL_CallBack_Ctrl(BSL_SAL_MEM_MALLOC, (void *)g_prevMalloc);
+        (void)BSL_SAL_CallBack_Ctrl(BSL_SAL_MEM_FREE, (void *)g_prevFree);
+#if defined(HITLS_SM2_POOL_REALLOC_CB)
+        (void)BSL_SAL_CallBack_Ctrl(BSL_SAL_MEM_REALLOC, NULL);
+#endif
+        g_hooked = FALSE;
+    }
+    g_poolReady = FALSE;
+}
+
+CRYPT_SM2_Ctx *HitlsSm2PoolAcquire(void)
+{
+    CRYPT_SM2_Ctx *ctx = NULL;
+
+    if (!g_poolReady) {
+        return NULL;
+    }
+
+    UINT32 intSave = LOS_IntLock();
+    for (int i = 0; i < HITLS_SM2_POOL_SIZE; i++) {
+        if (g_slots[i].owner == POOL_OWNER_NONE) {
+            g_slots[i].owner = LOS_CurTaskIDGet();
+            ctx = g_slots[i].ctx;
+            break;
+        }
+    }
+    LOS_IntRestore(intSave);
+    return ctx;
+}
+
+void HitlsSm2PoolRelease(CRYPT_SM2_Ctx *ctx)
+{
+    HitlsSm2Slot *slot = FindSlotByCtx(ctx);
+    if (slot == NULL) {
+        return;
+    }
+    slot->arenaActive = FALSE;
+    slot->owner = POOL_OWNER_NONE;
+}
+
+void HitlsSm2ArenaBegin(CRYPT_SM2_Ctx *ctx)
+{
+    HitlsSm2Slot *slot = FindSlotByCtx(ctx);
+    if (slot == NULL || slot->owner != LOS_CurTaskIDGet()) {
+        return;
+    }
+    slot->arenaActive = TRUE;
+}
+
+void HitlsSm2ArenaEnd(CRYPT_SM2_Ctx *ctx)
+{
+    HitlsSm2Slot *slot = FindSlotByCtx(ctx);
+    if (slot == NULL) {
+        return;
+    }
+    // 仍被上下文持有的对象留在 arena 中，其余空间已随释放从栈顶回收
+    slot->arenaActive = FALSE;
+}
+
+void HitlsSm2PoolStatsGet(HitlsSm2PoolStats *stats)
+{
+    if (stats != NULL) {
+        UINT32 intSave = LOS_IntLock();
+        *stats = g_stats;
+        LOS_IntRestore(intSave);
+    }
+}
+
+void HitlsSm2PoolStatsReset(void)
+{
+    UINT32 intSave = LOS_IntLock();
+    memset(&g_stats, 0, sizeof(g_stats));
+    LOS_IntRestore(intSave);
+}
@@ -0,0 +1,59 @@
+#ifndef APP_HITLS_SM2_POOL_H
+#define APP_HITLS_SM2_POOL_H
+
+#include <stdint.h>
+#include "crypt_sm2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 预初始化 SM2 上下文个数 (每个上下文独占一块 scratch arena)
+#define HITLS_SM2_POOL_SIZE     2
+// 单次操作的大数临时缓冲区大小 (SM2 签名/加解密实测峰值约 4KB)
+#define HITLS_SM2_ARENA_SIZE    (6 * 1024)
+
+typedef struct {
+    uint32_t heapAllocs;      // 落到堆上的分配次数
+    uint32_t heapFrees;       // 堆释放次数
+    uint32_t arenaAllocs;     // 在 arena 内完成的分配次数
+    uint32_t arenaOverflows;  // arena 空间不足而回退到堆的次数
+    uint32_t arenaPeak;       // arena 使用峰值 (字节)
+    uint32_t reallocs;        // 经 realloc 钩子处理的 arena 对象次数
+} HitlsSm2PoolStats;
+
+typedef void *(*HitlsSm2MallocFunc)(uint32_t size);
+typedef void (*HitlsSm2FreeFunc)(void *ptr);
+
+/**
+ * @brief 注册 BSL SAL 内存钩子并预创建上下文 (每个上下文都会生成密钥对)
+ * @param prevMalloc / prevFree 应用此前注册的 BSL SAL 内存回调，NULL 表示库默认的 malloc / free；
+ *        BSL SAL 无法查询已注册的回调，需由调用方传入。arena 之外的分配转交给它们，Deinit 时恢复
+ * 调用前需先通过 CRYPT_RandRegist 注册随机数源。
+ * BSL SAL 提供 realloc 回调时 (GN 参数 hitls_sal_realloc_cb) 同时接管 realloc，
+ * 否则 BSL_SAL_Realloc 由 malloc + 拷贝 + free 组成，同样经过上面两个钩子。
+ */
+int32_t HitlsSm2PoolInit(HitlsSm2MallocFunc prevMalloc, HitlsSm2FreeFunc prevFree);
+void HitlsSm2PoolDeinit(void);
+
+/**
+ * @brief 取出 / 归还一个已带密钥的上下文，取出后绑定到当前任务
+ * @return 池中无空闲上下文时返回 NULL
+ */
+CRYPT_SM2_Ctx *HitlsSm2PoolAcquire(void);
+void HitlsSm2PoolRelease(CRYPT_SM2_Ctx *ctx);
+
+/**
+ * @brief 包裹单次 SM2 操作：期间当前任务的 BSL_SAL_Malloc 走该上下文的 arena
+ * arena 按分配顺序成栈，栈顶对象释放即回收，全部释放时整体复位
+ */
+void HitlsSm2ArenaBegin(CRYPT_SM2_Ctx *ctx);
+void HitlsSm2ArenaEnd(CRYPT_SM2_Ctx *ctx);
+
+void HitlsSm2PoolStatsGet(HitlsSm2PoolStats *stats);
+void HitlsSm2PoolStatsReset(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
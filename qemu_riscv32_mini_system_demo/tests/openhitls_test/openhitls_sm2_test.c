@@ -6,6 +6,7 @@
 #include "cmsis_os2.h"
 
 #include "los_task.h"
+#include "los_tick.h"
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -18,44 +19,228 @@
 #include "bsl_params.h"
 #include "crypt_util_rand.h"
 
-#define HITLS_CRYPTO_SM2
-#define HITLS_CRYPTO_SM2_CRYPT
-
 #include "crypt_sm2.h"  
 #include "crypt_sm2.h"  
 #include "crypt_local_types.h"
 #include "crypt_util_rand.h"
 // #include "crypt_eal_rand.h"
+#include "hitls_sm2_pool.h"
+#include "bench_rng.h"
+#if defined(ALLOC_TRACE_RECORD)
+#include "alloc_trace.h"
+#endif
 
 #define TASK_STACK_SIZE (1024*20) 
 #define TASK_PRIO       25
 #define UINT8_MAX_NUM   255
 
+// 池化路径与原路径对比的迭代次数
+#define POOL_CMP_ITERATIONS 8
+
 
 typedef int32_t (*myfun)(uint8_t *myrandNum, uint32_t myLen);
 typedef int32_t (*Testfun)(uint8_t *rand, uint32_t randLen);
 static myfun myfuntest=NULL;
 Testfun testfun1 = NULL;
 
+static BenchRng g_testRng;
+static bool g_testRngReady = false;
+
+static void TestRngBytes(uint8_t *buf, uint32_t len)
+{
+    if (!g_testRngReady) {
+        BenchRngInit(&g_testRng, BENCH_RNG_STREAM_HITLS_TEST);
+        g_testRngReady = true;
+    }
+    BenchRngBytes(&g_testRng, buf, len);
+}
+
 int32_t Myfun(uint8_t *myrandNum, uint32_t myLen)
 {
     printf("myfun = %d\n", myLen);
-    for (uint32_t i = 0; i < myLen; i++) {
-        myrandNum[i] = (uint8_t)(rand() % UINT8_MAX_NUM);
-    }
-    return 0;
+    TestRngBytes(myrandNum, myLen);
     return 0;
 }
 
 
 int32_t TestRandFunc(uint8_t *randNum, uint32_t randLen)
 {
-    for (uint32_t i = 0; i < randLen; i++) {
-        randNum[i] = (uint8_t)(rand() % UINT8_MAX_NUM);
-    }
+    TestRngBytes(randNum, randLen);
     return 0;
 }
 
+/* =====================  上下文池对比  ===================== */
+
+typedef struct {
+    uint64_t cycles;
+    uint32_t heapAllocs;
+    uint32_t fails;         // 返回错误或解密结果与明文不符的次数
+} OpCost;
+
+static void PrintOpCost(const char *path, const char *op, const OpCost *cost, uint32_t ops)
+{
+    if (ops == 0) {
+        return;
+    }
+    printf("%-8s | %-8s | %12llu | %10u | %5u\n", path, op,
+           cost->cycles / ops, cost->heapAllocs / ops, cost->fails);
+}
+
+static bool DecryptFailed(int32_t ret, const uint8_t *message, const uint8_t *plain, uint32_t plainLen)
+{
+    uint32_t msgLen = (uint32_t)strlen((const char *)message);
+    return ret != CRYPT_SUCCESS || plainLen != msgLen || memcmp(plain, message, msgLen) != 0;
+}
+
+/**
+ * @brief 原路径：每次使用都 NewCtx/Gen/FreeCtx，临时大数全部走堆
+ * 两条路径对同一明文做同样次数的加密与解密，并校验解密结果
+ */
+static void RunLegacyPath(OpCost *use, OpCost *enc, OpCost *dec)
+{
+    uint8_t message[] = "encryption standard NEWPLAN!!";
+    uint8_t out[256];
+    uint8_t plain[64];
+    HitlsSm2PoolStats before, after;
+
+    for (int i = 0; i < POOL_CMP_ITERATIONS; i++) {
+        uint32_t outlen = sizeof(out);
+        uint32_t plainLen = sizeof(plain);
+
+        HitlsSm2PoolStatsGet(&before);
+        uint64_t t0 = LOS_SysCycleGet();
+        CRYPT_SM2_Ctx *ctx = CRYPT_SM2_NewCtx();
+        if (ctx == NULL || CRYPT_SM2_Gen(ctx) != CRYPT_SUCCESS) {
+            printf("legacy path: ctx setup fail!\n");
+            CRYPT_SM2_FreeCtx(ctx);
+            return;
+        }
+        uint64_t t1 = LOS_SysCycleGet();
+        HitlsSm2PoolStatsGet(&after);
+        use->cycles += t1 - t0;
+        use->heapAllocs += after.heapAllocs - before.heapAllocs;
+
+        before = after;
+        t0 = LOS_SysCycleGet();
+        int32_t ret = CRYPT_SM2_Encrypt(ctx, message, strlen((char *)message), out, &outlen);
+        t1 = LOS_SysCycleGet();
+        enc->fails += (ret != CRYPT_SUCCESS) ? 1 : 0;
+        HitlsSm2PoolStatsGet(&after);
+        enc->cycles += t1 - t0;
+        enc->heapAllocs += after.heapAllocs - before.heapAllocs;
+
+        before = after;
+        t0 = LOS_SysCycleGet();
+        ret = CRYPT_SM2_Decrypt(ctx, out, outlen, plain, &plainLen);
+        t1 = LOS_SysCycleGet();
+        dec->fails += DecryptFailed(ret, message, plain, plainLen) ? 1 : 0;
+        HitlsSm2PoolStatsGet(&after);
+        dec->cycles += t1 - t0;
+        dec->heapAllocs += after.heapAllocs - before.heapAllocs;
+
+        CRYPT_SM2_FreeCtx(ctx);
+    }
+}
+
+/**
+ * @brief 池化路径：上下文常驻，单次操作的临时大数走 arena
+ */
+static void RunPooledPath(OpCost *use, OpCost *enc, OpCost *dec)
+{
+    uint8_t message[] = "encryption standard NEWPLAN!!";
+    uint8_t out[256];
+    uint8_t plain[64];
+    HitlsSm2PoolStats before, after;
+
+    for (int i = 0; i < POOL_CMP_ITERATIONS; i++) {
+        uint32_t outlen = sizeof(out);
+        uint32_t plainLen = sizeof(plain);
+
+        HitlsSm2PoolStatsGet(&before);
+        uint64_t t0 = LOS_SysCycleGet();
+        CRYPT_SM2_Ctx *ctx = HitlsSm2PoolAcquire();
+        uint64_t t1 = LOS_SysCycleGet();
+        if (ctx == NULL) {
+            printf("pooled path: no free ctx!\n");
+            return;
+        }
+        HitlsSm2PoolStatsGet(&after);
+        use->cycles += t1 - t0;
+        use->heapAllocs += after.heapAllocs - before.heapAllocs;
+
+        before = after;
+        t0 = LOS_SysCycleGet();
+        HitlsSm2ArenaBegin(ctx);
+        int32_t ret = CRYPT_SM2_Encrypt(ctx, message, strlen((char *)message), out, &outlen);
+        HitlsSm2ArenaEnd(ctx);
+        t1 = LOS_SysCycleGet();
+        enc->fails += (ret != CRYPT_SUCCESS) ? 1 : 0;
+        HitlsSm2PoolStatsGet(&after);
+        enc->cycles += t1 - t0;
+        enc->heapAllocs += after.heapAllocs - before.heapAllocs;
+
+        before = after;
+        t0 = LOS_SysCycleGet();
+        HitlsSm2ArenaBegin(ctx);
+        ret = CRYPT_SM2_Decrypt(ctx, out, outlen, plain, &plainLen);
+        HitlsSm2ArenaEnd(ctx);
+        t1 = LOS_SysCycleGet();
+        dec->fails += DecryptFailed(ret, message, plain, plainLen) ? 1 : 0;
+        HitlsSm2PoolStatsGet(&after);
+        dec->cycles += t1 - t0;
+        dec->heapAllocs += after.heapAllocs - before.heapAllocs;
+
+        HitlsSm2PoolRelease(ctx);
+    }
+}
+
+static void HitlsSM2PoolCompare(void)
+{
+    OpCost legacyUse = {0}, legacyEnc = {0}, legacyDec = {0};
+    OpCost pooledUse = {0}, pooledEnc = {0}, pooledDec = {0};
+    HitlsSm2PoolStats stats;
+
+    printf("\n=== SM2 context pool vs per-use ctx (%d iterations) ===\n", POOL_CMP_ITERATIONS);
+    if (HitlsSm2PoolInit(NULL, NULL) != CRYPT_SUCCESS) {
+        printf("HitlsSm2PoolInit fail!\n");
+        return;
+    }
+
+    // 两条路径各预热一轮，让 arena 复位路径、SM3 等内部状态与堆布局都进入稳态后再计数
+    RunLegacyPath(&legacyUse, &legacyEnc, &legacyDec);
+    RunPooledPath(&pooledUse, &pooledEnc, &pooledDec);
+    memset(&legacyUse, 0, sizeof(OpCost));
+    memset(&legacyEnc, 0, sizeof(OpCost));
+    memset(&legacyDec, 0, sizeof(OpCost));
+    memset(&pooledUse, 0, sizeof(OpCost));
+    memset(&pooledEnc, 0, sizeof(OpCost));
+    memset(&pooledDec, 0, sizeof(OpCost));
+    HitlsSm2PoolStatsReset();
+
+    RunLegacyPath(&legacyUse, &legacyEnc, &legacyDec);
+    RunPooledPath(&pooledUse, &pooledEnc, &pooledDec);
+
+    printf("%-8s | %-8s | %12s | %10s | %5s\n", "Path", "Op", "Cycles/op", "HeapAlloc", "Fails");
+    printf("---------|----------|--------------|------------|------\n");
+    PrintOpCost("legacy", "ctx", &legacyUse, POOL_CMP_ITERATIONS);
+    PrintOpCost("legacy", "encrypt", &legacyEnc, POOL_CMP_ITERATIONS);
+    PrintOpCost("legacy", "decrypt", &legacyDec, POOL_CMP_ITERATIONS);
+    PrintOpCost("pooled", "ctx", &pooledUse, POOL_CMP_ITERATIONS);
+    PrintOpCost("pooled", "encrypt", &pooledEnc, POOL_CMP_ITERATIONS);
+    PrintOpCost("pooled", "decrypt", &pooledDec, POOL_CMP_ITERATIONS);
+
+    HitlsSm2PoolStatsGet(&stats);
+    printf("arena allocs: %u, overflows: %u, peak: %u bytes, reallocs: %u\n",
+           stats.arenaAllocs, stats.arenaOverflows, stats.arenaPeak, stats.reallocs);
+    if (pooledEnc.heapAllocs == 0 && pooledDec.heapAllocs == 0) {
+        printf("pooled path: zero heap allocations in steady state\n");
+    } else {
+        printf("pooled path: heap still used, enlarge HITLS_SM2_ARENA_SIZE\n");
+    }
+    // 恢复注册池之前的 BSL SAL 内存回调
+    HitlsSm2PoolDeinit();
+}
+
 /* =====================  任务入口  =======  ============== */
 
 static void HitlsSM2TestTask(void)
@@ -143,15 +328,32 @@ static void HitlsSM2TestTask(void)
         sleep(1);
     }
     CRYPT_SM2_FreeCtx(ctx);
+
+    HitlsSM2PoolCompare();
 }
 
 
+#if defined(ALLOC_TRACE_RECORD)
+// 测试函数中途有多处返回，在外层包一层记录 hitls 轨迹
+static void HitlsSM2TraceTask(void)
+{
+    (void)AllocTraceStart("hitls", LOS_CurTaskIDGet());
+    HitlsSM2TestTask();
+    (void)AllocTraceStop();
+    (void)AllocTraceSave();
+}
+#endif
+
 void HitlsSM2TestTaskApp(void)
 {
     unsigned int taskID;
     TSK_INIT_PARAM_S task = { 0 };
 
+#if defined(ALLOC_TRACE_RECORD)
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)HitlsSM2TraceTask;
+#else
     task.pfnTaskEntry = (TSK_ENTRY_FUNC)HitlsSM2TestTask;
+#endif
     task.uwStackSize  = TASK_STACK_SIZE;
     task.pcName       = "hitls_sm2_test";
     task.usTaskPrio   = TASK_PRIO;
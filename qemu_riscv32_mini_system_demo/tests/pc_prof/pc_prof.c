@@ -0,0 +1,213 @@
+/*
+ * 定时器中断 PC 采样 profiler
+ * 生产者是 ISR_ENTER 钩子 (中断上下文，中断嵌套关闭)，只追加不回绕，数组满后计数丢弃；
+ * 读取方在任务上下文按 g_count 读取已发布的样本，样本先写完再发布计数。
+ * 回溯由 LOS_RecordLR 从当前栈向上扫描得到，是启发式结果：前几层是中断入口与本钩子自身，
+ * 由主机端脚本按符号名剔除；若移植在中断中切到独立的中断栈，扫描不到任务的调用者，
+ * 此时只能使用 PC (depth 0)。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+#include "shcmd.h"
+#if defined(LOSCFG_DEBUG_HOOK)
+#include "los_hook.h"
+#endif
+#if defined(LOSCFG_KERNEL_BACKTRACE)
+#include "los_backtrace.h"
+#endif
+
+#include "pc_prof.h"
+
+/* ================= 全局变量 ================= */
+static PcProfSample g_samples[PC_PROF_SAMPLES];
+// g_count 只由钩子写，样本内容先于计数可见
+static volatile UINT32 g_count = 0;
+static volatile UINT32 g_dropped = 0;
+static volatile UINT32 g_ticks = 0;
+static volatile BOOL g_running = FALSE;
+static UINT32 g_divider = 1;
+static UINT32 g_depth = 0;
+static UINT32 g_phase = 0;
+static BOOL g_inited = FALSE;
+
+/* ================= 生产者 ================= */
+
+static inline UINTPTR ReadMepc(VOID)
+{
+    UINTPTR pc;
+    __asm__ volatile("csrr %0, mepc" : "=r"(pc));
+    return pc;
+}
+
+static VOID PcProfOnIsrEnter(UINT32 hwiNum)
+{
+    PcProfSample *s;
+    UINT32 count;
+    UINT32 taskId;
+
+    if (!g_running || hwiNum != PC_PROF_TIMER_IRQ) {
+        return;
+    }
+    g_ticks++;
+    if (++g_phase < g_divider) {
+        return;
+    }
+    g_phase = 0;
+
+    count = g_count;
+    if (count >= PC_PROF_SAMPLES) {
+        g_dropped++;
+        return;
+    }
+    s = &g_samples[count];
+    taskId = g_losTask.runTask->taskID;
+    s->pc = ReadMepc();
+    s->taskId = (UINT16)taskId;
+    s->flags = (taskId == g_idleTaskID) ? PC_PROF_FLAG_IDLE : 0;
+    s->depth = 0;
+#if defined(LOSCFG_KERNEL_BACKTRACE)
+    if (g_depth > 0) {
+        memset(s->bt, 0, sizeof(s->bt));
+        LOS_RecordLR(s->bt, g_depth, 0, 0);
+        while (s->depth < g_depth && s->bt[s->depth] != 0) {
+            s->depth++;
+        }
+    }
+#endif
+    __atomic_store_n(&g_count, count + 1, __ATOMIC_RELEASE);
+}
+
+/* ================= 控制 ================= */
+
+UINT32 PcProfStart(UINT32 divider, UINT32 depth)
+{
+    UINT32 intSave;
+
+    if (!g_inited) {
+        return LOS_NOK;
+    }
+    if (depth > PC_PROF_BT_DEPTH) {
+        depth = PC_PROF_BT_DEPTH;
+    }
+#if !defined(LOSCFG_KERNEL_BACKTRACE)
+    depth = 0;
+#endif
+    intSave = LOS_IntLock();
+    g_count = 0;
+    g_dropped = 0;
+    g_ticks = 0;
+    g_phase = 0;
+    g_divider = (divider == 0) ? 1 : divider;
+    g_depth = depth;
+    g_running = TRUE;
+    LOS_IntRestore(intSave);
+    return LOS_OK;
+}
+
+VOID PcProfStop(VOID)
+{
+    g_running = FALSE;
+}
+
+VOID PcProfStatsGet(PcProfStats *stats)
+{
+    stats->samples = __atomic_load_n(&g_count, __ATOMIC_ACQUIRE);
+    stats->dropped = g_dropped;
+    stats->ticks = g_ticks;
+    stats->divider = g_divider;
+    stats->depth = g_depth;
+    stats->running = g_running;
+}
+
+UINT32 PcProfSampleGet(UINT32 index, PcProfSample *sample)
+{
+    if (sample == NULL || index >= __atomic_load_n(&g_count, __ATOMIC_ACQUIRE)) {
+        return LOS_NOK;
+    }
+    *sample = g_samples[index];
+    return LOS_OK;
+}
+
+/* ================= 转储 ================= */
+
+VOID PcProfDumpUart(VOID)
+{
+    UINT32 count = __atomic_load_n(&g_count, __ATOMIC_ACQUIRE);
+    TSK_INFO_S info;
+
+    printf("#PP BEGIN %u %u %u %u %u %u\n", PC_PROF_VERSION, (UINT32)LOSCFG_BASE_CORE_TICK_PER_SECOND,
+           g_divider, g_depth, count, g_dropped);
+    // 已退出任务的名字查不到，主机端按任务号显示
+    for (UINT32 id = 0; id <= LOSCFG_BASE_CORE_TSK_LIMIT; id++) {
+        if (LOS_TaskInfoGet(id, &info) == LOS_OK) {
+            printf("#PP T %u %s\n", id, info.acName);
+        }
+    }
+    for (UINT32 i = 0; i < count; i++) {
+        const PcProfSample *s = &g_samples[i];
+        printf("#PP S %u %u 0x%08x", s->taskId, s->flags, (UINT32)s->pc);
+        for (UINT32 d = 0; d < s->depth; d++) {
+            printf(" 0x%08x", (UINT32)s->bt[d]);
+        }
+        printf("\n");
+    }
+    printf("#PP END %u\n", count);
+}
+
+/* ================= shell 命令 ================= */
+
+static UINT32 PcProfCmd(UINT32 argc, const CHAR **argv)
+{
+    PcProfStats stats;
+
+    if (argc < 1) {
+        printf("usage: pcprof start [divider] [depth]|stop|stat|dump\n");
+        return LOS_NOK;
+    }
+    if (strcmp(argv[0], "start") == 0) {
+        UINT32 divider = (argc >= 2) ? (UINT32)strtoul(argv[1], NULL, 0) : 1;
+        UINT32 depth = (argc >= 3) ? (UINT32)strtoul(argv[2], NULL, 0) : 0;
+        return PcProfStart(divider, depth);
+    } else if (strcmp(argv[0], "stop") == 0) {
+        PcProfStop();
+    } else if (strcmp(argv[0], "stat") == 0) {
+        PcProfStatsGet(&stats);
+        printf("running %u, samples %u/%u, dropped %u, ticks %u, rate %u Hz, depth %u\n", stats.running,
+               stats.samples, PC_PROF_SAMPLES, stats.dropped, stats.ticks,
+               (UINT32)LOSCFG_BASE_CORE_TICK_PER_SECOND / stats.divider, stats.depth);
+    } else if (strcmp(argv[0], "dump") == 0) {
+        PcProfDumpUart();
+    } else {
+        printf("unknown subcommand: %s\n", argv[0]);
+        return LOS_NOK;
+    }
+    return LOS_OK;
+}
+
+UINT32 PcProfInit(VOID)
+{
+    if (g_inited) {
+        return LOS_OK;
+    }
+#if defined(LOSCFG_DEBUG_HOOK)
+    UINT32 ret = LOS_HookReg(LOS_HOOK_TYPE_ISR_ENTER, PcProfOnIsrEnter);
+    if (ret != LOS_OK) {
+        printf("[pcprof] isr hook register failed: 0x%X\n", ret);
+        return ret;
+    }
+#else
+    (void)PcProfOnIsrEnter;
+    printf("[pcprof] LOSCFG_DEBUG_HOOK is not enabled\n");
+    return LOS_NOK;
+#endif
+    (void)osCmdReg(CMD_TYPE_EX, "pcprof", XARGS, (CmdCallBackFunc)PcProfCmd);
+    g_inited = TRUE;
+    return LOS_OK;
+}
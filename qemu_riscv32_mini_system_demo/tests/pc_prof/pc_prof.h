@@ -0,0 +1,77 @@
+#ifndef APP_PC_PROF_H
+#define APP_PC_PROF_H
+
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 定时器中断 PC 采样 profiler
+ * 通过内核的 ISR_ENTER 钩子 (需要 LOSCFG_DEBUG_HOOK，见 kernel_configs/pc_prof.config) 在机器定时器中断进入时读取 mepc，
+ * 即被打断的指令地址，连同当前任务号 (可选再加几级回溯) 写入预分配的样本数组。
+ * 采样率为 tick 频率 / divider；tickless 空闲期间没有 tick，也就没有 idle 样本。
+ * shell: pcprof start [divider] [depth] | stop | stat | dump
+ * 转储为 "#PP" 文本行，主机端 tools/pcprof_fold.py 对照 OHOS_Image 符号化并输出折叠栈。
+ */
+
+#define PC_PROF_VERSION          1
+#define PC_PROF_SAMPLES          2048
+#define PC_PROF_BT_DEPTH         4
+
+// 机器模式定时器中断号
+#ifndef PC_PROF_TIMER_IRQ
+#define PC_PROF_TIMER_IRQ        7
+#endif
+
+#define PC_PROF_FLAG_IDLE        0x1
+
+typedef struct {
+    UINTPTR pc;                     // 被打断的指令地址
+    UINT16 taskId;
+    UINT8 depth;                    // bt 中有效的层数
+    UINT8 flags;                    // PC_PROF_FLAG_*
+    UINTPTR bt[PC_PROF_BT_DEPTH];   // LOS_RecordLR 扫描到的返回地址，由内向外
+} PcProfSample;
+
+typedef struct {
+    UINT32 samples;
+    UINT32 dropped;                 // 样本数组满后丢弃的采样
+    UINT32 ticks;                   // 运行期间进入的定时器中断数
+    UINT32 divider;
+    UINT32 depth;
+    BOOL running;
+} PcProfStats;
+
+/**
+ * @brief 注册中断钩子与 shell 命令 pcprof，重复调用无副作用
+ * @return LOS_NOK 内核未开启 LOSCFG_DEBUG_HOOK 或钩子注册失败
+ */
+UINT32 PcProfInit(VOID);
+
+/**
+ * @brief 清空上一轮样本并开始采样
+ * @param divider 每 divider 个定时器中断采一次，0 按 1 处理
+ * @param depth 回溯层数，0 只记 PC；超过 PC_PROF_BT_DEPTH 时截断，未开启 LOSCFG_KERNEL_BACKTRACE 时忽略
+ */
+UINT32 PcProfStart(UINT32 divider, UINT32 depth);
+
+VOID PcProfStop(VOID);
+
+VOID PcProfStatsGet(PcProfStats *stats);
+
+/**
+ * @brief 读取第 index 个样本，采样期间也可调用
+ */
+UINT32 PcProfSampleGet(UINT32 index, PcProfSample *sample);
+
+/**
+ * @brief 以 "#PP" 文本行输出任务表与全部样本，样本保留到下一次 start
+ */
+VOID PcProfDumpUart(VOID);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,208 @@
+/*
+ * PC 采样 profiler 测试
+ * PpHotA (低优先级) 一直运行；PpHotB (高优先级) 每轮烧约 HOT_B_BURN_TICKS 个 tick 后延时
+ * HOT_B_DELAY_TICKS，预期 A 的样本多于 B。分别以 divider 1 与 PROF_DIVIDER 采样 PROF_TICKS，
+ * 检查钩子看到的定时器中断数、样本数与 divider 的关系，以及按任务的样本分布。
+ * divider 1 一轮的样本以 "#PP" 行转储，可直接交给 tools/pcprof_fold.py。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+
+#include "pc_prof.h"
+#include "pc_prof_test.h"
+#include "test_assert.h"
+
+#define TASK_STACK_SIZE          0x1000
+#define CTRL_TASK_PRI            4
+#define HOT_A_PRI                20
+#define HOT_B_PRI                19
+
+#define HOT_B_BURN_TICKS         2
+#define HOT_B_DELAY_TICKS        4
+#define PROF_TICKS               (3 * LOSCFG_BASE_CORE_TICK_PER_SECOND)
+#define PROF_DIVIDER             4
+#define PROF_DEPTH               PC_PROF_BT_DEPTH
+
+typedef struct {
+    UINT32 divider;
+    UINT32 ticks;
+    UINT32 samples;
+    UINT32 dropped;
+    UINT32 hotA;
+    UINT32 hotB;
+    UINT32 idle;
+    UINT32 other;
+} ProfRun;
+
+static TestStats g_stats = { 0 };
+
+/* ================= 全局变量 ================= */
+static volatile BOOL g_running = FALSE;
+static volatile UINT32 g_alive = 0;
+static UINT32 g_hotAId;
+static UINT32 g_hotBId;
+
+/* ================= 负载 ================= */
+
+static VOID __attribute__((noinline)) HotLoopA(VOID)
+{
+    volatile UINT32 acc = 0;
+    for (UINT32 i = 0; i < 1000; i++) {
+        acc += i * 3;
+    }
+}
+
+static VOID __attribute__((noinline)) HotLoopB(UINT64 cycles)
+{
+    UINT64 end = LOS_SysCycleGet() + cycles;
+    volatile UINT32 acc = 0;
+    while (LOS_SysCycleGet() < end) {
+        acc += 7;
+    }
+}
+
+static VOID TaskExit(VOID)
+{
+    UINT32 intSave = LOS_IntLock();
+    g_alive--;
+    LOS_IntRestore(intSave);
+}
+
+static VOID *HotAEntry(UINTPTR arg)
+{
+    (VOID)arg;
+    while (g_running) {
+        HotLoopA();
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID *HotBEntry(UINTPTR arg)
+{
+    UINT64 burn = (UINT64)OS_SYS_CLOCK * HOT_B_BURN_TICKS / LOSCFG_BASE_CORE_TICK_PER_SECOND;
+
+    (VOID)arg;
+    while (g_running) {
+        HotLoopB(burn);
+        (VOID)LOS_TaskDelay(HOT_B_DELAY_TICKS);
+    }
+    TaskExit();
+    return NULL;
+}
+
+static UINT32 CreateTask(UINT32 *id, TSK_ENTRY_FUNC entry, const CHAR *name, UINT16 prio)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 ret;
+
+    param.pfnTaskEntry = entry;
+    param.uwStackSize  = TASK_STACK_SIZE;
+    param.pcName       = (CHAR *)name;
+    param.usTaskPrio   = prio;
+    ret = LOS_TaskCreate(id, &param);
+    if (ret == LOS_OK) {
+        g_alive++;
+    } else {
+        printf("create %s failed: 0x%X\n", name, ret);
+    }
+    return ret;
+}
+
+/* ================= 测试流程 ================= */
+
+static VOID Profile(UINT32 divider, ProfRun *run)
+{
+    PcProfStats stats;
+    PcProfSample s;
+
+    memset(run, 0, sizeof(*run));
+    run->divider = divider;
+    (VOID)PcProfStart(divider, PROF_DEPTH);
+    (VOID)LOS_TaskDelay(PROF_TICKS);
+    PcProfStop();
+
+    PcProfStatsGet(&stats);
+    run->ticks = stats.ticks;
+    run->samples = stats.samples;
+    run->dropped = stats.dropped;
+    for (UINT32 i = 0; PcProfSampleGet(i, &s) == LOS_OK; i++) {
+        if (s.taskId == g_hotAId) {
+            run->hotA++;
+        } else if (s.taskId == g_hotBId) {
+            run->hotB++;
+        } else if (s.flags & PC_PROF_FLAG_IDLE) {
+            run->idle++;
+        } else {
+            run->other++;
+        }
+    }
+    printf("PCPROF divider=%u ticks=%u samples=%u dropped=%u hot_a=%u hot_b=%u idle=%u other=%u\n",
+           run->divider, run->ticks, run->samples, run->dropped, run->hotA, run->hotB, run->idle, run->other);
+}
+
+static VOID *PcProfTestTask(UINTPTR arg)
+{
+    ProfRun full;
+    ProfRun div;
+
+    (VOID)arg;
+    printf("\n>>> PC Sampling Profiler Test <<<\n");
+    if (PcProfInit() != LOS_OK) {
+        TEST_ASSERT(FALSE, "PcProfInit (需要 LOSCFG_DEBUG_HOOK)");
+        TEST_SUMMARY();
+        return NULL;
+    }
+
+    g_running = TRUE;
+    g_alive = 0;
+    if (CreateTask(&g_hotAId, (TSK_ENTRY_FUNC)HotAEntry, "PpHotA", HOT_A_PRI) != LOS_OK ||
+        CreateTask(&g_hotBId, (TSK_ENTRY_FUNC)HotBEntry, "PpHotB", HOT_B_PRI) != LOS_OK) {
+        g_running = FALSE;
+        return NULL;
+    }
+
+    Profile(PROF_DIVIDER, &div);
+    Profile(1, &full);
+    // 负载任务退出前转储，任务表中才有它们的名字
+    PcProfDumpUart();
+    g_running = FALSE;
+    while (g_alive != 0) {
+        (VOID)LOS_TaskDelay(1);
+    }
+
+    TEST_ASSERT(full.ticks * 10 >= PROF_TICKS * 9 && full.ticks * 10 <= PROF_TICKS * 11,
+                "钩子看到的定时器中断数与采样时长一致");
+    TEST_ASSERT(full.samples == full.ticks, "divider 1 时每个定时器中断一个样本");
+    TEST_ASSERT(div.samples + 1 >= div.ticks / PROF_DIVIDER && div.samples <= div.ticks / PROF_DIVIDER + 1,
+                "divider 按比例降低采样率");
+    TEST_ASSERT(full.dropped == 0 && div.dropped == 0, "样本数组未溢出");
+    TEST_ASSERT(full.hotB > 0 && full.hotA > full.hotB, "样本按任务的分布与负载一致 (A > B > 0)");
+
+    TEST_SUMMARY();
+    return NULL;
+}
+
+void PcProfTestApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)PcProfTestTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "PcProfTestTask";
+    task.usTaskPrio   = CTRL_TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("PcProfTestTask create failed: 0x%X\n", ret);
+    }
+}
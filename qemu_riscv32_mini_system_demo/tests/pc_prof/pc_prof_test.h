@@ -0,0 +1,13 @@
+#ifndef APP_PC_PROF_TEST_H
+#define APP_PC_PROF_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void PcProfTestApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,87 @@
+/*
+ * 基准结果记录
+ * 整行 (含串口前缀) 格式化到调用方栈上的缓冲区后一次输出，多个任务同时输出时记录不会互相覆盖；
+ * 字符串字段按 JSON 转义，名字中带引号或反斜杠也不会破坏记录。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "los_task.h"
+
+#include "bench_result.h"
+
+#define BENCH_RESULT_LINE_MAX    256
+
+#if defined(BENCH_BUILD_ID)
+static const CHAR g_buildId[] = BENCH_BUILD_ID;
+#else
+static const CHAR g_buildId[] = __DATE__ " " __TIME__;
+#endif
+
+const CHAR *BenchBuildId(VOID)
+{
+    return g_buildId;
+}
+
+/**
+ * @brief 在 off 处追加 ,"key":"<转义后的 str>"，返回新的 off；放不下时返回 -1
+ */
+static INT32 JsonPutString(CHAR *buf, INT32 off, const CHAR *key, const CHAR *str)
+{
+    INT32 n;
+
+    if (off < 0) {
+        return -1;
+    }
+    n = snprintf(buf + off, BENCH_RESULT_LINE_MAX - off, ",\"%s\":\"", key);
+    if (n <= 0 || n >= BENCH_RESULT_LINE_MAX - off) {
+        return -1;
+    }
+    off += n;
+    for (const CHAR *p = (str != NULL) ? str : ""; *p != '\0'; p++) {
+        UINT8 c = (UINT8)*p;
+        // 最坏情况 \u00XX 占 6 字节，另留结尾引号与 '\0'
+        if (off + 8 > BENCH_RESULT_LINE_MAX) {
+            return -1;
+        }
+        if (c == '"' || c == '\\') {
+            buf[off++] = '\\';
+            buf[off++] = (CHAR)c;
+        } else if (c < 0x20) {
+            off += snprintf(buf + off, BENCH_RESULT_LINE_MAX - off, "\\u%04x", c);
+        } else {
+            buf[off++] = (CHAR)c;
+        }
+    }
+    buf[off++] = '"';
+    buf[off] = '\0';
+    return off;
+}
+
+VOID BenchResultEmit(const BenchResult *result, FILE *fp)
+{
+    CHAR line[BENCH_RESULT_LINE_MAX];
+    const INT32 start = (INT32)strlen(BENCH_RESULT_PREFIX);
+    INT32 off = snprintf(line, sizeof(line), BENCH_RESULT_PREFIX "{\"v\":%u", BENCH_RESULT_VERSION);
+    INT32 n;
+
+    off = JsonPutString(line, off, "build", g_buildId);
+    off = JsonPutString(line, off, "suite", result->suite);
+    off = JsonPutString(line, off, "case", result->name);
+    off = JsonPutString(line, off, "metric", result->metric);
+    off = JsonPutString(line, off, "unit", result->unit);
+    if (off > 0) {
+        n = snprintf(line + off, sizeof(line) - off, ",\"value\":%llu,\"iterations\":%u}\n",
+                     result->value, result->iterations);
+        off = (n <= 0 || n >= (INT32)sizeof(line) - off) ? -1 : off + n;
+    }
+    if (off <= 0) {
+        printf("[bench] result record too long: %s.%s\n", result->suite, result->name);
+        return;
+    }
+    printf("%s", line);
+    if (fp != NULL) {
+        fputs(line + start, fp);
+    }
+}
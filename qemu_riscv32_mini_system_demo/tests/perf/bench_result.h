@@ -0,0 +1,43 @@
+#ifndef APP_BENCH_RESULT_H
+#define APP_BENCH_RESULT_H
+
+#include <stdio.h>
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 基准结果记录
+ * 每个测量值一行，串口上以 "#BR " 为前缀，与控制台文本穿插也能被 tools/bench_compare.py 提取；
+ * 写文件时不带前缀，即 JSON Lines。字段固定，新增字段只能追加并提升 BENCH_RESULT_VERSION：
+ *   {"v":1,"build":"<id>","suite":"..","case":"..","metric":"..","unit":"..","value":N,"iterations":N}
+ * unit 决定比较方向：带 "/s" 或以 "fps" 开头的越大越好，"count" 只作信息展示，其余 (cycles / us / instr /
+ * bytes / errors 等) 越小越好。
+ * build 取 GN 参数 bench_build_id (CI 传入提交号)，未设置时为编译时间。
+ */
+
+#define BENCH_RESULT_PREFIX      "#BR "
+#define BENCH_RESULT_VERSION     1
+
+typedef struct {
+    const CHAR *suite;
+    const CHAR *name;           // 输出为 "case"
+    const CHAR *metric;
+    const CHAR *unit;
+    UINT64 value;
+    UINT32 iterations;          // 得到 value 所用的样本数
+} BenchResult;
+
+/**
+ * @brief 输出一条记录到串口，fp 非 NULL 时同时追加到文件 (不带前缀)
+ */
+VOID BenchResultEmit(const BenchResult *result, FILE *fp);
+
+const CHAR *BenchBuildId(VOID);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
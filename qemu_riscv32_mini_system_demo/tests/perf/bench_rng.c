@@ -0,0 +1,64 @@
+/*
+ * 测试用伪随机数
+ * 种子经一轮 murmur3 finalizer 打散，相邻流号也得到不相关的起点；xorshift32 的状态不能为 0。
+ */
+
+#include "los_task.h"
+#include "los_tick.h"
+
+#include "bench_rng.h"
+
+static UINT32 Mix(UINT32 x)
+{
+    x ^= x >> 16;
+    x *= 0x85EBCA6BU;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35U;
+    x ^= x >> 16;
+    return x;
+}
+
+VOID BenchRngInit(BenchRng *rng, UINT32 stream)
+{
+#if defined(BENCH_DETERMINISTIC)
+    UINT32 seed = BENCH_RNG_SEED;
+#else
+    UINT32 seed = (UINT32)LOS_SysCycleGet();
+#endif
+    rng->state = Mix(seed ^ Mix(stream + 1));
+    if (rng->state == 0) {
+        rng->state = BENCH_RNG_SEED;
+    }
+}
+
+UINT32 BenchRngNext(BenchRng *rng)
+{
+    UINT32 x = rng->state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng->state = x;
+    return x;
+}
+
+VOID BenchRngBytes(BenchRng *rng, UINT8 *buf, UINT32 len)
+{
+    UINT32 i = 0;
+
+    while (i < len) {
+        UINT32 v = BenchRngNext(rng);
+        for (UINT32 k = 0; k < sizeof(v) && i < len; k++, i++) {
+            buf[i] = (UINT8)(v >> (k * 8));
+        }
+    }
+}
+
+BOOL BenchRngDeterministic(VOID)
+{
+#if defined(BENCH_DETERMINISTIC)
+    return TRUE;
+#else
+    return FALSE;
+#endif
+}
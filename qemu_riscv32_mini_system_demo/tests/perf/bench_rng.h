@@ -0,0 +1,50 @@
+#ifndef APP_BENCH_RNG_H
+#define APP_BENCH_RNG_H
+
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 测试用伪随机数 (xorshift32)
+ * 每个使用者持有独立的状态，取数顺序不受其他任务穿插影响。
+ * 定义 BENCH_DETERMINISTIC (GN 参数 bench_deterministic) 时种子由 BENCH_RNG_SEED 与流号导出，
+ * 配合 qemu_run.sh 的 QEMU_BENCH=yes (-icount) 每次运行得到相同的序列；否则按启动后的周期计数取种子。
+ * 不用于任何安全用途。
+ */
+
+#define BENCH_RNG_SEED           0x2545F491U
+
+// 各使用者的流号，新增使用者在末尾追加
+typedef enum {
+    BENCH_RNG_STREAM_HITLS_TEST = 1,
+    BENCH_RNG_STREAM_CRYPTO_BENCH,
+    BENCH_RNG_STREAM_UI_DEMO,
+    BENCH_RNG_STREAM_ALLOC_REPLAY,
+} BenchRngStream;
+
+typedef struct {
+    UINT32 state;
+} BenchRng;
+
+/**
+ * @brief 初始化一路随机数流
+ * @param stream 流号，同一镜像内各使用者取不同值，确定模式下得到互不相同但固定的序列
+ */
+VOID BenchRngInit(BenchRng *rng, UINT32 stream);
+
+UINT32 BenchRngNext(BenchRng *rng);
+
+VOID BenchRngBytes(BenchRng *rng, UINT8 *buf, UINT32 len);
+
+/**
+ * @brief 是否以确定模式编译，结果记录与日志据此标注
+ */
+BOOL BenchRngDeterministic(VOID);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
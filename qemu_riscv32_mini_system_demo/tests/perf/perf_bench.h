@@ -0,0 +1,39 @@
+#ifndef APP_PERF_BENCH_H
+#define APP_PERF_BENCH_H
+
+#include "perf_counter.h"
+
+/*
+ * 基准测试的区间宏
+ * 每个调用点缓存自己的 PerfRegion 指针，只有第一次经过时按名字查找；
+ * 名字相同的调用点共享同一个区间。定义 PERF_DISABLE 时全部展开为空。
+ *
+ *   PERF_BEGIN("fopen");
+ *   fp = fopen(path, "w");
+ *   PERF_END("fopen");
+ *
+ *   PERF_MEASURE("memset 4K", memset(buf, 0, sizeof(buf)));
+ */
+
+#if defined(PERF_DISABLE)
+#define PERF_BEGIN(name)          do { } while (0)
+#define PERF_END(name)            do { } while (0)
+#define PERF_MEASURE(name, stmt)  do { stmt; } while (0)
+#define PERF_REPORT()             do { } while (0)
+#define PERF_RESET()              do { } while (0)
+#else
+#define PERF_SITE_REGION(name) ({ \
+    static PerfRegion *perfSite_ = NULL; \
+    if (perfSite_ == NULL) { \
+        perfSite_ = PerfRegionGet(name); \
+    } \
+    perfSite_; \
+})
+#define PERF_BEGIN(name)          PerfRegionBegin(PERF_SITE_REGION(name))
+#define PERF_END(name)            PerfRegionEnd(PERF_SITE_REGION(name))
+#define PERF_MEASURE(name, stmt)  do { PERF_BEGIN(name); stmt; PERF_END(name); } while (0)
+#define PERF_REPORT()             PerfReport()
+#define PERF_RESET()              PerfReset()
+#endif
+
+#endif
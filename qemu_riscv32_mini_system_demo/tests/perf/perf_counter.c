@@ -0,0 +1,217 @@
+/*
+ * 硬件性能计数器区间统计
+ * 区间表全局共享，按名字登记；嵌套栈按任务号分开，同一区间可以在多个任务中同时打开。
+ * Begin 在记账之后才读计数器，End 一进入就读，区间内尽量不含统计本身的开销。
+ * 统计更新在关中断下进行，只能在任务上下文中使用。
+ * 开启 LOSCFG_DEBUG_HOOK 时在任务删除钩子中清空该任务的嵌套栈，任务号被复用时不会继承未配对的 Begin。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "los_task.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+#if defined(LOSCFG_DEBUG_HOOK)
+#include "los_hook.h"
+#endif
+
+#include "perf_counter.h"
+#include "bench_result.h"
+
+#define PERF_MAX_TASKS           (LOSCFG_BASE_CORE_TSK_LIMIT + 1)
+
+typedef struct {
+    PerfRegion *region;
+    PerfCounters start;
+    UINT64 childCycles;
+} PerfFrame;
+
+/* ================= 全局变量 ================= */
+static PerfRegion g_regions[PERF_MAX_REGIONS];
+static UINT32 g_regionCount = 0;
+static PerfFrame g_stack[PERF_MAX_TASKS][PERF_MAX_DEPTH];
+static UINT8 g_depth[PERF_MAX_TASKS];
+static UINT32 g_mismatch = 0;
+static UINT32 g_regionOverflow = 0;     // 区间表已满时查找新名字的次数
+#if defined(LOSCFG_DEBUG_HOOK)
+static BOOL g_hookRegistered = FALSE;
+#endif
+
+static VOID MismatchInc(VOID)
+{
+    UINT32 intSave = LOS_IntLock();
+    g_mismatch++;
+    LOS_IntRestore(intSave);
+}
+
+#if defined(LOSCFG_DEBUG_HOOK)
+/**
+ * @brief 任务删除钩子：丢弃该任务未结束的区间
+ */
+static VOID PerfOnTaskDelete(const LosTaskCB *taskCB)
+{
+    if (taskCB->taskID < PERF_MAX_TASKS) {
+        g_depth[taskCB->taskID] = 0;
+    }
+}
+#endif
+
+UINT32 PerfIpcX100(UINT64 instret, UINT64 cycles)
+{
+    return (cycles == 0) ? 0 : (UINT32)(instret * 100 / cycles);
+}
+
+PerfRegion *PerfRegionGet(const CHAR *name)
+{
+    PerfRegion *r = NULL;
+    UINT32 overflow = 0;
+    UINT32 intSave = LOS_IntLock();
+
+    for (UINT32 i = 0; i < g_regionCount; i++) {
+        if (g_regions[i].name == name || strcmp(g_regions[i].name, name) == 0) {
+            r = &g_regions[i];
+            break;
+        }
+    }
+    if (r == NULL && g_regionCount < PERF_MAX_REGIONS) {
+        r = &g_regions[g_regionCount++];
+        memset(r, 0, sizeof(*r));
+        r->name = name;
+        r->minCycles = ~0ULL;
+    } else if (r == NULL) {
+        overflow = ++g_regionOverflow;
+    }
+#if defined(LOSCFG_DEBUG_HOOK)
+    // 没有单独的初始化入口，第一次登记区间时挂钩子
+    if (!g_hookRegistered) {
+        g_hookRegistered = (LOS_HookReg(LOS_HOOK_TYPE_TASK_DELETE, PerfOnTaskDelete) == LOS_OK);
+    }
+#endif
+    LOS_IntRestore(intSave);
+    // 只在第一次溢出时提示，其余计数在 PerfReport 中给出
+    if (overflow == 1) {
+        printf("[perf] region table full (%u), \"%s\" not recorded\n", PERF_MAX_REGIONS, name);
+    }
+    return r;
+}
+
+VOID PerfRegionBegin(PerfRegion *region)
+{
+    UINT32 task = LOS_CurTaskIDGet();
+    PerfFrame *f;
+
+    if (region == NULL || task >= PERF_MAX_TASKS) {
+        return;
+    }
+    if (g_depth[task] >= PERF_MAX_DEPTH) {
+        MismatchInc();
+        return;
+    }
+    f = &g_stack[task][g_depth[task]++];
+    f->region = region;
+    f->childCycles = 0;
+    PerfRead(&f->start);
+}
+
+VOID PerfRegionEnd(PerfRegion *region)
+{
+    PerfCounters now;
+    UINT32 task;
+    PerfFrame *f;
+    UINT64 cycles;
+    UINT32 intSave;
+
+    PerfRead(&now);
+    task = LOS_CurTaskIDGet();
+    if (region == NULL || task >= PERF_MAX_TASKS) {
+        return;
+    }
+    if (g_depth[task] == 0 || g_stack[task][g_depth[task] - 1].region != region) {
+        MismatchInc();
+        return;
+    }
+    f = &g_stack[task][--g_depth[task]];
+    cycles = now.cycles - f->start.cycles;
+    if (g_depth[task] > 0) {
+        g_stack[task][g_depth[task] - 1].childCycles += cycles;
+    }
+
+    intSave = LOS_IntLock();
+    region->calls++;
+    region->cycles += cycles;
+    region->selfCycles += cycles - f->childCycles;
+    region->instret += now.instret - f->start.instret;
+    if (cycles < region->minCycles) {
+        region->minCycles = cycles;
+    }
+    if (cycles > region->maxCycles) {
+        region->maxCycles = cycles;
+    }
+    LOS_IntRestore(intSave);
+}
+
+UINT32 PerfMismatchCount(VOID)
+{
+    UINT32 intSave = LOS_IntLock();
+    UINT32 n = g_mismatch;
+    LOS_IntRestore(intSave);
+    return n;
+}
+
+VOID PerfReset(VOID)
+{
+    UINT32 intSave = LOS_IntLock();
+
+    for (UINT32 i = 0; i < g_regionCount; i++) {
+        const CHAR *name = g_regions[i].name;
+        memset(&g_regions[i], 0, sizeof(g_regions[i]));
+        g_regions[i].name = name;
+        g_regions[i].minCycles = ~0ULL;
+    }
+    g_mismatch = 0;
+    g_regionOverflow = 0;
+    LOS_IntRestore(intSave);
+}
+
+VOID PerfReport(VOID)
+{
+    printf("\n%-20s | %-6s | %-12s | %-12s | %-5s | %-10s | %-10s | %-12s\n",
+           "Region", "Calls", "Cycles", "Instret", "IPC", "AvgCycles", "MaxCycles", "SelfCycles");
+    printf("---------------------|--------|--------------|--------------|-------|------------|"
+           "------------|-------------\n");
+    for (UINT32 i = 0; i < g_regionCount; i++) {
+        const PerfRegion *r = &g_regions[i];
+        if (r->calls == 0) {
+            continue;
+        }
+        UINT32 ipc = PerfIpcX100(r->instret, r->cycles);
+        printf("%-20s | %-6u | %-12llu | %-12llu | %u.%02u | %-10llu | %-10llu | %-12llu\n", r->name, r->calls,
+               r->cycles, r->instret, ipc / 100, ipc % 100, r->cycles / r->calls, r->maxCycles, r->selfCycles);
+    }
+    // 便于脚本提取的单行结果，以及 bench_result 记录 (suite 为 "perf"，case 为区间名)
+    for (UINT32 i = 0; i < g_regionCount; i++) {
+        const PerfRegion *r = &g_regions[i];
+        if (r->calls == 0) {
+            continue;
+        }
+        printf("PERF name=\"%s\" calls=%u cycles=%llu instret=%llu ipc_x100=%u min=%llu max=%llu self=%llu\n",
+               r->name, r->calls, r->cycles, r->instret, PerfIpcX100(r->instret, r->cycles), r->minCycles,
+               r->maxCycles, r->selfCycles);
+        BenchResult res = { "perf", r->name, "cycles_avg", "cycles", r->cycles / r->calls, r->calls };
+        BenchResultEmit(&res, NULL);
+        res.metric = "cycles_min";
+        res.value = r->minCycles;
+        BenchResultEmit(&res, NULL);
+        res.metric = "instret_avg";
+        res.unit = "instr";
+        res.value = r->instret / r->calls;
+        BenchResultEmit(&res, NULL);
+    }
+    if (g_mismatch != 0) {
+        printf("PERF begin/end mismatch: %u\n", g_mismatch);
+    }
+    if (g_regionOverflow != 0) {
+        printf("PERF region table full: %u lookups dropped\n", g_regionOverflow);
+    }
+}
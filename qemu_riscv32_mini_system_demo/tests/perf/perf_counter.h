@@ -0,0 +1,103 @@
+#ifndef APP_PERF_COUNTER_H
+#define APP_PERF_COUNTER_H
+
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 硬件性能计数器
+ * 读取 RISC-V 机器模式的 mcycle / minstret。rv32 上高低两半分两次读，
+ * 按 "高-低-高" 重读直到两次高位一致，低位进位时也能得到一致的 64 位值。
+ * QEMU virt 不实现 mhpmcounter3..31 的事件，这里只提供 cycle 与 instret；
+ * 不带 -icount 时 QEMU 的两个计数器都由宿主时钟换算，IPC 只有在 -icount (qemu_run.sh 的 QEMU_BENCH=yes) 下才有意义。
+ *
+ * 区间统计：PerfRegionBegin / PerfRegionEnd 成对使用，可嵌套 (每个任务独立一个栈)，
+ * 区间的 self 周期扣除了嵌套在其中的子区间。计数器是全核的，区间内发生的抢占与中断计入该区间。
+ * 任务退出时未结束的区间在任务删除钩子中丢弃 (需要 LOSCFG_DEBUG_HOOK)。
+ */
+
+#define PERF_MAX_REGIONS         32
+#define PERF_MAX_DEPTH           8
+
+typedef struct {
+    UINT64 cycles;
+    UINT64 instret;
+} PerfCounters;
+
+typedef struct {
+    const CHAR *name;               // 须在整个运行期间有效，通常为字符串字面量
+    UINT32 calls;
+    UINT64 cycles;                  // 含子区间
+    UINT64 selfCycles;              // 扣除子区间
+    UINT64 instret;
+    UINT64 minCycles;
+    UINT64 maxCycles;
+} PerfRegion;
+
+#if defined(__riscv_xlen) && (__riscv_xlen == 64)
+#define PERF_READ_CSR64(lo, hi) ({ UINT64 v_; __asm__ volatile("csrr %0, " #lo : "=r"(v_)); v_; })
+#else
+#define PERF_READ_CSR64(lo, hi) ({ \
+    UINT32 h1_, l_, h2_; \
+    do { \
+        __asm__ volatile("csrr %0, " #hi : "=r"(h1_)); \
+        __asm__ volatile("csrr %0, " #lo : "=r"(l_)); \
+        __asm__ volatile("csrr %0, " #hi : "=r"(h2_)); \
+    } while (h1_ != h2_); \
+    ((UINT64)h1_ << 32) | l_; \
+})
+#endif
+
+static inline UINT64 PerfCycleRead(VOID)
+{
+    return PERF_READ_CSR64(mcycle, mcycleh);
+}
+
+static inline UINT64 PerfInstretRead(VOID)
+{
+    return PERF_READ_CSR64(minstret, minstreth);
+}
+
+static inline VOID PerfRead(PerfCounters *c)
+{
+    c->cycles = PerfCycleRead();
+    c->instret = PerfInstretRead();
+}
+
+/**
+ * @brief IPC x100，cycles 为 0 时返回 0
+ */
+UINT32 PerfIpcX100(UINT64 instret, UINT64 cycles);
+
+/**
+ * @brief 按名字查找区间，不存在则创建；名字按指针比较后再按内容比较
+ * @return NULL 区间表已满，第一次时打印提示，累计次数在 PerfReport 中给出
+ */
+PerfRegion *PerfRegionGet(const CHAR *name);
+
+VOID PerfRegionBegin(PerfRegion *region);
+
+/**
+ * @brief 结束当前任务最内层的区间；region 与之不匹配时忽略并计入 PerfMismatchCount
+ */
+VOID PerfRegionEnd(PerfRegion *region);
+
+UINT32 PerfMismatchCount(VOID);
+
+/**
+ * @brief 清零全部区间的统计，区间名保留
+ */
+VOID PerfReset(VOID);
+
+/**
+ * @brief 打印有调用记录的区间表，并逐个输出 "PERF name=..." 单行结果
+ */
+VOID PerfReport(VOID);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,166 @@
+/*
+ * 性能计数器 API 测试
+ * 检查 64 位读数单调、已知条数的循环至少计入相应的 instret、嵌套区间的 self 扣除、
+ * begin/end 不匹配的检测，以及 PERF_* 宏按调用点共享区间；最后打印区间表。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_config.h"
+
+#include "perf_counter.h"
+#include "perf_bench.h"
+#include "perf_test.h"
+#include "test_assert.h"
+
+#define TASK_STACK_SIZE          0x1000
+#define CTRL_TASK_PRI            10
+
+#define MONOTONIC_READS          10000
+#define LOOP_ITERS               100000
+#define MEMSET_SIZE              4096
+
+static TestStats g_stats = { 0 };
+
+/* ================= 全局变量 ================= */
+static UINT8 g_buf[MEMSET_SIZE];
+
+static VOID __attribute__((noinline)) Spin(UINT32 iters)
+{
+    for (UINT32 i = 0; i < iters; i++) {
+        __asm__ volatile("nop");
+    }
+}
+
+/* ================= 测试用例 ================= */
+
+static VOID TestMonotonic(VOID)
+{
+    PerfCounters prev;
+    PerfCounters cur;
+    BOOL ok = TRUE;
+
+    printf("\n--- 64 位读数单调 ---\n");
+    PerfRead(&prev);
+    for (UINT32 i = 0; i < MONOTONIC_READS; i++) {
+        PerfRead(&cur);
+        if (cur.cycles < prev.cycles || cur.instret < prev.instret) {
+            ok = FALSE;
+        }
+        prev = cur;
+    }
+    printf("mcycle %llu, minstret %llu\n", cur.cycles, cur.instret);
+    TEST_ASSERT(ok, "连续读取 mcycle / minstret 不回退");
+}
+
+static VOID TestKnownLoop(VOID)
+{
+    PerfCounters a;
+    PerfCounters b;
+    UINT64 instret;
+
+    printf("\n--- 已知条数的循环 ---\n");
+    PerfRead(&a);
+    Spin(LOOP_ITERS);
+    PerfRead(&b);
+    instret = b.instret - a.instret;
+    printf("%u iterations: cycles %llu, instret %llu, IPC x100 %u\n", LOOP_ITERS, b.cycles - a.cycles, instret,
+           PerfIpcX100(instret, b.cycles - a.cycles));
+    // 每次迭代至少 nop、自增与分支三条指令
+    TEST_ASSERT(instret >= 3ULL * LOOP_ITERS, "instret 不少于循环的指令数");
+    TEST_ASSERT(b.cycles > a.cycles, "循环期间 mcycle 前进");
+}
+
+static VOID TestNesting(VOID)
+{
+    PerfRegion *outer = PerfRegionGet("nest.outer");
+    PerfRegion *inner = PerfRegionGet("nest.inner");
+
+    printf("\n--- 嵌套区间 ---\n");
+    TEST_ASSERT(outer != NULL && inner != NULL && outer != inner, "区间登记");
+    if (outer == NULL || inner == NULL) {
+        return;
+    }
+    TEST_ASSERT(PerfRegionGet("nest.outer") == outer, "同名区间返回同一项");
+
+    PerfRegionBegin(outer);
+    Spin(LOOP_ITERS / 10);
+    PerfRegionBegin(inner);
+    Spin(LOOP_ITERS);
+    PerfRegionEnd(inner);
+    Spin(LOOP_ITERS / 10);
+    PerfRegionEnd(outer);
+
+    TEST_ASSERT(outer->calls == 1 && inner->calls == 1, "每个区间各记一次");
+    TEST_ASSERT(outer->cycles >= inner->cycles, "外层区间包含内层");
+    TEST_ASSERT(outer->selfCycles == outer->cycles - inner->cycles, "外层 self 扣除内层");
+    TEST_ASSERT(inner->selfCycles == inner->cycles, "最内层 self 等于总数");
+    TEST_ASSERT(outer->instret > inner->instret, "外层 instret 大于内层");
+}
+
+static VOID TestMismatch(VOID)
+{
+    PerfRegion *a = PerfRegionGet("mismatch.a");
+    PerfRegion *b = PerfRegionGet("mismatch.b");
+    UINT32 before = PerfMismatchCount();
+
+    printf("\n--- begin/end 不匹配 ---\n");
+    PerfRegionBegin(a);
+    PerfRegionEnd(b);
+    TEST_ASSERT(PerfMismatchCount() == before + 1, "结束非最内层区间被计为不匹配");
+    PerfRegionEnd(a);
+    TEST_ASSERT(a->calls == 1 && b->calls == 0, "不匹配的结束不计入统计，原区间仍可正常结束");
+}
+
+static VOID TestMacros(VOID)
+{
+    PerfRegion *r;
+
+    printf("\n--- PERF_* 宏 ---\n");
+    for (UINT32 i = 0; i < 4; i++) {
+        PERF_MEASURE("memset 4K", memset(g_buf, (INT32)i, sizeof(g_buf)));
+    }
+    PERF_BEGIN("memset 4K");
+    memset(g_buf, 0, sizeof(g_buf));
+    PERF_END("memset 4K");
+    r = PerfRegionGet("memset 4K");
+    TEST_ASSERT(r != NULL && r->calls == 5, "同名调用点共享区间");
+    TEST_ASSERT(r != NULL && r->minCycles <= r->maxCycles && r->cycles >= r->maxCycles, "min / max 合理");
+}
+
+static VOID *PerfTestTask(UINTPTR arg)
+{
+    (VOID)arg;
+    printf("\n>>> Performance Counter Test <<<\n");
+    PerfReset();
+
+    TestMonotonic();
+    TestKnownLoop();
+    TestNesting();
+    TestMismatch();
+    TestMacros();
+
+    PerfReport();
+    TEST_SUMMARY();
+    return NULL;
+}
+
+void PerfTestApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)PerfTestTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "PerfTestTask";
+    task.usTaskPrio   = CTRL_TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("PerfTestTask create failed: 0x%X\n", ret);
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef APP_PERF_TEST_H
+#define APP_PERF_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void PerfTestApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,40 @@
+#ifndef APP_TEST_ASSERT_H
+#define APP_TEST_ASSERT_H
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 测试套件共用的断言
+ * 每条断言一行，行首为 "PASS: " 或 "FAIL: "，汇总一行以 "TESTS: " 开头，均为纯 ASCII 前缀，
+ * 与 bench_result 的 "#BR " 记录一样可以从串口日志中直接 grep / diff。
+ * 使用方在文件内定义 static TestStats g_stats = { 0 };
+ */
+
+typedef struct {
+    int total;
+    int passed;
+    int failed;
+} TestStats;
+
+#define TEST_ASSERT(condition, message) do { \
+    g_stats.total++; \
+    if (condition) { \
+        g_stats.passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        g_stats.failed++; \
+        printf("FAIL: %s (at %s:%d)\n", message, __FILE__, __LINE__); \
+    } \
+} while (0)
+
+#define TEST_SUMMARY() \
+    printf("\nTESTS: total %d, passed %d, failed %d\n", g_stats.total, g_stats.passed, g_stats.failed)
+
+#ifdef __cplusplus
+}
+#endif
+#endif
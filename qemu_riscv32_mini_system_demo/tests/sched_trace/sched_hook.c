@@ -0,0 +1,78 @@
+/*
+ * 任务切换钩子分发
+ * 内核只提供一个切换钩子，tracer / CPU 统计等模块通过这里共享
+ */
+
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_interrupt.h"
+
+#include "sched_hook.h"
+
+static SchedSwitchFn g_subscribers[SCHED_HOOK_MAX];
+static BOOL g_hookRegistered = FALSE;
+
+/**
+ * @brief 注册给内核的唯一钩子
+ * 签名与 LOS_TaskSwitchHookReg 要求的 VOID (*)(UINT32 taskId) 一致；
+ * 调用时 g_losTask.runTask 仍是被换出的任务，newTask 为即将运行的任务，两端都从这里取，不用 taskId
+ */
+static VOID SchedHookDispatch(UINT32 taskId)
+{
+    UINT64 now = LOS_SysCycleGet();
+    const LosTaskCB *from = g_losTask.runTask;
+    const LosTaskCB *to = g_losTask.newTask;
+
+    (VOID)taskId;
+    for (UINT32 i = 0; i < SCHED_HOOK_MAX; i++) {
+        SchedSwitchFn fn = g_subscribers[i];
+        if (fn != NULL) {
+            fn(from, to, now);
+        }
+    }
+}
+
+UINT32 SchedHookAdd(SchedSwitchFn fn)
+{
+    UINT32 ret = LOS_NOK;
+    UINT32 intSave = LOS_IntLock();
+
+    for (UINT32 i = 0; i < SCHED_HOOK_MAX; i++) {
+        if (g_subscribers[i] == fn) {
+            ret = LOS_OK;
+            break;
+        }
+    }
+    for (UINT32 i = 0; ret != LOS_OK && i < SCHED_HOOK_MAX; i++) {
+        if (g_subscribers[i] == NULL) {
+            g_subscribers[i] = fn;
+            ret = LOS_OK;
+        }
+    }
+    if (ret == LOS_OK && !g_hookRegistered) {
+        if (LOS_TaskSwitchHookReg(SchedHookDispatch) == LOS_OK) {
+            g_hookRegistered = TRUE;
+        } else {
+            for (UINT32 i = 0; i < SCHED_HOOK_MAX; i++) {
+                if (g_subscribers[i] == fn) {
+                    g_subscribers[i] = NULL;
+                }
+            }
+            ret = LOS_NOK;
+        }
+    }
+    LOS_IntRestore(intSave);
+    return ret;
+}
+
+VOID SchedHookRemove(SchedSwitchFn fn)
+{
+    UINT32 intSave = LOS_IntLock();
+
+    for (UINT32 i = 0; i < SCHED_HOOK_MAX; i++) {
+        if (g_subscribers[i] == fn) {
+            g_subscribers[i] = NULL;
+        }
+    }
+    LOS_IntRestore(intSave);
+}
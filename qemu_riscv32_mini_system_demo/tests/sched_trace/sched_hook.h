@@ -0,0 +1,32 @@
+#ifndef APP_SCHED_HOOK_H
+#define APP_SCHED_HOOK_H
+
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCHED_HOOK_MAX           4
+
+/*
+ * 任务切换回调
+ * 在调度器切换路径上、关中断状态下调用，from 为被换出的任务，to 为即将运行的任务，
+ * cycles 为本次切换的时间戳 (LOS_SysCycleGet)，所有订阅者共用同一个时间戳。
+ * 回调内不得阻塞、打印或申请内存。
+ */
+typedef VOID (*SchedSwitchFn)(const LosTaskCB *from, const LosTaskCB *to, UINT64 cycles);
+
+/**
+ * @brief 订阅任务切换
+ * LOS_TaskSwitchHookReg 只能挂一个钩子，这里统一注册并分发给多个订阅者
+ * @return LOS_OK 成功；LOS_NOK 订阅已满或内核钩子注册失败
+ */
+UINT32 SchedHookAdd(SchedSwitchFn fn);
+
+VOID SchedHookRemove(SchedSwitchFn fn);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
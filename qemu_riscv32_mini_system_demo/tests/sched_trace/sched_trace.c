@@ -0,0 +1,272 @@
+/*
+ * 任务切换 tracer
+ * 切换钩子 (生产者) 把定长二进制记录写入环形缓冲区，读取方 (消费者) 在任务上下文中取出，
+ * 双方各自只写自己的下标，不需要关中断；转储到 /data 或串口后由
+ * tools/sched_trace2json.py 转成 Chrome / Perfetto 时间线。
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+#include "shcmd.h"
+
+#include "sched_hook.h"
+#include "sched_trace.h"
+
+#define SCHED_TRACE_MASK         (SCHED_TRACE_RECORDS - 1)
+#define SCHED_TRACE_DUMP_CHUNK   32
+
+#if (SCHED_TRACE_RECORDS & SCHED_TRACE_MASK) != 0
+#error "SCHED_TRACE_RECORDS must be a power of two"
+#endif
+
+/* ================= 全局变量 ================= */
+static SchedTraceRecord g_ring[SCHED_TRACE_RECORDS];
+// head 只由钩子写，tail 只由读取方写；均单调递增，取模得到下标
+static volatile UINT32 g_head = 0;
+static volatile UINT32 g_tail = 0;
+static volatile UINT32 g_dropped = 0;
+static volatile BOOL g_running = FALSE;
+static BOOL g_inited = FALSE;
+
+// 转储时的临时缓冲，避免占用调用方栈
+static SchedTraceRecord g_chunk[SCHED_TRACE_DUMP_CHUNK];
+
+/* ================= 生产者 ================= */
+
+static UINT8 ReasonFromStatus(UINT16 status)
+{
+    if (status & OS_TASK_STATUS_READY) {
+        return SCHED_REASON_PREEMPT;
+    }
+    if (status & OS_TASK_STATUS_DELAY) {
+        return SCHED_REASON_DELAY;
+    }
+    if (status & OS_TASK_STATUS_PEND) {
+        return SCHED_REASON_PEND;
+    }
+    if (status & OS_TASK_STATUS_SUSPEND) {
+        return SCHED_REASON_SUSPEND;
+    }
+    if (status & (OS_TASK_STATUS_EXIT | OS_TASK_STATUS_UNUSED)) {
+        return SCHED_REASON_EXIT;
+    }
+    return SCHED_REASON_OTHER;
+}
+
+static VOID SchedTraceOnSwitch(const LosTaskCB *from, const LosTaskCB *to, UINT64 cycles)
+{
+    UINT32 head;
+    SchedTraceRecord *rec;
+
+    if (!g_running) {
+        return;
+    }
+    head = g_head;
+    // 满了就丢弃新记录，保证读取方看到的是连续的一段
+    if (head - __atomic_load_n(&g_tail, __ATOMIC_ACQUIRE) >= SCHED_TRACE_RECORDS) {
+        g_dropped++;
+        return;
+    }
+
+    rec = &g_ring[head & SCHED_TRACE_MASK];
+    rec->cycles = cycles;
+    rec->fromId = (UINT16)from->taskID;
+    rec->toId = (UINT16)to->taskID;
+    rec->reason = ReasonFromStatus(from->taskStatus);
+    rec->fromPrio = (UINT8)from->priority;
+    rec->toPrio = (UINT8)to->priority;
+    rec->reserved = 0;
+    // 记录内容先于 head 可见
+    __atomic_store_n(&g_head, head + 1, __ATOMIC_RELEASE);
+}
+
+/* ================= 消费者 ================= */
+
+UINT32 SchedTraceRead(SchedTraceRecord *out, UINT32 max)
+{
+    UINT32 tail = g_tail;
+    UINT32 head = __atomic_load_n(&g_head, __ATOMIC_ACQUIRE);
+    UINT32 count = head - tail;
+
+    if (count > max) {
+        count = max;
+    }
+    for (UINT32 i = 0; i < count; i++) {
+        out[i] = g_ring[(tail + i) & SCHED_TRACE_MASK];
+    }
+    // 拷贝完成后才释放槽位
+    __atomic_store_n(&g_tail, tail + count, __ATOMIC_RELEASE);
+    return count;
+}
+
+VOID SchedTraceStart(VOID)
+{
+    g_running = TRUE;
+}
+
+VOID SchedTraceStop(VOID)
+{
+    g_running = FALSE;
+}
+
+VOID SchedTraceReset(VOID)
+{
+    __atomic_store_n(&g_tail, g_head, __ATOMIC_RELEASE);
+    g_dropped = 0;
+}
+
+VOID SchedTraceStatsGet(SchedTraceStats *stats)
+{
+    UINT32 head = g_head;
+
+    stats->recorded = head;
+    stats->dropped = g_dropped;
+    stats->pending = head - g_tail;
+    stats->running = g_running;
+}
+
+/* ================= 转储 ================= */
+
+/**
+ * @brief 遍历当前存在的任务，回调输出任务表 (ID / 优先级 / 名字)
+ */
+static UINT32 ForEachTask(VOID (*emit)(const SchedTraceTaskEntry *entry, VOID *arg), VOID *arg)
+{
+    TSK_INFO_S info;
+    SchedTraceTaskEntry entry;
+    UINT32 count = 0;
+
+    for (UINT32 id = 0; id <= LOSCFG_BASE_CORE_TSK_LIMIT; id++) {
+        if (LOS_TaskInfoGet(id, &info) != LOS_OK) {
+            continue;
+        }
+        memset(&entry, 0, sizeof(entry));
+        entry.taskId = id;
+        entry.priority = info.usTaskPrio;
+        (void)strncpy(entry.name, info.acName, SCHED_TRACE_NAME_LEN - 1);
+        if (emit != NULL) {
+            emit(&entry, arg);
+        }
+        count++;
+    }
+    return count;
+}
+
+static VOID EmitTaskToFile(const SchedTraceTaskEntry *entry, VOID *arg)
+{
+    (void)fwrite(entry, sizeof(*entry), 1, (FILE *)arg);
+}
+
+static VOID EmitTaskToUart(const SchedTraceTaskEntry *entry, VOID *arg)
+{
+    (void)arg;
+    printf("#ST T %u %u %s\n", entry->taskId, entry->priority, entry->name);
+}
+
+UINT32 SchedTraceDumpFile(const CHAR *path)
+{
+    SchedTraceFileHeader hdr = { 0 };
+    UINT32 n;
+    FILE *fp;
+
+    if (path == NULL) {
+        path = SCHED_TRACE_DEFAULT_FILE;
+    }
+    fp = fopen(path, "wb");
+    if (fp == NULL) {
+        printf("[schedtrace] cannot open %s\n", path);
+        return LOS_NOK;
+    }
+
+    // 先占位写头，记录数与任务数写完后回填
+    hdr.magic = SCHED_TRACE_MAGIC;
+    hdr.version = SCHED_TRACE_VERSION;
+    hdr.recordSize = sizeof(SchedTraceRecord);
+    hdr.clockHz = OS_SYS_CLOCK;
+    hdr.dropped = g_dropped;
+    (void)fwrite(&hdr, sizeof(hdr), 1, fp);
+    hdr.taskCount = ForEachTask(EmitTaskToFile, fp);
+
+    while ((n = SchedTraceRead(g_chunk, SCHED_TRACE_DUMP_CHUNK)) > 0) {
+        (void)fwrite(g_chunk, sizeof(SchedTraceRecord), n, fp);
+        hdr.recordCount += n;
+    }
+
+    (void)fseek(fp, 0, SEEK_SET);
+    (void)fwrite(&hdr, sizeof(hdr), 1, fp);
+    fclose(fp);
+    printf("[schedtrace] %u records (%u dropped) -> %s\n", hdr.recordCount, hdr.dropped, path);
+    return LOS_OK;
+}
+
+VOID SchedTraceDumpUart(VOID)
+{
+    UINT32 n;
+    UINT32 total = 0;
+
+    printf("#ST BEGIN %u %u %u\n", SCHED_TRACE_VERSION, (UINT32)OS_SYS_CLOCK, g_dropped);
+    (void)ForEachTask(EmitTaskToUart, NULL);
+    while ((n = SchedTraceRead(g_chunk, SCHED_TRACE_DUMP_CHUNK)) > 0) {
+        for (UINT32 i = 0; i < n; i++) {
+            const SchedTraceRecord *r = &g_chunk[i];
+            printf("#ST R %llu %u %u %u %u %u\n", r->cycles, r->fromId, r->toId,
+                   r->reason, r->fromPrio, r->toPrio);
+        }
+        total += n;
+    }
+    printf("#ST END %u\n", total);
+}
+
+/* ================= shell 命令 ================= */
+
+static UINT32 SchedTraceCmd(UINT32 argc, const CHAR **argv)
+{
+    SchedTraceStats stats;
+
+    if (argc < 1) {
+        printf("usage: schedtrace start|stop|reset|stat|dump [uart|file [path]]\n");
+        return LOS_NOK;
+    }
+    if (strcmp(argv[0], "start") == 0) {
+        SchedTraceStart();
+    } else if (strcmp(argv[0], "stop") == 0) {
+        SchedTraceStop();
+    } else if (strcmp(argv[0], "reset") == 0) {
+        SchedTraceReset();
+    } else if (strcmp(argv[0], "stat") == 0) {
+        SchedTraceStatsGet(&stats);
+        printf("running %u, recorded %u, pending %u, dropped %u, capacity %u\n",
+               stats.running, stats.recorded, stats.pending, stats.dropped, SCHED_TRACE_RECORDS);
+    } else if (strcmp(argv[0], "dump") == 0) {
+        if (argc >= 2 && strcmp(argv[1], "file") == 0) {
+            return SchedTraceDumpFile(argc >= 3 ? argv[2] : NULL);
+        }
+        SchedTraceDumpUart();
+    } else {
+        printf("unknown subcommand: %s\n", argv[0]);
+        return LOS_NOK;
+    }
+    return LOS_OK;
+}
+
+UINT32 SchedTraceInit(VOID)
+{
+    UINT32 ret;
+
+    if (g_inited) {
+        return LOS_OK;
+    }
+    ret = SchedHookAdd(SchedTraceOnSwitch);
+    if (ret != LOS_OK) {
+        printf("[schedtrace] hook register failed\n");
+        return ret;
+    }
+    (void)osCmdReg(CMD_TYPE_EX, "schedtrace", XARGS, (CmdCallBackFunc)SchedTraceCmd);
+    g_inited = TRUE;
+    return LOS_OK;
+}
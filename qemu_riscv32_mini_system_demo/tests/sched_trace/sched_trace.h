@@ -0,0 +1,103 @@
+#ifndef APP_SCHED_TRACE_H
+#define APP_SCHED_TRACE_H
+
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 环形缓冲区记录数，必须为 2 的幂；每条 16 字节
+#ifndef SCHED_TRACE_RECORDS
+#define SCHED_TRACE_RECORDS      1024
+#endif
+
+#define SCHED_TRACE_MAGIC        0x43525453  /* "STRC" */
+#define SCHED_TRACE_VERSION      1
+#define SCHED_TRACE_NAME_LEN     16
+#define SCHED_TRACE_DEFAULT_FILE "/data/sched_trace.bin"
+
+// 被换出任务离开 CPU 的原因，由换出时的任务状态推断
+typedef enum {
+    SCHED_REASON_PREEMPT = 0,   // 仍处于就绪态：被抢占或主动 Yield
+    SCHED_REASON_DELAY,         // LOS_TaskDelay
+    SCHED_REASON_PEND,          // 等待信号量 / 队列 / 事件 / 互斥锁
+    SCHED_REASON_SUSPEND,
+    SCHED_REASON_EXIT,
+    SCHED_REASON_OTHER,
+} SchedTraceReason;
+
+typedef struct {
+    UINT64 cycles;              // 切换时刻，LOS_SysCycleGet
+    UINT16 fromId;
+    UINT16 toId;
+    UINT8 reason;               // SchedTraceReason
+    UINT8 fromPrio;
+    UINT8 toPrio;
+    UINT8 reserved;
+} SchedTraceRecord;
+
+/*
+ * /data 转储文件格式 (小端)：
+ *   SchedTraceFileHeader
+ *   SchedTraceTaskEntry x taskCount
+ *   SchedTraceRecord    x recordCount
+ */
+typedef struct {
+    UINT32 magic;
+    UINT16 version;
+    UINT16 recordSize;
+    UINT32 clockHz;
+    UINT32 recordCount;
+    UINT32 dropped;
+    UINT32 taskCount;
+} SchedTraceFileHeader;
+
+typedef struct {
+    UINT32 taskId;
+    UINT32 priority;
+    CHAR name[SCHED_TRACE_NAME_LEN];
+} SchedTraceTaskEntry;
+
+typedef struct {
+    UINT32 recorded;            // 已写入的记录总数
+    UINT32 dropped;             // 缓冲区满时丢弃的记录数
+    UINT32 pending;             // 尚未读出的记录数
+    BOOL running;
+} SchedTraceStats;
+
+/**
+ * @brief 挂接切换钩子并注册 shell 命令 schedtrace，重复调用无副作用
+ */
+UINT32 SchedTraceInit(VOID);
+
+VOID SchedTraceStart(VOID);
+VOID SchedTraceStop(VOID);
+
+/**
+ * @brief 丢弃未读记录并清零统计，需在停止状态下调用
+ */
+VOID SchedTraceReset(VOID);
+
+VOID SchedTraceStatsGet(SchedTraceStats *stats);
+
+/**
+ * @brief 读出最多 max 条记录 (消费者)，返回实际条数
+ * 单生产者 (切换钩子) / 单消费者，无锁；缓冲区满时生产者丢弃新记录而不覆盖
+ */
+UINT32 SchedTraceRead(SchedTraceRecord *out, UINT32 max);
+
+/**
+ * @brief 读空缓冲区并写入二进制文件，path 为 NULL 时使用默认路径
+ */
+UINT32 SchedTraceDumpFile(const CHAR *path);
+
+/**
+ * @brief 读空缓冲区并以 "#ST " 前缀的文本行输出到串口，供主机端从日志中提取
+ */
+VOID SchedTraceDumpUart(VOID);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
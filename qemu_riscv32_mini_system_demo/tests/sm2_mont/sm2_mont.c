@@ -0,0 +1,386 @@
+/*
+ * SM2 素数域 Montgomery 运算：C 参考内核 + 域 / 点运算
+ * 域 / 点运算通过 Sm2MontKernels 调用底层内核，便于在同一套上层代码上对比 C 与汇编
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "sm2_mont.h"
+
+#define W SM2_MONT_WORDS
+
+typedef struct {
+    uint32_t x[W];
+    uint32_t y[W];
+    uint32_t z[W];
+} JacPoint;
+
+// p = 2^256 - 2^224 - 2^96 + 2^64 - 1
+static const uint32_t g_p[W] = {
+    0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE,
+};
+// R^2 mod p，用于转入 Montgomery 域
+static const uint32_t g_rr[W] = {
+    0x00000003, 0x00000002, 0xFFFFFFFF, 0x00000002, 0x00000001, 0x00000001, 0x00000002, 0x00000004,
+};
+// R mod p，即 Montgomery 域中的 1
+static const uint32_t g_one[W] = {
+    0x00000001, 0x00000000, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000001,
+};
+
+/* ================= C 参考内核 ================= */
+
+static void RefMul256(uint32_t t[W * 2], const uint32_t a[W], const uint32_t b[W])
+{
+    memset(t, 0, sizeof(uint32_t) * W * 2);
+    for (int i = 0; i < W; i++) {
+        uint64_t c = 0;
+        for (int j = 0; j < W; j++) {
+            c += (uint64_t)a[j] * b[i] + t[i + j];
+            t[i + j] = (uint32_t)c;
+            c >>= 32;
+        }
+        t[i + W] = (uint32_t)c;
+    }
+}
+
+static void RefSqr256(uint32_t t[W * 2], const uint32_t a[W])
+{
+    RefMul256(t, a, a);
+}
+
+/**
+ * @brief 常数时间条件减：hi:s >= p 时 r = hi:s - p，否则 r = s
+ * 调用方保证 hi:s < 2p
+ */
+static void CondSubP(uint32_t r[W], const uint32_t s[W], uint32_t hi)
+{
+    uint32_t d[W];
+    uint32_t borrow = 0;
+
+    for (int i = 0; i < W; i++) {
+        uint64_t diff = (uint64_t)s[i] - g_p[i] - borrow;
+        d[i] = (uint32_t)diff;
+        borrow = (uint32_t)(diff >> 32) & 1;
+    }
+    // 溢出位与借位相等说明 hi:s >= p
+    uint32_t mask = (hi ^ borrow) - 1;
+    for (int i = 0; i < W; i++) {
+        r[i] = s[i] ^ ((s[i] ^ d[i]) & mask);
+    }
+}
+
+static void RefMontRed(uint32_t r[W], const uint32_t t[W * 2])
+{
+    uint32_t w[W * 2 + 1];
+
+    memcpy(w, t, sizeof(uint32_t) * W * 2);
+    w[W * 2] = 0;
+    for (int i = 0; i < W; i++) {
+        // -p^-1 mod 2^32 = 1，m 即当前最低字
+        uint32_t m = w[i];
+        uint64_t c = 0;
+        for (int j = 0; j < W; j++) {
+            c += (uint64_t)m * g_p[j] + w[i + j];
+            w[i + j] = (uint32_t)c;
+            c >>= 32;
+        }
+        for (int j = i + W; j <= W * 2; j++) {
+            c += w[j];
+            w[j] = (uint32_t)c;
+            c >>= 32;
+        }
+    }
+    CondSubP(r, &w[W], w[W * 2]);
+}
+
+const Sm2MontKernels g_sm2MontRef = {
+    .name = "c-ref",
+    .mul  = RefMul256,
+    .sqr  = RefSqr256,
+    .red  = RefMontRed,
+};
+
+#if defined(SM2_MONT_ASM)
+extern void Sm2Mul256Asm(uint32_t t[W * 2], const uint32_t a[W], const uint32_t b[W]);
+extern void Sm2Sqr256Asm(uint32_t t[W * 2], const uint32_t a[W]);
+extern void Sm2MontRedAsm(uint32_t r[W], const uint32_t t[W * 2]);
+
+const Sm2MontKernels g_sm2MontAsm = {
+    .name = "rv32-asm",
+    .mul  = Sm2Mul256Asm,
+    .sqr  = Sm2Sqr256Asm,
+    .red  = Sm2MontRedAsm,
+};
+#endif
+
+const Sm2MontKernels *Sm2MontDefault(void)
+{
+#if defined(SM2_MONT_ASM)
+    return &g_sm2MontAsm;
+#else
+    return &g_sm2MontRef;
+#endif
+}
+
+void Sm2MontMul(const Sm2MontKernels *k, uint32_t r[W], const uint32_t a[W], const uint32_t b[W])
+{
+    uint32_t t[W * 2];
+
+    k->mul(t, a, b);
+    k->red(r, t);
+}
+
+void Sm2MontSqr(const Sm2MontKernels *k, uint32_t r[W], const uint32_t a[W])
+{
+    uint32_t t[W * 2];
+
+    k->sqr(t, a);
+    k->red(r, t);
+}
+
+/* ================= 域运算 ================= */
+
+static void FpAdd(uint32_t r[W], const uint32_t a[W], const uint32_t b[W])
+{
+    uint32_t s[W];
+    uint64_t c = 0;
+
+    for (int i = 0; i < W; i++) {
+        c += (uint64_t)a[i] + b[i];
+        s[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    CondSubP(r, s, (uint32_t)c);
+}
+
+static void FpSub(uint32_t r[W], const uint32_t a[W], const uint32_t b[W])
+{
+    uint32_t borrow = 0;
+    uint64_t c = 0;
+
+    for (int i = 0; i < W; i++) {
+        uint64_t diff = (uint64_t)a[i] - b[i] - borrow;
+        r[i] = (uint32_t)diff;
+        borrow = (uint32_t)(diff >> 32) & 1;
+    }
+    // 有借位时加回 p
+    uint32_t mask = 0U - borrow;
+    for (int i = 0; i < W; i++) {
+        c += (uint64_t)r[i] + (g_p[i] & mask);
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+}
+
+static int FpIsZero(const uint32_t a[W])
+{
+    uint32_t acc = 0;
+
+    for (int i = 0; i < W; i++) {
+        acc |= a[i];
+    }
+    return acc == 0;
+}
+
+static void FpFromMont(const Sm2MontKernels *k, uint32_t r[W], const uint32_t a[W])
+{
+    uint32_t t[W * 2] = { 0 };
+
+    memcpy(t, a, sizeof(uint32_t) * W);
+    k->red(r, t);
+}
+
+/**
+ * @brief r = a^(p-2)，费马小定理求逆
+ */
+static void FpInv(const Sm2MontKernels *k, uint32_t r[W], const uint32_t a[W])
+{
+    uint32_t e[W];
+    uint32_t acc[W];
+
+    memcpy(e, g_p, sizeof(e));
+    e[0] -= 2;
+    memcpy(acc, g_one, sizeof(acc));
+    for (int i = W * 32 - 1; i >= 0; i--) {
+        Sm2MontSqr(k, acc, acc);
+        if ((e[i / 32] >> (i % 32)) & 1) {
+            Sm2MontMul(k, acc, acc, a);
+        }
+    }
+    memcpy(r, acc, sizeof(acc));
+}
+
+static void BytesToWords(uint32_t w[W], const uint8_t b[SM2_MONT_BYTES])
+{
+    for (int i = 0; i < W; i++) {
+        const uint8_t *p = b + SM2_MONT_BYTES - 4 * (i + 1);
+        w[i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    }
+}
+
+static void WordsToBytes(uint8_t b[SM2_MONT_BYTES], const uint32_t w[W])
+{
+    for (int i = 0; i < W; i++) {
+        uint8_t *p = b + SM2_MONT_BYTES - 4 * (i + 1);
+        p[0] = (uint8_t)(w[i] >> 24);
+        p[1] = (uint8_t)(w[i] >> 16);
+        p[2] = (uint8_t)(w[i] >> 8);
+        p[3] = (uint8_t)w[i];
+    }
+}
+
+int Sm2ModMul(const Sm2MontKernels *k, uint8_t r[SM2_MONT_BYTES],
+              const uint8_t a[SM2_MONT_BYTES], const uint8_t b[SM2_MONT_BYTES])
+{
+    uint32_t wa[W];
+    uint32_t wb[W];
+    uint32_t wr[W];
+
+    BytesToWords(wa, a);
+    BytesToWords(wb, b);
+    // MontMul(a, b) = a*b*R^-1，再乘 R^2 抵消
+    Sm2MontMul(k, wr, wa, wb);
+    Sm2MontMul(k, wr, wr, g_rr);
+    WordsToBytes(r, wr);
+    return 0;
+}
+
+/* ================= 点运算 (a = -3) ================= */
+
+/**
+ * @brief 雅可比坐标倍点，dbl-2001-b
+ */
+static void PointDbl(const Sm2MontKernels *k, JacPoint *r)
+{
+    uint32_t delta[W], gamma[W], beta[W], alpha[W], t1[W], t2[W];
+
+    Sm2MontSqr(k, delta, r->z);
+    Sm2MontSqr(k, gamma, r->y);
+    Sm2MontMul(k, beta, r->x, gamma);
+
+    // alpha = 3 * (X - delta) * (X + delta)
+    FpSub(t1, r->x, delta);
+    FpAdd(t2, r->x, delta);
+    Sm2MontMul(k, alpha, t1, t2);
+    FpAdd(t1, alpha, alpha);
+    FpAdd(alpha, t1, alpha);
+
+    // Z3 = (Y + Z)^2 - gamma - delta
+    FpAdd(t1, r->y, r->z);
+    Sm2MontSqr(k, t1, t1);
+    FpSub(t1, t1, gamma);
+    FpSub(r->z, t1, delta);
+
+    // X3 = alpha^2 - 8 * beta
+    FpAdd(beta, beta, beta);
+    FpAdd(beta, beta, beta);
+    FpAdd(t2, beta, beta);
+    Sm2MontSqr(k, t1, alpha);
+    FpSub(r->x, t1, t2);
+
+    // Y3 = alpha * (4 * beta - X3) - 8 * gamma^2
+    FpSub(t1, beta, r->x);
+    Sm2MontMul(k, t1, alpha, t1);
+    Sm2MontSqr(k, t2, gamma);
+    FpAdd(t2, t2, t2);
+    FpAdd(t2, t2, t2);
+    FpAdd(t2, t2, t2);
+    FpSub(r->y, t1, t2);
+}
+
+/**
+ * @brief 混合加 r = r + (px, py)，仿射点 Z = 1
+ */
+static void PointAddAffine(const Sm2MontKernels *k, JacPoint *r, const uint32_t px[W], const uint32_t py[W])
+{
+    uint32_t z1z1[W], u2[W], s2[W], h[W], rr[W], hh[W], hhh[W], v[W], t[W];
+
+    if (FpIsZero(r->z)) {
+        memcpy(r->x, px, sizeof(r->x));
+        memcpy(r->y, py, sizeof(r->y));
+        memcpy(r->z, g_one, sizeof(r->z));
+        return;
+    }
+
+    Sm2MontSqr(k, z1z1, r->z);
+    Sm2MontMul(k, u2, px, z1z1);
+    Sm2MontMul(k, s2, r->z, z1z1);
+    Sm2MontMul(k, s2, py, s2);
+    FpSub(h, u2, r->x);
+    FpSub(rr, s2, r->y);
+
+    if (FpIsZero(h)) {
+        if (FpIsZero(rr)) {
+            // 两点相同，退化为倍点
+            memcpy(r->x, px, sizeof(r->x));
+            memcpy(r->y, py, sizeof(r->y));
+            memcpy(r->z, g_one, sizeof(r->z));
+            PointDbl(k, r);
+        } else {
+            memset(r->z, 0, sizeof(r->z));
+        }
+        return;
+    }
+
+    Sm2MontMul(k, r->z, r->z, h);
+    Sm2MontSqr(k, hh, h);
+    Sm2MontMul(k, hhh, hh, h);
+    Sm2MontMul(k, v, r->x, hh);
+
+    // X3 = rr^2 - hhh - 2v
+    Sm2MontSqr(k, t, rr);
+    FpSub(t, t, hhh);
+    FpSub(t, t, v);
+    FpSub(t, t, v);
+
+    // Y3 = rr * (v - X3) - Y1 * hhh
+    FpSub(v, v, t);
+    Sm2MontMul(k, v, rr, v);
+    Sm2MontMul(k, hhh, r->y, hhh);
+    FpSub(r->y, v, hhh);
+    memcpy(r->x, t, sizeof(t));
+}
+
+int Sm2PointMul(const Sm2MontKernels *k, uint8_t r[SM2_MONT_POINT_BYTES],
+                const uint8_t scalar[SM2_MONT_BYTES], const uint8_t p[SM2_MONT_POINT_BYTES])
+{
+    uint32_t px[W], py[W], e[W], zinv[W], t[W];
+    JacPoint acc;
+    int top;
+
+    BytesToWords(e, scalar);
+    BytesToWords(px, p);
+    BytesToWords(py, p + SM2_MONT_BYTES);
+    Sm2MontMul(k, px, px, g_rr);
+    Sm2MontMul(k, py, py, g_rr);
+
+    memset(&acc, 0, sizeof(acc));
+    for (top = W * 32 - 1; top >= 0; top--) {
+        if ((e[top / 32] >> (top % 32)) & 1) {
+            break;
+        }
+    }
+    for (int i = top; i >= 0; i--) {
+        PointDbl(k, &acc);
+        if ((e[i / 32] >> (i % 32)) & 1) {
+            PointAddAffine(k, &acc, px, py);
+        }
+    }
+    if (FpIsZero(acc.z)) {
+        return -1;
+    }
+
+    // 转回仿射坐标 x = X / Z^2, y = Y / Z^3
+    FpInv(k, zinv, acc.z);
+    Sm2MontSqr(k, t, zinv);
+    Sm2MontMul(k, acc.x, acc.x, t);
+    Sm2MontMul(k, t, t, zinv);
+    Sm2MontMul(k, acc.y, acc.y, t);
+    FpFromMont(k, acc.x, acc.x);
+    FpFromMont(k, acc.y, acc.y);
+    WordsToBytes(r, acc.x);
+    WordsToBytes(r + SM2_MONT_BYTES, acc.y);
+    return 0;
+}
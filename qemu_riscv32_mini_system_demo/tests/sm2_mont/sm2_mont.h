@@ -0,0 +1,63 @@
+#ifndef APP_SM2_MONT_H
+#define APP_SM2_MONT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SM2_MONT_WORDS           8
+#define SM2_MONT_BYTES           32
+#define SM2_MONT_POINT_BYTES     64
+
+/*
+ * SM2 素数域 Montgomery 内核
+ * 数据为 8 x 32 位小端字，输入须小于 p；R = 2^256
+ * mul / sqr 输出 512 位乘积，red 把 t < p * R 约减为 t * R^-1 mod p
+ */
+typedef struct {
+    const char *name;
+    void (*mul)(uint32_t t[SM2_MONT_WORDS * 2], const uint32_t a[SM2_MONT_WORDS],
+                const uint32_t b[SM2_MONT_WORDS]);
+    void (*sqr)(uint32_t t[SM2_MONT_WORDS * 2], const uint32_t a[SM2_MONT_WORDS]);
+    void (*red)(uint32_t r[SM2_MONT_WORDS], const uint32_t t[SM2_MONT_WORDS * 2]);
+} Sm2MontKernels;
+
+// 通用 C 字循环实现，作为差分测试的参考
+extern const Sm2MontKernels g_sm2MontRef;
+
+#if defined(SM2_MONT_ASM)
+// rv32 汇编实现 (sm2_mont_rv32.S)
+extern const Sm2MontKernels g_sm2MontAsm;
+#endif
+
+/**
+ * @brief 编译开关 SM2_MONT_ASM 打开时返回汇编内核，否则返回 C 参考实现
+ */
+const Sm2MontKernels *Sm2MontDefault(void);
+
+void Sm2MontMul(const Sm2MontKernels *k, uint32_t r[SM2_MONT_WORDS],
+                const uint32_t a[SM2_MONT_WORDS], const uint32_t b[SM2_MONT_WORDS]);
+void Sm2MontSqr(const Sm2MontKernels *k, uint32_t r[SM2_MONT_WORDS], const uint32_t a[SM2_MONT_WORDS]);
+
+/**
+ * @brief r = a * b mod p，32 字节大端，a / b 须小于 p
+ */
+int Sm2ModMul(const Sm2MontKernels *k, uint8_t r[SM2_MONT_BYTES],
+              const uint8_t a[SM2_MONT_BYTES], const uint8_t b[SM2_MONT_BYTES]);
+
+/**
+ * @brief SM2 标量乘 R = scalar * P，点为 x || y 各 32 字节大端
+ * @return 0 成功；-1 结果为无穷远点
+ *
+ * 雅可比坐标 + 混合加，逐位 double-and-add，按标量位分支，仅用于性能评估，
+ * 不应直接用于处理私钥。
+ */
+int Sm2PointMul(const Sm2MontKernels *k, uint8_t r[SM2_MONT_POINT_BYTES],
+                const uint8_t scalar[SM2_MONT_BYTES], const uint8_t p[SM2_MONT_POINT_BYTES]);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
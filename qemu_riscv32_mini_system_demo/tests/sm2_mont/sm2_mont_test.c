@@ -0,0 +1,277 @@
+/*
+ * SM2 Montgomery 内核测试
+ * 1. 差分测试：汇编内核与 C 参考逐字比对 (随机 + 边界操作数)
+ * 2. 已知答案：2G / kG 与离线计算结果比对
+ * 3. 性能：模乘 / 模平方 / 点乘在两套内核上的周期数
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+
+#include "sm2_mont.h"
+#include "sm2_mont_test.h"
+#include "test_assert.h"
+
+#define TASK_STACK_SIZE          0x3000
+#define TASK_PRI                 25
+
+#define DIFF_RANDOM_CASES        2000
+#define BENCH_FIELD_ITERS        1000
+#define BENCH_POINT_ITERS        3
+
+static TestStats g_stats = { 0 };
+
+static const uint32_t g_pWords[SM2_MONT_WORDS] = {
+    0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE,
+};
+
+static const uint8_t g_sm2G[SM2_MONT_POINT_BYTES] = {
+    0x32, 0xC4, 0xAE, 0x2C, 0x1F, 0x19, 0x81, 0x19, 0x5F, 0x99, 0x04, 0x46, 0x6A, 0x39, 0xC9, 0x94,
+    0x8F, 0xE3, 0x0B, 0xBF, 0xF2, 0x66, 0x0B, 0xE1, 0x71, 0x5A, 0x45, 0x89, 0x33, 0x4C, 0x74, 0xC7,
+    0xBC, 0x37, 0x36, 0xA2, 0xF4, 0xF6, 0x77, 0x9C, 0x59, 0xBD, 0xCE, 0xE3, 0x6B, 0x69, 0x21, 0x53,
+    0xD0, 0xA9, 0x87, 0x7C, 0xC6, 0x2A, 0x47, 0x40, 0x02, 0xDF, 0x32, 0xE5, 0x21, 0x39, 0xF0, 0xA0,
+};
+static const uint8_t g_sm2G2[SM2_MONT_POINT_BYTES] = {
+    0x56, 0xCE, 0xFD, 0x60, 0xD7, 0xC8, 0x7C, 0x00, 0x0D, 0x58, 0xEF, 0x57, 0xFA, 0x73, 0xBA, 0x4D,
+    0x9C, 0x0D, 0xFA, 0x08, 0xC0, 0x8A, 0x73, 0x31, 0x49, 0x5C, 0x2E, 0x1D, 0xA3, 0xF2, 0xBD, 0x52,
+    0x31, 0xB7, 0xE7, 0xE6, 0xCC, 0x81, 0x89, 0xF6, 0x68, 0x53, 0x5C, 0xE0, 0xF8, 0xEA, 0xF1, 0xBD,
+    0x6D, 0xE8, 0x4C, 0x18, 0x2F, 0x6C, 0x8E, 0x71, 0x6F, 0x78, 0x0D, 0x3A, 0x97, 0x0A, 0x23, 0xC3,
+};
+static const uint8_t g_kScalar[SM2_MONT_BYTES] = {
+    0x39, 0x45, 0x20, 0x8F, 0x7B, 0x21, 0x44, 0xB1, 0x3F, 0x36, 0xE3, 0x8A, 0xC6, 0xD3, 0x9F, 0x95,
+    0x88, 0x93, 0x93, 0x69, 0x28, 0x60, 0xB5, 0x1A, 0x42, 0xFB, 0x81, 0xEF, 0x4D, 0xF7, 0xC5, 0xB8,
+};
+static const uint8_t g_kG[SM2_MONT_POINT_BYTES] = {
+    0x09, 0xF9, 0xDF, 0x31, 0x1E, 0x54, 0x21, 0xA1, 0x50, 0xDD, 0x7D, 0x16, 0x1E, 0x4B, 0xC5, 0xC6,
+    0x72, 0x17, 0x9F, 0xAD, 0x18, 0x33, 0xFC, 0x07, 0x6B, 0xB0, 0x8F, 0xF3, 0x56, 0xF3, 0x50, 0x20,
+    0xCC, 0xEA, 0x49, 0x0C, 0xE2, 0x67, 0x75, 0xA5, 0x2D, 0xC6, 0xEA, 0x71, 0x8C, 0xC1, 0xAA, 0x60,
+    0x0A, 0xED, 0x05, 0xFB, 0xF3, 0x5E, 0x08, 0x4A, 0x66, 0x32, 0xF6, 0x07, 0x2D, 0xA9, 0xAD, 0x13,
+};
+
+static uint32_t g_rngState = 0x2545F491;
+
+static uint32_t XorShift32(void)
+{
+    g_rngState ^= g_rngState << 13;
+    g_rngState ^= g_rngState >> 17;
+    g_rngState ^= g_rngState << 5;
+    return g_rngState;
+}
+
+/**
+ * @brief 生成小于 p 的随机操作数，最高字限制在 p7 以下
+ */
+static void RandomFieldElem(uint32_t a[SM2_MONT_WORDS])
+{
+    for (int i = 0; i < SM2_MONT_WORDS; i++) {
+        a[i] = XorShift32();
+    }
+    a[SM2_MONT_WORDS - 1] %= g_pWords[SM2_MONT_WORDS - 1];
+}
+
+/**
+ * @brief 第 idx 个边界操作数：0、1、p-1、p-2、高位全 1 等
+ */
+static void EdgeFieldElem(int idx, uint32_t a[SM2_MONT_WORDS])
+{
+    memset(a, 0, sizeof(uint32_t) * SM2_MONT_WORDS);
+    switch (idx) {
+        case 0:
+            break;
+        case 1:
+            a[0] = 1;
+            break;
+        case 2:
+            memcpy(a, g_pWords, sizeof(g_pWords));
+            a[0] -= 1;
+            break;
+        case 3:
+            memcpy(a, g_pWords, sizeof(g_pWords));
+            a[0] -= 2;
+            break;
+        case 4:
+            memset(a, 0xFF, sizeof(uint32_t) * (SM2_MONT_WORDS - 1));
+            a[SM2_MONT_WORDS - 1] = 0x7FFFFFFF;
+            break;
+        default:
+            a[SM2_MONT_WORDS - 1] = 0x80000000;
+            break;
+    }
+}
+
+#define EDGE_COUNT 6
+
+#if defined(SM2_MONT_ASM)
+/**
+ * @brief 对一组操作数比对乘法 / 平方 / 约减三个内核，返回不一致的个数
+ */
+static int DiffOne(const uint32_t a[SM2_MONT_WORDS], const uint32_t b[SM2_MONT_WORDS])
+{
+    uint32_t tRef[SM2_MONT_WORDS * 2];
+    uint32_t tAsm[SM2_MONT_WORDS * 2];
+    uint32_t rRef[SM2_MONT_WORDS];
+    uint32_t rAsm[SM2_MONT_WORDS];
+    int bad = 0;
+
+    g_sm2MontRef.mul(tRef, a, b);
+    g_sm2MontAsm.mul(tAsm, a, b);
+    bad += memcmp(tRef, tAsm, sizeof(tRef)) != 0;
+
+    g_sm2MontRef.red(rRef, tRef);
+    g_sm2MontAsm.red(rAsm, tRef);
+    bad += memcmp(rRef, rAsm, sizeof(rRef)) != 0;
+
+    g_sm2MontRef.sqr(tRef, a);
+    g_sm2MontAsm.sqr(tAsm, a);
+    bad += memcmp(tRef, tAsm, sizeof(tRef)) != 0;
+
+    g_sm2MontRef.red(rRef, tRef);
+    g_sm2MontAsm.red(rAsm, tRef);
+    bad += memcmp(rRef, rAsm, sizeof(rRef)) != 0;
+    return bad;
+}
+
+static void TestDifferential(void)
+{
+    uint32_t a[SM2_MONT_WORDS];
+    uint32_t b[SM2_MONT_WORDS];
+    int edgeBad = 0;
+    int randBad = 0;
+
+    printf("\n=== 测试1: 汇编 / C 参考差分 ===\n");
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        for (int j = 0; j < EDGE_COUNT; j++) {
+            EdgeFieldElem(i, a);
+            EdgeFieldElem(j, b);
+            edgeBad += DiffOne(a, b);
+        }
+    }
+    TEST_ASSERT(edgeBad == 0, "边界操作数 mul/sqr/red 一致");
+
+    for (int i = 0; i < DIFF_RANDOM_CASES; i++) {
+        RandomFieldElem(a);
+        RandomFieldElem(b);
+        randBad += DiffOne(a, b);
+    }
+    printf("random cases: %d, mismatches: %d\n", DIFF_RANDOM_CASES, randBad);
+    TEST_ASSERT(randBad == 0, "随机操作数 mul/sqr/red 一致");
+}
+#endif
+
+static void TestKnownAnswer(const Sm2MontKernels *k)
+{
+    uint8_t two[SM2_MONT_BYTES] = { 0 };
+    uint8_t out[SM2_MONT_POINT_BYTES];
+    char msg[64];
+
+    two[SM2_MONT_BYTES - 1] = 2;
+    (void)snprintf(msg, sizeof(msg), "[%s] 2G 已知答案", k->name);
+    TEST_ASSERT(Sm2PointMul(k, out, two, g_sm2G) == 0 && memcmp(out, g_sm2G2, sizeof(out)) == 0, msg);
+
+    (void)snprintf(msg, sizeof(msg), "[%s] kG 已知答案", k->name);
+    TEST_ASSERT(Sm2PointMul(k, out, g_kScalar, g_sm2G) == 0 && memcmp(out, g_kG, sizeof(out)) == 0, msg);
+}
+
+/* ================= 性能 ================= */
+
+typedef struct {
+    uint64_t mulCycles;
+    uint64_t sqrCycles;
+    uint64_t pointCycles;
+} KernelCost;
+
+static void BenchKernels(const Sm2MontKernels *k, KernelCost *cost)
+{
+    uint32_t a[SM2_MONT_WORDS];
+    uint32_t b[SM2_MONT_WORDS];
+    uint8_t out[SM2_MONT_POINT_BYTES];
+    uint64_t t0;
+
+    RandomFieldElem(a);
+    RandomFieldElem(b);
+
+    t0 = LOS_SysCycleGet();
+    for (int i = 0; i < BENCH_FIELD_ITERS; i++) {
+        Sm2MontMul(k, a, a, b);
+    }
+    cost->mulCycles = (LOS_SysCycleGet() - t0) / BENCH_FIELD_ITERS;
+
+    t0 = LOS_SysCycleGet();
+    for (int i = 0; i < BENCH_FIELD_ITERS; i++) {
+        Sm2MontSqr(k, a, a);
+    }
+    cost->sqrCycles = (LOS_SysCycleGet() - t0) / BENCH_FIELD_ITERS;
+
+    t0 = LOS_SysCycleGet();
+    for (int i = 0; i < BENCH_POINT_ITERS; i++) {
+        (void)Sm2PointMul(k, out, g_kScalar, g_sm2G);
+    }
+    cost->pointCycles = (LOS_SysCycleGet() - t0) / BENCH_POINT_ITERS;
+}
+
+static void PrintCostRow(const char *name, uint64_t ref, uint64_t opt)
+{
+    // 加速比保留两位小数
+    uint64_t ratio = opt ? ref * 100 / opt : 0;
+    printf("%-14s | %12llu | %12llu | %3llu.%02llux\n", name, ref, opt, ratio / 100, ratio % 100);
+}
+
+static void Sm2MontTestTask(void)
+{
+    KernelCost ref;
+    const Sm2MontKernels *opt = Sm2MontDefault();
+
+    printf("\n=== SM2 Montgomery Kernel Test (default: %s) ===\n", opt->name);
+
+#if defined(SM2_MONT_ASM)
+    TestDifferential();
+#else
+    printf("SM2_MONT_ASM 未打开，跳过差分测试\n");
+#endif
+
+    printf("\n=== 测试2: 点乘已知答案 ===\n");
+    TestKnownAnswer(&g_sm2MontRef);
+    if (opt != &g_sm2MontRef) {
+        TestKnownAnswer(opt);
+    }
+
+    printf("\n=== 性能对比 (cycles/op) ===\n");
+    BenchKernels(&g_sm2MontRef, &ref);
+    if (opt != &g_sm2MontRef) {
+        KernelCost fast;
+        BenchKernels(opt, &fast);
+        printf("%-14s | %12s | %12s | %8s\n", "Op", "c-ref", opt->name, "Speedup");
+        printf("---------------|--------------|--------------|---------\n");
+        PrintCostRow("mont_mul", ref.mulCycles, fast.mulCycles);
+        PrintCostRow("mont_sqr", ref.sqrCycles, fast.sqrCycles);
+        PrintCostRow("sm2_point_mul", ref.pointCycles, fast.pointCycles);
+    } else {
+        printf("mont_mul %llu, mont_sqr %llu, sm2_point_mul %llu\n",
+               ref.mulCycles, ref.sqrCycles, ref.pointCycles);
+    }
+
+    TEST_SUMMARY();
+}
+
+void Sm2MontTestApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)Sm2MontTestTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "Sm2MontTestTask";
+    task.usTaskPrio   = TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("Sm2MontTestTask create failed: 0x%X\n", ret);
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef APP_SM2_MONT_TEST_H
+#define APP_SM2_MONT_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void Sm2MontTestApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,225 @@
+/*
+ * 栈水位统计与栈大小推荐
+ * 扫描在软件定时器任务中进行，记录表由定时器与 shell 共同访问，读写时锁调度；
+ * 锁调度期间只更新记录，告警在解锁后打印。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "los_task.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+#include "cmsis_os2.h"
+#include "shcmd.h"
+
+#include "stack_prof.h"
+
+// 重新着色当前任务的栈时，在当前栈指针之下保留的字节数
+#define STACK_PROF_SELF_GUARD    0x100
+
+/* ================= 全局变量 ================= */
+static StackProfRecord g_records[STACK_PROF_MAX_RECORDS];
+static UINT32 g_recordCount = 0;
+static UINT32 g_scanCount = 0;
+static osTimerId_t g_scanTimer = NULL;
+static BOOL g_inited = FALSE;
+
+/* ================= 扫描 ================= */
+
+static StackProfRecord *RecordFind(const CHAR *name)
+{
+    for (UINT32 i = 0; i < g_recordCount; i++) {
+        if (strncmp(g_records[i].name, name, STACK_PROF_NAME_LEN - 1) == 0) {
+            return &g_records[i];
+        }
+    }
+    if (g_recordCount >= STACK_PROF_MAX_RECORDS) {
+        return NULL;
+    }
+    StackProfRecord *rec = &g_records[g_recordCount++];
+    memset(rec, 0, sizeof(*rec));
+    (void)strncpy(rec->name, name, STACK_PROF_NAME_LEN - 1);
+    return rec;
+}
+
+VOID StackProfScan(VOID)
+{
+    TSK_INFO_S info;
+    // 本次扫描新产生的告警，解锁后打印
+    static StackProfRecord warn[STACK_PROF_MAX_RECORDS];
+    UINT32 warnCount = 0;
+
+    LOS_TaskLock();
+    for (UINT32 i = 0; i < g_recordCount; i++) {
+        g_records[i].alive = FALSE;
+    }
+    for (UINT32 id = 0; id <= LOSCFG_BASE_CORE_TSK_LIMIT; id++) {
+        if (LOS_TaskInfoGet(id, &info) != LOS_OK) {
+            continue;
+        }
+        StackProfRecord *rec = RecordFind(info.acName);
+        if (rec == NULL) {
+            continue;
+        }
+        rec->taskId = id;
+        rec->alive = TRUE;
+        // 同名任务可能以不同栈大小重建，取最近一次的大小
+        rec->stackSize = info.uwStackSize;
+        if (info.uwPeakUsed > rec->peakUsed) {
+            rec->peakUsed = info.uwPeakUsed;
+        }
+        if (info.bOvf) {
+            rec->overflow = TRUE;
+        }
+        if (!rec->warned && (rec->overflow ||
+            (UINT64)rec->peakUsed * 100 >= (UINT64)rec->stackSize * STACK_PROF_WARN_PCT)) {
+            rec->warned = TRUE;
+            warn[warnCount++] = *rec;
+        }
+    }
+    g_scanCount++;
+    LOS_TaskUnlock();
+
+    for (UINT32 i = 0; i < warnCount; i++) {
+        printf("[stackprof] %s (0x%X): peak %u / %u bytes%s\n", warn[i].name, warn[i].taskId,
+               warn[i].peakUsed, warn[i].stackSize, warn[i].overflow ? ", OVERFLOW" : "");
+    }
+}
+
+/**
+ * @brief 把各任务栈中当前栈指针以下的部分重新填成 OS_TASK_STACK_INIT，
+ *        LOS_TaskInfoGet 得到的峰值从此刻重新累计
+ * 其他任务以切出时保存的栈指针为界；当前任务以本函数的栈帧再留 STACK_PROF_SELF_GUARD 为界。
+ * 每个任务在关中断下填充，单个栈的耗时与其大小成正比。
+ */
+static VOID StackProfRecolor(VOID)
+{
+    UINT32 selfId = LOS_CurTaskIDGet();
+    UINTPTR selfSp = (UINTPTR)&selfId;
+
+    for (UINT32 id = 0; id <= LOSCFG_BASE_CORE_TSK_LIMIT; id++) {
+        UINT32 intSave = LOS_IntLock();
+        LosTaskCB *tcb = OS_TCB_FROM_TID(id);
+        if ((tcb->taskStatus & OS_TASK_STATUS_UNUSED) != 0) {
+            LOS_IntRestore(intSave);
+            continue;
+        }
+        // 栈顶 (低地址) 第一个字是魔术字，从下一个字开始填
+        UINT32 *p = (UINT32 *)(tcb->topOfStack + sizeof(UINTPTR));
+        UINTPTR end = (id == selfId) ? (selfSp - STACK_PROF_SELF_GUARD) : (UINTPTR)tcb->stackPointer;
+        if (end > tcb->topOfStack + tcb->stackSize) {
+            end = tcb->topOfStack;
+        }
+        while ((UINTPTR)(p + 1) <= end) {
+            *p++ = OS_TASK_STACK_INIT;
+        }
+        LOS_IntRestore(intSave);
+    }
+}
+
+static VOID StackProfTimer(VOID *arg)
+{
+    (void)arg;
+    StackProfScan();
+}
+
+UINT32 StackProfRecordsGet(StackProfRecord *out, UINT32 max)
+{
+    UINT32 n;
+
+    LOS_TaskLock();
+    n = (g_recordCount < max) ? g_recordCount : max;
+    memcpy(out, g_records, n * sizeof(StackProfRecord));
+    LOS_TaskUnlock();
+    return n;
+}
+
+UINT32 StackProfRecommend(UINT32 peakUsed)
+{
+    UINT32 size = (UINT32)((UINT64)peakUsed * (100 + STACK_PROF_MARGIN_PCT) / 100);
+
+    size = (size + STACK_PROF_ALIGN - 1) & ~(STACK_PROF_ALIGN - 1);
+    if (size < LOSCFG_BASE_CORE_TSK_MIN_STACK_SIZE) {
+        size = LOSCFG_BASE_CORE_TSK_MIN_STACK_SIZE;
+    }
+    return size;
+}
+
+/* ================= 报告 ================= */
+
+VOID StackProfReport(VOID)
+{
+    static StackProfRecord snap[STACK_PROF_MAX_RECORDS];
+    UINT32 n;
+    UINT32 totalSize = 0;
+    UINT32 totalReclaim = 0;
+
+    StackProfScan();
+    n = StackProfRecordsGet(snap, STACK_PROF_MAX_RECORDS);
+
+    printf("%-20s %-6s %8s %8s %5s %8s %8s %s\n", "Name", "ID", "Size", "Peak", "Use%", "Suggest",
+           "Reclaim", "State");
+    for (UINT32 i = 0; i < n; i++) {
+        const StackProfRecord *r = &snap[i];
+        UINT32 suggest = StackProfRecommend(r->peakUsed);
+        UINT32 pct = (r->stackSize == 0) ? 0 : (UINT32)((UINT64)r->peakUsed * 100 / r->stackSize);
+        INT32 reclaim = (INT32)r->stackSize - (INT32)suggest;
+
+        printf("%-20s 0x%-4X %8u %8u %4u%% %8u %8d %s\n", r->name, r->taskId, r->stackSize,
+               r->peakUsed, pct, suggest, reclaim,
+               r->overflow ? "OVERFLOW" : (r->alive ? "alive" : "exited"));
+        totalSize += r->stackSize;
+        if (reclaim > 0) {
+            totalReclaim += (UINT32)reclaim;
+        }
+    }
+    printf("%u tasks, %u scans, stacks %u bytes, reclaimable %u bytes (margin %u%%)\n",
+           n, g_scanCount, totalSize, totalReclaim, STACK_PROF_MARGIN_PCT);
+    printf("note: peaks only cover code paths exercised so far\n");
+}
+
+/* ================= shell 命令 ================= */
+
+static UINT32 StackProfCmd(UINT32 argc, const CHAR **argv)
+{
+    if (argc == 0 || strcmp(argv[0], "report") == 0) {
+        StackProfReport();
+        return LOS_OK;
+    }
+    if (strcmp(argv[0], "reset") == 0) {
+        LOS_TaskLock();
+        g_recordCount = 0;
+        g_scanCount = 0;
+        // 内核的峰值来自栈着色，只清记录的话下一次扫描又会读回历史峰值
+        StackProfRecolor();
+        LOS_TaskUnlock();
+        printf("[stackprof] records cleared, stacks recolored\n");
+        return LOS_OK;
+    }
+    printf("usage: stackprof [report|reset]\n");
+    return LOS_NOK;
+}
+
+UINT32 StackProfInit(VOID)
+{
+    if (g_inited) {
+        return LOS_OK;
+    }
+    g_scanTimer = osTimerNew((osTimerFunc_t)StackProfTimer, osTimerPeriodic, NULL, NULL);
+    if (g_scanTimer == NULL || osTimerStart(g_scanTimer, STACK_PROF_PERIOD_TICKS) != osOK) {
+        printf("[stackprof] scan timer start failed\n");
+        return LOS_NOK;
+    }
+    (void)osCmdReg(CMD_TYPE_EX, "stackprof", XARGS, (CmdCallBackFunc)StackProfCmd);
+    g_inited = TRUE;
+    return LOS_OK;
+}
+
+void StackProfApp(void)
+{
+    if (StackProfInit() == LOS_OK) {
+        printf("[stackprof] scanning every %u ticks, use 'stackprof' for the report\n",
+               (UINT32)STACK_PROF_PERIOD_TICKS);
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef APP_STACK_PROF_H
+#define APP_STACK_PROF_H
+
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 按任务名保留记录，任务退出后其水位仍出现在报告中
+#define STACK_PROF_MAX_RECORDS   48
+#define STACK_PROF_NAME_LEN      24
+// 周期扫描间隔 (tick)
+#ifndef STACK_PROF_PERIOD_TICKS
+#define STACK_PROF_PERIOD_TICKS  LOSCFG_BASE_CORE_TICK_PER_SECOND
+#endif
+// 推荐栈大小 = 峰值 * (100 + MARGIN) / 100，向上取整到 ALIGN
+#define STACK_PROF_MARGIN_PCT    25
+#define STACK_PROF_ALIGN         0x100
+// 峰值超过该比例时打印一次告警
+#define STACK_PROF_WARN_PCT      90
+
+typedef struct {
+    CHAR name[STACK_PROF_NAME_LEN];
+    UINT32 taskId;              // 最近一次看到该任务时的 ID
+    UINT32 stackSize;
+    UINT32 peakUsed;            // 历次扫描的最大水位 (字节)
+    BOOL alive;                 // 最近一次扫描时仍存在
+    BOOL overflow;              // 栈顶魔术字被破坏
+    BOOL warned;
+} StackProfRecord;
+
+/*
+ * 栈水位统计
+ * 内核创建任务时已用 OS_TASK_STACK_INIT 填充整个栈 (栈着色)，LOS_TaskInfoGet 从栈顶向下
+ * 找第一个被改写的字得到历史峰值 uwPeakUsed；这里周期性扫描所有任务并按任务名累计最大值，
+ * 给出带余量的推荐大小。shell 命令 "stackprof reset" 清空记录并把各任务栈中未使用的部分重新着色，
+ * 之后的峰值只反映 reset 之后的执行路径。
+ */
+
+/**
+ * @brief 启动周期扫描并注册 shell 命令 stackprof，重复调用无副作用
+ */
+UINT32 StackProfInit(VOID);
+
+/**
+ * @brief 立即扫描一次所有任务
+ */
+VOID StackProfScan(VOID);
+
+/**
+ * @brief 读出记录，返回实际条数
+ */
+UINT32 StackProfRecordsGet(StackProfRecord *out, UINT32 max);
+
+UINT32 StackProfRecommend(UINT32 peakUsed);
+
+/**
+ * @brief 打印每个任务的栈大小、峰值、推荐值与可回收字节数
+ */
+VOID StackProfReport(VOID);
+
+/**
+ * @brief 与其他测试同时打开，开机即开始记录各任务栈水位
+ */
+void StackProfApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
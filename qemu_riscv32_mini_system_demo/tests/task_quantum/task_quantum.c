@@ -0,0 +1,159 @@
+/*
+ * 按任务设置的时间片
+ * 切换钩子累计每个任务本轮的连续运行时间，检查线程按 tick 比较并轮转超时任务。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+
+#include "sched_hook.h"
+#include "task_quantum.h"
+
+#define TASK_QUANTUM_NONE        0xFFFFFFFF
+#define ENFORCER_STACK_SIZE      0x800
+
+/* ================= 全局变量 ================= */
+// 切换钩子 (关中断) 与检查线程共同访问，检查线程读写时关中断
+static UINT64 g_quantumCycles[TASK_QUANTUM_MAX_TASKS];
+static UINT64 g_usedCycles[TASK_QUANTUM_MAX_TASKS];
+static UINT32 g_rotations[TASK_QUANTUM_MAX_TASKS];
+static UINT64 g_runStart;
+static UINT32 g_interrupted = TASK_QUANTUM_NONE;  // 最近一次被检查线程打断的任务
+
+static UINT32 g_enforcerId = TASK_QUANTUM_NONE;
+static BOOL g_inited = FALSE;
+
+/* ================= 切换钩子 ================= */
+
+static VOID TaskQuantumOnSwitch(const LosTaskCB *from, const LosTaskCB *to, UINT64 cycles)
+{
+    UINT32 id = from->taskID;
+
+    if (id < TASK_QUANTUM_MAX_TASKS) {
+        // 仍就绪且被更高优先级抢占时保留已用时间；同级让出 / 阻塞 / 退出时本轮结束
+        if ((from->taskStatus & OS_TASK_STATUS_READY) && to->priority < from->priority) {
+            g_usedCycles[id] += cycles - g_runStart;
+        } else {
+            g_usedCycles[id] = 0;
+        }
+        if (from->taskStatus & (OS_TASK_STATUS_EXIT | OS_TASK_STATUS_UNUSED)) {
+            g_quantumCycles[id] = 0;
+            g_rotations[id] = 0;
+        }
+    }
+    if (to->taskID == g_enforcerId) {
+        g_interrupted = id;
+    }
+    g_runStart = cycles;
+}
+
+/* ================= 检查线程 ================= */
+
+static VOID *TaskQuantumEnforcer(UINTPTR arg)
+{
+    (void)arg;
+    while (1) {
+        (void)LOS_TaskDelay(1);
+
+        UINT32 intSave = LOS_IntLock();
+        UINT32 id = g_interrupted;
+        BOOL expired = (id < TASK_QUANTUM_MAX_TASKS) && (g_quantumCycles[id] != 0) &&
+                       (g_usedCycles[id] >= g_quantumCycles[id]);
+        g_interrupted = TASK_QUANTUM_NONE;
+        LOS_IntRestore(intSave);
+        if (!expired) {
+            continue;
+        }
+
+        // 挂起再恢复会把任务重新挂到同优先级就绪队列末尾，效果等同于在它的位置 Yield
+        LOS_TaskLock();
+        if (LOS_TaskSuspend(id) == LOS_OK) {
+            (void)LOS_TaskResume(id);
+            intSave = LOS_IntLock();
+            g_usedCycles[id] = 0;
+            g_rotations[id]++;
+            LOS_IntRestore(intSave);
+        }
+        LOS_TaskUnlock();
+    }
+    return NULL;
+}
+
+/* ================= 接口 ================= */
+
+UINT32 TaskQuantumSet(UINT32 taskId, UINT32 quantumTicks)
+{
+    UINT32 intSave;
+
+    if (taskId >= TASK_QUANTUM_MAX_TASKS || taskId == g_enforcerId) {
+        return LOS_NOK;
+    }
+    intSave = LOS_IntLock();
+    g_quantumCycles[taskId] = (UINT64)quantumTicks * OS_SYS_CLOCK / LOSCFG_BASE_CORE_TICK_PER_SECOND;
+    g_rotations[taskId] = 0;
+    LOS_IntRestore(intSave);
+    return LOS_OK;
+}
+
+UINT32 TaskQuantumGet(UINT32 taskId, TaskQuantumInfo *info)
+{
+    UINT32 intSave;
+
+    if (taskId >= TASK_QUANTUM_MAX_TASKS || info == NULL) {
+        return LOS_NOK;
+    }
+    intSave = LOS_IntLock();
+    info->quantumTicks = (UINT32)(g_quantumCycles[taskId] * LOSCFG_BASE_CORE_TICK_PER_SECOND / OS_SYS_CLOCK);
+    info->rotations = g_rotations[taskId];
+    info->usedCycles = g_usedCycles[taskId];
+    LOS_IntRestore(intSave);
+    return LOS_OK;
+}
+
+UINT32 TaskQuantumCreate(UINT32 *taskId, TSK_INIT_PARAM_S *param, UINT32 quantumTicks)
+{
+    UINT32 ret;
+
+    // 锁调度，避免高优先级任务在设置时间片之前就开始运行
+    LOS_TaskLock();
+    ret = LOS_TaskCreate(taskId, param);
+    if (ret == LOS_OK) {
+        ret = TaskQuantumSet(*taskId, quantumTicks);
+    }
+    LOS_TaskUnlock();
+    return ret;
+}
+
+UINT32 TaskQuantumInit(VOID)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 ret;
+
+    if (g_inited) {
+        return LOS_OK;
+    }
+    g_runStart = LOS_SysCycleGet();
+    ret = SchedHookAdd(TaskQuantumOnSwitch);
+    if (ret != LOS_OK) {
+        printf("[quantum] hook register failed\n");
+        return ret;
+    }
+
+    param.pfnTaskEntry = (TSK_ENTRY_FUNC)TaskQuantumEnforcer;
+    param.uwStackSize  = ENFORCER_STACK_SIZE;
+    param.pcName       = "QuantumEnforcer";
+    param.usTaskPrio   = TASK_QUANTUM_ENFORCER_PRI;
+    ret = LOS_TaskCreate(&g_enforcerId, &param);
+    if (ret != LOS_OK) {
+        printf("[quantum] enforcer create failed: 0x%X\n", ret);
+        SchedHookRemove(TaskQuantumOnSwitch);
+        return ret;
+    }
+    g_inited = TRUE;
+    return LOS_OK;
+}
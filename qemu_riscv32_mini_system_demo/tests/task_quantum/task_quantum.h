@@ -0,0 +1,50 @@
+#ifndef APP_TASK_QUANTUM_H
+#define APP_TASK_QUANTUM_H
+
+#include "los_task.h"
+#include "los_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TASK_QUANTUM_MAX_TASKS   (LOSCFG_BASE_CORE_TSK_LIMIT + 1)
+// 检查线程优先级，仅次于软件定时器任务
+#define TASK_QUANTUM_ENFORCER_PRI 1
+
+/*
+ * 按任务设置的时间片
+ * 内核轮转只有一个全局时间片 (LOSCFG_BASE_CORE_TIMESLICE_TIMEOUT)。检查线程每个 tick 醒来一次，
+ * 若被它打断的任务在本轮已连续运行满自己的时间片，就挂起再恢复该任务，把它放到同优先级就绪队列末尾。
+ * - 精度为 1 tick；未设置的任务 (quantum 为 0) 仍由内核时间片决定
+ * - 只能把时间片缩短到全局值以下；需要更长时间片的任务，应把全局时间片调到不小于最大值
+ * - 被更高优先级任务抢占时保留已用时间，让出 / 阻塞 / 被轮转后清零
+ */
+typedef struct {
+    UINT32 quantumTicks;        // 0 表示未设置
+    UINT32 rotations;           // 被检查线程轮转的次数
+    UINT64 usedCycles;          // 本轮已连续运行的周期
+} TaskQuantumInfo;
+
+/**
+ * @brief 挂接切换钩子并创建检查线程，重复调用无副作用
+ */
+UINT32 TaskQuantumInit(VOID);
+
+/**
+ * @brief 设置任务时间片 (tick)，0 表示恢复为内核全局时间片
+ */
+UINT32 TaskQuantumSet(UINT32 taskId, UINT32 quantumTicks);
+
+UINT32 TaskQuantumGet(UINT32 taskId, TaskQuantumInfo *info);
+
+/**
+ * @brief 按 param 创建任务并在其首次运行前设置时间片
+ * TSK_INIT_PARAM_S 属于内核结构，无法增加字段，因此单独提供创建入口
+ */
+UINT32 TaskQuantumCreate(UINT32 *taskId, TSK_INIT_PARAM_S *param, UINT32 quantumTicks);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
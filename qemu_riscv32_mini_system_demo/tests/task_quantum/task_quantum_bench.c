@@ -0,0 +1,270 @@
+/*
+ * 时间片长度的吞吐 / 延迟权衡
+ * 同一优先级上 3 个批处理任务 (如密码运算) 与 1 个交互任务 (如 UI) 竞争 CPU：
+ *   - 批处理任务使用被测时间片，统计每秒完成的工作单元数 (吞吐)
+ *   - 交互任务固定 1 tick 时间片，由更高优先级的唤醒任务周期性释放信号量，
+ *     统计从释放到交互任务真正运行的周期数 (调度延迟)
+ * 时间片越长，切换越少、吞吐越高，交互任务排在批处理任务后面等待的时间也越长。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_sem.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+
+#include "task_quantum.h"
+#include "task_quantum_bench.h"
+
+#define TASK_STACK_SIZE          0x1000
+#define CTRL_TASK_PRI            4
+#define WAKER_TASK_PRI           6
+#define WORKER_TASK_PRI          12
+
+#define BATCH_TASK_NUM           3
+#define RUN_SEC_PER_QUANTUM      3
+#define UI_PERIOD_TICKS          5
+#define UI_QUANTUM_TICKS         1
+#define WORK_UNIT_LOOPS          1000
+
+static const UINT32 g_quanta[] = { 1, 2, 5, 10, 20 };
+
+typedef struct {
+    UINT32 quantum;
+    UINT32 unitsPerSec;
+    UINT32 rotations;
+    UINT32 uiWakeups;
+    UINT32 uiAvgUs;
+    UINT32 uiMaxUs;
+} QuantumResult;
+
+/* ================= 全局变量 ================= */
+static volatile BOOL g_running = FALSE;
+static volatile UINT32 g_alive = 0;
+static volatile UINT32 g_units[BATCH_TASK_NUM];
+static UINT32 g_batchIds[BATCH_TASK_NUM];
+static UINT32 g_uiSem;
+static volatile UINT64 g_postCycles;
+static UINT64 g_latSum;
+static UINT64 g_latMax;
+static UINT32 g_latCount;
+
+static VOID TaskExit(VOID)
+{
+    UINT32 intSave = LOS_IntLock();
+    g_alive--;
+    LOS_IntRestore(intSave);
+}
+
+static VOID BurnCpu(UINT32 intensity)
+{
+    volatile UINT32 res = 0;
+    for (UINT32 i = 0; i < intensity; i++) {
+        res += i * i;
+    }
+    (void)res;
+}
+
+/* ================= 任务入口 ================= */
+
+static VOID *BatchTaskEntry(UINTPTR arg)
+{
+    while (g_running) {
+        BurnCpu(WORK_UNIT_LOOPS);
+        g_units[arg]++;
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID *UiTaskEntry(UINTPTR arg)
+{
+    (void)arg;
+    while (1) {
+        (void)LOS_SemPend(g_uiSem, LOS_WAIT_FOREVER);
+        if (!g_running) {
+            break;
+        }
+        UINT64 lat = LOS_SysCycleGet() - g_postCycles;
+        g_latSum += lat;
+        g_latCount++;
+        if (lat > g_latMax) {
+            g_latMax = lat;
+        }
+        // 一次交互处理的计算量
+        BurnCpu(WORK_UNIT_LOOPS / 4);
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID *WakerTaskEntry(UINTPTR arg)
+{
+    (void)arg;
+    while (g_running) {
+        (void)LOS_TaskDelay(UI_PERIOD_TICKS);
+        g_postCycles = LOS_SysCycleGet();
+        (void)LOS_SemPost(g_uiSem);
+    }
+    // 放出可能仍在等待的交互任务
+    (void)LOS_SemPost(g_uiSem);
+    TaskExit();
+    return NULL;
+}
+
+/* ================= 测试流程 ================= */
+
+static UINT32 SpawnTask(const CHAR *name, TSK_ENTRY_FUNC entry, UINT16 prio, UINTPTR arg,
+                        UINT32 quantum, UINT32 *taskId)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 id;
+    UINT32 ret;
+
+    param.pfnTaskEntry = entry;
+    param.uwStackSize  = TASK_STACK_SIZE;
+    param.pcName       = (CHAR *)name;
+    param.usTaskPrio   = prio;
+    param.uwArg        = arg;
+    ret = TaskQuantumCreate(&id, &param, quantum);
+    if (ret != LOS_OK) {
+        printf("create %s failed: 0x%X\n", name, ret);
+        return ret;
+    }
+    g_alive++;
+    if (taskId != NULL) {
+        *taskId = id;
+    }
+    return LOS_OK;
+}
+
+/**
+ * @brief 停止并等待已创建的任务退出
+ * 交互任务可能阻塞在信号量上，唤醒任务未创建成功时只能由这里放出
+ */
+static VOID StopTasks(VOID)
+{
+    g_running = FALSE;
+    (void)LOS_SemPost(g_uiSem);
+    while (g_alive != 0) {
+        (void)LOS_TaskDelay(1);
+    }
+    (void)LOS_SemDelete(g_uiSem);
+}
+
+static UINT32 RunQuantum(UINT32 quantum, QuantumResult *res)
+{
+    static const CHAR *batchNames[BATCH_TASK_NUM] = { "Batch0", "Batch1", "Batch2" };
+    TaskQuantumInfo info;
+    UINT32 total = 0;
+    UINT32 ret;
+
+    memset(res, 0, sizeof(*res));
+    memset((VOID *)g_units, 0, sizeof(g_units));
+    g_latSum = 0;
+    g_latMax = 0;
+    g_latCount = 0;
+    g_running = TRUE;
+    g_alive = 0;
+
+    ret = LOS_SemCreate(0, &g_uiSem);
+    if (ret != LOS_OK) {
+        printf("LOS_SemCreate failed: 0x%X\n", ret);
+        return ret;
+    }
+    for (UINT32 i = 0; i < BATCH_TASK_NUM && ret == LOS_OK; i++) {
+        ret = SpawnTask(batchNames[i], (TSK_ENTRY_FUNC)BatchTaskEntry, WORKER_TASK_PRI, i, quantum,
+                        &g_batchIds[i]);
+    }
+    if (ret == LOS_OK) {
+        ret = SpawnTask("UiTask", (TSK_ENTRY_FUNC)UiTaskEntry, WORKER_TASK_PRI, 0, UI_QUANTUM_TICKS, NULL);
+    }
+    if (ret == LOS_OK) {
+        ret = SpawnTask("UiWaker", (TSK_ENTRY_FUNC)WakerTaskEntry, WAKER_TASK_PRI, 0, 0, NULL);
+    }
+    if (ret != LOS_OK) {
+        StopTasks();
+        return ret;
+    }
+
+    (void)LOS_TaskDelay(RUN_SEC_PER_QUANTUM * LOSCFG_BASE_CORE_TICK_PER_SECOND);
+
+    for (UINT32 i = 0; i < BATCH_TASK_NUM; i++) {
+        total += g_units[i];
+        if (TaskQuantumGet(g_batchIds[i], &info) == LOS_OK) {
+            res->rotations += info.rotations;
+        }
+    }
+    StopTasks();
+
+    res->quantum = quantum;
+    res->unitsPerSec = total / RUN_SEC_PER_QUANTUM;
+    res->uiWakeups = g_latCount;
+    if (g_latCount != 0) {
+        res->uiAvgUs = (UINT32)(g_latSum / g_latCount * 1000000ULL / OS_SYS_CLOCK);
+        res->uiMaxUs = (UINT32)(g_latMax * 1000000ULL / OS_SYS_CLOCK);
+    }
+    return ret;
+}
+
+static VOID *TaskQuantumBenchTask(UINTPTR arg)
+{
+    QuantumResult results[sizeof(g_quanta) / sizeof(g_quanta[0])];
+    UINT32 count = sizeof(g_quanta) / sizeof(g_quanta[0]);
+
+    (void)arg;
+    printf("\n>>> Per-task Quantum Benchmark <<<\n");
+    printf("%u batch tasks + 1 UI task (quantum %u tick) at prio %u, UI wakeup every %u ticks, %u s per quantum\n",
+           BATCH_TASK_NUM, UI_QUANTUM_TICKS, WORKER_TASK_PRI, UI_PERIOD_TICKS, RUN_SEC_PER_QUANTUM);
+#ifdef LOSCFG_BASE_CORE_TIMESLICE_TIMEOUT
+    // 长于全局时间片的设置不会生效，见 task_quantum.h
+    printf("kernel timeslice: %u, longer quanta are capped by it\n", (UINT32)LOSCFG_BASE_CORE_TIMESLICE_TIMEOUT);
+#endif
+    if (TaskQuantumInit() != LOS_OK) {
+        return NULL;
+    }
+
+    for (UINT32 i = 0; i < count; i++) {
+        if (RunQuantum(g_quanta[i], &results[i]) != LOS_OK) {
+            count = i;
+            break;
+        }
+    }
+
+    printf("\n%-8s | %-12s | %-9s | %-9s | %-10s | %-10s\n",
+           "Quantum", "Units/s", "Rotations", "UiWakeups", "UiAvgUs", "UiMaxUs");
+    printf("---------|--------------|-----------|-----------|------------|-----------\n");
+    for (UINT32 i = 0; i < count; i++) {
+        const QuantumResult *r = &results[i];
+        printf("%-8u | %-12u | %-9u | %-9u | %-10u | %-10u\n",
+               r->quantum, r->unitsPerSec, r->rotations, r->uiWakeups, r->uiAvgUs, r->uiMaxUs);
+    }
+    // 便于脚本提取的单行结果
+    for (UINT32 i = 0; i < count; i++) {
+        const QuantumResult *r = &results[i];
+        printf("QUANTUM ticks=%u units_per_s=%u rotations=%u ui_wakeups=%u ui_avg_us=%u ui_max_us=%u\n",
+               r->quantum, r->unitsPerSec, r->rotations, r->uiWakeups, r->uiAvgUs, r->uiMaxUs);
+    }
+    return NULL;
+}
+
+void TaskQuantumBenchApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)TaskQuantumBenchTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "QuantumBenchTask";
+    task.usTaskPrio   = CTRL_TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("QuantumBenchTask create failed: 0x%X\n", ret);
+    }
+}
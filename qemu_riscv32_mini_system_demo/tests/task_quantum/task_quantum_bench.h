@@ -0,0 +1,13 @@
+#ifndef APP_TASK_QUANTUM_BENCH_H
+#define APP_TASK_QUANTUM_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void TaskQuantumBenchApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -12,6 +12,19 @@
 #include "ohos_init.h"
 #include "cmsis_os2.h"
 #include "los_task.h"
+#include "perf_counter.h"
+#if defined(TCM_DLOG)
+#include "dlog.h"
+#endif
+#if defined(TCM_PC_PROF)
+#include "pc_prof.h"
+#endif
+#if defined(ALLOC_TRACE_RECORD)
+#include "alloc_trace.h"
+#endif
+#if defined(BLOCK_POOLS)
+#include "block_pool.h"
+#endif
 
 // Task Configuration
 #define TASK_STACK_SIZE      0x4000 
@@ -80,6 +93,12 @@ typedef struct {
     uint32_t rsp_size;
 } TcmTestContext;
 
+#if defined(BLOCK_POOLS)
+// 命令上下文从定长池借出；测试序列只有一个使用者，池里放一个 (约 2.6 KB) 即可
+#define TCM_CTX_POOL_COUNT       1
+BLOCK_POOL_DEFINE(g_tcmCtxPool, TcmTestContext, TCM_CTX_POOL_COUNT);
+#endif
+
 static const uint8_t platform_policy[32] = {
     0x16, 0x78, 0x60, 0xA3, 0x5F, 0x2C, 0x5C, 0x35,
     0x67, 0xF9, 0xC9, 0x27, 0xAC, 0x56, 0xC0, 0x32,
@@ -348,18 +367,52 @@ static void parse_SelfTest(const uint8_t *rsp_ptr, uint32_t rsp_size)
 }
 
 
+/*
+ * 周期统计按命令码归到固定的一组区间，不随 desc 增长，避免占满 PERF_MAX_REGIONS 共享的区间表
+ */
+static const char *TcmPerfRegionName(uint32_t cc)
+{
+    switch (cc) {
+        case TCM_CC_Startup:        return "Tcm.Startup";
+        case TCM_CC_SelfTest:       return "Tcm.SelfTest";
+        case TCM_CC_GetRandom:      return "Tcm.GetRandom";
+        case TCM_CC_PCR_Read:       return "Tcm.PCR_Read";
+        case TCM_CC_GetCapability:  return "Tcm.GetCapability";
+        case TCM_CC_Hash:           return "Tcm.Hash";
+        case TCM_CC_NV_DefineSpace: return "Tcm.NV_DefineSpace";
+        case TCM_CC_NV_Write:       return "Tcm.NV_Write";
+        case TCM_CC_NV_Read:        return "Tcm.NV_Read";
+        case TCM_CC_CreatePrimary:  return "Tcm.CreatePrimary";
+        case TCM_CC_Create:         return "Tcm.Create";
+        case TCM_CC_Load:           return "Tcm.Load";
+        case TCM_CC_Sign:           return "Tcm.Sign";
+        case TCM_CC_RSA_Decrypt:    return "Tcm.RSA_Decrypt";
+        case TCM_CC_FlushContext:   return "Tcm.FlushContext";
+        default:                    return "TcmCommand";
+    }
+}
+
 /* * Core Execution Wrapper 
  * Sends command, receives response, checks RC.
  * Returns: RC (uint32)
  */
 static uint32_t TcmSendCmd(TcmTestContext *ctx, uint32_t cmd_len, const char *desc) {
+#if defined(TCM_DLOG)
+    // 逐条命令的十六进制转储改为一条延迟日志，desc 均为字符串字面量
+    if (desc) DLOG("%s: cc=0x%08X len=%u\n", desc, (cmd_len >= 10) ? read_be32(ctx->cmd_buf + 6) : 0, cmd_len);
+#else
     if (desc) print_hex(desc, ctx->cmd_buf, cmd_len);
+#endif
     
     ctx->rsp_size = sizeof(ctx->rsp_buf);
     ctx->rsp_ptr = ctx->rsp_buf;
     memset(ctx->rsp_buf, 0, ctx->rsp_size);
     
+    // 每条命令按命令码统计周期与指令数，未列出的命令与原始十六进制命令合并到 "TcmCommand"
+    PerfRegion *region = PerfRegionGet(TcmPerfRegionName((cmd_len >= 10) ? read_be32(ctx->cmd_buf + 6) : 0));
+    PerfRegionBegin(region);
     _plat__RunCommand(cmd_len, ctx->cmd_buf, &ctx->rsp_size, &ctx->rsp_ptr);
+    PerfRegionEnd(region);
     
     if (!ctx->rsp_ptr || ctx->rsp_size < 10) {
         printf("Error: No response or response too short\n");
@@ -1264,9 +1317,6 @@ void Test_Replay_Capture_Flushcontext(TcmTestContext *ctx) {
  * ========================================================================= */
 void TCMTestTask(void *arg) {
     (void)arg;
-    
-    // Static allocation to avoid stack overflow on small task stacks
-    static TcmTestContext ctx;
 
     // 1. Initialization
     _plat__Signal_PowerOn();
@@ -1294,39 +1344,87 @@ void TCMTestTask(void *arg) {
     }
 
     printf("=== TCM Modular Test Suite Started ===\n");
+#if defined(TCM_DLOG)
+    (void)DlogInit();
+#endif
+#if defined(TCM_PC_PROF)
+    // 整个命令序列逐 tick 采样 (含回溯)，结束后转储给 tools/pcprof_fold.py
+    if (PcProfInit() == LOS_OK) {
+        (void)PcProfStart(1, PC_PROF_BT_DEPTH);
+    }
+#endif
+#if defined(ALLOC_TRACE_RECORD)
+    // 只记录本任务发起的分配，作为分配器基准的 tcm 轨迹
+    (void)AllocTraceStart("tcm", LOS_CurTaskIDGet());
+#endif
+
+#if defined(BLOCK_POOLS)
+    TcmTestContext *ctx = BlockPoolAlloc(&g_tcmCtxPool, sizeof(TcmTestContext));
+    if (ctx == NULL) {
+        printf("[TCM] context alloc failed\n");
+        // 上面已开始的采样与轨迹记录不能留在运行状态
+#if defined(TCM_PC_PROF)
+        PcProfStop();
+#endif
+#if defined(ALLOC_TRACE_RECORD)
+        (void)AllocTraceStop();
+#endif
+        return;
+    }
+#else
+    // Static allocation to avoid stack overflow on small task stacks
+    static TcmTestContext ctxBuf;
+    TcmTestContext *ctx = &ctxBuf;
+#endif
 
     // Execute Modules
-    Test_Startup(&ctx);
+    Test_Startup(ctx);
     LOS_TaskDelay(2);
     
-    Test_SelfTest(&ctx);
+    Test_SelfTest(ctx);
     LOS_TaskDelay(2);
     
-    Test_GetRandom(&ctx);
+    Test_GetRandom(ctx);
     LOS_TaskDelay(2);
     
-    Test_PCR_Read(&ctx);
+    Test_PCR_Read(ctx);
     LOS_TaskDelay(2);
     
-    Test_GetCapability(&ctx);
+    Test_GetCapability(ctx);
     LOS_TaskDelay(2);
     
-    Test_Hash(&ctx);
+    Test_Hash(ctx);
     LOS_TaskDelay(2);
     
-    Test_NV_Storage(&ctx);
+    Test_NV_Storage(ctx);
     LOS_TaskDelay(2);
     
-    Test_SM2_Hierarchy(&ctx);
+    Test_SM2_Hierarchy(ctx);
     
-    /* Test_Replay_Capture_CreatePrimary(&ctx);
-    Test_Replay_Capture_Create(&ctx);
-    Test_Replay_Capture_Load(&ctx);
-    Test_Replay_Capture_Sign(&ctx);
-    Test_Replay_Capture_Verifysignature(&ctx);
-    Test_Replay_Capture_Flushcontext(&ctx);
+    /* Test_Replay_Capture_CreatePrimary(ctx);
+    Test_Replay_Capture_Create(ctx);
+    Test_Replay_Capture_Load(ctx);
+    Test_Replay_Capture_Sign(ctx);
+    Test_Replay_Capture_Verifysignature(ctx);
+    Test_Replay_Capture_Flushcontext(ctx);
     LOS_TaskDelay(2); */
 
+#if defined(TCM_PC_PROF)
+    PcProfStop();
+    PcProfDumpUart();
+#endif
+#if defined(ALLOC_TRACE_RECORD)
+    (void)AllocTraceStop();
+    (void)AllocTraceSave();
+#endif
+#if defined(TCM_DLOG)
+    (void)DlogFlush();
+#endif
+#if defined(BLOCK_POOLS)
+    BlockPoolFree(&g_tcmCtxPool, ctx);
+    BlockPoolDump();
+#endif
+    PerfReport();
     printf("\n=== All Tests Finished ===\n");
 }
 
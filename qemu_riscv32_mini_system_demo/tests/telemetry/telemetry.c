@@ -0,0 +1,375 @@
+/*
+ * 串口二进制遥测
+ * 帧在静态缓冲区中拼装，序号分配与整行输出都在互斥锁内完成，同一流的帧在串口上保持顺序。
+ * 计数器用 LEB128 变长编码，典型的切换次数 / 微秒 / 千分比只占 1~3 字节。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_mux.h"
+#include "shcmd.h"
+
+#include "telemetry.h"
+
+#define TM_HDR_SIZE              12
+#define TM_CRC_SIZE              2
+#define TM_FRAME_MAX             (TM_HDR_SIZE + TM_PAYLOAD_MAX + TM_CRC_SIZE)
+#define TM_B64_MAX               (((TM_FRAME_MAX + 2) / 3) * 4)
+#define TM_VARINT_MAX            5
+#define TM_TRACE_HDR             4
+
+typedef struct {
+    BOOL defined;
+    TmKind kind;
+    const CHAR *name;
+    const CHAR *const *fields;
+    UINT32 fieldCount;
+    UINT32 sinceMeta;            // 上次 META 之后的数据帧数
+} TmStream;
+
+/* ================= 全局变量 ================= */
+static const CHAR g_b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// 以下均在 g_mux 内访问
+static TmStream g_streams[TM_MAX_STREAMS];
+static UINT8 g_frame[TM_FRAME_MAX];
+static UINT8 g_payload[TM_PAYLOAD_MAX];
+static CHAR g_line[sizeof(TM_LINE_PREFIX) + TM_B64_MAX + 2];
+static UINT16 g_seq = 0;
+static TmStats g_stats;
+
+static UINT32 g_mux;
+static volatile BOOL g_enabled = TRUE;
+static BOOL g_inited = FALSE;
+
+/* ================= 编码 ================= */
+
+static UINT16 Crc16(const UINT8 *data, UINT32 len)
+{
+    UINT16 crc = 0xFFFF;
+
+    for (UINT32 i = 0; i < len; i++) {
+        crc ^= (UINT16)data[i] << 8;
+        for (UINT32 b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (UINT16)((crc << 1) ^ 0x1021) : (UINT16)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static UINT32 Base64(const UINT8 *in, UINT32 len, CHAR *out)
+{
+    UINT32 o = 0;
+    UINT32 i = 0;
+
+    for (; i + 2 < len; i += 3) {
+        UINT32 v = ((UINT32)in[i] << 16) | ((UINT32)in[i + 1] << 8) | in[i + 2];
+        out[o++] = g_b64[(v >> 18) & 0x3F];
+        out[o++] = g_b64[(v >> 12) & 0x3F];
+        out[o++] = g_b64[(v >> 6) & 0x3F];
+        out[o++] = g_b64[v & 0x3F];
+    }
+    if (i < len) {
+        UINT32 v = (UINT32)in[i] << 16;
+        if (i + 1 < len) {
+            v |= (UINT32)in[i + 1] << 8;
+        }
+        out[o++] = g_b64[(v >> 18) & 0x3F];
+        out[o++] = g_b64[(v >> 12) & 0x3F];
+        out[o++] = (i + 1 < len) ? g_b64[(v >> 6) & 0x3F] : '=';
+        out[o++] = '=';
+    }
+    out[o] = '\0';
+    return o;
+}
+
+static UINT32 PutVarint(UINT8 *buf, UINT32 v)
+{
+    UINT32 n = 0;
+
+    while (v >= 0x80) {
+        buf[n++] = (UINT8)(v | 0x80);
+        v >>= 7;
+    }
+    buf[n++] = (UINT8)v;
+    return n;
+}
+
+static inline VOID PutLe16(UINT8 *buf, UINT16 v)
+{
+    buf[0] = (UINT8)v;
+    buf[1] = (UINT8)(v >> 8);
+}
+
+static inline VOID PutLe32(UINT8 *buf, UINT32 v)
+{
+    PutLe16(buf, (UINT16)v);
+    PutLe16(buf + 2, (UINT16)(v >> 16));
+}
+
+/**
+ * @brief 拼装一帧并整行输出；调用方持有 g_mux
+ */
+static VOID EmitLocked(TmType type, UINT8 stream, UINT8 flags, const UINT8 *payload, UINT32 len)
+{
+    UINT32 total = TM_HDR_SIZE + len;
+    UINT32 n;
+
+    g_frame[0] = TM_VERSION;
+    g_frame[1] = (UINT8)type;
+    g_frame[2] = stream;
+    g_frame[3] = flags;
+    PutLe16(&g_frame[4], g_seq++);
+    PutLe16(&g_frame[6], (UINT16)len);
+    PutLe32(&g_frame[8], (UINT32)LOS_TickCountGet());
+    (VOID)memcpy(&g_frame[TM_HDR_SIZE], payload, len);
+    PutLe16(&g_frame[total], Crc16(g_frame, total));
+    total += TM_CRC_SIZE;
+
+    (VOID)memcpy(g_line, TM_LINE_PREFIX, sizeof(TM_LINE_PREFIX) - 1);
+    n = sizeof(TM_LINE_PREFIX) - 1;
+    n += Base64(g_frame, total, &g_line[n]);
+    g_line[n++] = '\n';
+    g_line[n] = '\0';
+    // 一次调用输出整行，避免与其它任务的打印在行内交错
+    printf("%s", g_line);
+
+    g_stats.frames++;
+    g_stats.payloadBytes += len;
+    g_stats.lineBytes += n;
+}
+
+// flags 为 TM_FLAG_RESEND 时表示 "telemetry meta" 补发，主机端不据此判定目标重启
+static VOID EmitHelloLocked(UINT8 flags)
+{
+    UINT8 hello[8];
+
+    PutLe32(&hello[0], (UINT32)OS_SYS_CLOCK);
+    PutLe16(&hello[4], LOSCFG_BASE_CORE_TICK_PER_SECOND);
+    PutLe16(&hello[6], TM_PAYLOAD_MAX);
+    EmitLocked(TM_TYPE_HELLO, 0, flags, hello, sizeof(hello));
+}
+
+/**
+ * @brief 生成流的 META 负载，超过一帧时返回 0
+ */
+static UINT32 BuildMeta(const TmStream *s, UINT8 *buf)
+{
+    UINT32 len = 2;
+
+    buf[0] = (UINT8)s->kind;
+    buf[1] = (UINT8)s->fieldCount;
+    for (UINT32 i = 0; i <= s->fieldCount; i++) {
+        const CHAR *str = (i == 0) ? s->name : s->fields[i - 1];
+        UINT32 sl = strlen(str) + 1;
+        if (len + sl > TM_PAYLOAD_MAX) {
+            return 0;
+        }
+        (VOID)memcpy(&buf[len], str, sl);
+        len += sl;
+    }
+    return len;
+}
+
+static VOID EmitMetaLocked(UINT8 stream)
+{
+    TmStream *s = &g_streams[stream];
+    UINT32 len = BuildMeta(s, g_payload);
+
+    if (len != 0) {
+        EmitLocked(TM_TYPE_META, stream, 0, g_payload, len);
+    }
+    s->sinceMeta = 0;
+}
+
+/**
+ * @brief 检查流是否可用于 kind 类型的数据帧，必要时先补发 META；失败时释放锁
+ */
+static BOOL DataBegin(UINT8 stream, TmKind kind)
+{
+    if (!g_inited || !g_enabled) {
+        return FALSE;
+    }
+    (VOID)LOS_MuxPend(g_mux, LOS_WAIT_FOREVER);
+    if (stream >= TM_MAX_STREAMS || !g_streams[stream].defined || g_streams[stream].kind != kind) {
+        g_stats.rejected++;
+        (VOID)LOS_MuxPost(g_mux);
+        return FALSE;
+    }
+    if (g_streams[stream].sinceMeta >= TM_META_INTERVAL) {
+        EmitMetaLocked(stream);
+    }
+    return TRUE;
+}
+
+/* ================= 对外接口 ================= */
+
+UINT32 TmStreamDefine(UINT8 stream, TmKind kind, const CHAR *name, const CHAR *const *fields, UINT32 fieldCount)
+{
+    TmStream *s;
+    UINT32 ret = LOS_OK;
+
+    if (!g_inited || stream >= TM_MAX_STREAMS || name == NULL || fieldCount > TM_MAX_FIELDS ||
+        (fieldCount != 0 && fields == NULL) || (kind != TM_KIND_TRACE && fieldCount == 0)) {
+        return LOS_NOK;
+    }
+    (VOID)LOS_MuxPend(g_mux, LOS_WAIT_FOREVER);
+    s = &g_streams[stream];
+    s->kind = kind;
+    s->name = name;
+    s->fields = fields;
+    s->fieldCount = fieldCount;
+    s->defined = (BuildMeta(s, g_payload) != 0);
+    if (s->defined) {
+        EmitMetaLocked(stream);
+    } else {
+        printf("[telemetry] stream %u meta exceeds %u bytes\n", stream, TM_PAYLOAD_MAX);
+        ret = LOS_NOK;
+    }
+    (VOID)LOS_MuxPost(g_mux);
+    return ret;
+}
+
+UINT32 TmSendCounters(UINT8 stream, const UINT32 *values, UINT32 n)
+{
+    UINT32 cols;
+    UINT32 len = 0;
+
+    if (values == NULL || n == 0 || !DataBegin(stream, TM_KIND_COUNTERS)) {
+        return LOS_NOK;
+    }
+    cols = g_streams[stream].fieldCount;
+    if (n % cols != 0) {
+        g_stats.rejected++;
+        (VOID)LOS_MuxPost(g_mux);
+        return LOS_NOK;
+    }
+    // 按行分帧，一行 (至多 TM_MAX_FIELDS 个变长整数) 总能放进一帧
+    for (UINT32 row = 0; row < n; row += cols) {
+        if (len + cols * TM_VARINT_MAX > TM_PAYLOAD_MAX) {
+            EmitLocked(TM_TYPE_COUNTERS, stream, 0, g_payload, len);
+            g_streams[stream].sinceMeta++;
+            len = 0;
+        }
+        for (UINT32 i = 0; i < cols; i++) {
+            len += PutVarint(&g_payload[len], values[row + i]);
+        }
+    }
+    EmitLocked(TM_TYPE_COUNTERS, stream, 0, g_payload, len);
+    g_streams[stream].sinceMeta++;
+    (VOID)LOS_MuxPost(g_mux);
+    return LOS_OK;
+}
+
+UINT32 TmSendHistogram(UINT8 stream, const UINT32 *counts, UINT32 n)
+{
+    UINT32 len = 0;
+
+    if (counts == NULL || !DataBegin(stream, TM_KIND_HISTOGRAM)) {
+        return LOS_NOK;
+    }
+    if (n != g_streams[stream].fieldCount) {
+        g_stats.rejected++;
+        (VOID)LOS_MuxPost(g_mux);
+        return LOS_NOK;
+    }
+    for (UINT32 i = 0; i < n; i++) {
+        len += PutVarint(&g_payload[len], counts[i]);
+    }
+    EmitLocked(TM_TYPE_HISTOGRAM, stream, 0, g_payload, len);
+    g_streams[stream].sinceMeta++;
+    (VOID)LOS_MuxPost(g_mux);
+    return LOS_OK;
+}
+
+UINT32 TmSendTrace(UINT8 stream, UINT32 offset, const VOID *data, UINT32 len)
+{
+    const UINT8 *p = (const UINT8 *)data;
+
+    if (data == NULL || !DataBegin(stream, TM_KIND_TRACE)) {
+        return LOS_NOK;
+    }
+    while (len != 0) {
+        UINT32 chunk = (len > TM_PAYLOAD_MAX - TM_TRACE_HDR) ? TM_PAYLOAD_MAX - TM_TRACE_HDR : len;
+        PutLe32(g_payload, offset);
+        (VOID)memcpy(&g_payload[TM_TRACE_HDR], p, chunk);
+        EmitLocked(TM_TYPE_TRACE, stream, 0, g_payload, TM_TRACE_HDR + chunk);
+        g_streams[stream].sinceMeta++;
+        p += chunk;
+        offset += chunk;
+        len -= chunk;
+    }
+    (VOID)LOS_MuxPost(g_mux);
+    return LOS_OK;
+}
+
+VOID TmEnable(BOOL enable)
+{
+    g_enabled = enable;
+}
+
+VOID TmStatsGet(TmStats *stats)
+{
+    if (!g_inited) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    (VOID)LOS_MuxPend(g_mux, LOS_WAIT_FOREVER);
+    *stats = g_stats;
+    (VOID)LOS_MuxPost(g_mux);
+}
+
+/* ================= shell 命令 ================= */
+
+static UINT32 TmCmd(UINT32 argc, const CHAR **argv)
+{
+    TmStats stats;
+
+    if (argc == 0 || strcmp(argv[0], "stats") == 0) {
+        TmStatsGet(&stats);
+        printf("%s, frames %u, payload %u bytes, line %u bytes, rejected %u\n",
+               g_enabled ? "on" : "off", stats.frames, stats.payloadBytes, stats.lineBytes, stats.rejected);
+        return LOS_OK;
+    }
+    if (strcmp(argv[0], "on") == 0 || strcmp(argv[0], "off") == 0) {
+        TmEnable(strcmp(argv[0], "on") == 0);
+        return LOS_OK;
+    }
+    if (strcmp(argv[0], "meta") == 0) {
+        // 主机端中途开始抓取时手动补发 HELLO 与全部 META
+        (VOID)LOS_MuxPend(g_mux, LOS_WAIT_FOREVER);
+        EmitHelloLocked(TM_FLAG_RESEND);
+        for (UINT8 i = 0; i < TM_MAX_STREAMS; i++) {
+            if (g_streams[i].defined) {
+                EmitMetaLocked(i);
+            }
+        }
+        (VOID)LOS_MuxPost(g_mux);
+        return LOS_OK;
+    }
+    printf("usage: telemetry [stats|on|off|meta]\n");
+    return LOS_NOK;
+}
+
+UINT32 TmInit(VOID)
+{
+    UINT32 ret;
+
+    if (g_inited) {
+        return LOS_OK;
+    }
+    ret = LOS_MuxCreate(&g_mux);
+    if (ret != LOS_OK) {
+        printf("[telemetry] mutex create failed: 0x%X\n", ret);
+        return ret;
+    }
+    g_inited = TRUE;
+    (VOID)LOS_MuxPend(g_mux, LOS_WAIT_FOREVER);
+    EmitHelloLocked(0);
+    (VOID)LOS_MuxPost(g_mux);
+    (VOID)osCmdReg(CMD_TYPE_EX, "telemetry", XARGS, (CmdCallBackFunc)TmCmd);
+    return LOS_OK;
+}
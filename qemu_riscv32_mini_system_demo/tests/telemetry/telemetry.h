@@ -0,0 +1,93 @@
+#ifndef APP_TELEMETRY_H
+#define APP_TELEMETRY_H
+
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 串口二进制遥测
+ * 计数器、直方图与 trace 片段打包成带序号和 CRC 的帧，与控制台文本共用串口：
+ * 每帧 base64 编码后作为一行 "#TM <base64>" 输出，控制台驱动的换行转换不会破坏帧，
+ * 其它任务的打印也只会整行穿插。主机端 tools/telemetry_decode.py 从串口日志中提取并校验，
+ * 输出 CSV 或 JSON，并按序号统计丢帧。
+ *
+ * 帧格式 (小端，编码前)：
+ *   u8 version | u8 type | u8 stream | u8 flags | u16 seq | u16 len | u32 tick | payload[len] | u16 crc
+ *   crc 为 CRC-16/CCITT (多项式 0x1021，初值 0xFFFF)，覆盖 crc 之前的全部字节
+ *   flags bit0 (TM_FLAG_RESEND) 只用于 HELLO：置位表示 "telemetry meta" 补发，不是目标重启
+ * payload：
+ *   HELLO      u32 clockHz, u16 tickHz, u16 payloadMax
+ *   META       u8 kind, u8 fieldCount, name\0, field\0 x fieldCount
+ *   COUNTERS   无符号 LEB128 x N，N 为 fieldCount 的整数倍，每 fieldCount 个值为一行
+ *   HISTOGRAM  无符号 LEB128 x fieldCount
+ *   TRACE      u32 offset, 原始字节
+ * 数据帧按流号引用 META 中的名字；META 每 TM_META_INTERVAL 个数据帧重发一次，中途开始的抓取也能解码。
+ * 只能在任务上下文中调用。
+ */
+
+#define TM_VERSION               1
+#define TM_LINE_PREFIX           "#TM "
+#define TM_PAYLOAD_MAX           192
+#define TM_MAX_STREAMS           16
+#define TM_MAX_FIELDS            32
+#define TM_META_INTERVAL         64
+#define TM_FLAG_RESEND           0x01
+
+typedef enum {
+    TM_TYPE_HELLO = 0,
+    TM_TYPE_META,
+    TM_TYPE_COUNTERS,
+    TM_TYPE_HISTOGRAM,
+    TM_TYPE_TRACE,
+} TmType;
+
+typedef enum {
+    TM_KIND_COUNTERS = 0,
+    TM_KIND_HISTOGRAM,
+    TM_KIND_TRACE,
+} TmKind;
+
+typedef struct {
+    UINT32 frames;
+    UINT32 payloadBytes;         // 编码前的负载字节数
+    UINT32 lineBytes;            // 实际写到串口的字节数 (含前缀与换行)
+    UINT32 rejected;             // 流未定义、类型不符或超长被拒绝的帧
+} TmStats;
+
+/**
+ * @brief 创建互斥锁、注册 shell 命令 telemetry 并发送 HELLO 帧，重复调用无副作用
+ */
+UINT32 TmInit(VOID);
+
+/**
+ * @brief 定义一个流并立即发送其 META 帧
+ * @param fields 列名 (直方图为桶标签)，须在流的整个生命周期内有效；TRACE 流可为 NULL
+ */
+UINT32 TmStreamDefine(UINT8 stream, TmKind kind, const CHAR *name, const CHAR *const *fields, UINT32 fieldCount);
+
+/**
+ * @brief 发送若干行计数器，n 须为该流列数的整数倍
+ */
+UINT32 TmSendCounters(UINT8 stream, const UINT32 *values, UINT32 n);
+
+UINT32 TmSendHistogram(UINT8 stream, const UINT32 *counts, UINT32 n);
+
+/**
+ * @brief 发送 trace 字节流，超过一帧时自动分片；offset 为本段在该流中的起始偏移
+ */
+UINT32 TmSendTrace(UINT8 stream, UINT32 offset, const VOID *data, UINT32 len);
+
+/**
+ * @brief 关闭后所有发送接口直接返回，便于在同一镜像中对比文本输出
+ */
+VOID TmEnable(BOOL enable);
+
+VOID TmStatsGet(TmStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,349 @@
+/*
+ * 文本表格与二进制遥测的串口字节数对比
+ * 三个周期性负载任务运行 REPORT_NUM 个 2 秒区间，每个区间结束时：
+ *   cpumon    同 vtcm 调度测试监控任务的表格 (名字、切入次数、区间运行微秒、区间与 10 秒占用)
+ *   idle_res  同 cpumon idle 的 idle 驻留分布
+ * 最后一个区间同时录制 sched_trace，结束后按 /data 转储文件的格式作为 trace 流发送，
+ * 与 SchedTraceDumpUart 的 "#ST R" 文本行比较。
+ * 文本只计算长度不打印 (第一个区间打印一次作对照)，遥测帧真实输出到串口，
+ * 主机端: tools/telemetry_decode.py <串口日志> -f csv --trace-dir <目录>
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+
+#include "cpu_monitor.h"
+#include "sched_trace.h"
+#include "telemetry.h"
+#include "telemetry_test.h"
+#include "test_assert.h"
+
+#define TASK_STACK_SIZE          0x1000
+#define CTRL_TASK_PRI            4
+#define WORKER_TASK_PRI          10
+
+#define WORKER_NUM               3
+#define REPORT_NUM               5
+#define REPORT_TICKS             (2 * LOSCFG_BASE_CORE_TICK_PER_SECOND)
+#define BURN_LOOPS               20000
+#define TRACE_CHUNK              32
+
+#define STREAM_CPUMON            1
+#define STREAM_IDLE              2
+#define STREAM_SCHED             3
+#define CPUMON_COLS              5
+
+typedef enum {
+    PART_TABLE = 0,
+    PART_HISTOGRAM,
+    PART_TRACE,
+    PART_NUM,
+} Part;
+
+typedef struct {
+    UINT32 textBytes;
+    UINT32 tmBytes;
+} PartBytes;
+
+static TestStats g_stats = { 0 };
+
+/* ================= 全局变量 ================= */
+static const CHAR *g_partNames[PART_NUM] = { "table", "histogram", "trace" };
+static const CHAR *const g_cpumonFields[CPUMON_COLS] = { "task", "switches", "run_us", "int_pm", "win10_pm" };
+static const CHAR *const g_idleLabels[CPU_MON_IDLE_BUCKETS] = {
+    "0-1", "1-2", "2-5", "5-10", "10-50", "50-100", ">=100"
+};
+
+static volatile BOOL g_running = FALSE;
+static volatile UINT32 g_alive = 0;
+static UINT32 g_workerIds[WORKER_NUM];
+static PartBytes g_bytes[PART_NUM];
+static BOOL g_echo = FALSE;
+
+static CpuMonSnapshot g_monPrev;
+static CpuMonSnapshot g_monNow;
+static CpuMonIdleResidency g_idlePrev;
+static SchedTraceRecord g_chunk[TRACE_CHUNK];
+
+/**
+ * @brief 文本输出的字节数；g_echo 为真时同时打印
+ */
+static UINT32 TextLen(const CHAR *fmt, ...)
+{
+    CHAR line[128];
+    va_list ap;
+    INT32 n;
+
+    va_start(ap, fmt);
+    n = vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+    if (g_echo) {
+        printf("%s", line);
+    }
+    return (n < 0) ? 0 : (UINT32)n;
+}
+
+static UINT32 TmLineBytes(VOID)
+{
+    TmStats stats;
+    TmStatsGet(&stats);
+    return stats.lineBytes;
+}
+
+static VOID BurnCpu(UINT32 loops)
+{
+    volatile UINT32 acc = 0;
+    for (UINT32 i = 0; i < loops; i++) {
+        acc += i;
+    }
+    (VOID)acc;
+}
+
+static VOID *WorkerEntry(UINTPTR arg)
+{
+    while (g_running) {
+        BurnCpu(BURN_LOOPS);
+        (VOID)LOS_TaskDelay(1 + (UINT32)arg);
+    }
+    UINT32 intSave = LOS_IntLock();
+    g_alive--;
+    LOS_IntRestore(intSave);
+    return NULL;
+}
+
+/* ================= 各类数据 ================= */
+
+static VOID ReportTable(VOID)
+{
+    UINT32 rows[WORKER_NUM * CPUMON_COLS];
+    UINT32 text = 0;
+    UINT32 before;
+
+    CpuMonSnapshotTake(&g_monNow);
+    text += TextLen("\n=== Scheduler Snapshot (Time: %llu ticks) ===\n", LOS_TickCountGet());
+    text += TextLen("%-10s | %-6s | %-8s | %-10s | %-6s | %-6s\n", "Name", "Type", "Switches", "RunUs", "Int%", "10s%");
+    text += TextLen("-----------|--------|----------|------------|--------|-------\n");
+    for (UINT32 i = 0; i < WORKER_NUM; i++) {
+        CpuMonTaskUsage usage;
+        UINT64 delta = 0;
+        UINT32 *row = &rows[i * CPUMON_COLS];
+        UINT32 interval = CpuMonIntervalUsage(&g_monPrev, &g_monNow, g_workerIds[i], &delta);
+        (VOID)CpuMonTaskUsageGet(g_workerIds[i], &usage);
+        row[0] = g_workerIds[i];
+        row[1] = usage.switchIns;
+        row[2] = (UINT32)(delta * 1000000ULL / OS_SYS_CLOCK);
+        row[3] = interval;
+        row[4] = usage.usage[CPU_MON_WIN_10S];
+        text += TextLen("%-10s | %-6s | %-8u | %-10u | %3u.%u%% | %3u.%u%%\n", "TmWorker", "Delay", row[1],
+                        row[2], row[3] / 10, row[3] % 10, row[4] / 10, row[4] % 10);
+    }
+    text += TextLen("System busy (1s): %u.%u%%\n", CpuMonSysUsage(CPU_MON_WIN_1S) / 10,
+                    CpuMonSysUsage(CPU_MON_WIN_1S) % 10);
+    text += TextLen("==========================================\n");
+    g_monPrev = g_monNow;
+
+    before = TmLineBytes();
+    (VOID)TmSendCounters(STREAM_CPUMON, rows, WORKER_NUM * CPUMON_COLS);
+    g_bytes[PART_TABLE].tmBytes += TmLineBytes() - before;
+    g_bytes[PART_TABLE].textBytes += text;
+}
+
+static VOID ReportIdle(VOID)
+{
+    CpuMonIdleResidency cur;
+    UINT32 counts[CPU_MON_IDLE_BUCKETS];
+    UINT64 total = 0;
+    UINT32 text = 0;
+    UINT32 before;
+
+    CpuMonIdleResidencyGet(&cur);
+    for (UINT32 b = 0; b < CPU_MON_IDLE_BUCKETS; b++) {
+        counts[b] = cur.count[b] - g_idlePrev.count[b];
+        total += cur.cycles[b] - g_idlePrev.cycles[b];
+    }
+    // 与 CpuMonIdleResidencyDump 的输出逐行对应
+    text += TextLen("%-12s %8s %12s %7s\n", "IdleTicks", "Count", "TimeUs", "Time%");
+    for (UINT32 b = 0; b < CPU_MON_IDLE_BUCKETS; b++) {
+        UINT64 cyc = cur.cycles[b] - g_idlePrev.cycles[b];
+        UINT32 pm = (total == 0) ? 0 : (UINT32)(cyc * 1000 / total);
+        text += TextLen("%-12s %8u %12u %3u.%u%%\n", g_idleLabels[b], counts[b],
+                        (UINT32)(cyc * 1000000ULL / OS_SYS_CLOCK), pm / 10, pm % 10);
+    }
+    text += TextLen("idle entries %u, avg %u us, longest %u us\n", cur.entries - g_idlePrev.entries,
+                    (UINT32)((cur.entries == g_idlePrev.entries) ? 0 :
+                             total * 1000000ULL / OS_SYS_CLOCK / (cur.entries - g_idlePrev.entries)),
+                    (UINT32)(cur.longest * 1000000ULL / OS_SYS_CLOCK));
+    g_idlePrev = cur;
+
+    before = TmLineBytes();
+    (VOID)TmSendHistogram(STREAM_IDLE, counts, CPU_MON_IDLE_BUCKETS);
+    g_bytes[PART_HISTOGRAM].tmBytes += TmLineBytes() - before;
+    g_bytes[PART_HISTOGRAM].textBytes += text;
+}
+
+/**
+ * @brief 读空 sched_trace，按转储文件格式 (头 + 记录，不含任务表) 发送
+ */
+static UINT32 ReportTrace(VOID)
+{
+    SchedTraceStats st;
+    SchedTraceFileHeader hdr;
+    UINT32 offset = 0;
+    UINT32 sent = 0;
+    UINT32 text = 0;
+    UINT32 before = TmLineBytes();
+    UINT32 n;
+
+    SchedTraceStatsGet(&st);
+    hdr.magic = SCHED_TRACE_MAGIC;
+    hdr.version = SCHED_TRACE_VERSION;
+    hdr.recordSize = sizeof(SchedTraceRecord);
+    hdr.clockHz = (UINT32)OS_SYS_CLOCK;
+    hdr.recordCount = st.pending;
+    hdr.dropped = st.dropped;
+    hdr.taskCount = 0;
+    (VOID)TmSendTrace(STREAM_SCHED, offset, &hdr, sizeof(hdr));
+    offset += sizeof(hdr);
+    text += TextLen("#ST BEGIN %u %u %u\n", SCHED_TRACE_VERSION, (UINT32)OS_SYS_CLOCK, st.dropped);
+
+    while (sent < hdr.recordCount) {
+        UINT32 want = hdr.recordCount - sent;
+        n = SchedTraceRead(g_chunk, (want > TRACE_CHUNK) ? TRACE_CHUNK : want);
+        if (n == 0) {
+            break;
+        }
+        for (UINT32 i = 0; i < n; i++) {
+            const SchedTraceRecord *r = &g_chunk[i];
+            text += TextLen("#ST R %llu %u %u %u %u %u\n", r->cycles, r->fromId, r->toId,
+                            r->reason, r->fromPrio, r->toPrio);
+        }
+        (VOID)TmSendTrace(STREAM_SCHED, offset, g_chunk, n * sizeof(SchedTraceRecord));
+        offset += n * sizeof(SchedTraceRecord);
+        sent += n;
+    }
+    text += TextLen("#ST END %u\n", sent);
+
+    g_bytes[PART_TRACE].tmBytes += TmLineBytes() - before;
+    g_bytes[PART_TRACE].textBytes += text;
+    return sent;
+}
+
+/* ================= 测试流程 ================= */
+
+static UINT32 StartWorkers(VOID)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 ret;
+
+    g_running = TRUE;
+    g_alive = 0;
+    for (UINT32 i = 0; i < WORKER_NUM; i++) {
+        param.pfnTaskEntry = (TSK_ENTRY_FUNC)WorkerEntry;
+        param.uwStackSize  = TASK_STACK_SIZE;
+        param.pcName       = "TmWorker";
+        param.usTaskPrio   = WORKER_TASK_PRI;
+        param.uwArg        = i;
+        ret = LOS_TaskCreate(&g_workerIds[i], &param);
+        if (ret != LOS_OK) {
+            printf("create worker %u failed: 0x%X\n", i, ret);
+            return ret;
+        }
+        g_alive++;
+    }
+    return LOS_OK;
+}
+
+static VOID *TelemetryTestTask(UINTPTR arg)
+{
+    UINT32 records;
+    TmStats tm;
+
+    (VOID)arg;
+    printf("\n>>> Serial Telemetry Test <<<\n");
+    if (CpuMonInit() != LOS_OK || SchedTraceInit() != LOS_OK || TmInit() != LOS_OK) {
+        printf("cpumon / schedtrace / telemetry init failed\n");
+        return NULL;
+    }
+    if (TmStreamDefine(STREAM_CPUMON, TM_KIND_COUNTERS, "cpumon", g_cpumonFields, CPUMON_COLS) != LOS_OK ||
+        TmStreamDefine(STREAM_IDLE, TM_KIND_HISTOGRAM, "idle_res", g_idleLabels, CPU_MON_IDLE_BUCKETS) != LOS_OK ||
+        TmStreamDefine(STREAM_SCHED, TM_KIND_TRACE, "sched", NULL, 0) != LOS_OK) {
+        printf("stream define failed\n");
+        return NULL;
+    }
+
+    memset(g_bytes, 0, sizeof(g_bytes));
+    CpuMonSnapshotTake(&g_monPrev);
+    CpuMonIdleResidencyGet(&g_idlePrev);
+    if (StartWorkers() != LOS_OK) {
+        g_running = FALSE;
+        return NULL;
+    }
+
+    for (UINT32 r = 0; r < REPORT_NUM; r++) {
+        if (r == REPORT_NUM - 1) {
+            SchedTraceStop();
+            SchedTraceReset();
+            SchedTraceStart();
+        }
+        (VOID)LOS_TaskDelay(REPORT_TICKS);
+        g_echo = (r == 0);
+        ReportTable();
+        ReportIdle();
+        g_echo = FALSE;
+    }
+    SchedTraceStop();
+    g_running = FALSE;
+    while (g_alive != 0) {
+        (VOID)LOS_TaskDelay(1);
+    }
+    records = ReportTrace();
+    TmStatsGet(&tm);
+
+    printf("\n%-10s | %-10s | %-10s | %s\n", "Part", "TextBytes", "TmBytes", "Ratio");
+    printf("-----------|------------|------------|-------\n");
+    for (UINT32 p = 0; p < PART_NUM; p++) {
+        const PartBytes *b = &g_bytes[p];
+        UINT32 x10 = (b->tmBytes == 0) ? 0 : b->textBytes * 10 / b->tmBytes;
+        printf("%-10s | %-10u | %-10u | %u.%ux\n", g_partNames[p], b->textBytes, b->tmBytes, x10 / 10, x10 % 10);
+    }
+    printf("%u trace records, %u frames, payload %u bytes, line %u bytes (base64 + prefix)\n",
+           records, tm.frames, tm.payloadBytes, tm.lineBytes);
+
+    // 便于脚本提取的单行结果；前缀不能是 "#TM "
+    for (UINT32 p = 0; p < PART_NUM; p++) {
+        printf("TELEM part=%s text_bytes=%u tm_bytes=%u\n", g_partNames[p], g_bytes[p].textBytes, g_bytes[p].tmBytes);
+    }
+
+    TEST_ASSERT(g_bytes[PART_TABLE].tmBytes * 4 <= g_bytes[PART_TABLE].textBytes, "监控表格的串口字节数降到 1/4 以下");
+    TEST_ASSERT(g_bytes[PART_HISTOGRAM].tmBytes * 4 <= g_bytes[PART_HISTOGRAM].textBytes,
+                "idle 分布的串口字节数降到 1/4 以下");
+    TEST_ASSERT(g_bytes[PART_TRACE].tmBytes < g_bytes[PART_TRACE].textBytes, "trace 帧小于等价的文本行");
+    TEST_ASSERT(tm.rejected == 0, "没有被拒绝的帧");
+
+    TEST_SUMMARY();
+    return NULL;
+}
+
+void TelemetryTestApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)TelemetryTestTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "TelemetryTestTask";
+    task.usTaskPrio   = CTRL_TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("TelemetryTestTask create failed: 0x%X\n", ret);
+    }
+}
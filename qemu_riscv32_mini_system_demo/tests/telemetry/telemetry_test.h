@@ -0,0 +1,13 @@
+#ifndef APP_TELEMETRY_TEST_H
+#define APP_TELEMETRY_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void TelemetryTestApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
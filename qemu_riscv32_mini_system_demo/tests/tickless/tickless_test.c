@@ -0,0 +1,374 @@
+/*
+ * 无节拍空闲与唤醒合并
+ * 取 vtcm 调度测试中的周期部分 (Monitor 每 2 秒报告、UrgentTask 每秒一次短计算)，
+ * 再加上若干会话超时定时器，分别以两种方式运行 RUN_SEC 秒：
+ *   ticked    Monitor / Urgent 用 LOS_TaskDelay 循环，会话定时器挂在每 tick 驱动的时间轮上
+ *   tickless  Monitor / Urgent 阻塞在事件上，由时间轮定时器唤醒；时间轮按下一事件一次性编程，
+ *             每个定时器带 slack，相近的到期合并为一次唤醒
+ * vtcm 测试中的 CPU-hog Worker 会让 idle 永远得不到运行，这里不包含它们。
+ * 由 cpu_monitor 统计除 idle 外的切入次数 (唤醒次数)、idle 占用与 idle 驻留分布。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+#include "los_interrupt.h"
+
+#include "cpu_monitor.h"
+#include "event_wake.h"
+#include "timer_wheel.h"
+#include "tickless_test.h"
+#include "test_assert.h"
+
+#define TASK_STACK_SIZE          0x1000
+#define CTRL_TASK_PRI            4
+#define MONITOR_TASK_PRI         3
+#define URGENT_TASK_PRI          5
+
+#define RUN_SEC                  10
+#define MONITOR_TICKS            (2 * LOSCFG_BASE_CORE_TICK_PER_SECOND)
+#define URGENT_TICKS             LOSCFG_BASE_CORE_TICK_PER_SECOND
+#define SESSION_NUM              8
+#define SESSION_BASE_TICKS       37
+#define SESSION_STEP_TICKS       5
+// 合并窗口：周期任务允许推迟 10%，会话超时允许推迟 SESSION_SLACK_TICKS
+#define PERIODIC_SLACK_PCT       10
+#define SESSION_SLACK_TICKS      15
+
+typedef enum {
+    MODE_TICKED = 0,
+    MODE_TICKLESS,
+    MODE_NUM,
+} TickMode;
+
+typedef struct {
+    UINT32 wakeups;
+    UINT32 driverRuns;
+    UINT32 idlePermille;
+    UINT32 idleEntries;
+    UINT32 idleAvgUs;
+    UINT32 idleLongTimePermille;   // 不短于 10 tick 的 idle 段占 idle 时间的比例
+    UINT32 reports;
+    UINT32 urgentRuns;
+    UINT32 sessionFires;
+} TickResult;
+
+static TestStats g_stats = { 0 };
+
+/* ================= 全局变量 ================= */
+static const CHAR *g_modeNames[MODE_NUM] = { "ticked", "tickless" };
+static volatile BOOL g_running = FALSE;
+static volatile UINT32 g_alive = 0;
+static TickResult g_res;
+
+static EvtWaiter g_monitorWaiter;
+static EvtWaiter g_urgentWaiter;
+static TwTimer g_monitorTimer;
+static TwTimer g_urgentTimer;
+static TwTimer g_sessions[SESSION_NUM];
+
+static CpuMonSnapshot g_snapBegin;
+static CpuMonSnapshot g_snapEnd;
+static UINT32 g_switchBegin[CPU_MON_MAX_TASKS];
+static CpuMonIdleResidency g_idleBegin;
+
+static VOID TaskExit(VOID)
+{
+    UINT32 intSave = LOS_IntLock();
+    g_alive--;
+    LOS_IntRestore(intSave);
+}
+
+static VOID BurnCpu(UINT32 intensity)
+{
+    volatile UINT32 res = 0;
+    for (UINT32 i = 0; i < intensity; i++) {
+        res += i * i;
+    }
+    (void)res;
+}
+
+/* ================= 定时器回调 ================= */
+
+static VOID SessionTimeout(VOID *arg)
+{
+    (VOID)arg;
+    g_res.sessionFires++;
+}
+
+static VOID SignalWaiter(VOID *arg)
+{
+    (VOID)EvtWaiterSignal((EvtWaiter *)arg, EVT_WAKE_PERIOD);
+}
+
+/* ================= 任务入口 ================= */
+
+static VOID *MonitorEntry(UINTPTR arg)
+{
+    TickMode mode = (TickMode)arg;
+
+    while (g_running) {
+        if (mode == MODE_TICKED) {
+            (VOID)LOS_TaskDelay(MONITOR_TICKS);
+        } else if ((EvtWaiterWait(&g_monitorWaiter, EVT_WAKE_PERIOD | EVT_WAKE_STOP, LOS_WAIT_FOREVER) &
+                    EVT_WAKE_STOP) != 0) {
+            break;
+        }
+        // 报告内容与调度测试相同，这里只计数，避免串口输出干扰 idle 统计
+        g_res.reports++;
+    }
+    TaskExit();
+    return NULL;
+}
+
+static VOID *UrgentEntry(UINTPTR arg)
+{
+    TickMode mode = (TickMode)arg;
+
+    while (g_running) {
+        if (mode == MODE_TICKED) {
+            (VOID)LOS_TaskDelay(URGENT_TICKS);
+        } else if ((EvtWaiterWait(&g_urgentWaiter, EVT_WAKE_PERIOD | EVT_WAKE_STOP, LOS_WAIT_FOREVER) &
+                    EVT_WAKE_STOP) != 0) {
+            break;
+        }
+        BurnCpu(1000);
+        g_res.urgentRuns++;
+    }
+    TaskExit();
+    return NULL;
+}
+
+/* ================= 测试流程 ================= */
+
+static UINT32 SpawnTask(const CHAR *name, TSK_ENTRY_FUNC entry, UINT16 prio, UINTPTR arg)
+{
+    TSK_INIT_PARAM_S param = { 0 };
+    UINT32 id;
+    UINT32 ret;
+
+    param.pfnTaskEntry = entry;
+    param.uwStackSize  = TASK_STACK_SIZE;
+    param.pcName       = (CHAR *)name;
+    param.usTaskPrio   = prio;
+    param.uwArg        = arg;
+    ret = LOS_TaskCreate(&id, &param);
+    if (ret != LOS_OK) {
+        printf("create %s failed: 0x%X\n", name, ret);
+        return ret;
+    }
+    g_alive++;
+    return LOS_OK;
+}
+
+static VOID MeasureBegin(VOID)
+{
+    CpuMonTaskUsage usage;
+
+    CpuMonSnapshotTake(&g_snapBegin);
+    CpuMonIdleResidencyGet(&g_idleBegin);
+    for (UINT32 id = 0; id < CPU_MON_MAX_TASKS; id++) {
+        g_switchBegin[id] = (CpuMonTaskUsageGet(id, &usage) == LOS_OK) ? usage.switchIns : 0;
+    }
+}
+
+static VOID MeasureEnd(TickResult *res)
+{
+    CpuMonTaskUsage usage;
+    CpuMonIdleResidency idle;
+    UINT64 idleCycles = 0;
+    UINT64 longCycles = 0;
+
+    CpuMonSnapshotTake(&g_snapEnd);
+    CpuMonIdleResidencyGet(&idle);
+    for (UINT32 id = 0; id < CPU_MON_MAX_TASKS; id++) {
+        if (id != g_idleTaskID && CpuMonTaskUsageGet(id, &usage) == LOS_OK) {
+            res->wakeups += usage.switchIns - g_switchBegin[id];
+        }
+    }
+    res->idlePermille = CpuMonIntervalUsage(&g_snapBegin, &g_snapEnd, g_idleTaskID, NULL);
+    res->idleEntries = idle.entries - g_idleBegin.entries;
+    for (UINT32 b = 0; b < CPU_MON_IDLE_BUCKETS; b++) {
+        UINT64 c = idle.cycles[b] - g_idleBegin.cycles[b];
+        idleCycles += c;
+        // 第 4 桶起为 >= 10 tick
+        if (b >= 3) {
+            longCycles += c;
+        }
+    }
+    if (res->idleEntries != 0) {
+        res->idleAvgUs = (UINT32)(idleCycles / res->idleEntries * 1000000ULL / OS_SYS_CLOCK);
+    }
+    if (idleCycles != 0) {
+        res->idleLongTimePermille = (UINT32)(longCycles * 1000 / idleCycles);
+    }
+}
+
+static UINT32 StartTimers(TickMode mode)
+{
+    UINT32 slack = (mode == MODE_TICKLESS) ? SESSION_SLACK_TICKS : 0;
+    UINT32 ret = LOS_OK;
+
+    for (UINT32 i = 0; i < SESSION_NUM; i++) {
+        UINT32 interval = SESSION_BASE_TICKS + i * SESSION_STEP_TICKS;
+        TwTimerInit(&g_sessions[i], SessionTimeout, NULL);
+        ret |= TwTimerStartSlack(&g_sessions[i], interval, interval, slack);
+    }
+    if (mode == MODE_TICKLESS) {
+        TwTimerInit(&g_monitorTimer, SignalWaiter, &g_monitorWaiter);
+        TwTimerInit(&g_urgentTimer, SignalWaiter, &g_urgentWaiter);
+        ret |= TwTimerStartSlack(&g_monitorTimer, MONITOR_TICKS, MONITOR_TICKS,
+                                 MONITOR_TICKS * PERIODIC_SLACK_PCT / 100);
+        ret |= TwTimerStartSlack(&g_urgentTimer, URGENT_TICKS, URGENT_TICKS,
+                                 URGENT_TICKS * PERIODIC_SLACK_PCT / 100);
+    }
+    return ret;
+}
+
+static VOID StopTimers(VOID)
+{
+    for (UINT32 i = 0; i < SESSION_NUM; i++) {
+        (VOID)TwTimerCancel(&g_sessions[i]);
+    }
+    (VOID)TwTimerCancel(&g_monitorTimer);
+    (VOID)TwTimerCancel(&g_urgentTimer);
+}
+
+static UINT32 RunMode(TickMode mode, TickResult *out)
+{
+    UINT32 ret;
+    TwStats tw;
+
+    memset(&g_res, 0, sizeof(g_res));
+    memset(&g_monitorTimer, 0, sizeof(g_monitorTimer));
+    memset(&g_urgentTimer, 0, sizeof(g_urgentTimer));
+    g_alive = 0;
+    g_running = TRUE;
+
+    ret = TwModeSet((mode == MODE_TICKLESS) ? TW_MODE_TICKLESS : TW_MODE_PERIODIC);
+    if (ret != LOS_OK) {
+        printf("TwModeSet failed\n");
+        return ret;
+    }
+    if (mode == MODE_TICKLESS) {
+        (VOID)EvtWaiterInit(&g_monitorWaiter);
+        (VOID)EvtWaiterInit(&g_urgentWaiter);
+    }
+
+    ret = SpawnTask("Monitor", (TSK_ENTRY_FUNC)MonitorEntry, MONITOR_TASK_PRI, (UINTPTR)mode);
+    ret |= SpawnTask("UrgentTask", (TSK_ENTRY_FUNC)UrgentEntry, URGENT_TASK_PRI, (UINTPTR)mode);
+    ret |= StartTimers(mode);
+
+    // 任务启动后的第一轮切换不计入
+    (VOID)LOS_TaskDelay(1);
+    TwStatsReset();
+    MeasureBegin();
+    (VOID)LOS_TaskDelay(RUN_SEC * LOSCFG_BASE_CORE_TICK_PER_SECOND);
+    MeasureEnd(&g_res);
+    TwStatsGet(&tw);
+    g_res.driverRuns = tw.driverRuns;
+
+    g_running = FALSE;
+    StopTimers();
+    if (mode == MODE_TICKLESS) {
+        (VOID)EvtWaiterSignal(&g_monitorWaiter, EVT_WAKE_STOP);
+        (VOID)EvtWaiterSignal(&g_urgentWaiter, EVT_WAKE_STOP);
+    }
+    while (g_alive != 0) {
+        (VOID)LOS_TaskDelay(1);
+    }
+    if (mode == MODE_TICKLESS) {
+        EvtWaiterDeinit(&g_monitorWaiter);
+        EvtWaiterDeinit(&g_urgentWaiter);
+    }
+
+    *out = g_res;
+    return ret;
+}
+
+static VOID *TicklessTestTask(UINTPTR arg)
+{
+    TickResult res[MODE_NUM];
+
+    (VOID)arg;
+    printf("\n>>> Tickless Idle / Wake-up Coalescing Test <<<\n");
+#ifdef LOSCFG_KERNEL_PM
+    printf("LOSCFG_KERNEL_PM: on\n");
+#else
+    printf("LOSCFG_KERNEL_PM: off (residency still measured, idle stays in WFI)\n");
+#endif
+    printf("monitor %u ticks, urgent %u ticks, %u sessions %u..%u ticks, slack %u%% / %u ticks\n",
+           MONITOR_TICKS, URGENT_TICKS, SESSION_NUM, SESSION_BASE_TICKS,
+           SESSION_BASE_TICKS + (SESSION_NUM - 1) * SESSION_STEP_TICKS, PERIODIC_SLACK_PCT, SESSION_SLACK_TICKS);
+    if (CpuMonInit() != LOS_OK || TwInit() != LOS_OK) {
+        return NULL;
+    }
+
+    for (UINT32 m = 0; m < MODE_NUM; m++) {
+        if (RunMode((TickMode)m, &res[m]) != LOS_OK) {
+            printf("mode %s setup failed\n", g_modeNames[m]);
+            return NULL;
+        }
+        printf("\n[%s] idle residency:\n", g_modeNames[m]);
+        CpuMonIdleResidencyDump(&g_idleBegin);
+    }
+    (VOID)TwModeSet(TW_MODE_PERIODIC);
+
+    printf("\n%-9s | %-10s | %-10s | %-7s | %-10s | %-10s | %-7s | %-7s | %-8s\n",
+           "Mode", "Wakeups/s", "Driver/s", "Idle", "IdleAvgUs", "Idle>=10t", "Reports", "Urgent", "Sessions");
+    printf("----------|------------|------------|---------|------------|------------|---------|---------|---------\n");
+    for (UINT32 m = 0; m < MODE_NUM; m++) {
+        const TickResult *r = &res[m];
+        printf("%-9s | %-10u | %-10u | %3u.%u%% | %-10u | %6u.%u%% | %-7u | %-7u | %-8u\n",
+               g_modeNames[m], r->wakeups / RUN_SEC, r->driverRuns / RUN_SEC,
+               r->idlePermille / 10, r->idlePermille % 10, r->idleAvgUs,
+               r->idleLongTimePermille / 10, r->idleLongTimePermille % 10,
+               r->reports, r->urgentRuns, r->sessionFires);
+    }
+    // 便于脚本提取的单行结果
+    for (UINT32 m = 0; m < MODE_NUM; m++) {
+        const TickResult *r = &res[m];
+        printf("TICKLESS mode=%s run_s=%u wakeups=%u driver_runs=%u idle_permille=%u idle_entries=%u "
+               "idle_avg_us=%u idle_long_permille=%u\n",
+               g_modeNames[m], RUN_SEC, r->wakeups, r->driverRuns, r->idlePermille, r->idleEntries,
+               r->idleAvgUs, r->idleLongTimePermille);
+    }
+
+    const TickResult *ticked = &res[MODE_TICKED];
+    const TickResult *tickless = &res[MODE_TICKLESS];
+    UINT32 minSessionFires = 0;
+    for (UINT32 i = 0; i < SESSION_NUM; i++) {
+        UINT32 interval = SESSION_BASE_TICKS + i * SESSION_STEP_TICKS;
+        // slack 最多让每个周期推迟 SESSION_SLACK_TICKS，但周期按名义时刻累加，长期次数不减少
+        minSessionFires += RUN_SEC * LOSCFG_BASE_CORE_TICK_PER_SECOND / interval - 1;
+    }
+    TEST_ASSERT(tickless->wakeups < ticked->wakeups, "无节拍模式唤醒次数更少");
+    TEST_ASSERT(tickless->idleAvgUs > ticked->idleAvgUs, "无节拍模式 idle 平均驻留更长");
+    TEST_ASSERT(tickless->sessionFires >= minSessionFires, "合并后会话超时次数不减少");
+    TEST_ASSERT(tickless->reports + 1 >= ticked->reports && tickless->urgentRuns + 1 >= ticked->urgentRuns,
+                "周期任务运行次数一致");
+
+    TEST_SUMMARY();
+    return NULL;
+}
+
+void TicklessTestApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)TicklessTestTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "TicklessTestTask";
+    task.usTaskPrio   = CTRL_TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("TicklessTestTask create failed: 0x%X\n", ret);
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef APP_TICKLESS_TEST_H
+#define APP_TICKLESS_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void TicklessTestApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
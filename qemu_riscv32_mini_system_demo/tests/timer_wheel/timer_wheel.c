@@ -0,0 +1,380 @@
+/*
+ * 分层时间轮
+ * 每个槽是一条以 pprev 回指的单向链表 (同 hlist)，节点自带删除所需的全部信息。
+ * g_now 是下一个待处理的 tick；处理 g_now 时若第 0 级索引回绕到 0，先把上一级对应槽整体下移。
+ * 无节拍模式下 g_now 只在驱动醒来时追到当前 tick，中间空 tick 的推进只做一次索引判断。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_interrupt.h"
+#include "cmsis_os2.h"
+
+#include "timer_wheel.h"
+
+/* ================= 全局变量 ================= */
+static TwTimer *g_slots[TW_LEVELS][TW_SLOTS];
+// 当前 tick 已摘下、尚未回调的定时器；回调中取消它们同样有效
+static TwTimer *g_expired = NULL;
+static UINT64 g_now = 0;
+static TwStats g_stats;
+static osTimerId_t g_driver = NULL;
+static BOOL g_driverRunning = FALSE;
+static TwMode g_mode = TW_MODE_PERIODIC;
+// 无节拍模式下驱动定时器已编程的唤醒时刻
+static UINT64 g_deadline = 0;
+
+/* ================= 链表与放置 ================= */
+
+static inline VOID ListAdd(TwTimer **head, TwTimer *t)
+{
+    t->next = *head;
+    if (*head != NULL) {
+        (*head)->pprev = &t->next;
+    }
+    *head = t;
+    t->pprev = head;
+}
+
+static inline VOID ListDel(TwTimer *t)
+{
+    *t->pprev = t->next;
+    if (t->next != NULL) {
+        t->next->pprev = t->pprev;
+    }
+    t->next = NULL;
+    t->pprev = NULL;
+}
+
+static VOID Place(TwTimer *t)
+{
+    UINT64 delta;
+    UINT32 level = 0;
+
+    if (t->expires < g_now) {
+        t->expires = g_now;
+    }
+    delta = t->expires - g_now;
+    if (delta > TW_MAX_DELAY) {
+        delta = TW_MAX_DELAY;
+        t->expires = g_now + TW_MAX_DELAY;
+    }
+    while (level < TW_LEVELS - 1 && delta >= ((UINT64)1 << (TW_SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    ListAdd(&g_slots[level][(t->expires >> (TW_SLOT_BITS * level)) & TW_SLOT_MASK], t);
+}
+
+/**
+ * @brief 在 [t, t + slack] 内取最低位尽量多为 0 的时刻，slack 相近的定时器落到同一边界
+ */
+static UINT64 Coalesce(UINT64 t, UINT32 slack)
+{
+    UINT64 align = 1;
+
+    if (slack == 0) {
+        return t;
+    }
+    while (align * 2 <= (UINT64)slack + 1) {
+        align *= 2;
+    }
+    return (t + slack) & ~(align - 1);
+}
+
+/**
+ * @brief 下一个需要驱动醒来的 tick：第 0 级最近的非空槽，或高层最近一个非空槽的下移时刻
+ *        没有挂起的定时器时返回 0
+ */
+static UINT64 NextEvent(VOID)
+{
+    UINT64 best = 0;
+
+    for (UINT32 level = 0; level < TW_LEVELS; level++) {
+        UINT32 shift = TW_SLOT_BITS * level;
+        // 该层第一个不早于 g_now 的处理 / 下移时刻
+        UINT64 m = (g_now + ((UINT64)1 << shift) - 1) >> shift;
+        for (UINT32 k = 0; k < TW_SLOTS; k++, m++) {
+            if (g_slots[level][m & TW_SLOT_MASK] != NULL) {
+                UINT64 when = m << shift;
+                if (best == 0 || when < best) {
+                    best = when;
+                }
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief 无节拍模式下把驱动定时器编程到 when；调用方持有中断锁
+ * 启动失败时驱动不再视为运行，下一次 TwTimerStart 会重新编程，而不是以为旧的截止时刻仍然有效
+ */
+static VOID ProgramDriver(UINT64 when)
+{
+    UINT64 tick = LOS_TickCountGet();
+    UINT32 delay = (when > tick) ? (UINT32)(when - tick) : 1;
+
+    if (osTimerStart(g_driver, delay) == osOK) {
+        g_driverRunning = TRUE;
+        g_deadline = tick + delay;
+    } else {
+        g_driverRunning = FALSE;
+    }
+}
+
+/* ================= 推进与分发 ================= */
+
+static UINT32 Cascade(UINT32 level, UINT32 idx)
+{
+    TwTimer *list = g_slots[level][idx];
+    UINT32 moved = 0;
+
+    g_slots[level][idx] = NULL;
+    while (list != NULL) {
+        TwTimer *t = list;
+        list = t->next;
+        Place(t);
+        moved++;
+    }
+    return moved;
+}
+
+static VOID Dispatch(VOID)
+{
+    UINT32 batch = 0;
+    UINT32 intSave;
+
+    while (1) {
+        intSave = LOS_IntLock();
+        TwTimer *t = g_expired;
+        if (t == NULL) {
+            LOS_IntRestore(intSave);
+            break;
+        }
+        ListDel(t);
+        g_stats.active--;
+        g_stats.fired++;
+        if (t->interval != 0) {
+            // 按上一次名义到期时刻累加，避免分发延迟与 slack 对齐累积成漂移
+            t->nominal += t->interval;
+            t->expires = Coalesce(t->nominal, t->slack);
+            Place(t);
+            g_stats.active++;
+        }
+        TwCallback fn = t->fn;
+        VOID *arg = t->arg;
+        LOS_IntRestore(intSave);
+
+        batch++;
+        fn(arg);
+    }
+    if (batch != 0) {
+        g_stats.dispatches++;
+        if (batch > g_stats.maxBatch) {
+            g_stats.maxBatch = batch;
+        }
+    }
+}
+
+static VOID Step(VOID)
+{
+    UINT32 intSave = LOS_IntLock();
+    UINT32 idx = (UINT32)(g_now & TW_SLOT_MASK);
+
+    if (idx == 0) {
+        UINT64 start = LOS_SysCycleGet();
+        for (UINT32 level = 1; level < TW_LEVELS; level++) {
+            UINT32 upper = (UINT32)((g_now >> (TW_SLOT_BITS * level)) & TW_SLOT_MASK);
+            g_stats.cascaded += Cascade(level, upper);
+            if (upper != 0) {
+                break;
+            }
+        }
+        g_stats.cascadeCycles += LOS_SysCycleGet() - start;
+    }
+    // 整槽摘下挂到 g_expired，随后一次分发
+    TwTimer *list = g_slots[0][idx];
+    g_slots[0][idx] = NULL;
+    while (list != NULL) {
+        TwTimer *t = list;
+        list = t->next;
+        ListAdd(&g_expired, t);
+    }
+    g_now++;
+    LOS_IntRestore(intSave);
+}
+
+static VOID TwDriver(VOID *arg)
+{
+    UINT64 target = LOS_TickCountGet();
+    UINT32 intSave;
+
+    (VOID)arg;
+    // 软件定时器任务被推迟时一次补齐落下的 tick
+    while (g_now <= target) {
+        Step();
+        if (g_expired != NULL) {
+            UINT64 start = LOS_SysCycleGet();
+            Dispatch();
+            g_stats.dispatchCycles += LOS_SysCycleGet() - start;
+        }
+    }
+
+    intSave = LOS_IntLock();
+    g_stats.driverRuns++;
+    if (g_stats.active == 0) {
+        if (g_driverRunning) {
+            g_driverRunning = FALSE;
+            (VOID)osTimerStop(g_driver);
+        }
+    } else if (g_mode == TW_MODE_TICKLESS) {
+        ProgramDriver(NextEvent());
+    }
+    LOS_IntRestore(intSave);
+}
+
+static osTimerId_t DriverCreate(TwMode mode)
+{
+    return osTimerNew((osTimerFunc_t)TwDriver, (mode == TW_MODE_TICKLESS) ? osTimerOnce : osTimerPeriodic,
+                      NULL, NULL);
+}
+
+/* ================= 对外接口 ================= */
+
+UINT32 TwInit(VOID)
+{
+    if (g_driver != NULL) {
+        return LOS_OK;
+    }
+    g_driver = DriverCreate(g_mode);
+    if (g_driver == NULL) {
+        printf("[timerwheel] driver timer create failed\n");
+        return LOS_NOK;
+    }
+    g_now = LOS_TickCountGet();
+    return LOS_OK;
+}
+
+UINT32 TwModeSet(TwMode mode)
+{
+    osTimerId_t driver;
+    UINT32 intSave;
+
+    if (g_driver == NULL || mode == g_mode) {
+        g_mode = mode;
+        return LOS_OK;
+    }
+    intSave = LOS_IntLock();
+    if (g_stats.active != 0 || g_expired != NULL) {
+        LOS_IntRestore(intSave);
+        return LOS_NOK;
+    }
+    (VOID)osTimerStop(g_driver);
+    g_driverRunning = FALSE;
+    driver = g_driver;
+    g_driver = NULL;
+    LOS_IntRestore(intSave);
+
+    (VOID)osTimerDelete(driver);
+    g_mode = mode;
+    g_driver = DriverCreate(mode);
+    return (g_driver != NULL) ? LOS_OK : LOS_NOK;
+}
+
+VOID TwTimerInit(TwTimer *t, TwCallback fn, VOID *arg)
+{
+    memset(t, 0, sizeof(*t));
+    t->fn = fn;
+    t->arg = arg;
+}
+
+UINT32 TwTimerStartSlack(TwTimer *t, UINT32 delayTicks, UINT32 intervalTicks, UINT32 slackTicks)
+{
+    UINT32 ret = LOS_OK;
+    UINT32 intSave;
+
+    if (t == NULL || t->fn == NULL || g_driver == NULL) {
+        return LOS_NOK;
+    }
+    if (delayTicks == 0) {
+        delayTicks = 1;
+    }
+
+    intSave = LOS_IntLock();
+    if (t->pprev != NULL) {
+        ListDel(t);
+        g_stats.active--;
+    }
+    if (!g_driverRunning && g_stats.active == 0 && g_expired == NULL) {
+        // 时间轮为空时可以直接对齐到当前 tick
+        g_now = LOS_TickCountGet();
+    }
+    // 以内核 tick 为基准；驱动落后时 Place 按 g_now 计算层级，到期时刻不变
+    t->nominal = LOS_TickCountGet() + delayTicks;
+    t->expires = Coalesce(t->nominal, slackTicks);
+    t->interval = intervalTicks;
+    t->slack = slackTicks;
+    Place(t);
+    g_stats.active++;
+
+    if (g_mode == TW_MODE_TICKLESS) {
+        if (!g_driverRunning || t->expires < g_deadline) {
+            ProgramDriver(t->expires);
+        }
+    } else if (!g_driverRunning) {
+        if (osTimerStart(g_driver, 1) == osOK) {
+            g_driverRunning = TRUE;
+        }
+    }
+    if (!g_driverRunning) {
+        ListDel(t);
+        g_stats.active--;
+        ret = LOS_NOK;
+    }
+    LOS_IntRestore(intSave);
+    return ret;
+}
+
+UINT32 TwTimerStart(TwTimer *t, UINT32 delayTicks, UINT32 intervalTicks)
+{
+    return TwTimerStartSlack(t, delayTicks, intervalTicks, 0);
+}
+
+BOOL TwTimerCancel(TwTimer *t)
+{
+    BOOL pending = FALSE;
+    UINT32 intSave = LOS_IntLock();
+
+    if (t->pprev != NULL) {
+        ListDel(t);
+        g_stats.active--;
+        pending = TRUE;
+    }
+    LOS_IntRestore(intSave);
+    return pending;
+}
+
+BOOL TwTimerPending(const TwTimer *t)
+{
+    return t->pprev != NULL;
+}
+
+VOID TwStatsGet(TwStats *stats)
+{
+    UINT32 intSave = LOS_IntLock();
+    *stats = g_stats;
+    LOS_IntRestore(intSave);
+}
+
+VOID TwStatsReset(VOID)
+{
+    UINT32 intSave = LOS_IntLock();
+    UINT32 active = g_stats.active;
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_stats.active = active;
+    LOS_IntRestore(intSave);
+}
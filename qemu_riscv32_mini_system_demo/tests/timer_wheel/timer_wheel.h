@@ -0,0 +1,94 @@
+#ifndef APP_TIMER_WHEEL_H
+#define APP_TIMER_WHEEL_H
+
+#include "los_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 分层时间轮
+ * 4 级、每级 64 槽，第 n 级一个槽覆盖 64^n 个 tick，最长定时 64^4 - 1 tick，超出部分按最长值处理。
+ * 定时器节点由调用者提供 (内嵌在会话 / 对象结构体中)，插入与取消都是 O(1) 链表操作，不分配内存。
+ * 整个时间轮只用一个内核软件定时器驱动；没有挂起的定时器时该软件定时器停止，不产生空唤醒。
+ * 同一 tick 到期的定时器先整体摘下，再在一次分发中依次回调。
+ * TW_MODE_TICKLESS 下驱动定时器改为一次性，每次只在下一个到期 (或高层槽下移) 时刻醒来，
+ * 内核据此把下一次唤醒写入 CLINT 比较寄存器，空闲期间没有周期 tick；
+ * 配合每个定时器的 slack 把到期时刻对齐到 2 的幂边界，相近的唤醒合并为一次。
+ * 回调运行在软件定时器任务中，不能阻塞；回调内可以重新启动或取消任意定时器。
+ */
+
+#define TW_LEVELS                4
+#define TW_SLOT_BITS             6
+#define TW_SLOTS                 (1U << TW_SLOT_BITS)
+#define TW_SLOT_MASK             (TW_SLOTS - 1)
+#define TW_MAX_DELAY             ((1U << (TW_LEVELS * TW_SLOT_BITS)) - 1)
+
+typedef enum {
+    TW_MODE_PERIODIC = 0,        // 驱动定时器每 tick 运行一次
+    TW_MODE_TICKLESS,            // 驱动定时器按下一事件一次性编程
+} TwMode;
+
+typedef VOID (*TwCallback)(VOID *arg);
+
+typedef struct TwTimer {
+    struct TwTimer *next;
+    struct TwTimer **pprev;      // 指向前一节点的 next (或槽头)，NULL 表示未挂起
+    UINT64 expires;              // 到期时刻 (时间轮 tick)
+    UINT64 nominal;              // 未按 slack 对齐的到期时刻，周期定时器以此累加
+    UINT32 interval;             // 非 0 时到期后按该周期自动重启
+    UINT32 slack;                // 允许推迟的 tick 数
+    TwCallback fn;
+    VOID *arg;
+} TwTimer;
+
+typedef struct {
+    UINT32 active;               // 当前挂起的定时器数
+    UINT32 fired;
+    UINT32 cascaded;             // 从高层槽下移的次数
+    UINT32 dispatches;           // 至少有一个定时器到期的 tick 数
+    UINT32 maxBatch;             // 单个 tick 内到期的最大数量
+    UINT64 dispatchCycles;       // 分发 (摘链 + 回调) 累计周期
+    UINT64 cascadeCycles;        // 下移累计周期
+    UINT32 driverRuns;           // 驱动定时器回调次数 (即时间轮引起的唤醒)
+} TwStats;
+
+/**
+ * @brief 创建驱动用的软件定时器，重复调用无副作用
+ */
+UINT32 TwInit(VOID);
+
+/**
+ * @brief 切换驱动方式，只能在没有挂起定时器时调用
+ */
+UINT32 TwModeSet(TwMode mode);
+
+VOID TwTimerInit(TwTimer *t, TwCallback fn, VOID *arg);
+
+/**
+ * @brief delayTicks 后到期；已挂起时先取消再按新的时间重新插入
+ * @param intervalTicks 0 为一次性，非 0 为周期
+ */
+UINT32 TwTimerStart(TwTimer *t, UINT32 delayTicks, UINT32 intervalTicks);
+
+/**
+ * @brief 同 TwTimerStart，到期时刻可推迟至多 slackTicks，以便与其他定时器合并
+ */
+UINT32 TwTimerStartSlack(TwTimer *t, UINT32 delayTicks, UINT32 intervalTicks, UINT32 slackTicks);
+
+/**
+ * @brief 取消定时器，返回取消前是否处于挂起状态
+ */
+BOOL TwTimerCancel(TwTimer *t);
+
+BOOL TwTimerPending(const TwTimer *t);
+
+VOID TwStatsGet(TwStats *stats);
+
+VOID TwStatsReset(VOID);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,282 @@
+/*
+ * 时间轮插入 / 取消 / 到期开销
+ * 分别挂起 10、1000、10000 个定时器 (到期时间在 1..SPREAD_TICKS 内伪随机分布，覆盖第 0、1 级与下移)：
+ *   insert  全部插入的平均周期
+ *   cancel  全部取消的平均周期
+ *   expire  重新插入后等待全部到期，(下移 + 分发) 周期除以到期个数
+ * 10 个定时器时同时测内核软件定时器 (osTimerStart / osTimerStop) 作为参照，
+ * 内核软件定时器数量受 LOSCFG_BASE_CORE_SWTMR_LIMIT 限制，更大规模无法对比。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ohos_init.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_config.h"
+#include "cmsis_os2.h"
+
+#include "timer_wheel.h"
+#include "timer_wheel_bench.h"
+#include "test_assert.h"
+
+#define TASK_STACK_SIZE          0x1000
+#define CTRL_TASK_PRI            4
+
+#define SPREAD_TICKS             300
+#define EXPIRE_TIMEOUT_TICKS     (SPREAD_TICKS + 2 * LOSCFG_BASE_CORE_TICK_PER_SECOND)
+#define SWTMR_COMPARE_NUM        10
+
+static const UINT32 g_sizes[] = { 10, 1000, 10000 };
+#define SIZE_NUM                 (sizeof(g_sizes) / sizeof(g_sizes[0]))
+
+typedef struct {
+    TwTimer tw;
+    UINT64 due;                  // 期望到期的内核 tick
+} BenchTimer;
+
+typedef struct {
+    UINT32 count;
+    BOOL skipped;
+    UINT32 insertCyc;
+    UINT32 cancelCyc;
+    UINT32 expireCyc;
+    UINT32 fired;
+    UINT32 early;
+    UINT32 maxLateTicks;
+    UINT32 maxBatch;
+    UINT32 cascaded;
+} WheelResult;
+
+static TestStats g_stats = { 0 };
+
+/* ================= 全局变量 ================= */
+static volatile UINT32 g_fired = 0;
+static UINT32 g_early = 0;
+static UINT32 g_maxLate = 0;
+static UINT32 g_seed = 1;
+
+static UINT32 NextRand(VOID)
+{
+    g_seed = g_seed * 1103515245U + 12345U;
+    return g_seed >> 8;
+}
+
+static VOID BenchCallback(VOID *arg)
+{
+    BenchTimer *bt = (BenchTimer *)arg;
+    UINT64 now = LOS_TickCountGet();
+
+    if (now < bt->due) {
+        g_early++;
+    } else if (now - bt->due > g_maxLate) {
+        g_maxLate = (UINT32)(now - bt->due);
+    }
+    g_fired++;
+}
+
+/* ================= 时间轮 ================= */
+
+static UINT64 InsertAll(BenchTimer *timers, UINT32 n, const UINT32 *delays)
+{
+    UINT64 start = LOS_SysCycleGet();
+    for (UINT32 i = 0; i < n; i++) {
+        (VOID)TwTimerStart(&timers[i].tw, delays[i], 0);
+    }
+    return LOS_SysCycleGet() - start;
+}
+
+static UINT32 RunWheel(UINT32 n, WheelResult *res)
+{
+    BenchTimer *timers = (BenchTimer *)malloc(n * sizeof(BenchTimer));
+    UINT32 *delays = (UINT32 *)malloc(n * sizeof(UINT32));
+    TwStats stats;
+    UINT64 cycles;
+
+    memset(res, 0, sizeof(*res));
+    res->count = n;
+    if (timers == NULL || delays == NULL) {
+        printf("n=%u: out of memory (%u bytes), skipped\n", n, n * (UINT32)(sizeof(BenchTimer) + sizeof(UINT32)));
+        free(timers);
+        free(delays);
+        res->skipped = TRUE;
+        return LOS_OK;
+    }
+    g_seed = n;
+    for (UINT32 i = 0; i < n; i++) {
+        TwTimerInit(&timers[i].tw, BenchCallback, &timers[i]);
+        delays[i] = 1 + NextRand() % SPREAD_TICKS;
+    }
+
+    // 插入与取消在锁调度下计时，避免驱动定时器的分发混入
+    LOS_TaskLock();
+    cycles = InsertAll(timers, n, delays);
+    res->insertCyc = (UINT32)(cycles / n);
+    cycles = LOS_SysCycleGet();
+    for (UINT32 i = 0; i < n; i++) {
+        (VOID)TwTimerCancel(&timers[i].tw);
+    }
+    res->cancelCyc = (UINT32)((LOS_SysCycleGet() - cycles) / n);
+    LOS_TaskUnlock();
+
+    // 到期：记录每个定时器期望的 tick 后插入，等待全部回调
+    g_fired = 0;
+    g_early = 0;
+    g_maxLate = 0;
+    TwStatsReset();
+    LOS_TaskLock();
+    UINT64 base = LOS_TickCountGet();
+    for (UINT32 i = 0; i < n; i++) {
+        timers[i].due = base + delays[i];
+    }
+    (VOID)InsertAll(timers, n, delays);
+    LOS_TaskUnlock();
+
+    UINT64 deadline = LOS_TickCountGet() + EXPIRE_TIMEOUT_TICKS;
+    while (g_fired < n && LOS_TickCountGet() < deadline) {
+        (VOID)LOS_TaskDelay(LOSCFG_BASE_CORE_TICK_PER_SECOND / 10);
+    }
+    TwStatsGet(&stats);
+    for (UINT32 i = 0; i < n; i++) {
+        (VOID)TwTimerCancel(&timers[i].tw);
+    }
+
+    res->fired = g_fired;
+    res->early = g_early;
+    res->maxLateTicks = g_maxLate;
+    res->maxBatch = stats.maxBatch;
+    res->cascaded = stats.cascaded;
+    if (stats.fired != 0) {
+        res->expireCyc = (UINT32)((stats.dispatchCycles + stats.cascadeCycles) / stats.fired);
+    }
+    free(timers);
+    free(delays);
+    return LOS_OK;
+}
+
+/* ================= 内核软件定时器参照 ================= */
+
+static VOID SwtmrCallback(VOID *arg)
+{
+    (VOID)arg;
+}
+
+static VOID RunSwtmr(UINT32 *insertCyc, UINT32 *cancelCyc)
+{
+    osTimerId_t ids[SWTMR_COMPARE_NUM];
+    UINT32 created = 0;
+    UINT64 start;
+
+    *insertCyc = 0;
+    *cancelCyc = 0;
+    for (; created < SWTMR_COMPARE_NUM; created++) {
+        ids[created] = osTimerNew((osTimerFunc_t)SwtmrCallback, osTimerOnce, NULL, NULL);
+        if (ids[created] == NULL) {
+            break;
+        }
+    }
+    if (created != 0) {
+        LOS_TaskLock();
+        start = LOS_SysCycleGet();
+        for (UINT32 i = 0; i < created; i++) {
+            (VOID)osTimerStart(ids[i], 1 + i * SPREAD_TICKS / SWTMR_COMPARE_NUM);
+        }
+        *insertCyc = (UINT32)((LOS_SysCycleGet() - start) / created);
+        start = LOS_SysCycleGet();
+        for (UINT32 i = 0; i < created; i++) {
+            (VOID)osTimerStop(ids[i]);
+        }
+        *cancelCyc = (UINT32)((LOS_SysCycleGet() - start) / created);
+        LOS_TaskUnlock();
+    }
+    for (UINT32 i = 0; i < created; i++) {
+        (VOID)osTimerDelete(ids[i]);
+    }
+    if (created < SWTMR_COMPARE_NUM) {
+        printf("only %u kernel software timers available\n", created);
+    }
+}
+
+/* ================= 测试流程 ================= */
+
+static VOID *TimerWheelBenchTask(UINTPTR arg)
+{
+    WheelResult results[SIZE_NUM];
+    UINT32 swInsert;
+    UINT32 swCancel;
+
+    (VOID)arg;
+    printf("\n>>> Timer Wheel Benchmark <<<\n");
+    printf("%u levels x %u slots, delays 1..%u ticks, cycles at %u Hz\n",
+           TW_LEVELS, TW_SLOTS, SPREAD_TICKS, (UINT32)OS_SYS_CLOCK);
+    if (TwInit() != LOS_OK) {
+        return NULL;
+    }
+
+    for (UINT32 i = 0; i < SIZE_NUM; i++) {
+        (VOID)RunWheel(g_sizes[i], &results[i]);
+    }
+    RunSwtmr(&swInsert, &swCancel);
+
+    printf("\n%-8s | %-7s | %-10s | %-10s | %-10s | %-8s | %-8s | %-8s\n",
+           "Impl", "Timers", "InsertCyc", "CancelCyc", "ExpireCyc", "MaxBatch", "Cascaded", "MaxLate");
+    printf("---------|---------|------------|------------|------------|----------|----------|---------\n");
+    for (UINT32 i = 0; i < SIZE_NUM; i++) {
+        const WheelResult *r = &results[i];
+        if (r->skipped) {
+            printf("%-8s | %-7u | skipped\n", "wheel", r->count);
+            continue;
+        }
+        printf("%-8s | %-7u | %-10u | %-10u | %-10u | %-8u | %-8u | %-8u\n", "wheel", r->count,
+               r->insertCyc, r->cancelCyc, r->expireCyc, r->maxBatch, r->cascaded, r->maxLateTicks);
+    }
+    printf("%-8s | %-7u | %-10u | %-10u | %-10s | %-8s | %-8s | %-8s\n", "swtmr", SWTMR_COMPARE_NUM,
+           swInsert, swCancel, "-", "-", "-", "-");
+
+    // 便于脚本提取的单行结果
+    for (UINT32 i = 0; i < SIZE_NUM; i++) {
+        const WheelResult *r = &results[i];
+        if (!r->skipped) {
+            printf("TW impl=wheel n=%u insert_cyc=%u cancel_cyc=%u expire_cyc=%u max_batch=%u cascaded=%u\n",
+                   r->count, r->insertCyc, r->cancelCyc, r->expireCyc, r->maxBatch, r->cascaded);
+        }
+    }
+    printf("TW impl=swtmr n=%u insert_cyc=%u cancel_cyc=%u\n", SWTMR_COMPARE_NUM, swInsert, swCancel);
+
+    for (UINT32 i = 0; i < SIZE_NUM; i++) {
+        const WheelResult *r = &results[i];
+        if (r->skipped) {
+            continue;
+        }
+        CHAR msg[64];
+        (VOID)snprintf(msg, sizeof(msg), "n=%u 全部按时到期", r->count);
+        TEST_ASSERT(r->fired == r->count && r->early == 0, msg);
+    }
+    if (!results[0].skipped && !results[SIZE_NUM - 1].skipped) {
+        // O(1)：规模扩大 1000 倍，单次插入 / 取消开销不应随之增长 (留 4 倍余量给缓存效应)
+        TEST_ASSERT(results[SIZE_NUM - 1].insertCyc <= results[0].insertCyc * 4 + 64, "插入开销与定时器数量无关");
+        TEST_ASSERT(results[SIZE_NUM - 1].cancelCyc <= results[0].cancelCyc * 4 + 64, "取消开销与定时器数量无关");
+    }
+
+    TEST_SUMMARY();
+    return NULL;
+}
+
+void TimerWheelBenchApp(void)
+{
+    unsigned int ret;
+    unsigned int taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    task.pfnTaskEntry = (TSK_ENTRY_FUNC)TimerWheelBenchTask;
+    task.uwStackSize  = TASK_STACK_SIZE;
+    task.pcName       = "TimerWheelBenchTask";
+    task.usTaskPrio   = CTRL_TASK_PRI;
+
+    ret = LOS_TaskCreate(&taskID, &task);
+    if (ret != LOS_OK) {
+        printf("TimerWheelBenchTask create failed: 0x%X\n", ret);
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef APP_TIMER_WHEEL_BENCH_H
+#define APP_TIMER_WHEEL_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void TimerWheelBenchApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
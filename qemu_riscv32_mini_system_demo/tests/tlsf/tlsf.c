@@ -0,0 +1,512 @@
+/*
+ * 两级分离适配 (TLSF) 内存池
+ * 块头只有物理前驱指针与大小两个字，空闲块在负载区再放空闲链表的前后指针。
+ * 大小的低两位为标志：本块空闲 / 物理前驱空闲；空闲块总是立即与相邻空闲块合并，
+ * 因此物理上不会出现两个相邻的空闲块。块区末尾放一个大小为 0 的已用哨兵块。
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "los_interrupt.h"
+
+#include "tlsf.h"
+
+#define TLSF_MAGIC               0x46534C54U    // "TLSF"
+#define BLOCK_FREE               0x1U
+#define BLOCK_PREV_FREE          0x2U
+#define BLOCK_FLAGS              (BLOCK_FREE | BLOCK_PREV_FREE)
+#define BLOCK_HDR                ((UINT32)offsetof(TlsfBlock, nextFree))
+#define BLOCK_MIN                ((UINT32)sizeof(TlsfBlock))
+#define BLOCK_MAX                ((1U << TLSF_FL_MAX) - TLSF_ALIGN)
+#define ALIGN_UP(x, a)           (((x) + ((a) - 1)) & ~((UINTPTR)(a) - 1))
+#define ALIGN_DOWN(x, a)         ((x) & ~((UINTPTR)(a) - 1))
+
+typedef struct TlsfBlock {
+    struct TlsfBlock *prevPhys;     // 仅在物理前驱空闲时有效
+    UINT32 size;                    // 负载字节数 | 标志
+    struct TlsfBlock *nextFree;     // 以下两项只在空闲时有效，与负载重叠
+    struct TlsfBlock *prevFree;
+} TlsfBlock;
+
+typedef struct {
+    UINT32 magic;
+    UINT32 poolSize;
+    UINT8 *areaBegin;
+    UINT8 *areaEnd;
+    UINT32 flBitmap;
+    UINT32 slBitmap[TLSF_FL_COUNT];
+    TlsfBlock *heads[TLSF_FL_COUNT][TLSF_SL_COUNT];
+} TlsfControl;
+
+/* ================= 块操作 ================= */
+
+static inline UINT32 Fls(UINT32 x)
+{
+    return 31 - (UINT32)__builtin_clz(x);
+}
+
+static inline UINT32 Ffs(UINT32 x)
+{
+    return (UINT32)__builtin_ctz(x);
+}
+
+static inline UINT32 BlockSize(const TlsfBlock *b)
+{
+    return b->size & ~BLOCK_FLAGS;
+}
+
+static inline VOID BlockSetSize(TlsfBlock *b, UINT32 size)
+{
+    b->size = size | (b->size & BLOCK_FLAGS);
+}
+
+static inline VOID *BlockPayload(TlsfBlock *b)
+{
+    return (UINT8 *)b + BLOCK_HDR;
+}
+
+static inline TlsfBlock *BlockFromPayload(const VOID *ptr)
+{
+    return (TlsfBlock *)((UINT8 *)ptr - BLOCK_HDR);
+}
+
+static inline TlsfBlock *BlockNext(const TlsfBlock *b)
+{
+    return (TlsfBlock *)((UINT8 *)b + BLOCK_HDR + BlockSize(b));
+}
+
+static VOID BlockMarkFree(TlsfBlock *b)
+{
+    TlsfBlock *next = BlockNext(b);
+
+    b->size |= BLOCK_FREE;
+    next->prevPhys = b;
+    next->size |= BLOCK_PREV_FREE;
+}
+
+static VOID BlockMarkUsed(TlsfBlock *b)
+{
+    b->size &= ~BLOCK_FREE;
+    BlockNext(b)->size &= ~BLOCK_PREV_FREE;
+}
+
+/* ================= 两级索引 ================= */
+
+static VOID MappingInsert(UINT32 size, UINT32 *fl, UINT32 *sl)
+{
+    if (size < TLSF_SMALL_BLOCK) {
+        *fl = 0;
+        *sl = size >> TLSF_ALIGN_LOG2;
+    } else {
+        UINT32 f = Fls(size);
+        *sl = (size >> (f - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+        *fl = f - (TLSF_FL_SHIFT - 1);
+    }
+}
+
+// 向上取整到二级区间上界，使选中链表的任意块都放得下
+static VOID MappingSearch(UINT32 size, UINT32 *fl, UINT32 *sl)
+{
+    if (size >= TLSF_SMALL_BLOCK) {
+        size += (1U << (Fls(size) - TLSF_SL_LOG2)) - 1;
+    }
+    MappingInsert(size, fl, sl);
+}
+
+static VOID FreeListRemove(TlsfControl *c, TlsfBlock *b, UINT32 fl, UINT32 sl)
+{
+    TlsfBlock *prev = b->prevFree;
+    TlsfBlock *next = b->nextFree;
+
+    if (next != NULL) {
+        next->prevFree = prev;
+    }
+    if (prev != NULL) {
+        prev->nextFree = next;
+        return;
+    }
+    c->heads[fl][sl] = next;
+    if (next == NULL) {
+        c->slBitmap[fl] &= ~(1U << sl);
+        if (c->slBitmap[fl] == 0) {
+            c->flBitmap &= ~(1U << fl);
+        }
+    }
+}
+
+static VOID BlockRemove(TlsfControl *c, TlsfBlock *b)
+{
+    UINT32 fl;
+    UINT32 sl;
+
+    MappingInsert(BlockSize(b), &fl, &sl);
+    FreeListRemove(c, b, fl, sl);
+}
+
+static VOID BlockInsert(TlsfControl *c, TlsfBlock *b)
+{
+    UINT32 fl;
+    UINT32 sl;
+
+    MappingInsert(BlockSize(b), &fl, &sl);
+    b->prevFree = NULL;
+    b->nextFree = c->heads[fl][sl];
+    if (b->nextFree != NULL) {
+        b->nextFree->prevFree = b;
+    }
+    c->heads[fl][sl] = b;
+    c->slBitmap[fl] |= 1U << sl;
+    c->flBitmap |= 1U << fl;
+}
+
+/*
+ * 取出一个能放下 size 字节的空闲块，只查两次位图
+ */
+static TlsfBlock *BlockLocate(TlsfControl *c, UINT32 size)
+{
+    UINT32 fl;
+    UINT32 sl;
+    UINT32 slMap;
+
+    MappingSearch(size, &fl, &sl);
+    if (fl >= TLSF_FL_COUNT) {
+        return NULL;
+    }
+    slMap = c->slBitmap[fl] & (~0U << sl);
+    if (slMap == 0) {
+        UINT32 flMap = c->flBitmap & (~0U << (fl + 1));
+        if (flMap == 0) {
+            return NULL;
+        }
+        fl = Ffs(flMap);
+        slMap = c->slBitmap[fl];
+    }
+    sl = Ffs(slMap);
+    TlsfBlock *b = c->heads[fl][sl];
+    FreeListRemove(c, b, fl, sl);
+    return b;
+}
+
+/*
+ * 释放一个已用块：与前后空闲块合并后挂回链表
+ */
+static VOID BlockRelease(TlsfControl *c, TlsfBlock *b)
+{
+    TlsfBlock *next = BlockNext(b);
+
+    if (b->size & BLOCK_PREV_FREE) {
+        TlsfBlock *prev = b->prevPhys;
+        BlockRemove(c, prev);
+        BlockSetSize(prev, BlockSize(prev) + BLOCK_HDR + BlockSize(b));
+        // 被并入的块头留在空闲负载里，置空闲位使重复释放在 BlockCheck 中被拒绝
+        b->size |= BLOCK_FREE;
+        b = prev;
+    }
+    if (next->size & BLOCK_FREE) {
+        BlockRemove(c, next);
+        BlockSetSize(b, BlockSize(b) + BLOCK_HDR + BlockSize(next));
+    }
+    BlockMarkFree(b);
+    BlockInsert(c, b);
+}
+
+/*
+ * 已用块 b 只保留 size 字节负载，多出的部分够成块时切下释放
+ */
+static VOID BlockTrimTail(TlsfControl *c, TlsfBlock *b, UINT32 size)
+{
+    UINT32 total = BlockSize(b);
+    TlsfBlock *rest;
+
+    if (total < size + BLOCK_MIN) {
+        return;
+    }
+    rest = (TlsfBlock *)((UINT8 *)BlockPayload(b) + size);
+    rest->size = total - size - BLOCK_HDR;
+    rest->prevPhys = b;
+    BlockSetSize(b, size);
+    BlockRelease(c, rest);
+}
+
+static VOID *BlockUse(TlsfControl *c, TlsfBlock *b, UINT32 size)
+{
+    BlockMarkUsed(b);
+    BlockTrimTail(c, b, size);
+    return BlockPayload(b);
+}
+
+static UINT32 AdjustSize(UINT32 size)
+{
+    size = ALIGN_UP(size, TLSF_ALIGN);
+    return (size < BLOCK_MIN - BLOCK_HDR) ? (BLOCK_MIN - BLOCK_HDR) : size;
+}
+
+static TlsfControl *ControlGet(VOID *pool)
+{
+    TlsfControl *c = (TlsfControl *)pool;
+
+    return (c != NULL && c->magic == TLSF_MAGIC) ? c : NULL;
+}
+
+/*
+ * 校验 ptr 是一个已用块的负载：空闲位之外再核对物理邻居，
+ * 已被并入前驱空闲块的旧块头 (重复释放) 即使标志被负载数据改写也过不了邻居检查
+ */
+static TlsfBlock *BlockCheck(TlsfControl *c, const VOID *ptr)
+{
+    TlsfBlock *b;
+    TlsfBlock *next;
+
+    if ((const UINT8 *)ptr < c->areaBegin + BLOCK_HDR || (const UINT8 *)ptr >= c->areaEnd ||
+        ((UINTPTR)ptr & (TLSF_ALIGN - 1)) != 0) {
+        return NULL;
+    }
+    b = BlockFromPayload(ptr);
+    if (b->size & BLOCK_FREE) {
+        return NULL;
+    }
+    // 已用块的后继必须在块区内且不带 "前驱空闲" 标志
+    if ((UINTPTR)BlockSize(b) + BLOCK_HDR > (UINTPTR)(c->areaEnd - (const UINT8 *)ptr)) {
+        return NULL;
+    }
+    next = BlockNext(b);
+    if (next->size & BLOCK_PREV_FREE) {
+        return NULL;
+    }
+    // 前驱空闲时它必须正好止于本块
+    if (b->size & BLOCK_PREV_FREE) {
+        TlsfBlock *prev = b->prevPhys;
+        if ((UINT8 *)prev < c->areaBegin || (UINT8 *)prev >= (UINT8 *)b ||
+            (prev->size & BLOCK_FREE) == 0 || BlockNext(prev) != b) {
+            return NULL;
+        }
+    }
+    return b;
+}
+
+/* ================= 接口 ================= */
+
+UINT32 TlsfMemInit(VOID *pool, UINT32 size)
+{
+    TlsfControl *c = (TlsfControl *)pool;
+    UINTPTR begin;
+    UINTPTR end;
+    UINT32 payload;
+    TlsfBlock *first;
+
+    if (pool == NULL || ((UINTPTR)pool & (TLSF_ALIGN - 1)) != 0) {
+        return LOS_NOK;
+    }
+    begin = ALIGN_UP((UINTPTR)pool + sizeof(TlsfControl), TLSF_ALIGN);
+    end = ALIGN_DOWN((UINTPTR)pool + size, TLSF_ALIGN);
+    if (end < begin + BLOCK_HDR * 2 + BLOCK_MIN) {
+        return LOS_NOK;
+    }
+    payload = (UINT32)(end - begin) - BLOCK_HDR * 2;
+    payload = (payload > BLOCK_MAX) ? BLOCK_MAX : payload;
+
+    memset(c, 0, sizeof(*c));
+    first = (TlsfBlock *)begin;
+    first->prevPhys = NULL;
+    first->size = payload;
+    BlockNext(first)->size = 0;
+    BlockMarkFree(first);
+    BlockInsert(c, first);
+
+    c->areaBegin = (UINT8 *)begin;
+    c->areaEnd = (UINT8 *)BlockNext(first) + BLOCK_HDR;
+    c->poolSize = size;
+    c->magic = TLSF_MAGIC;
+    return LOS_OK;
+}
+
+UINT32 TlsfMemDeInit(VOID *pool)
+{
+    TlsfControl *c = ControlGet(pool);
+
+    if (c == NULL) {
+        return LOS_NOK;
+    }
+    c->magic = 0;
+    return LOS_OK;
+}
+
+VOID *TlsfMemAlloc(VOID *pool, UINT32 size)
+{
+    TlsfControl *c = ControlGet(pool);
+    VOID *ptr = NULL;
+    UINT32 intSave;
+    TlsfBlock *b;
+
+    if (c == NULL || size == 0 || size > BLOCK_MAX) {
+        return NULL;
+    }
+    size = AdjustSize(size);
+    intSave = LOS_IntLock();
+    b = BlockLocate(c, size);
+    if (b != NULL) {
+        ptr = BlockUse(c, b, size);
+    }
+    LOS_IntRestore(intSave);
+    return ptr;
+}
+
+VOID *TlsfMemAllocAlign(VOID *pool, UINT32 size, UINT32 boundary)
+{
+    TlsfControl *c = ControlGet(pool);
+    VOID *ptr = NULL;
+    UINT32 intSave;
+    TlsfBlock *b;
+
+    if (c == NULL || size == 0 || size > BLOCK_MAX || boundary == 0 || (boundary & (boundary - 1)) != 0) {
+        return NULL;
+    }
+    if (boundary <= TLSF_ALIGN) {
+        return TlsfMemAlloc(pool, size);
+    }
+    size = AdjustSize(size);
+    intSave = LOS_IntLock();
+    // 多取 boundary + BLOCK_MIN，对齐点前的空隙要么为 0，要么能切成独立的空闲块
+    b = BlockLocate(c, size + boundary + BLOCK_MIN);
+    if (b != NULL) {
+        UINTPTR payload = (UINTPTR)BlockPayload(b);
+        UINTPTR aligned = ALIGN_UP(payload, boundary);
+        UINT32 gap = (UINT32)(aligned - payload);
+        while (gap != 0 && gap < BLOCK_MIN) {
+            aligned += boundary;
+            gap += boundary;
+        }
+        if (gap != 0) {
+            TlsfBlock *nb = BlockFromPayload((VOID *)aligned);
+            nb->size = (BlockSize(b) - gap) | BLOCK_FREE | BLOCK_PREV_FREE;
+            nb->prevPhys = b;
+            BlockSetSize(b, gap - BLOCK_HDR);
+            BlockInsert(c, b);
+            b = nb;
+        }
+        ptr = BlockUse(c, b, size);
+    }
+    LOS_IntRestore(intSave);
+    return ptr;
+}
+
+UINT32 TlsfMemFree(VOID *pool, VOID *ptr)
+{
+    TlsfControl *c = ControlGet(pool);
+    UINT32 intSave;
+    TlsfBlock *b;
+
+    if (c == NULL || ptr == NULL) {
+        return LOS_NOK;
+    }
+    intSave = LOS_IntLock();
+    b = BlockCheck(c, ptr);
+    if (b != NULL) {
+        BlockRelease(c, b);
+    }
+    LOS_IntRestore(intSave);
+    return (b != NULL) ? LOS_OK : LOS_NOK;
+}
+
+VOID *TlsfMemRealloc(VOID *pool, VOID *ptr, UINT32 size)
+{
+    TlsfControl *c = ControlGet(pool);
+    UINT32 intSave;
+    UINT32 cur;
+    UINT32 adjust;
+    TlsfBlock *b;
+    TlsfBlock *next;
+    VOID *p;
+
+    if (ptr == NULL) {
+        return TlsfMemAlloc(pool, size);
+    }
+    if (size == 0) {
+        (void)TlsfMemFree(pool, ptr);
+        return NULL;
+    }
+    if (c == NULL || size > BLOCK_MAX) {
+        return NULL;
+    }
+    adjust = AdjustSize(size);
+    intSave = LOS_IntLock();
+    b = BlockCheck(c, ptr);
+    if (b == NULL) {
+        LOS_IntRestore(intSave);
+        return NULL;
+    }
+    cur = BlockSize(b);
+    if (adjust <= cur) {
+        BlockTrimTail(c, b, adjust);
+        LOS_IntRestore(intSave);
+        return ptr;
+    }
+    next = BlockNext(b);
+    if ((next->size & BLOCK_FREE) && cur + BLOCK_HDR + BlockSize(next) >= adjust) {
+        BlockRemove(c, next);
+        BlockSetSize(b, cur + BLOCK_HDR + BlockSize(next));
+        BlockMarkUsed(b);
+        BlockTrimTail(c, b, adjust);
+        LOS_IntRestore(intSave);
+        return ptr;
+    }
+    LOS_IntRestore(intSave);
+
+    p = TlsfMemAlloc(pool, size);
+    if (p != NULL) {
+        (void)memcpy(p, ptr, cur);
+        (void)TlsfMemFree(pool, ptr);
+    }
+    return p;
+}
+
+UINT32 TlsfMemInfoGet(VOID *pool, LOS_MEM_POOL_STATUS *status)
+{
+    TlsfControl *c = ControlGet(pool);
+    UINT32 intSave;
+
+    if (c == NULL || status == NULL) {
+        return LOS_NOK;
+    }
+    memset(status, 0, sizeof(*status));
+    intSave = LOS_IntLock();
+    // 控制结构、哨兵与所有块头都计入已用，与 LOS_MemInfoGet 把池头和节点头算作已用一致
+    status->totalUsedSize = (UINT32)(c->areaBegin - (UINT8 *)pool) + BLOCK_HDR;
+    for (TlsfBlock *b = (TlsfBlock *)c->areaBegin; BlockSize(b) != 0; b = BlockNext(b)) {
+        if (b->size & BLOCK_FREE) {
+            status->totalFreeSize += BlockSize(b);
+            status->maxFreeNodeSize = (BlockSize(b) > status->maxFreeNodeSize) ?
+                                      BlockSize(b) : status->maxFreeNodeSize;
+            status->freeNodeNum++;
+            status->totalUsedSize += BLOCK_HDR;
+        } else {
+            status->totalUsedSize += BLOCK_HDR + BlockSize(b);
+            status->usedNodeNum++;
+        }
+    }
+    LOS_IntRestore(intSave);
+    return LOS_OK;
+}
+
+UINT32 TlsfMemUsableSize(VOID *pool, const VOID *ptr)
+{
+    TlsfControl *c = ControlGet(pool);
+    TlsfBlock *b;
+
+    if (c == NULL || ptr == NULL) {
+        return 0;
+    }
+    b = BlockCheck(c, ptr);
+    return (b != NULL) ? BlockSize(b) : 0;
+}
+
+BOOL TlsfMemOwns(const VOID *pool, const VOID *ptr)
+{
+    const TlsfControl *c = (const TlsfControl *)pool;
+
+    if (c == NULL || c->magic != TLSF_MAGIC) {
+        return FALSE;
+    }
+    return (const UINT8 *)ptr >= c->areaBegin + BLOCK_HDR && (const UINT8 *)ptr < c->areaEnd;
+}
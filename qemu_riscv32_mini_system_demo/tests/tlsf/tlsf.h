@@ -0,0 +1,71 @@
+#ifndef APP_TLSF_H
+#define APP_TLSF_H
+
+#include "los_memory.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 两级分离适配 (TLSF) 内存池
+ * 接口与 los_memory.h 一一对应，pool 为调用者提供的一段内存，控制结构放在池首。
+ * 空闲块按 (一级: 最高位, 二级: 其下 TLSF_SL_LOG2 位) 挂到 TLSF_FL_COUNT x TLSF_SL_COUNT 个链表，
+ * 两级位图记录非空链表。分配时请求向上取整到所在二级区间的上界，该区间之上任意非空链表的
+ * 表头都一定放得下，不需要遍历链表，分配与释放都是常数步 (只有 realloc 搬移时的拷贝与大小相关)。
+ * LOS_MemAlloc 在选中的链表里逐个比较大小，链表越长 (碎片越多) 越慢，这里用多一点内部碎片
+ * (最多约 1/TLSF_SL_COUNT) 换取与碎片无关的最坏延迟。
+ * 每个操作关中断执行，与 LOS_Mem* 相同。
+ */
+
+#define TLSF_ALIGN_LOG2          3
+#define TLSF_ALIGN               (1U << TLSF_ALIGN_LOG2)
+#define TLSF_SL_LOG2             4
+#define TLSF_SL_COUNT            (1U << TLSF_SL_LOG2)
+#define TLSF_FL_SHIFT            (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_FL_MAX              24                                  // 单块最大 16MB
+#define TLSF_FL_COUNT            (TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+#define TLSF_SMALL_BLOCK         (1U << TLSF_FL_SHIFT)               // 以下按 TLSF_ALIGN 线性分档
+
+/**
+ * @brief 在 pool 上建立 TLSF 池，pool 须 TLSF_ALIGN 对齐
+ * @return LOS_NOK 对齐不符或 size 放不下控制结构
+ */
+UINT32 TlsfMemInit(VOID *pool, UINT32 size);
+
+UINT32 TlsfMemDeInit(VOID *pool);
+
+VOID *TlsfMemAlloc(VOID *pool, UINT32 size);
+
+/**
+ * @brief boundary 须为 2 的幂，小于 TLSF_ALIGN 时按 TLSF_ALIGN 处理
+ */
+VOID *TlsfMemAllocAlign(VOID *pool, UINT32 size, UINT32 boundary);
+
+UINT32 TlsfMemFree(VOID *pool, VOID *ptr);
+
+/**
+ * @brief 语义同 LOS_MemRealloc：ptr 为 NULL 时等同分配，size 为 0 时等同释放；
+ * 优先原地扩缩 (并入后面的空闲块)，失败时原块保持不变
+ */
+VOID *TlsfMemRealloc(VOID *pool, VOID *ptr, UINT32 size);
+
+/**
+ * @brief 遍历整个池统计占用，耗时与块数成正比，不要在计时区间内调用
+ */
+UINT32 TlsfMemInfoGet(VOID *pool, LOS_MEM_POOL_STATUS *status);
+
+/**
+ * @brief 块的实际可用大小 (不小于申请大小)
+ */
+UINT32 TlsfMemUsableSize(VOID *pool, const VOID *ptr);
+
+/**
+ * @brief ptr 是否落在 pool 的块区内
+ */
+BOOL TlsfMemOwns(const VOID *pool, const VOID *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,128 @@
+/*
+ * TLSF 应用堆：malloc 系列的 --wrap 实现
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "los_config.h"
+#include "los_memory.h"
+#include "los_interrupt.h"
+
+#include "tlsf_heap.h"
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+/* ================= 全局变量 ================= */
+static VOID *volatile g_heap = NULL;
+static UINT32 g_fallbacks;
+static UINT32 g_foreignFrees;
+
+/* ================= 堆建立 ================= */
+
+static VOID *HeapGet(VOID)
+{
+    UINT32 intSave;
+    VOID *heap;
+
+    if (g_heap != NULL) {
+        return g_heap;
+    }
+    intSave = LOS_IntLock();
+    if (g_heap == NULL) {
+        heap = LOS_MemAllocAlign(OS_SYS_MEM_ADDR, HEAP_TLSF_SIZE, TLSF_ALIGN);
+        if (heap != NULL && TlsfMemInit(heap, HEAP_TLSF_SIZE) != LOS_OK) {
+            (void)LOS_MemFree(OS_SYS_MEM_ADDR, heap);
+            heap = NULL;
+        }
+        g_heap = heap;
+    }
+    LOS_IntRestore(intSave);
+    return g_heap;
+}
+
+static BOOL HeapOwns(const VOID *ptr)
+{
+    return g_heap != NULL && TlsfMemOwns(g_heap, ptr);
+}
+
+/* ================= malloc 系列 ================= */
+
+void *__wrap_malloc(size_t size)
+{
+    VOID *heap = HeapGet();
+    VOID *ptr = (heap != NULL) ? TlsfMemAlloc(heap, (UINT32)size) : NULL;
+
+    if (ptr == NULL && size != 0) {
+        g_fallbacks++;
+        ptr = __real_malloc(size);
+    }
+    return ptr;
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    size_t total = nmemb * size;
+    VOID *ptr;
+
+    if (size != 0 && total / size != nmemb) {
+        return NULL;
+    }
+    ptr = __wrap_malloc(total);
+    if (ptr != NULL) {
+        (void)memset(ptr, 0, total);
+    }
+    return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    VOID *p;
+
+    if (ptr == NULL) {
+        return __wrap_malloc(size);
+    }
+    if (!HeapOwns(ptr)) {
+        return __real_realloc(ptr, size);
+    }
+    p = TlsfMemRealloc(g_heap, ptr, (UINT32)size);
+    if (p == NULL && size != 0) {
+        // TLSF 池放不下时搬到系统内存池
+        p = __real_malloc(size);
+        if (p != NULL) {
+            UINT32 old = TlsfMemUsableSize(g_heap, ptr);
+            (void)memcpy(p, ptr, (old < size) ? old : size);
+            (void)TlsfMemFree(g_heap, ptr);
+            g_fallbacks++;
+        }
+    }
+    return p;
+}
+
+void __wrap_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    if (HeapOwns(ptr)) {
+        (void)TlsfMemFree(g_heap, ptr);
+        return;
+    }
+    g_foreignFrees++;
+    __real_free(ptr);
+}
+
+UINT32 TlsfHeapStatsGet(TlsfHeapStats *stats)
+{
+    if (g_heap == NULL) {
+        return LOS_NOK;
+    }
+    (void)TlsfMemInfoGet(g_heap, &stats->pool);
+    stats->poolSize = HEAP_TLSF_SIZE;
+    stats->fallbacks = g_fallbacks;
+    stats->foreignFrees = g_foreignFrees;
+    return LOS_OK;
+}
@@ -0,0 +1,38 @@
+#ifndef APP_TLSF_HEAP_H
+#define APP_TLSF_HEAP_H
+
+#include "tlsf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * TLSF 应用堆 (GN 参数 heap_tlsf)
+ * 链接时以 --wrap 接管 malloc / calloc / realloc / free，C++ 的 new / delete 经 malloc 一并接管。
+ * 首次分配时从系统内存池取 HEAP_TLSF_SIZE 字节建立 TLSF 池；池满时退回系统内存池并计数。
+ * newlib 内部直接调用 _malloc_r 的路径 (stdio 缓冲、strdup 等) 仍走系统内存池，
+ * 因此 free / realloc 按地址判断归属，不属于 TLSF 池的交回原实现。
+ * 内核与直接调用 LOS_MemAlloc 的代码不受影响。
+ */
+
+#ifndef HEAP_TLSF_SIZE
+#define HEAP_TLSF_SIZE           (256 * 1024)
+#endif
+
+typedef struct {
+    LOS_MEM_POOL_STATUS pool;
+    UINT32 poolSize;
+    UINT32 fallbacks;           // TLSF 池满后落到系统内存池的分配次数
+    UINT32 foreignFrees;        // 交回系统内存池的释放次数
+} TlsfHeapStats;
+
+/**
+ * @brief 获取堆统计；堆尚未建立时返回 LOS_NOK
+ */
+UINT32 TlsfHeapStatsGet(TlsfHeapStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
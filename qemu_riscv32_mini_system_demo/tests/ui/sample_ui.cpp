@@ -30,6 +30,7 @@
 #include "common/screen.h"
 #include "hal_tick.h"
 #include "hilog/log.h"
+#include "bench_rng.h"
 
 #include <stdio.h>
 
@@ -104,12 +105,12 @@ public:
     void Start();
 
 private:
-    UiDemo() { srand(HALTick::GetInstance().GetTime()); }
+    UiDemo() { BenchRngInit(&rng_, BENCH_RNG_STREAM_UI_DEMO); }
     ~UiDemo();
 
     int random(int min, int max)
     {
-        return rand() % (max - min) + min;
+        return static_cast<int>(BenchRngNext(&rng_) % static_cast<uint32_t>(max - min)) + min;
     }
 
     bool OnClick(UIView &view, const ClickEvent &event) override
@@ -127,6 +128,7 @@ private:
     UILabelButton *btn_ = nullptr;
     UILabel *label_ = nullptr;
     UIViewScaleRotate *viewScaleRotate_ = nullptr;
+    BenchRng rng_;
 };
 
 
@@ -24,6 +24,7 @@
 #include "graphic_config.h"
 #include "hal_tick.h"
 #include "hilog/log.h"
+#include "ui_pool.h"
 #include "ui_test.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -165,7 +166,7 @@ private:
         if (titleName == nullptr) {
             return nullptr;
         }
-        UILabel *label = new UILabel();
+        UILabel *label = new PooledLabel();
         if (label == nullptr) {
             return nullptr;
         }
@@ -209,7 +210,7 @@ void AnimatorDemo::SetUp()
         uiViewGroupFrame_->SetPosition(VIEW_DISTANCE_TO_LEFT_SIDE2, VIEW_DISTANCE_TO_TOP_SIDE);
         container_->Add(uiViewGroupFrame_);
 
-        label_ = new UILabel();
+        label_ = new PooledLabel();
         container_->Add(label_);
         label_->SetPosition(100, 20, 264, 48);
         label_->SetText("AnimatorDemo");
@@ -272,10 +273,10 @@ void AnimatorDemo::SetUpButton(UILabelButton *btn, const char *title, int16_t x,
 
 void AnimatorDemo::UIKit_Animator_Test_BackEasing_001()
 {
-    backOvershootBtn_ = new UILabelButton();
-    backEaseInBtn_ = new UILabelButton();
-    backEaseOutBtn_ = new UILabelButton();
-    backEaseInOutBtn_ = new UILabelButton();
+    backOvershootBtn_ = new PooledLabelButton();
+    backEaseInBtn_ = new PooledLabelButton();
+    backEaseOutBtn_ = new PooledLabelButton();
+    backEaseInOutBtn_ = new PooledLabelButton();
     positionX_ = TEXT_DISTANCE_TO_LEFT_SIDE;
     positionY_ = 0;
     SetUpLabel("back动画效果： ", positionX_, positionY_);
@@ -338,12 +339,12 @@ public:
         container_ = new UIScrollView();
         container_->SetPosition(0, 0, Screen::GetInstance().GetWidth(), Screen::GetInstance().GetHeight());
         container_->SetStyle(STYLE_BACKGROUND_COLOR, Color::White().full);
-        label_ = new UILabel();
+        label_ = new PooledLabel();
         label_->SetText("label");
         label_->SetPosition(100, 100, 100, 50);
         container_->Add(label_);
 
-        button_ = new UILabelButton();
+        button_ = new PooledLabelButton();
         button_->SetText("button");
         button_->SetPosition(100, 200, 100, 50);
         container_->Add(button_);
@@ -0,0 +1,124 @@
+/*
+ * ui 套件的注册表用例
+ *   ui.fps     每次迭代等待 1 秒后读取渲染线程统计的帧率，指标 fps_x10
+ *   ui.switch  模拟一次换屏：建出与 ImageDemo / AnimatorDemo 同类的一屏控件，再用 DeleteChildren 拆掉
+ * 只有 UI 动画在刷新时读数才有意义；帧率为 0 时记为失败，避免把空闲屏幕当成结果。
+ * ui.switch 的控件树不挂到 RootView，渲染任务不会同时访问；控件用 ui_pool.h 的 Pooled 类型创建，
+ * 打开与关闭 block_pools 各跑一次即可比较换屏耗时与系统堆碎片。每屏之间留下一个小的常驻分配
+ * (相当于换屏间产生的缓存、日志等)，控件走系统堆时它会落进控件释放后的空洞里，碎片逐屏累积。
+ * 系统堆指标在 heap_tlsf 关闭时才反映 UI 的分配。
+ */
+
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include "components/ui_scroll_view.h"
+#include "gfx_utils/sys_info.h"
+#include "los_task.h"
+#include "los_config.h"
+#include "los_memory.h"
+
+#include "bench_registry.h"
+#include "ui_pool.h"
+
+using namespace OHOS;
+
+namespace {
+constexpr UINT32 FPS_WINDOW_TICKS = LOSCFG_BASE_CORE_TICK_PER_SECOND;
+constexpr UINT32 SWITCH_LABELS = 8;
+constexpr UINT32 SWITCH_BUTTONS = 4;
+constexpr UINT32 SWITCH_IMAGES = 1;
+constexpr UINT32 SWITCH_RESIDUE_SIZE = 48;
+
+void *g_residue[BENCH_MAX_ITERS];
+
+UINT32 FpsRun(UINT32 iter, BenchMetrics *metrics)
+{
+    (void)iter;
+    (void)LOS_TaskDelay(FPS_WINDOW_TICKS);
+    float fps = SysInfo::GetFPS();
+    BenchMetricSetUnit(metrics, "fps_x10", "fps_x10", static_cast<UINT64>(fps * 10));
+    return (fps > 0) ? LOS_OK : LOS_NOK;
+}
+
+void DeleteChildren(UIView *view)
+{
+    while (view != nullptr) {
+        UIView *tempView = view;
+        view = view->GetNextSibling();
+        if (tempView->IsViewGroup()) {
+            DeleteChildren(static_cast<UIViewGroup *>(tempView)->GetChildrenHead());
+        }
+        if (tempView->GetParent()) {
+            static_cast<UIViewGroup *>(tempView->GetParent())->Remove(tempView);
+        }
+        delete tempView;
+    }
+}
+
+UIView *BuildScreen()
+{
+    UIScrollView *container = new UIScrollView();
+    int16_t y = 0;
+
+    container->SetPosition(25, 25, 400, 400);
+    for (UINT32 i = 0; i < SWITCH_LABELS; i++, y += 30) {
+        UILabel *label = new PooledLabel();
+        label->SetPosition(0, y, 200, 29);
+        label->SetText("label");
+        container->Add(label);
+    }
+    for (UINT32 i = 0; i < SWITCH_BUTTONS; i++, y += 60) {
+        UILabelButton *btn = new PooledLabelButton();
+        btn->SetPosition(0, y, 150, 50);
+        btn->SetText("button");
+        container->Add(btn);
+    }
+    for (UINT32 i = 0; i < SWITCH_IMAGES; i++) {
+        UIImageView *image = new PooledImageView();
+        image->SetPosition(200, 0, 100, 100);
+        container->Add(image);
+    }
+    return container;
+}
+
+UINT32 SwitchRun(UINT32 iter, BenchMetrics *metrics)
+{
+    LOS_MEM_POOL_STATUS status = { 0 };
+    UIView *screen = BuildScreen();
+
+    g_residue[iter] = malloc(SWITCH_RESIDUE_SIZE);
+    DeleteChildren(screen);
+
+    (void)LOS_MemInfoGet(OS_SYS_MEM_ADDR, &status);
+    UINT32 frag = (status.totalFreeSize == 0) ? 0 :
+        100 - static_cast<UINT32>(static_cast<UINT64>(status.maxFreeNodeSize) * 100 / status.totalFreeSize);
+    BenchMetricSetUnit(metrics, "heap_free_nodes", "nodes", status.freeNodeNum);
+    BenchMetricSetUnit(metrics, "heap_frag_pct", "pct", frag);
+    return LOS_OK;
+}
+
+void SwitchTeardown(void)
+{
+    for (UINT32 i = 0; i < BENCH_MAX_ITERS; i++) {
+        free(g_residue[i]);
+        g_residue[i] = nullptr;
+    }
+#if defined(BLOCK_POOLS)
+    BlockPoolDump();
+#endif
+}
+
+const BenchCase g_uiFps = {
+    "ui.fps", "ui", "render FPS sampled over 1s windows", 5, nullptr, FpsRun, nullptr,
+};
+
+const BenchCase g_uiSwitch = {
+    "ui.switch", "ui", "build and tear down one screen of labels/buttons/image", 20, nullptr, SwitchRun,
+    SwitchTeardown,
+};
+} // namespace
+
+BENCH_REGISTER(g_uiFps);
+BENCH_REGISTER(g_uiSwitch);
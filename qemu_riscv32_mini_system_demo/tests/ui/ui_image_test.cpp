@@ -21,6 +21,7 @@
 #include "components/ui_qrcode.h"
 #include "components/ui_scroll_view.h"
 #include "components/ui_view.h"
+#include "ui_pool.h"
 #include "ui_test.h"
 
 #define IMAGE_DIR "/data/img/"
@@ -112,26 +113,26 @@ void ImageDemo::CreateImageSwitch()
     if (container_ == nullptr) {
         return;
     }
-    UILabel *label = new UILabel();
+    UILabel *label = new PooledLabel();
     container_->Add(label);
     label->SetPosition(100, g_height, 200, 29);
     label->SetText("不同类型图片切换");
     g_height += 30;
 
-    gifImageView_ = new UIImageView();
+    gifImageView_ = new PooledImageView();
     gifImageView_->SetPosition(48, g_height);
     gifImageView_->SetSrc(GIF_PATH1);
     gifImageView_->Resize(100, 100);
     container_->Add(gifImageView_);
     g_height += 150;
 
-    gifToGif_ = new UILabelButton();
+    gifToGif_ = new PooledLabelButton();
     SetUpButton(gifToGif_, "切换GIF");
     gifToGif_->SetPosition(48, g_height + 10);
-    gifToJpeg_ = new UILabelButton();
+    gifToJpeg_ = new PooledLabelButton();
     SetUpButton(gifToJpeg_, "切换JPG");
     gifToJpeg_->SetPosition(48 + 120, g_height + 10);
-    gifToPng_ = new UILabelButton();
+    gifToPng_ = new PooledLabelButton();
     SetUpButton(gifToPng_, "切换PNG");
     gifToPng_->SetPosition(48 + 240, g_height + 10);
 }
@@ -200,7 +201,7 @@ UIView *QrcodeDemo::GetView()
         return nullptr;
     }
 
-    UILabel *titleLabel = new UILabel();
+    UILabel *titleLabel = new PooledLabel();
     titleLabel->SetPosition(100, 100, 300, 30);
     titleLabel->SetText("qrcode");
 
@@ -0,0 +1,13 @@
+/*
+ * UI 控件定长块池
+ */
+
+#include "ui_pool.h"
+
+#if defined(BLOCK_POOLS)
+using namespace OHOS;
+
+BLOCK_POOL_DEFINE(g_uiLabelPool, UILabel, UI_LABEL_POOL_COUNT);
+BLOCK_POOL_DEFINE(g_uiButtonPool, UILabelButton, UI_BUTTON_POOL_COUNT);
+BLOCK_POOL_DEFINE(g_uiImagePool, UIImageView, UI_IMAGE_POOL_COUNT);
+#endif
@@ -0,0 +1,68 @@
+#ifndef UI_POOL_H
+#define UI_POOL_H
+
+#include "components/ui_image_view.h"
+#include "components/ui_label.h"
+#include "components/ui_label_button.h"
+#if defined(BLOCK_POOLS)
+#include "block_pool.h"
+#endif
+
+/*
+ * 换屏时成批创建、由 DeleteChildren 成批销毁的控件改从定长块池分配 (GN 参数 block_pools)。
+ * 创建处写 new PooledLabel() 等，指针仍按 UILabel * 保存；UIView 的析构函数是虚函数，
+ * 经 UIView * delete 时调用的是 Pooled<T> 的 operator delete，块回到对应的池。
+ * 池在 ui_pool.cpp 中按类型定义，取空后退回 malloc；未打开 block_pools 时即为原类型。
+ */
+
+#if defined(BLOCK_POOLS)
+#define UI_LABEL_POOL_COUNT      24
+#define UI_BUTTON_POOL_COUNT     16
+#define UI_IMAGE_POOL_COUNT      4
+
+extern BlockPool g_uiLabelPool;
+extern BlockPool g_uiButtonPool;
+extern BlockPool g_uiImagePool;
+
+namespace OHOS {
+template <typename T> BlockPool *UiViewPool();
+template <> inline BlockPool *UiViewPool<UILabel>()
+{
+    return &g_uiLabelPool;
+}
+template <> inline BlockPool *UiViewPool<UILabelButton>()
+{
+    return &g_uiButtonPool;
+}
+template <> inline BlockPool *UiViewPool<UIImageView>()
+{
+    return &g_uiImagePool;
+}
+
+template <typename T>
+class Pooled : public T {
+public:
+    static void *operator new(size_t size)
+    {
+        return BlockPoolAlloc(UiViewPool<T>(), static_cast<UINT32>(size));
+    }
+
+    static void operator delete(void *ptr)
+    {
+        BlockPoolFree(UiViewPool<T>(), ptr);
+    }
+};
+
+using PooledLabel = Pooled<UILabel>;
+using PooledLabelButton = Pooled<UILabelButton>;
+using PooledImageView = Pooled<UIImageView>;
+} // namespace OHOS
+#else
+namespace OHOS {
+using PooledLabel = UILabel;
+using PooledLabelButton = UILabelButton;
+using PooledImageView = UIImageView;
+} // namespace OHOS
+#endif
+
+#endif // UI_POOL_H
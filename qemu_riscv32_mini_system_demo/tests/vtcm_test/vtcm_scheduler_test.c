@@ -4,6 +4,15 @@
 #include "los_atomic.h"
 #include "securec.h"
 #include "stdio.h"
+#if defined(SCHED_TRACE)
+#include "sched_trace.h"
+#endif
+#if defined(CPU_MONITOR)
+#include "cpu_monitor.h"
+#endif
+#if defined(TELEMETRY)
+#include "telemetry.h"
+#endif
 
 /* ================= 配置区域 ================= */
 // 测试总时长 (秒)
@@ -20,6 +29,12 @@
 // 可视化 Trace 缓冲区长度
 #define TRACE_BUF_LEN           64
 
+#if defined(TELEMETRY)
+// 监控表格改为遥测流，每个任务一行
+#define TM_STREAM_MONITOR       1
+#define TM_MONITOR_COLS         5
+#endif
+
 /* ================= 数据结构 ================= */
 typedef enum {
     TASK_TYPE_CPU_HOG = 0, // 死循环霸占 CPU
@@ -48,6 +63,18 @@ static UINT32 g_traceIdx = 0;
 // 上一次运行的任务ID (用于检测切换)
 static UINT32 g_lastRunningTaskId = 0xFFFFFFFF;
 
+#if defined(CPU_MONITOR)
+// 监控任务相邻两次打印的快照，用于计算区间增量
+static CpuMonSnapshot g_monPrev;
+static CpuMonSnapshot g_monNow;
+#endif
+
+#if defined(TELEMETRY)
+static const char *const g_tmMonitorFields[TM_MONITOR_COLS] = {
+    "task", "switches", "run_us", "int_pm", "win10_pm"
+};
+#endif
+
 /* ================= 辅助函数 ================= */
 
 /**
@@ -109,12 +136,14 @@ static void *WorkerTaskEntry(UINTPTR arg)
         // 每次跑一小段，模拟计算过程
         BurnCpu(1000); 
 
-        // --- 3. 更新运行时间 (非精确，仅作参考) ---
+#if !defined(CPU_MONITOR)
+        // --- 3. 更新运行时间 (非精确，仅作参考；开启 CPU_MONITOR 时由切换钩子按周期统计) ---
         UINT64 now = LOS_TickCountGet();
         if (now > stat->lastStartTime) {
             stat->totalRunTicks += (now - stat->lastStartTime);
             stat->lastStartTime = now;
         }
+#endif
 
         // --- 4. 行为分支 ---
         if (stat->type == TASK_TYPE_YIELDER) {
@@ -161,6 +190,9 @@ static void *PreemptorTaskEntry(UINTPTR arg)
 static void *MonitorTaskEntry(UINTPTR arg)
 {
     printf("[Monitor] Started.\n");
+#if defined(CPU_MONITOR)
+    CpuMonSnapshotTake(&g_monPrev);
+#endif
     UINT32 printInterval = 2 * LOSCFG_BASE_CORE_TICK_PER_SECOND; // 每2秒打印一次
     
     while (g_testRunning) {
@@ -178,6 +210,51 @@ static void *MonitorTaskEntry(UINTPTR arg)
         LOS_IntRestore(intSave);
 
         // 2. 打印表格
+#if defined(CPU_MONITOR) && defined(TELEMETRY)
+        // 与下面的表格同样的数据，以二进制帧输出；主机端 tools/telemetry_decode.py 还原为 CSV
+        CpuMonSnapshotTake(&g_monNow);
+        UINT32 rows[4 * TM_MONITOR_COLS];
+        for (int i = 0; i < 4; i++) {
+            const TaskStat *st = (i < 3) ? &g_lowStats[i] : &g_highStat;
+            CpuMonTaskUsage usage;
+            UINT64 delta;
+            UINT32 *row = &rows[i * TM_MONITOR_COLS];
+            UINT32 interval = CpuMonIntervalUsage(&g_monPrev, &g_monNow, st->taskId, &delta);
+            (void)CpuMonTaskUsageGet(st->taskId, &usage);
+            row[0] = st->taskId;
+            row[1] = usage.switchIns;
+            row[2] = (UINT32)(delta * 1000000ULL / OS_SYS_CLOCK);
+            row[3] = interval;
+            row[4] = usage.usage[CPU_MON_WIN_10S];
+        }
+        g_monPrev = g_monNow;
+        (void)TmSendCounters(TM_STREAM_MONITOR, rows, 4 * TM_MONITOR_COLS);
+#elif defined(CPU_MONITOR)
+        // 切入次数与运行时间来自切换钩子，Int% 为本次打印间隔内的占用率
+        CpuMonSnapshotTake(&g_monNow);
+        printf("%-10s | %-6s | %-8s | %-10s | %-6s | %-6s\n",
+               "Name", "Type", "Switches", "RunUs", "Int%", "10s%");
+        printf("-----------|--------|----------|------------|--------|-------\n");
+
+        for (int i = 0; i < 4; i++) {
+            const TaskStat *st = (i < 3) ? &g_lowStats[i] : &g_highStat;
+            CpuMonTaskUsage usage;
+            UINT64 delta;
+            UINT32 interval = CpuMonIntervalUsage(&g_monPrev, &g_monNow, st->taskId, &delta);
+            (void)CpuMonTaskUsageGet(st->taskId, &usage);
+            printf("%-10s | %-6s | %-8u | %-10llu | %3u.%u%% | %3u.%u%%\n",
+                   st->name,
+                   st->type == TASK_TYPE_PREEMPTOR ? "High" :
+                   (st->type == TASK_TYPE_YIELDER ? "Yield" : "Hog"),
+                   usage.switchIns,
+                   delta * 1000000ULL / OS_SYS_CLOCK,
+                   interval / 10, interval % 10,
+                   usage.usage[CPU_MON_WIN_10S] / 10, usage.usage[CPU_MON_WIN_10S] % 10);
+        }
+        g_monPrev = g_monNow;
+        printf("System busy (1s): %u.%u%%\n",
+               CpuMonSysUsage(CPU_MON_WIN_1S) / 10, CpuMonSysUsage(CPU_MON_WIN_1S) % 10);
+#else
         printf("%-10s | %-6s | %-8s | %-10s\n", "Name", "Type", "Switches", "RunTicks");
         printf("-----------|--------|----------|----------\n");
         
@@ -190,6 +267,7 @@ static void *MonitorTaskEntry(UINTPTR arg)
         }
         printf("%-10s | %-6s | %-8u | -\n", 
                g_highStat.name, "High", g_highStat.contextSwitchCount);
+#endif
         
         printf("==========================================\n");
     }
@@ -205,6 +283,26 @@ UINT32 SchedulerTestStart(void)
 
     printf("\n>>> LiteOS-M Scheduler Optimization Test <<<\n");
 
+#if defined(TELEMETRY)
+    if (TmInit() == LOS_OK) {
+        (void)TmStreamDefine(TM_STREAM_MONITOR, TM_KIND_COUNTERS, "vtcm_monitor",
+                             g_tmMonitorFields, TM_MONITOR_COLS);
+    }
+#endif
+
+#if defined(CPU_MONITOR)
+    // 首次初始化时已清零，不再重复 Reset，以免清掉其他模块正在使用的统计
+    (void)CpuMonInit();
+#endif
+
+#if defined(SCHED_TRACE)
+    // 记录整个测试期间的真实切换序列，结束后转储
+    if (SchedTraceInit() == LOS_OK) {
+        SchedTraceReset();
+        SchedTraceStart();
+    }
+#endif
+
     // 1. 初始化统计结构并创建 Worker 任务
     for (int i = 0; i < 3; i++) {
         memset_s(&g_lowStats[i], sizeof(TaskStat), 0, sizeof(TaskStat));
@@ -257,6 +355,23 @@ UINT32 SchedulerTestStart(void)
     g_testRunning = FALSE;
     printf("\n>>> Test Finished <<<\n");
 
+#if defined(SCHED_TRACE)
+    // 测试模式下串口是唯一出口，这里直接转储到串口；需要写 /data 时在 shell 中执行 schedtrace dump file
+    // 主机端: tools/sched_trace2json.py <串口日志|sched_trace.bin> -o trace.json
+    SchedTraceStop();
+    SchedTraceStats traceStats;
+    SchedTraceStatsGet(&traceStats);
+    if (traceStats.dropped != 0) {
+        printf("[schedtrace] %u records dropped, raise SCHED_TRACE_RECORDS\n", traceStats.dropped);
+    }
+    SchedTraceDumpUart();
+#endif
+
+#if defined(CPU_MONITOR)
+    // 全部任务 (含 idle / 系统任务) 的累计值与 1/10/60 秒窗口
+    CpuMonDump();
+#endif
+
     return LOS_OK;
 }
 
@@ -5,6 +5,16 @@
 #include "los_atomic.h"
 #include "securec.h"
 #include "stdio.h"
+#if defined(CPU_MONITOR)
+#include "cpu_monitor.h"
+#endif
+#if defined(VTPM_DLOG)
+#include "dlog.h"
+// 每次重调度的记录改为延迟日志，UART 输出不再计入被测任务的运行时间
+#define SCHED_LOG DLOG
+#else
+#define SCHED_LOG printf
+#endif
 
 // 配置常量
 #define TICKS_PER_SECOND 100
@@ -48,6 +58,12 @@ static volatile UINT32 g_approxSwitchCount = 0;
 static volatile UINT32 g_lastRunningTask = 0;
 static volatile UINT64 g_lastSwitchTick = 0;
 
+#if defined(CPU_MONITOR)
+// 监控任务相邻两次报告的快照
+static CpuMonSnapshot g_monPrev;
+static CpuMonSnapshot g_monNow;
+#endif
+
 // 原子操作包装（返回递增后的值，按 LOS_AtomicInc 的实际语义调整）
 static inline UINT32 AtomicIncrement(volatile UINT32 *value)
 {
@@ -81,7 +97,7 @@ static void *LowPriorityTaskEntry(UINTPTR arg)
             if (stat->lastScheduleTime > 0) {
                 UINT64 waitTime = currentTick - stat->lastSwitchTime;
                 if (waitTime > 0) {
-                    printf("[LTask%d] #%u Wait: %llu ticks\n",
+                    SCHED_LOG("[LTask%d] #%u Wait: %llu ticks\n",
                            taskIndex + 1, stat->scheduleCount, waitTime);
                 }
             }
@@ -143,7 +159,7 @@ static void *HighPriorityTaskEntry(UINTPTR arg)
         
         if (stat->lastScheduleTime > 0) {
             UINT64 waitTime = currentTick - stat->lastSwitchTime;
-            printf("[HTask] #%d EMERGENCY, Wait: %llu ticks\n",
+            SCHED_LOG("[HTask] #%d EMERGENCY, Wait: %llu ticks\n",
                    stat->scheduleCount, waitTime);
         }
         
@@ -198,6 +214,10 @@ static void *MonitorTaskEntry(UINTPTR arg)
     UINT64 lastReportTime = LOS_TickCountGet();
     UINT32 lastSwitchCount = g_approxSwitchCount;
     
+#if defined(CPU_MONITOR)
+    CpuMonSnapshotTake(&g_monPrev);
+#endif
+
     // 初始记录监控任务
     g_lastRunningTask = stat->taskId;
     g_lastSwitchTick = stat->startTime;
@@ -248,6 +268,23 @@ static void *MonitorTaskEntry(UINTPTR arg)
             printf("  Low tasks: CPU-bound (no TaskDelay)\n");
             printf("  High task: intermittent emergency work (TaskDelay(8))\n");
             
+#if defined(CPU_MONITOR)
+            // 运行占比：切换钩子按周期统计，取本次报告区间的增量
+            CpuMonSnapshotTake(&g_monNow);
+            UINT32 lowPermille = 0;
+            for (int i = 0; i < LOW_PRIORITY_TASK_COUNT; i++) {
+                UINT64 delta;
+                UINT32 usage = CpuMonIntervalUsage(&g_monPrev, &g_monNow, g_lowTasks[i].taskId, &delta);
+                printf("  Task%d: %llu us, %u.%u%%\n", i + 1,
+                       delta * 1000000ULL / OS_SYS_CLOCK, usage / 10, usage % 10);
+                lowPermille += usage;
+            }
+            UINT32 highPermille = CpuMonIntervalUsage(&g_monPrev, &g_monNow, g_highTask.taskId, NULL);
+            printf("  CPU Usage: Low %u.%u%%, High %u.%u%%, System %u.%u%% (1s)\n",
+                   lowPermille / 10, lowPermille % 10, highPermille / 10, highPermille % 10,
+                   CpuMonSysUsage(CPU_MON_WIN_1S) / 10, CpuMonSysUsage(CPU_MON_WIN_1S) % 10);
+            g_monPrev = g_monNow;
+#else
             // 计算运行占比（基于 ticks 统计）
             UINT64 totalLowTime = 0;
             for (int i = 0; i < LOW_PRIORITY_TASK_COUNT; i++) {
@@ -260,6 +297,7 @@ static void *MonitorTaskEntry(UINTPTR arg)
                 double highUsage = (double)g_highTask.totalRunTime * 100 / reportDuration;
                 printf("  CPU Usage: Low %.1f%%, High %.1f%%\n", lowUsage, highUsage);
             }
+#endif
             
             printf("===========================\n\n");
             
@@ -412,6 +450,14 @@ UINT32 VtpmSchedulerTest(void)
     printf("\nvTPM Multi-Instance Scheduler Test\n");
     printf("Testing LiteOS-M task scheduling with long timeslices\n");
     
+#if defined(CPU_MONITOR)
+    // 首次初始化时已清零，不再重复 Reset，以免清掉其他模块正在使用的统计
+    (void)CpuMonInit();
+#endif
+#if defined(VTPM_DLOG)
+    (void)DlogInit();
+#endif
+
     ret = CreateSchedulerTestTasks();
     if (ret != LOS_OK) {
         return ret;
@@ -422,8 +468,14 @@ UINT32 VtpmSchedulerTest(void)
     
     g_testRunning = FALSE;
     LOS_TaskDelay(500);  // 给任务时间结束
+#if defined(VTPM_DLOG)
+    (void)DlogFlush();
+#endif
     
     PrintFinalStatistics();
+#if defined(CPU_MONITOR)
+    CpuMonDump();
+#endif
     
     printf("\nTest completed\n");
     return LOS_OK;
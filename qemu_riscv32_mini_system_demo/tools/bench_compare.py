@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Huawei Device Co., Ltd.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+对比两次运行的基准结果记录 (tests/perf/bench_result.h)，有回归时以非 0 退出。
+
+输入可以是 qemu_run.sh 测试模式写出的串口日志 (取 "#BR " 前缀的行)，
+也可以是 "bench out file" 写出的 JSON Lines；两者可以混用，也可以各给多个文件。
+同一 (suite, case, metric) 出现多次 (多次启动或多次 bench run) 时取中位数，
+并用基线样本的离散度 (max - min) / 中位数 估计噪声。
+
+判定：变化超过 max(--threshold, --noise-mult x 基线噪声) 且绝对值超过 --min-abs 才算变化；
+方向由 unit 决定，"/s" 或 fps 开头越大越好，"count" 只展示不判定，其余越小越好。
+
+用法：
+  bench_compare.py -b base.log [-b base2.log] -n new.log [-n new2.log]
+                   [--threshold 5] [--noise-mult 2] [--min-abs 0]
+                   [--metric-threshold 'ipc/*/rate=10'] [--fail-missing] [--all]
+退出码：0 无回归；1 有回归 (或 --fail-missing 时有缺失用例)；2 输入中没有可比较的记录。
+"""
+
+import argparse
+import fnmatch
+import json
+import statistics
+import sys
+
+PREFIX = "#BR "
+SCHEMA_VERSION = 1
+
+
+class Series:
+    def __init__(self, unit):
+        self.unit = unit
+        self.values = []
+        self.iterations = 0
+
+    def median(self):
+        return statistics.median(self.values)
+
+    def noise(self):
+        med = self.median()
+        if len(self.values) < 2 or med == 0:
+            return 0.0
+        return (max(self.values) - min(self.values)) / abs(med)
+
+
+def parse_record(line):
+    line = line.strip()
+    if line.startswith(PREFIX):
+        line = line[len(PREFIX):]
+    elif not line.startswith("{"):
+        return None
+    try:
+        rec = json.loads(line)
+    except ValueError:
+        return None
+    if not isinstance(rec, dict) or "metric" not in rec or "value" not in rec:
+        return None
+    if rec.get("v", 0) > SCHEMA_VERSION:
+        raise ValueError("record schema v%s is newer than this tool (v%d)" % (rec.get("v"), SCHEMA_VERSION))
+    return rec
+
+
+def load(paths):
+    series = {}
+    builds = set()
+    for path in paths:
+        with open(path, "r", encoding="utf-8", errors="replace") as f:
+            for line in f:
+                # 串口日志里记录前面可能粘着其他任务的输出
+                pos = line.find(PREFIX)
+                rec = parse_record(line[pos:] if pos > 0 else line)
+                if rec is None:
+                    continue
+                key = (rec.get("suite", "-"), rec.get("case", "-"), rec["metric"])
+                s = series.setdefault(key, Series(rec.get("unit", "")))
+                s.values.append(float(rec["value"]))
+                s.iterations += int(rec.get("iterations", 0))
+                builds.add(rec.get("build", "?"))
+    return series, builds
+
+
+def direction(unit):
+    if unit == "count":
+        return 0
+    if "/s" in unit or unit.startswith("fps"):
+        return 1
+    return -1
+
+
+def key_name(key):
+    return "/".join(key)
+
+
+def threshold_for(key, args):
+    name = key_name(key)
+    for pattern, pct in args.metric_threshold:
+        if fnmatch.fnmatchcase(name, pattern):
+            return pct
+    return args.threshold
+
+
+def parse_metric_threshold(text):
+    pattern, sep, pct = text.rpartition("=")
+    if not sep or not pattern:
+        raise argparse.ArgumentTypeError("expected PATTERN=PCT, got %r" % text)
+    return pattern, float(pct)
+
+
+def compare(base, new, args):
+    rows = []
+    regressions = 0
+    missing = 0
+    for key in sorted(set(base) | set(new)):
+        b = base.get(key)
+        n = new.get(key)
+        if b is None:
+            rows.append((key, "-", "%g" % n.median(), "", "", "new"))
+            continue
+        if n is None:
+            rows.append((key, "%g" % b.median(), "-", "", "", "MISSING"))
+            missing += 1
+            continue
+        bv = b.median()
+        nv = n.median()
+        delta = nv - bv
+        rel = (delta / abs(bv) * 100.0) if bv != 0 else (0.0 if delta == 0 else float("inf"))
+        limit = max(threshold_for(key, args), args.noise_mult * b.noise() * 100.0)
+        sign = direction(b.unit)
+        if sign == 0:
+            verdict = "info" if delta else "same"
+        elif abs(rel) <= limit or abs(delta) <= args.min_abs:
+            verdict = "ok"
+        elif delta * sign < 0:
+            verdict = "REGRESSION"
+            regressions += 1
+        else:
+            verdict = "improved"
+        rows.append((key, "%g" % bv, "%g" % nv, "%+.1f%%" % rel, "%.1f%%" % limit, verdict))
+    return rows, regressions, missing
+
+
+def print_rows(rows, show_all):
+    header = ("suite/case/metric", "base", "new", "delta", "limit", "verdict")
+    shown = [r for r in rows if show_all or r[5] not in ("ok", "same")]
+    width = max([len(header[0])] + [len(key_name(r[0])) for r in shown])
+    fmt = "%-" + str(width) + "s  %14s  %14s  %9s  %7s  %s"
+    print(fmt % header)
+    for r in shown:
+        print(fmt % ((key_name(r[0]),) + r[1:]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="compare benchmark result records of two runs")
+    parser.add_argument("-b", "--base", action="append", required=True, help="baseline serial log / jsonl")
+    parser.add_argument("-n", "--new", action="append", required=True, help="candidate serial log / jsonl")
+    parser.add_argument("--threshold", type=float, default=5.0, help="minimum relative change in percent")
+    parser.add_argument("--noise-mult", type=float, default=2.0,
+                        help="multiple of baseline spread that is still treated as noise")
+    parser.add_argument("--min-abs", type=float, default=0.0, help="ignore absolute changes up to this value")
+    parser.add_argument("--metric-threshold", type=parse_metric_threshold, action="append", default=[],
+                        help="per-metric threshold, PATTERN=PCT on suite/case/metric (fnmatch), first match wins")
+    parser.add_argument("--fail-missing", action="store_true", help="treat cases missing from the new run as failure")
+    parser.add_argument("--all", action="store_true", help="also list unchanged metrics")
+    args = parser.parse_args()
+
+    try:
+        base, base_builds = load(args.base)
+        new, new_builds = load(args.new)
+    except (OSError, ValueError) as e:
+        print("bench_compare: %s" % e, file=sys.stderr)
+        return 2
+    if not set(base) & set(new):
+        print("bench_compare: no common records (base %d, new %d)" % (len(base), len(new)), file=sys.stderr)
+        return 2
+
+    print("base build: %s" % ", ".join(sorted(base_builds)))
+    print("new  build: %s" % ", ".join(sorted(new_builds)))
+    rows, regressions, missing = compare(base, new, args)
+    print_rows(rows, args.all)
+    print("%d metrics compared, %d regressions, %d missing" % (len(rows), regressions, missing))
+    if regressions or (missing and args.fail_missing):
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
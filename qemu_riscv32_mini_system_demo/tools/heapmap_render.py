@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Huawei Device Co., Ltd.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+渲染 tests/heap_mon 转储的系统堆图 (/data/heap/heapmap.bin，告警时为 heapmap_alarm.bin)。
+
+文本输出：汇总、空闲块大小直方图，以及按地址排列的占用图，每个字符代表若干格，
+字符由浅到深表示已用比例 (' ' 全空闲，'@' 全占用)，行首为相对池首的偏移。
+--pgm 另存为灰度图 (一格一个像素，黑为占用)，任何图片查看器都能打开，便于对比多次转储。
+
+用法：
+  heapmap_render.py <heapmap.bin> [--cols 64] [--rows 32] [--pgm out.pgm] [--pgm-width 64]
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x50414D48
+HEADER_FMT = "<IHHIIIII"
+REPORT_FMT = "<8I"
+HIST_MIN_SHIFT = 5
+SHADES = " .:-=+*#%@"
+
+
+class HeapMap:
+    def __init__(self, data):
+        off = 0
+        (magic, version, bins, self.pool_base, self.tick, self.cell_size, self.cell_count,
+         self.min_max_free) = struct.unpack_from(HEADER_FMT, data, off)
+        if magic != MAGIC:
+            raise ValueError("bad magic 0x%08x" % magic)
+        if version != 1:
+            raise ValueError("unsupported version %d" % version)
+        off += struct.calcsize(HEADER_FMT)
+        (self.walked, self.pool_size, self.used, self.free, self.max_free, self.free_nodes,
+         self.used_nodes, self.frag_pct) = struct.unpack_from(REPORT_FMT, data, off)
+        off += struct.calcsize(REPORT_FMT)
+        self.hist_count = struct.unpack_from("<%dI" % bins, data, off)
+        off += 4 * bins
+        self.hist_bytes = struct.unpack_from("<%dI" % bins, data, off)
+        off += 4 * bins
+        self.cells = data[off:off + self.cell_count]
+        if len(self.cells) != self.cell_count:
+            raise ValueError("truncated: %d of %d cells" % (len(self.cells), self.cell_count))
+
+
+def print_summary(hm, out):
+    out.write("pool 0x%08x size %d, tick %d, cell %d bytes x %d\n" % (
+        hm.pool_base, hm.pool_size, hm.tick, hm.cell_size, hm.cell_count))
+    out.write("used %d (%d nodes)  free %d (%d nodes)  max free %d  frag %d%%\n" % (
+        hm.used, hm.used_nodes, hm.free, hm.free_nodes, hm.max_free, hm.frag_pct))
+    if hm.min_max_free:
+        out.write("lowest max free seen by monitor: %d\n" % hm.min_max_free)
+    out.write("\n%-18s %8s %10s\n" % ("free block size", "count", "bytes"))
+    bins = len(hm.hist_count)
+    for i in range(bins):
+        lo = 0 if i == 0 else 1 << (HIST_MIN_SHIFT + i - 1)
+        label = (">= %d" % lo) if i == bins - 1 else ("%d..%d" % (lo, (1 << (HIST_MIN_SHIFT + i)) - 1))
+        out.write("%-18s %8d %10d\n" % (label, hm.hist_count[i], hm.hist_bytes[i]))
+
+
+def render_text(hm, cols, rows, out):
+    per_char = max(1, -(-hm.cell_count // (cols * rows)))
+    chars = []
+    for i in range(0, hm.cell_count, per_char):
+        group = hm.cells[i:i + per_char]
+        mean = sum(group) / (255.0 * len(group))
+        if mean <= 0:
+            chars.append(SHADES[0])
+        elif mean >= 1:
+            chars.append(SHADES[-1])
+        else:
+            chars.append(SHADES[1 + min(len(SHADES) - 3, int(mean * (len(SHADES) - 2)))])
+    span = per_char * hm.cell_size
+    out.write("\neach char = %d bytes, '%s' = free .. used\n" % (span, SHADES))
+    for r in range(0, len(chars), cols):
+        out.write("+%08x |%s|\n" % (r * span, "".join(chars[r:r + cols])))
+
+
+def write_pgm(hm, path, width):
+    height = -(-hm.cell_count // width)
+    pixels = bytes(255 - c for c in hm.cells) + bytes([128]) * (width * height - hm.cell_count)
+    with open(path, "wb") as f:
+        f.write(b"P5\n%d %d\n255\n" % (width, height))
+        f.write(pixels)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="heapmap.bin dumped by 'heapmon map'")
+    parser.add_argument("--cols", type=int, default=64, help="characters per row")
+    parser.add_argument("--rows", type=int, default=32, help="maximum rows of the text map")
+    parser.add_argument("--pgm", help="also write a grayscale PGM image")
+    parser.add_argument("--pgm-width", type=int, default=64, help="cells per PGM row")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        hm = HeapMap(f.read())
+    print_summary(hm, sys.stdout)
+    render_text(hm, args.cols, args.rows, sys.stdout)
+    if args.pgm:
+        write_pgm(hm, args.pgm, args.pgm_width)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Huawei Device Co., Ltd.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+把 tests/pc_prof 的串口转储 ("#PP" 行) 对照 OHOS_Image 符号化，输出折叠栈。
+
+每行输出 "任务;外层调用者;...;被打断的函数 样本数"，可直接交给 flamegraph.pl 或 speedscope。
+符号表取自 nm -n (只含函数级符号，内联函数归到调用者)；回溯地址是返回地址，减 1 后查找。
+回溯前几层是中断入口与 profiler 钩子本身，按 --skip 的正则剔除。
+串口日志中有多段转储时默认取最后一段，--all 合并全部。
+
+用法：
+  pcprof_fold.py <serial.log> [-e OHOS_Image] [--nm riscv32-unknown-elf-nm] [-o out.folded] [--top N]
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import subprocess
+import sys
+
+DEFAULT_ELF = "out/riscv32_virt/qemu_riscv_mini_system_demo/OHOS_Image"
+DEFAULT_SKIP = r"^(PcProf|OsHook|LOS_RecordLR|BackTrace|OsBackTrace|HalHwi|HalTrap|HalIrq|HalInterrupt|" \
+               r"ArchInterrupt|OsInterrupt|TrapVector|HandleInterrupt)"
+FLAG_IDLE = 0x1
+
+
+class Dump:
+    def __init__(self, tick_hz, divider, depth):
+        self.tick_hz = tick_hz
+        self.divider = divider
+        self.depth = depth
+        self.tasks = {}
+        self.samples = []          # (taskId, flags, pc, [bt...])
+        self.dropped = 0
+        self.complete = False
+
+
+def parse_dumps(path):
+    dumps = []
+    cur = None
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            pos = line.find("#PP ")
+            if pos < 0:
+                continue
+            parts = line[pos + 4:].split()
+            if not parts:
+                continue
+            tag = parts[0]
+            if tag == "BEGIN" and len(parts) >= 7:
+                cur = Dump(int(parts[2]), int(parts[3]), int(parts[4]))
+                cur.dropped = int(parts[6])
+                dumps.append(cur)
+            elif cur is None:
+                continue
+            elif tag == "T" and len(parts) >= 2:
+                cur.tasks[int(parts[1])] = " ".join(parts[2:]) or "task%s" % parts[1]
+            elif tag == "S" and len(parts) >= 4:
+                cur.samples.append((int(parts[1]), int(parts[2]), int(parts[3], 16),
+                                    [int(a, 16) for a in parts[4:]]))
+            elif tag == "END":
+                cur.complete = True
+                cur = None
+    return dumps
+
+
+class Symbols:
+    def __init__(self, elf, nm):
+        self.addrs = []
+        self.names = []
+        out = subprocess.run([nm, "-n", "--defined-only", elf], check=True,
+                             stdout=subprocess.PIPE, universal_newlines=True).stdout
+        for line in out.splitlines():
+            parts = line.split()
+            if len(parts) < 3 or parts[1] not in "tTwW":
+                continue
+            self.addrs.append(int(parts[0], 16))
+            self.names.append(parts[2])
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i < 0:
+            return "0x%08x" % addr
+        return self.names[i]
+
+
+def fold(dumps, syms, skip, with_task):
+    stacks = collections.Counter()
+    self_count = collections.Counter()
+    for d in dumps:
+        for task_id, flags, pc, bt in d.samples:
+            leaf = syms.lookup(pc)
+            callers = [syms.lookup(a - 1) for a in bt]
+            # 扫描从中断栈开始，剔除中断入口与钩子本身
+            while callers and skip.search(callers[0]):
+                callers.pop(0)
+            frames = list(reversed(callers)) + [leaf]
+            if with_task:
+                name = d.tasks.get(task_id, "task%d" % task_id)
+                if flags & FLAG_IDLE:
+                    name = "[idle] " + name
+                frames.insert(0, name.replace(";", "_").replace(" ", "_"))
+            stacks[";".join(frames)] += 1
+            self_count[leaf] += 1
+    return stacks, self_count
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="serial capture containing pcprof dump")
+    parser.add_argument("-e", "--elf", default=DEFAULT_ELF, help="image with symbols (default: %(default)s)")
+    parser.add_argument("--nm", default="riscv32-unknown-elf-nm", help="nm of the target toolchain")
+    parser.add_argument("-o", "--output", help="folded stacks output (default: stdout)")
+    parser.add_argument("--all", action="store_true", help="merge every dump in the log, not only the last")
+    parser.add_argument("--skip", default=DEFAULT_SKIP, help="regex of interrupt-path frames to strip")
+    parser.add_argument("--no-task", action="store_true", help="do not prefix stacks with the task name")
+    parser.add_argument("--top", type=int, default=15, help="print the N hottest functions to stderr")
+    args = parser.parse_args()
+
+    dumps = [d for d in parse_dumps(args.input) if d.complete]
+    if not dumps:
+        sys.stderr.write("no complete #PP dump found in %s\n" % args.input)
+        return 1
+    if not args.all:
+        dumps = dumps[-1:]
+
+    syms = Symbols(args.elf, args.nm)
+    stacks, self_count = fold(dumps, syms, re.compile(args.skip), not args.no_task)
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    try:
+        for stack, count in sorted(stacks.items()):
+            out.write("%s %d\n" % (stack, count))
+    finally:
+        if args.output:
+            out.close()
+
+    total = sum(self_count.values())
+    dropped = sum(d.dropped for d in dumps)
+    rates = sorted({d.tick_hz // max(d.divider, 1) for d in dumps})
+    sys.stderr.write("%d samples (%d dropped) at %s Hz, %d distinct stacks\n" % (
+        total, dropped, "/".join(str(r) for r in rates), len(stacks)))
+    for name, count in self_count.most_common(args.top):
+        sys.stderr.write("  %6.2f%% %6d  %s\n" % (100.0 * count / total, count, name))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Huawei Device Co., Ltd.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+把 tests/sched_trace 的转储转换为 Chrome / Perfetto trace JSON。
+
+输入可以是：
+  * /data/sched_trace.bin 二进制文件 (schedtrace dump file)
+  * 串口日志，包含 "#ST " 前缀的文本行 (schedtrace dump / SchedTraceDumpUart)
+
+用法：
+  sched_trace2json.py <input> [-o out.json]
+然后在 chrome://tracing 或 https://ui.perfetto.dev 打开 out.json。
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = 0x43525453
+HEADER_FMT = "<IHHIIII"
+TASK_FMT = "<II16s"
+RECORD_FMT = "<QHHBBBB"
+
+REASONS = ["preempt", "delay", "pend", "suspend", "exit", "other"]
+
+
+class Trace:
+    def __init__(self):
+        self.clock_hz = 0
+        self.dropped = 0
+        self.tasks = {}        # id -> (name, prio)
+        self.records = []      # (cycles, from, to, reason, from_prio, to_prio)
+
+
+def parse_binary(data):
+    trace = Trace()
+    hdr_size = struct.calcsize(HEADER_FMT)
+    magic, version, rec_size, clock_hz, rec_count, dropped, task_count = \
+        struct.unpack_from(HEADER_FMT, data, 0)
+    if magic != MAGIC:
+        raise ValueError("bad magic 0x%08x" % magic)
+    if rec_size != struct.calcsize(RECORD_FMT):
+        raise ValueError("unsupported record size %d (version %d)" % (rec_size, version))
+    trace.clock_hz = clock_hz
+    trace.dropped = dropped
+
+    off = hdr_size
+    task_size = struct.calcsize(TASK_FMT)
+    for _ in range(task_count):
+        tid, prio, name = struct.unpack_from(TASK_FMT, data, off)
+        trace.tasks[tid] = (name.split(b"\0", 1)[0].decode(errors="replace"), prio)
+        off += task_size
+    for _ in range(rec_count):
+        # 去掉末尾保留字节，与文本格式保持一致
+        trace.records.append(struct.unpack_from(RECORD_FMT, data, off)[:6])
+        off += rec_size
+    return trace
+
+
+def parse_log(text):
+    trace = Trace()
+    for line in text.splitlines():
+        pos = line.find("#ST ")
+        if pos < 0:
+            continue
+        fields = line[pos + 4:].split()
+        if not fields:
+            continue
+        kind = fields[0]
+        if kind == "BEGIN":
+            # 同一份日志可能有多次转储，只保留最后一次
+            trace = Trace()
+            trace.clock_hz = int(fields[2])
+            trace.dropped = int(fields[3])
+        elif kind == "T":
+            name = " ".join(fields[3:]) if len(fields) > 3 else "task%s" % fields[1]
+            trace.tasks[int(fields[1])] = (name, int(fields[2]))
+        elif kind == "R":
+            trace.records.append(tuple(int(v) for v in fields[1:7]))
+    return trace
+
+
+def load(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) >= 4 and struct.unpack_from("<I", data, 0)[0] == MAGIC:
+        return parse_binary(data)
+    return parse_log(data.decode(errors="replace"))
+
+
+def to_chrome(trace):
+    if not trace.records:
+        raise ValueError("no records in trace")
+    if trace.clock_hz == 0:
+        raise ValueError("missing clock frequency")
+
+    base = trace.records[0][0]
+
+    def us(cycles):
+        return (cycles - base) * 1e6 / trace.clock_hz
+
+    def name_of(tid):
+        return trace.tasks.get(tid, ("task%d" % tid, 0))[0]
+
+    events = [{"name": "process_name", "ph": "M", "pid": 0, "args": {"name": "LiteOS-M"}}]
+    seen = set()
+    for rec in trace.records:
+        seen.add(rec[1])
+        seen.add(rec[2])
+    for tid in sorted(seen):
+        events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": tid,
+                       "args": {"name": "%s (0x%x)" % (name_of(tid), tid)}})
+        events.append({"name": "thread_sort_index", "ph": "M", "pid": 0, "tid": tid,
+                       "args": {"sort_index": tid}})
+
+    # 第 i 条记录切入的任务一直运行到第 i+1 条记录把它切出
+    for cur, nxt in zip(trace.records, trace.records[1:]):
+        start, _, to_id, _, _, to_prio = cur
+        end, _, _, reason, _, _ = nxt
+        events.append({
+            "name": name_of(to_id), "ph": "X", "pid": 0, "tid": to_id,
+            "ts": us(start), "dur": us(end) - us(start),
+            "args": {"prio": to_prio, "switched_out": REASONS[min(reason, len(REASONS) - 1)]},
+        })
+    return {"traceEvents": events, "displayTimeUnit": "ns",
+            "otherData": {"clock_hz": trace.clock_hz, "dropped": trace.dropped}}
+
+
+def print_summary(trace, out):
+    run = {}
+    switches = {}
+    for cur, nxt in zip(trace.records, trace.records[1:]):
+        run[cur[2]] = run.get(cur[2], 0) + nxt[0] - cur[0]
+        switches[cur[2]] = switches.get(cur[2], 0) + 1
+    total = sum(run.values()) or 1
+    out.write("%-16s %10s %12s %7s\n" % ("Task", "Switches", "RunUs", "CPU%"))
+    for tid in sorted(run, key=run.get, reverse=True):
+        name = trace.tasks.get(tid, ("task%d" % tid, 0))[0]
+        out.write("%-16s %10d %12.1f %6.1f%%\n" % (
+            name, switches[tid], run[tid] * 1e6 / trace.clock_hz, run[tid] * 100.0 / total))
+    if trace.dropped:
+        out.write("warning: %d records were dropped on target\n" % trace.dropped)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="sched_trace.bin or serial log")
+    parser.add_argument("-o", "--output", help="output JSON file (default: stdout)")
+    args = parser.parse_args()
+
+    trace = load(args.input)
+    doc = to_chrome(trace)
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(doc, f)
+    else:
+        json.dump(doc, sys.stdout)
+        sys.stdout.write("\n")
+    print_summary(trace, sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
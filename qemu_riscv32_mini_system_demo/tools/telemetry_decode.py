@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Huawei Device Co., Ltd.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+把串口日志中的 tests/telemetry 遥测帧 ("#TM " 前缀的 base64 行) 解码为 CSV 或 JSON。
+
+控制台文本与遥测行可以任意穿插，非 "#TM " 行被忽略；CRC 错误的帧丢弃并计数，
+按 16 位序号统计丢帧。HELLO 帧 (目标重启) 会重置序号与流定义；
+"telemetry meta" 补发的 HELLO 带 RESEND 标志，只更新时钟参数，不重置也不计为重启。
+
+用法：
+  telemetry_decode.py <serial.log> [-f csv|json] [-o out] [--trace-dir DIR]
+CSV 为长表：time_s,seq,stream,name,row,field,value，可直接用 pandas / 表格软件透视。
+TRACE 流按偏移拼接后写入 DIR/<流名>.bin；sched 流即 sched_trace 的二进制文件格式，
+可继续交给 sched_trace2json.py。
+"""
+
+import argparse
+import base64
+import binascii
+import csv
+import json
+import struct
+import sys
+
+PREFIX = b"#TM "
+VERSION = 1
+HEADER_FMT = "<BBBBHHI"
+FLAG_RESEND = 0x01
+HEADER_SIZE = struct.calcsize(HEADER_FMT)
+CRC_SIZE = 2
+
+TYPE_HELLO, TYPE_META, TYPE_COUNTERS, TYPE_HISTOGRAM, TYPE_TRACE = range(5)
+KIND_COUNTERS, KIND_HISTOGRAM, KIND_TRACE = range(3)
+KIND_NAMES = ["counters", "histogram", "trace"]
+
+
+class Stream:
+    def __init__(self, kind, name, fields):
+        self.kind = kind
+        self.name = name
+        self.fields = fields
+        self.frames = 0
+        self.trace = bytearray()
+
+
+class Decoder:
+    def __init__(self):
+        self.clock_hz = 0
+        self.tick_hz = 100
+        self.streams = {}
+        self.records = []          # 每条数据帧一项
+        self.frames = 0
+        self.crc_errors = 0
+        self.malformed = 0
+        self.lost = 0
+        self.restarts = 0
+        self.undefined = 0
+        self._expect = None
+        self._tick_epoch = 0
+        self._last_tick = 0
+
+    def _time(self, tick):
+        # u32 tick 回绕时累加一个周期
+        if tick < self._last_tick and self._last_tick - tick > 0x80000000:
+            self._tick_epoch += 1 << 32
+        self._last_tick = tick
+        return (self._tick_epoch + tick) / float(self.tick_hz)
+
+    def _track_seq(self, seq):
+        if self._expect is not None:
+            gap = (seq - self._expect) & 0xFFFF
+            if gap < 0x8000:
+                self.lost += gap
+        self._expect = (seq + 1) & 0xFFFF
+
+    def feed_line(self, line):
+        pos = line.find(PREFIX)
+        if pos < 0:
+            return
+        text = line[pos + len(PREFIX):].strip()
+        try:
+            frame = base64.b64decode(text, validate=True)
+        except (binascii.Error, ValueError):
+            self.malformed += 1
+            return
+        if len(frame) < HEADER_SIZE + CRC_SIZE:
+            self.malformed += 1
+            return
+        version, ftype, stream, flags, seq, length, tick = struct.unpack_from(HEADER_FMT, frame, 0)
+        if version != VERSION or len(frame) != HEADER_SIZE + length + CRC_SIZE:
+            self.malformed += 1
+            return
+        crc = struct.unpack_from("<H", frame, HEADER_SIZE + length)[0]
+        if binascii.crc_hqx(frame[:HEADER_SIZE + length], 0xFFFF) != crc:
+            self.crc_errors += 1
+            return
+        payload = frame[HEADER_SIZE:HEADER_SIZE + length]
+        self.frames += 1
+
+        if ftype == TYPE_HELLO and flags & FLAG_RESEND:
+            # 补发的 HELLO 只是元数据，序号照常连续
+            self._track_seq(seq)
+            self._time(tick)
+            self.clock_hz, self.tick_hz, _ = struct.unpack_from("<IHH", payload, 0)
+            return
+        if ftype == TYPE_HELLO:
+            if self._expect is not None:
+                self.restarts += 1
+            self.clock_hz, self.tick_hz, _ = struct.unpack_from("<IHH", payload, 0)
+            self.streams = {}
+            self._expect = (seq + 1) & 0xFFFF
+            self._tick_epoch = 0
+            self._last_tick = tick
+            return
+        self._track_seq(seq)
+        t = self._time(tick)
+        if ftype == TYPE_META:
+            kind, count = payload[0], payload[1]
+            names = payload[2:].split(b"\0")
+            name = names[0].decode(errors="replace")
+            fields = [n.decode(errors="replace") for n in names[1:1 + count]]
+            old = self.streams.get(stream)
+            if old is None or old.name != name or old.fields != fields:
+                self.streams[stream] = Stream(kind, name, fields)
+            return
+
+        s = self.streams.get(stream)
+        if s is None:
+            self.undefined += 1
+            return
+        s.frames += 1
+        if ftype == TYPE_TRACE:
+            offset = struct.unpack_from("<I", payload, 0)[0]
+            data = payload[4:]
+            if offset > len(s.trace):
+                s.trace.extend(b"\0" * (offset - len(s.trace)))
+            s.trace[offset:offset + len(data)] = data
+            return
+
+        values = decode_varints(payload)
+        cols = len(s.fields) or 1
+        rows = [dict(zip(s.fields, values[i:i + cols])) for i in range(0, len(values), cols)]
+        self.records.append({"time_s": round(t, 3), "seq": seq, "stream": stream, "name": s.name,
+                             "kind": KIND_NAMES[min(s.kind, len(KIND_NAMES) - 1)], "rows": rows})
+
+
+def decode_varints(data):
+    values = []
+    cur = 0
+    shift = 0
+    for b in data:
+        cur |= (b & 0x7F) << shift
+        if b & 0x80:
+            shift += 7
+        else:
+            values.append(cur)
+            cur = 0
+            shift = 0
+    return values
+
+
+def write_csv(dec, out):
+    w = csv.writer(out)
+    w.writerow(["time_s", "seq", "stream", "name", "row", "field", "value"])
+    for rec in dec.records:
+        for idx, row in enumerate(rec["rows"]):
+            for field, value in row.items():
+                w.writerow([rec["time_s"], rec["seq"], rec["stream"], rec["name"], idx, field, value])
+
+
+def write_json(dec, out):
+    doc = {
+        "clock_hz": dec.clock_hz,
+        "tick_hz": dec.tick_hz,
+        "streams": {str(k): {"name": s.name, "kind": KIND_NAMES[min(s.kind, len(KIND_NAMES) - 1)],
+                             "fields": s.fields} for k, s in dec.streams.items()},
+        "records": dec.records,
+        "stats": summary(dec),
+    }
+    json.dump(doc, out, indent=1)
+    out.write("\n")
+
+
+def summary(dec):
+    return {"frames": dec.frames, "lost": dec.lost, "crc_errors": dec.crc_errors,
+            "malformed": dec.malformed, "undefined_stream": dec.undefined, "restarts": dec.restarts}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="serial capture (qemu_run.sh test mode output)")
+    parser.add_argument("-f", "--format", choices=["csv", "json"], default="csv")
+    parser.add_argument("-o", "--output", help="output file (default: stdout)")
+    parser.add_argument("--trace-dir", help="write reassembled TRACE streams to DIR/<name>.bin")
+    args = parser.parse_args()
+
+    dec = Decoder()
+    with open(args.input, "rb") as f:
+        for line in f:
+            dec.feed_line(line)
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    try:
+        if args.format == "csv":
+            write_csv(dec, out)
+        else:
+            write_json(dec, out)
+    finally:
+        if args.output:
+            out.close()
+
+    if args.trace_dir:
+        for s in dec.streams.values():
+            if s.kind == KIND_TRACE and s.trace:
+                with open("%s/%s.bin" % (args.trace_dir, s.name), "wb") as f:
+                    f.write(s.trace)
+
+    st = summary(dec)
+    sys.stderr.write("frames %d, lost %d, crc errors %d, malformed %d, undefined stream %d, restarts %d\n" % (
+        st["frames"], st["lost"], st["crc_errors"], st["malformed"], st["undefined_stream"], st["restarts"]))
+    for k in sorted(dec.streams):
+        s = dec.streams[k]
+        sys.stderr.write("  stream %d %-12s %-9s %d frames\n" % (
+            k, s.name, KIND_NAMES[min(s.kind, len(KIND_NAMES) - 1)], s.frames))
+    return 0 if dec.crc_errors == 0 and dec.lost == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())